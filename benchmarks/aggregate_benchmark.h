@@ -0,0 +1,94 @@
+/**
+ * Copyright © 2026 CZ.NIC, z. s. p. o.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, you can obtain one at https://mozilla.org/MPL/2.0/.
+ */
+
+#pragma once
+
+#include <chrono>
+#include <sstream>
+#include <benchmark/benchmark.h>
+
+#include "../src/cdns.h"
+#include "../src/aggregate.h"
+#include "common.h"
+
+namespace CDNS {
+    /**
+     * @brief Synthetic workload of 500000 records in 50 Blocks, encoded once for all aggregate benchmarks
+     */
+    const std::string& aggregate_workload() {
+        static const std::string data = encode_workload(generate_workload(500000), 10000);
+        return data;
+    }
+
+    /**
+     * @brief Aggregate every Block separately on the workers and merge each Block's aggregate
+     * on the calling thread. Counter "consumer" is the share of wall time spent merging
+     * on the calling thread, which bounds the speed-up of more workers.
+     * @param state Benchmark state, state.range(0) is the number of worker threads
+     */
+    void BM_AggregateMergePerBlock(benchmark::State& state) {
+        const std::string& data = aggregate_workload();
+        std::chrono::duration<double> consumer(0);
+        std::chrono::duration<double> total(0);
+
+        for (auto _ : state) {
+            auto start = std::chrono::steady_clock::now();
+            std::istringstream input(data);
+            CdnsReader reader(input);
+            TrafficAggregate aggregate;
+            ParallelBlockReader<TrafficAggregate> parallel(reader, state.range(0));
+            parallel.run([](CdnsBlockRead& block) {
+                TrafficAggregate partial;
+                partial.add_block(block);
+                return partial;
+            }, [&aggregate, &consumer](TrafficAggregate& partial) {
+                auto merge_start = std::chrono::steady_clock::now();
+                aggregate.merge(partial);
+                consumer += std::chrono::steady_clock::now() - merge_start;
+            });
+            benchmark::DoNotOptimize(aggregate.qr_count);
+            total += std::chrono::steady_clock::now() - start;
+        }
+
+        state.SetItemsProcessed(state.iterations() * 500000);
+        state.counters["consumer"] = total.count() > 0 ? consumer.count() / total.count() : 0;
+    }
+    BENCHMARK(BM_AggregateMergePerBlock)->Arg(1)->Arg(2)->Arg(4)->Arg(8)->Unit(benchmark::kMillisecond)->UseRealTime();
+
+    /**
+     * @brief Aggregate Blocks with TrafficAggregate::add_blocks(), each worker keeps its own aggregate
+     * and the calling thread only merges one aggregate per worker at the end (included in wall time).
+     * Counter "consumer" is the share of wall time spent merging the result into the total.
+     * @param state Benchmark state, state.range(0) is the number of worker threads
+     */
+    void BM_AggregateAddBlocks(benchmark::State& state) {
+        const std::string& data = aggregate_workload();
+        std::chrono::duration<double> consumer(0);
+        std::chrono::duration<double> total(0);
+
+        for (auto _ : state) {
+            auto start = std::chrono::steady_clock::now();
+            std::istringstream input(data);
+            CdnsReader reader(input);
+            TrafficAggregate partial;
+            partial.add_blocks(reader, state.range(0));
+
+            // Merge of the result into the aggregate of previous inputs, as cdns-stats does for each file
+            auto merge_start = std::chrono::steady_clock::now();
+            TrafficAggregate aggregate;
+            aggregate.merge(partial);
+            consumer += std::chrono::steady_clock::now() - merge_start;
+            benchmark::DoNotOptimize(aggregate.qr_count);
+            total += std::chrono::steady_clock::now() - start;
+        }
+
+        state.SetItemsProcessed(state.iterations() * 500000);
+        state.counters["consumer"] = total.count() > 0 ? consumer.count() / total.count() : 0;
+    }
+    BENCHMARK(BM_AggregateAddBlocks)->Arg(1)->Arg(2)->Arg(4)->Arg(8)->Unit(benchmark::kMillisecond)->UseRealTime();
+}
@@ -0,0 +1,17 @@
+/**
+ * Copyright © 2026 CZ.NIC, z. s. p. o.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, you can obtain one at https://mozilla.org/MPL/2.0/.
+ */
+
+#include <benchmark/benchmark.h>
+#include "cdns_encoder_benchmark.h"
+#include "cdns_decoder_benchmark.h"
+#include "block_table_benchmark.h"
+#include "block_benchmark.h"
+#include "writer_benchmark.h"
+#include "cdns_exporter_benchmark.h"
+#include "cdns_reader_benchmark.h"
+#include "aggregate_benchmark.h"
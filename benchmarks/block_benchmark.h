@@ -0,0 +1,132 @@
+/**
+ * Copyright © 2026 CZ.NIC, z. s. p. o.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, you can obtain one at https://mozilla.org/MPL/2.0/.
+ */
+
+#pragma once
+
+#include <sstream>
+#include <vector>
+#include <benchmark/benchmark.h>
+
+#include "../src/cdns.h"
+#include "common.h"
+
+namespace CDNS {
+    /**
+     * @brief Fill Block with the given records
+     * @param block Block to fill
+     * @param qrs Records to add to the Block
+     */
+    void fill_block(CdnsBlock& block, const std::vector<GenericQueryResponse>& qrs) {
+        for (auto& qr : qrs)
+            block.add_question_response_record(qr);
+    }
+
+    void BM_BlockAddQR(benchmark::State& state) {
+        std::vector<GenericQueryResponse> qrs = generate_workload(state.range(0));
+        BlockParameters bp;
+        bp.storage_parameters.max_block_items = qrs.size();
+        CdnsBlock block(bp, 0);
+
+        for (auto _ : state) {
+            fill_block(block, qrs);
+            block.clear();
+        }
+
+        state.SetItemsProcessed(state.iterations() * qrs.size());
+    }
+    BENCHMARK(BM_BlockAddQR)->Arg(10000);
+
+    void BM_BlockWrite(benchmark::State& state) {
+        std::vector<GenericQueryResponse> qrs = generate_workload(state.range(0));
+        BlockParameters bp;
+        bp.storage_parameters.max_block_items = qrs.size();
+        CdnsBlock block(bp, 0);
+        fill_block(block, qrs);
+        CdnsEncoder enc(null_output(), CborOutputCompression::NO_COMPRESSION);
+        std::size_t written = 0;
+
+        for (auto _ : state)
+            written += block.write(enc);
+
+        state.SetItemsProcessed(state.iterations() * qrs.size());
+        state.SetBytesProcessed(written);
+    }
+    BENCHMARK(BM_BlockWrite)->Arg(10000);
+
+    /**
+     * @brief Benchmark reading of one encoded Block
+     * @param state Benchmark state
+     * @param reuse Read all iterations into the same Block object
+     */
+    void block_read(benchmark::State& state, bool reuse) {
+        std::vector<GenericQueryResponse> qrs = generate_workload(state.range(0));
+        std::vector<BlockParameters> bps(1);
+        bps[0].storage_parameters.max_block_items = qrs.size();
+        CdnsBlock block(bps[0], 0);
+        fill_block(block, qrs);
+
+        MemoryOutput buffer;
+        {
+            CdnsEncoder enc(buffer, CborOutputCompression::NO_COMPRESSION);
+            block.write(enc);
+        }
+        std::string data = buffer.release();
+        CdnsBlockRead read_block;
+
+        for (auto _ : state) {
+            std::istringstream input(data);
+            CdnsDecoder dec(input);
+            if (reuse) {
+                read_block.read(dec, bps);
+            }
+            else {
+                CdnsBlockRead tmp(dec, bps);
+                benchmark::DoNotOptimize(tmp.get_qr_count());
+            }
+        }
+
+        state.SetItemsProcessed(state.iterations() * qrs.size());
+        state.SetBytesProcessed(state.iterations() * data.size());
+    }
+
+    void BM_BlockReadRead(benchmark::State& state) {
+        block_read(state, false);
+    }
+    BENCHMARK(BM_BlockReadRead)->Arg(10000);
+
+    void BM_BlockReadReadReuse(benchmark::State& state) {
+        block_read(state, true);
+    }
+    BENCHMARK(BM_BlockReadReadReuse)->Arg(10000);
+
+    void BM_BlockReadGenericQR(benchmark::State& state) {
+        std::vector<GenericQueryResponse> qrs = generate_workload(state.range(0));
+        BlockParameters bp;
+        bp.storage_parameters.max_block_items = qrs.size();
+        CdnsBlockRead block;
+        block.set_block_parameters(bp, 0);
+        fill_block(block, qrs);
+
+        for (auto _ : state) {
+            state.PauseTiming();
+            CdnsBlockRead copy(block);
+            state.ResumeTiming();
+
+            bool end = false;
+            while (true) {
+                GenericQueryResponse gqr = copy.read_generic_qr(end);
+                if (end)
+                    break;
+                benchmark::DoNotOptimize(gqr);
+            }
+        }
+
+        state.SetItemsProcessed(state.iterations() * qrs.size());
+    }
+    BENCHMARK(BM_BlockReadGenericQR)->Arg(10000);
+}
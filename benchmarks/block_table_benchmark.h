@@ -0,0 +1,247 @@
+/**
+ * Copyright © 2026 CZ.NIC, z. s. p. o.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, you can obtain one at https://mozilla.org/MPL/2.0/.
+ */
+
+#pragma once
+
+#include <vector>
+#include <string>
+#include <benchmark/benchmark.h>
+
+#include "../src/cdns.h"
+#include "common.h"
+
+namespace CDNS {
+    /**
+     * @brief Get QNAMEs of the synthetic workload as Block table items
+     * @param count Number of items
+     * @return QNAMEs with Zipfian distribution (many duplicates)
+     */
+    std::vector<StringItem> workload_names(std::size_t count) {
+        std::vector<StringItem> ret;
+        ret.reserve(count);
+        for (auto& qr : generate_workload(count)) {
+            StringItem si;
+            si.data = *qr.query_name;
+            ret.push_back(si);
+        }
+        return ret;
+    }
+
+    void BM_BlockTableAddUnique(benchmark::State& state) {
+        std::vector<StringItem> items(state.range(0));
+        for (std::size_t i = 0; i < items.size(); i++)
+            items[i].data = "\x07" "example" + std::to_string(i) + "\x03" "com";
+        BlockTable<StringItem> bt;
+
+        for (auto _ : state) {
+            for (auto& item : items)
+                benchmark::DoNotOptimize(bt.add(item));
+            bt.clear();
+        }
+
+        state.SetItemsProcessed(state.iterations() * items.size());
+    }
+    BENCHMARK(BM_BlockTableAddUnique)->Arg(1000)->Arg(10000);
+
+    void BM_BlockTableAddDuplicate(benchmark::State& state) {
+        std::vector<StringItem> items(state.range(0));
+        for (std::size_t i = 0; i < items.size(); i++)
+            items[i].data = "\x07" "example" + std::to_string(i) + "\x03" "com";
+        BlockTable<StringItem> bt;
+        for (auto& item : items)
+            bt.add(item);
+
+        for (auto _ : state) {
+            for (auto& item : items)
+                benchmark::DoNotOptimize(bt.add(item));
+        }
+
+        state.SetItemsProcessed(state.iterations() * items.size());
+    }
+    BENCHMARK(BM_BlockTableAddDuplicate)->Arg(1000)->Arg(10000);
+
+    void BM_BlockTableAddWorkload(benchmark::State& state) {
+        std::vector<StringItem> items = workload_names(state.range(0));
+        BlockTable<StringItem> bt;
+
+        for (auto _ : state) {
+            for (auto& item : items)
+                benchmark::DoNotOptimize(bt.add(item));
+            bt.clear();
+        }
+
+        state.SetItemsProcessed(state.iterations() * items.size());
+    }
+    BENCHMARK(BM_BlockTableAddWorkload)->Arg(10000);
+
+    // Hashes of the QNAMEs are calculated once outside of the measured loop, like when a capture
+    // tool already has them from its flow tracking
+    void BM_BlockTableAddWorkloadPrehashed(benchmark::State& state) {
+        std::vector<StringItem> items = workload_names(state.range(0));
+        std::vector<std::size_t> hashes;
+        for (auto& item : items)
+            hashes.push_back(CdnsBlock::string_hash(item.data));
+        BlockTable<StringItem> bt;
+
+        for (auto _ : state) {
+            for (std::size_t i = 0; i < items.size(); i++)
+                benchmark::DoNotOptimize(bt.add(items[i], hashes[i]));
+            bt.clear();
+        }
+
+        state.SetItemsProcessed(state.iterations() * items.size());
+    }
+    BENCHMARK(BM_BlockTableAddWorkloadPrehashed)->Arg(10000);
+
+    void BM_BlockTableAddClassType(benchmark::State& state) {
+        std::vector<ClassType> items(64);
+        for (std::size_t i = 0; i < items.size(); i++) {
+            items[i].type = i % 32;
+            items[i].class_ = 1 + i / 32;
+        }
+        BlockTable<ClassType> bt;
+
+        for (auto _ : state) {
+            for (auto& item : items)
+                benchmark::DoNotOptimize(bt.add(item));
+            bt.clear();
+        }
+
+        state.SetItemsProcessed(state.iterations() * items.size());
+    }
+    BENCHMARK(BM_BlockTableAddClassType);
+
+    /**
+     * @brief Switch to hash backend given by benchmark argument
+     * @return `false` if the backend isn't supported (the benchmark is skipped)
+     */
+    bool use_hash_backend(benchmark::State& state, int64_t arg) {
+        HashBackend backend = static_cast<HashBackend>(arg);
+        if (!hash_backend_supported(backend)) {
+            state.SkipWithError(("Hash backend " + hash_backend_name(backend) + " not supported").c_str());
+            return false;
+        }
+
+        set_hash_backend(backend);
+        state.SetLabel(hash_backend_name(backend));
+        return true;
+    }
+
+    // Arguments: hash backend, size of hashed data in bytes
+    void BM_HashBackend(benchmark::State& state) {
+        HashBackend original = get_hash_backend();
+        if (!use_hash_backend(state, state.range(0)))
+            return;
+
+        std::string data(state.range(1), 'x');
+        for (auto _ : state)
+            benchmark::DoNotOptimize(hash_value(data.data(), data.size()));
+
+        state.SetBytesProcessed(state.iterations() * data.size());
+        set_hash_backend(original);
+    }
+    BENCHMARK(BM_HashBackend)->ArgsProduct({{0, 1, 2}, {2, 4, 16, 32, 256}});
+
+    // Arguments: hash backend
+    void BM_BlockTableAddWorkloadBackend(benchmark::State& state) {
+        HashBackend original = get_hash_backend();
+        if (!use_hash_backend(state, state.range(0)))
+            return;
+
+        std::vector<StringItem> items = workload_names(10000);
+        BlockTable<StringItem> bt;
+
+        for (auto _ : state) {
+            for (auto& item : items)
+                benchmark::DoNotOptimize(bt.add(item));
+            bt.clear();
+        }
+
+        state.SetItemsProcessed(state.iterations() * items.size());
+        set_hash_backend(original);
+    }
+    BENCHMARK(BM_BlockTableAddWorkloadBackend)->DenseRange(0, 2);
+
+    // Arguments: hash backend
+    void BM_BlockTableFindBackend(benchmark::State& state) {
+        HashBackend original = get_hash_backend();
+        if (!use_hash_backend(state, state.range(0)))
+            return;
+
+        std::vector<StringItem> items = workload_names(10000);
+        BlockTable<StringItem> bt;
+        for (auto& item : items)
+            bt.add(item);
+
+        for (auto _ : state) {
+            for (auto& item : items) {
+                index_t index;
+                benchmark::DoNotOptimize(bt.find(item.key(), index));
+            }
+        }
+
+        state.SetItemsProcessed(state.iterations() * items.size());
+        set_hash_backend(original);
+    }
+    BENCHMARK(BM_BlockTableFindBackend)->DenseRange(0, 2);
+
+    /**
+     * @brief Get distinct Query/Response signatures and RRs of the synthetic workload
+     * @param count Number of records of the workload
+     * @param sigs Set by this function to the Query/Response signatures
+     * @param rrs Set by this function to the RRs
+     */
+    void workload_signatures(std::size_t count, std::vector<QueryResponseSignature>& sigs, std::vector<RR>& rrs) {
+        BlockParameters bp;
+        bp.storage_parameters.max_block_items = count;
+        CdnsBlock block(bp, 0);
+        for (auto& qr : generate_workload(count))
+            block.add_question_response_record(qr);
+
+        BlockTablesStats stats = block.get_tables_stats();
+        for (index_t i = 0; i < stats.qr_sig.items; i++)
+            sigs.push_back(block.get_qr_signature(i));
+        for (index_t i = 0; i < stats.rr.items; i++)
+            rrs.push_back(block.get_rr(i));
+    }
+
+    template<typename T>
+    void block_table_add_all(benchmark::State& state, const std::vector<T>& items, bool unique) {
+        BlockTable<T> bt;
+        for (auto& item : items)
+            bt.add(item);
+
+        for (auto _ : state) {
+            if (unique)
+                bt.clear();
+            for (auto& item : items)
+                benchmark::DoNotOptimize(bt.add(item));
+        }
+
+        state.SetItemsProcessed(state.iterations() * items.size());
+    }
+
+    // Arguments: 1 to add to empty table, 0 to add already present items
+    void BM_BlockTableAddQRSignature(benchmark::State& state) {
+        std::vector<QueryResponseSignature> sigs;
+        std::vector<RR> rrs;
+        workload_signatures(10000, sigs, rrs);
+        block_table_add_all(state, sigs, state.range(0));
+    }
+    BENCHMARK(BM_BlockTableAddQRSignature)->Arg(0)->Arg(1);
+
+    // Arguments: 1 to add to empty table, 0 to add already present items
+    void BM_BlockTableAddRR(benchmark::State& state) {
+        std::vector<QueryResponseSignature> sigs;
+        std::vector<RR> rrs;
+        workload_signatures(10000, sigs, rrs);
+        block_table_add_all(state, rrs, state.range(0));
+    }
+    BENCHMARK(BM_BlockTableAddRR)->Arg(0)->Arg(1);
+}
+
@@ -0,0 +1,122 @@
+/**
+ * Copyright © 2026 CZ.NIC, z. s. p. o.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, you can obtain one at https://mozilla.org/MPL/2.0/.
+ */
+
+#pragma once
+
+#include <sstream>
+#include <functional>
+#include <benchmark/benchmark.h>
+
+#include "../src/cdns.h"
+#include "common.h"
+
+namespace CDNS {
+    static constexpr std::size_t DECODER_BATCH = 10000;
+
+    /**
+     * @brief Encode the same item DECODER_BATCH times into memory
+     * @param write Function writing one item with given encoder
+     * @return Encoded items
+     */
+    std::string encode_batch(std::function<void(CdnsEncoder&)> write) {
+        MemoryOutput buffer;
+        {
+            CdnsEncoder enc(buffer, CborOutputCompression::NO_COMPRESSION);
+            for (std::size_t i = 0; i < DECODER_BATCH; i++)
+                write(enc);
+        }
+        return buffer.release();
+    }
+
+    /**
+     * @brief Decode batches of items encoded by encode_batch()
+     * @param state Benchmark state
+     * @param data Encoded items
+     * @param read Function reading one item with given decoder
+     */
+    void decode_batches(benchmark::State& state, const std::string& data,
+                        std::function<void(CdnsDecoder&)> read) {
+        for (auto _ : state) {
+            std::istringstream input(data);
+            CdnsDecoder dec(input);
+            for (std::size_t i = 0; i < DECODER_BATCH; i++)
+                read(dec);
+        }
+
+        state.SetItemsProcessed(state.iterations() * DECODER_BATCH);
+        state.SetBytesProcessed(state.iterations() * data.size());
+    }
+
+    void BM_DecoderReadUnsigned(benchmark::State& state) {
+        uint64_t value = static_cast<uint64_t>(state.range(0));
+        std::string data = encode_batch([value](CdnsEncoder& enc) { enc.write(value); });
+        decode_batches(state, data, [](CdnsDecoder& dec) { benchmark::DoNotOptimize(dec.read_unsigned()); });
+    }
+    BENCHMARK(BM_DecoderReadUnsigned)->Arg(10)->Arg(60000)->Arg(4000000000);
+
+    void BM_DecoderReadInteger(benchmark::State& state) {
+        int64_t value = -static_cast<int64_t>(state.range(0));
+        std::string data = encode_batch([value](CdnsEncoder& enc) { enc.write(value); });
+        decode_batches(state, data, [](CdnsDecoder& dec) { benchmark::DoNotOptimize(dec.read_integer()); });
+    }
+    BENCHMARK(BM_DecoderReadInteger)->Arg(10)->Arg(60000);
+
+    void BM_DecoderReadBytestring(benchmark::State& state) {
+        std::string value(state.range(0), 'x');
+        std::string data = encode_batch([&value](CdnsEncoder& enc) { enc.write_bytestring(value); });
+        decode_batches(state, data, [](CdnsDecoder& dec) { benchmark::DoNotOptimize(dec.read_bytestring()); });
+    }
+    BENCHMARK(BM_DecoderReadBytestring)->Arg(4)->Arg(16)->Arg(64)->Arg(1024);
+
+    void BM_DecoderReadBytestringInto(benchmark::State& state) {
+        std::string value(state.range(0), 'x');
+        std::string data = encode_batch([&value](CdnsEncoder& enc) { enc.write_bytestring(value); });
+        std::string str;
+        decode_batches(state, data, [&str](CdnsDecoder& dec) {
+            dec.read_bytestring(str);
+            benchmark::DoNotOptimize(str.data());
+        });
+    }
+    BENCHMARK(BM_DecoderReadBytestringInto)->Arg(4)->Arg(16)->Arg(64)->Arg(1024);
+
+    void BM_DecoderReadTextstring(benchmark::State& state) {
+        std::string value(16, 'x');
+        std::string data = encode_batch([&value](CdnsEncoder& enc) { enc.write_textstring(value); });
+        decode_batches(state, data, [](CdnsDecoder& dec) { benchmark::DoNotOptimize(dec.read_textstring()); });
+    }
+    BENCHMARK(BM_DecoderReadTextstring);
+
+    void BM_DecoderReadContainers(benchmark::State& state) {
+        std::string data = encode_batch([](CdnsEncoder& enc) {
+            enc.write_map_start(3);
+            enc.write_indef_array_start();
+            enc.write_break();
+        });
+        decode_batches(state, data, [](CdnsDecoder& dec) {
+            bool indef = false;
+            benchmark::DoNotOptimize(dec.read_map_start(indef));
+            benchmark::DoNotOptimize(dec.read_array_start(indef));
+            dec.read_break();
+        });
+    }
+    BENCHMARK(BM_DecoderReadContainers);
+
+    void BM_DecoderSkipItem(benchmark::State& state) {
+        std::string data = encode_batch([](CdnsEncoder& enc) {
+            enc.write_array_start(3);
+            enc.write(static_cast<uint64_t>(60000));
+            enc.write_bytestring(std::string(16, 'x'));
+            enc.write_indef_map_start();
+            enc.write(static_cast<uint8_t>(1));
+            enc.write(static_cast<int8_t>(-1));
+            enc.write_break();
+        });
+        decode_batches(state, data, [](CdnsDecoder& dec) { dec.skip_item(); });
+    }
+    BENCHMARK(BM_DecoderSkipItem);
+}
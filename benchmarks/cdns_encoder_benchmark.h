@@ -0,0 +1,84 @@
+/**
+ * Copyright © 2026 CZ.NIC, z. s. p. o.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, you can obtain one at https://mozilla.org/MPL/2.0/.
+ */
+
+#pragma once
+
+#include <benchmark/benchmark.h>
+
+#include "../src/cdns.h"
+#include "common.h"
+
+namespace CDNS {
+    void BM_EncoderWriteUnsigned(benchmark::State& state) {
+        CdnsEncoder enc(null_output(), CborOutputCompression::NO_COMPRESSION);
+        uint64_t value = static_cast<uint64_t>(state.range(0));
+        std::size_t written = 0;
+
+        for (auto _ : state)
+            written += enc.write(value);
+
+        state.SetItemsProcessed(state.iterations());
+        state.SetBytesProcessed(written);
+    }
+    BENCHMARK(BM_EncoderWriteUnsigned)->Arg(10)->Arg(200)->Arg(60000)->Arg(4000000000);
+
+    void BM_EncoderWriteNegative(benchmark::State& state) {
+        CdnsEncoder enc(null_output(), CborOutputCompression::NO_COMPRESSION);
+        int64_t value = -static_cast<int64_t>(state.range(0));
+        std::size_t written = 0;
+
+        for (auto _ : state)
+            written += enc.write(value);
+
+        state.SetItemsProcessed(state.iterations());
+        state.SetBytesProcessed(written);
+    }
+    BENCHMARK(BM_EncoderWriteNegative)->Arg(10)->Arg(60000);
+
+    void BM_EncoderWriteBytestring(benchmark::State& state) {
+        CdnsEncoder enc(null_output(), CborOutputCompression::NO_COMPRESSION);
+        std::string value(state.range(0), 'x');
+        std::size_t written = 0;
+
+        for (auto _ : state)
+            written += enc.write_bytestring(value);
+
+        state.SetItemsProcessed(state.iterations());
+        state.SetBytesProcessed(written);
+    }
+    BENCHMARK(BM_EncoderWriteBytestring)->Arg(4)->Arg(16)->Arg(64)->Arg(1024)->Arg(8192);
+
+    void BM_EncoderWriteTextstring(benchmark::State& state) {
+        CdnsEncoder enc(null_output(), CborOutputCompression::NO_COMPRESSION);
+        std::string value(state.range(0), 'x');
+        std::size_t written = 0;
+
+        for (auto _ : state)
+            written += enc.write_textstring(value);
+
+        state.SetItemsProcessed(state.iterations());
+        state.SetBytesProcessed(written);
+    }
+    BENCHMARK(BM_EncoderWriteTextstring)->Arg(16);
+
+    void BM_EncoderWriteContainers(benchmark::State& state) {
+        CdnsEncoder enc(null_output(), CborOutputCompression::NO_COMPRESSION);
+        std::size_t written = 0;
+
+        for (auto _ : state) {
+            written += enc.write_map_start(3);
+            written += enc.write_array_start(300);
+            written += enc.write_indef_array_start();
+            written += enc.write_break();
+        }
+
+        state.SetItemsProcessed(state.iterations() * 4);
+        state.SetBytesProcessed(written);
+    }
+    BENCHMARK(BM_EncoderWriteContainers);
+}
@@ -0,0 +1,66 @@
+/**
+ * Copyright © 2026 CZ.NIC, z. s. p. o.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, you can obtain one at https://mozilla.org/MPL/2.0/.
+ */
+
+#pragma once
+
+#include <vector>
+#include <benchmark/benchmark.h>
+
+#include "../src/cdns.h"
+#include "common.h"
+
+namespace CDNS {
+    /**
+     * @brief End-to-end export of the synthetic workload: buffering records, sealing Blocks,
+     * encoding and compressing them. Reports records/s and uncompressed bytes/s.
+     * @param state Benchmark state, state.range(0) is CborOutputCompression
+     */
+    void BM_ExporterWorkload(benchmark::State& state) {
+        std::vector<GenericQueryResponse> qrs = generate_workload(100000);
+        CborOutputCompression compression = static_cast<CborOutputCompression>(state.range(0));
+        uint64_t compressed = 0;
+        CallbackOutput output([&compressed](const char*, std::size_t size) { compressed += size; });
+        FilePreamble fp;
+        CdnsExporter exporter(fp, output, compression);
+        std::size_t written = 0;
+
+        for (auto _ : state) {
+            for (auto& qr : qrs)
+                written += exporter.buffer_qr(qr);
+            written += exporter.write_block();
+        }
+
+        state.SetItemsProcessed(state.iterations() * qrs.size());
+        state.SetBytesProcessed(written);
+        state.counters["ratio"] = compressed ? static_cast<double>(written) / compressed : 0;
+    }
+    BENCHMARK(BM_ExporterWorkload)
+        ->Arg(static_cast<int>(CborOutputCompression::NO_COMPRESSION))
+        ->Arg(static_cast<int>(CborOutputCompression::GZIP))
+        ->Arg(static_cast<int>(CborOutputCompression::XZ))
+        ->Unit(benchmark::kMillisecond);
+
+    // Argument: capacity of string interners (0 disables interning)
+    void BM_ExporterWorkloadInterning(benchmark::State& state) {
+        std::vector<GenericQueryResponse> qrs = generate_workload(100000);
+        FilePreamble fp;
+        CdnsExporter exporter(fp, null_output(), CborOutputCompression::NO_COMPRESSION);
+        exporter.set_string_interning(state.range(0));
+        std::size_t written = 0;
+
+        for (auto _ : state) {
+            for (auto& qr : qrs)
+                written += exporter.buffer_qr(qr);
+            written += exporter.write_block();
+        }
+
+        state.SetItemsProcessed(state.iterations() * qrs.size());
+        state.SetBytesProcessed(written);
+    }
+    BENCHMARK(BM_ExporterWorkloadInterning)->Arg(0)->Arg(4096)->Arg(65536)->Unit(benchmark::kMillisecond);
+}
@@ -0,0 +1,138 @@
+/**
+ * Copyright © 2026 CZ.NIC, z. s. p. o.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, you can obtain one at https://mozilla.org/MPL/2.0/.
+ */
+
+#pragma once
+
+#include <sstream>
+#include <benchmark/benchmark.h>
+
+#include "../src/cdns.h"
+#include "common.h"
+
+namespace CDNS {
+    /**
+     * @brief End-to-end read of the synthetic workload: decoding Blocks and converting all
+     * records to GenericQueryResponse. Reports records/s and uncompressed bytes/s.
+     * @param state Benchmark state
+     * @param reuse Read all Blocks into the same Block object
+     */
+    void reader_workload(benchmark::State& state, bool reuse) {
+        std::size_t count = 100000;
+        std::string data = encode_workload(generate_workload(count), 5000);
+
+        for (auto _ : state) {
+            std::istringstream input(data);
+            CdnsReader reader(input);
+            CdnsBlockRead block;
+            bool end = false;
+
+            while (true) {
+                if (reuse)
+                    reader.read_block_into(block, end);
+                else
+                    block = reader.read_block(end);
+
+                if (end)
+                    break;
+
+                while (true) {
+                    GenericQueryResponse gqr = block.read_generic_qr(end);
+                    if (end)
+                        break;
+                    benchmark::DoNotOptimize(gqr);
+                }
+            }
+        }
+
+        state.SetItemsProcessed(state.iterations() * count);
+        state.SetBytesProcessed(state.iterations() * data.size());
+    }
+
+    void BM_ReaderWorkload(benchmark::State& state) {
+        reader_workload(state, false);
+    }
+    BENCHMARK(BM_ReaderWorkload)->Unit(benchmark::kMillisecond);
+
+    void BM_ReaderWorkloadReuse(benchmark::State& state) {
+        reader_workload(state, true);
+    }
+    BENCHMARK(BM_ReaderWorkloadReuse)->Unit(benchmark::kMillisecond);
+
+    /**
+     * @brief Read all Blocks of the synthetic workload in memory for benchmarks of item access
+     */
+    std::vector<CdnsBlockRead> read_workload_blocks(std::size_t count) {
+        std::string data = encode_workload(generate_workload(count), 5000);
+        std::istringstream input(data);
+        CdnsReader reader(input);
+        std::vector<CdnsBlockRead> blocks;
+        bool end = false;
+
+        while (true) {
+            CdnsBlockRead block = reader.read_block(end);
+            if (end)
+                break;
+            blocks.push_back(std::move(block));
+        }
+
+        return blocks;
+    }
+
+    /**
+     * @brief Count queries per QNAME length and RCODE (two fields) with GenericQueryResponse
+     */
+    void BM_BlockTwoFieldsGeneric(benchmark::State& state) {
+        std::size_t count = 100000;
+        std::vector<CdnsBlockRead> blocks = read_workload_blocks(count);
+
+        for (auto _ : state) {
+            std::size_t sum = 0;
+            for (auto& block : blocks) {
+                CdnsBlockRead copy(block);
+                bool end = false;
+                while (true) {
+                    GenericQueryResponse gqr = copy.read_generic_qr(end);
+                    if (end)
+                        break;
+                    if (gqr.query_name && gqr.response_rcode)
+                        sum += gqr.query_name->size() + *gqr.response_rcode;
+                }
+            }
+            benchmark::DoNotOptimize(sum);
+        }
+
+        state.SetItemsProcessed(state.iterations() * count);
+    }
+    BENCHMARK(BM_BlockTwoFieldsGeneric)->Unit(benchmark::kMillisecond);
+
+    /**
+     * @brief Count queries per QNAME length and RCODE (two fields) with QueryResponseView visitor
+     */
+    void BM_BlockTwoFieldsVisitor(benchmark::State& state) {
+        std::size_t count = 100000;
+        std::vector<CdnsBlockRead> blocks = read_workload_blocks(count);
+
+        for (auto _ : state) {
+            std::size_t sum = 0;
+            for (auto& block : blocks) {
+                // Copy the Block as the generic benchmark does, so only the item access differs
+                CdnsBlockRead copy(block);
+                copy.for_each_qr([&sum](const QueryResponseView& qr) {
+                    auto name = qr.query_name();
+                    auto rcode = qr.response_rcode();
+                    if (name && rcode)
+                        sum += name->size() + *rcode;
+                });
+            }
+            benchmark::DoNotOptimize(sum);
+        }
+
+        state.SetItemsProcessed(state.iterations() * count);
+    }
+    BENCHMARK(BM_BlockTwoFieldsVisitor)->Unit(benchmark::kMillisecond);
+}
@@ -0,0 +1,59 @@
+/**
+ * Copyright © 2026 CZ.NIC, z. s. p. o.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, you can obtain one at https://mozilla.org/MPL/2.0/.
+ */
+
+#pragma once
+
+#include <string>
+#include <vector>
+#include <benchmark/benchmark.h>
+
+#include "../src/cdns.h"
+
+namespace CDNS {
+    static const std::string bench_file("benchmark.out");
+
+    /**
+     * @brief Create output that discards all written data, so only the cost of encoding is measured
+     * @return Callback output ignoring its input
+     */
+    CallbackOutput null_output() {
+        return CallbackOutput([](const char*, std::size_t) {});
+    }
+
+    /**
+     * @brief Generate deterministic stream of Query/Response records resembling resolver traffic
+     * @param count Number of records to generate
+     * @param seed Seed of the traffic generator
+     * @return Generated records
+     */
+    std::vector<GenericQueryResponse> generate_workload(std::size_t count, uint64_t seed = 42) {
+        GeneratorConfig config;
+        config.seed = seed;
+        TrafficGenerator generator(config);
+        return generator.generate_qrs(count);
+    }
+
+    /**
+     * @brief Encode C-DNS block(s) from the given records into uncompressed C-DNS file in memory
+     * @param qrs Records to store
+     * @param block_items Maximum number of items in one Block
+     * @return Uncompressed C-DNS file
+     */
+    std::string encode_workload(const std::vector<GenericQueryResponse>& qrs, uint64_t block_items = 10000) {
+        FilePreamble fp;
+        fp.m_block_parameters[0].storage_parameters.max_block_items = block_items;
+        MemoryOutput buffer;
+        {
+            CdnsExporter exporter(fp, buffer, CborOutputCompression::NO_COMPRESSION);
+            for (auto& qr : qrs)
+                exporter.buffer_qr(qr);
+            exporter.write_block();
+        }
+        return buffer.release();
+    }
+}
@@ -0,0 +1,117 @@
+/**
+ * Copyright © 2026 CZ.NIC, z. s. p. o.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, you can obtain one at https://mozilla.org/MPL/2.0/.
+ */
+
+#pragma once
+
+#include <cstdio>
+#include <fcntl.h>
+#include <memory>
+#include <functional>
+#include <benchmark/benchmark.h>
+
+#include "../src/cdns.h"
+#include "common.h"
+
+namespace CDNS {
+    /**
+     * @brief Get encoded synthetic workload used as realistic (compressible) writer input
+     * @return Uncompressed C-DNS data
+     */
+    const std::string& writer_input() {
+        static const std::string data = encode_workload(generate_workload(20000));
+        return data;
+    }
+
+    /**
+     * @brief Benchmark writing of the synthetic workload in chunks of state.range(0) bytes
+     * @param state Benchmark state
+     * @param create Function creating the measured writer
+     */
+    void writer_bench(benchmark::State& state, std::function<std::unique_ptr<BaseCborOutputWriter>()> create) {
+        const std::string& data = writer_input();
+        std::size_t chunk = state.range(0);
+        std::size_t pos = 0;
+
+        {
+            std::unique_ptr<BaseCborOutputWriter> writer = create();
+            for (auto _ : state) {
+                if (pos + chunk > data.size())
+                    pos = 0;
+                writer->write(data.data() + pos, chunk);
+                pos += chunk;
+            }
+        }
+
+        state.SetBytesProcessed(state.iterations() * chunk);
+    }
+
+    /**
+     * @brief Open /dev/null for writing
+     * @return File descriptor of /dev/null
+     */
+    int dev_null() {
+        return open("/dev/null", O_WRONLY);
+    }
+
+    void BM_WriterFile(benchmark::State& state) {
+        writer_bench(state, []() { return std::make_unique<Writer<std::string>>(bench_file); });
+        std::remove(bench_file.c_str());
+    }
+    BENCHMARK(BM_WriterFile)->Arg(CdnsEncoder::BUFFER_SIZE)->Arg(65536);
+
+    void BM_WriterFd(benchmark::State& state) {
+        writer_bench(state, []() { return std::make_unique<Writer<int>>(dev_null()); });
+    }
+    BENCHMARK(BM_WriterFd)->Arg(CdnsEncoder::BUFFER_SIZE)->Arg(65536);
+
+    void BM_WriterMemory(benchmark::State& state) {
+        MemoryOutput buffer;
+        const std::string& data = writer_input();
+        std::size_t chunk = state.range(0);
+        std::size_t pos = 0;
+        Writer<MemoryOutput> writer(buffer);
+
+        for (auto _ : state) {
+            if (pos + chunk > data.size()) {
+                pos = 0;
+                buffer.release();
+            }
+            writer.write(data.data() + pos, chunk);
+            pos += chunk;
+        }
+
+        state.SetBytesProcessed(state.iterations() * chunk);
+    }
+    BENCHMARK(BM_WriterMemory)->Arg(CdnsEncoder::BUFFER_SIZE)->Arg(65536);
+
+    void BM_WriterCallback(benchmark::State& state) {
+        writer_bench(state, []() { return std::make_unique<Writer<CallbackOutput>>(null_output()); });
+    }
+    BENCHMARK(BM_WriterCallback)->Arg(CdnsEncoder::BUFFER_SIZE)->Arg(65536);
+
+    void BM_WriterIoUring(benchmark::State& state) {
+        writer_bench(state, []() { return std::make_unique<Writer<IoUringOutput>>(IoUringOutput(bench_file)); });
+        std::remove(bench_file.c_str());
+    }
+    BENCHMARK(BM_WriterIoUring)->Arg(CdnsEncoder::BUFFER_SIZE)->Arg(65536);
+
+    void BM_CborOutputWriter(benchmark::State& state) {
+        writer_bench(state, []() { return std::make_unique<CborOutputWriter>(dev_null()); });
+    }
+    BENCHMARK(BM_CborOutputWriter)->Arg(CdnsEncoder::BUFFER_SIZE);
+
+    void BM_GzipCborOutputWriter(benchmark::State& state) {
+        writer_bench(state, []() { return std::make_unique<GzipCborOutputWriter>(dev_null()); });
+    }
+    BENCHMARK(BM_GzipCborOutputWriter)->Arg(CdnsEncoder::BUFFER_SIZE);
+
+    void BM_XzCborOutputWriter(benchmark::State& state) {
+        writer_bench(state, []() { return std::make_unique<XzCborOutputWriter>(dev_null()); });
+    }
+    BENCHMARK(BM_XzCborOutputWriter)->Arg(CdnsEncoder::BUFFER_SIZE);
+}
@@ -0,0 +1,67 @@
+/**
+ * Copyright © 2026 CZ.NIC, z. s. p. o.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, you can obtain one at https://mozilla.org/MPL/2.0/.
+ */
+
+#include <pybind11/pybind11.h>
+#include <pybind11/stl.h>
+#include "cdns.h"
+#include "sketch.h"
+#include "aggregate.h"
+#include "py_common.h"
+
+namespace py = pybind11;
+
+void init_aggregate(py::module& m)
+{
+    py::class_<CDNS::SpaceSaving> space_saving(m, "SpaceSaving");
+    space_saving.def(py::init<std::size_t>(), py::arg("capacity") = CDNS::SpaceSaving::DEFAULT_CAPACITY)
+        .def_readonly_static("DEFAULT_CAPACITY", &CDNS::SpaceSaving::DEFAULT_CAPACITY)
+        .def("add", &CDNS::SpaceSaving::add, py::arg("key"), py::arg("count") = 1)
+        .def("merge", &CDNS::SpaceSaving::merge)
+        .def("top", &CDNS::SpaceSaving::top)
+        .def("min_count", &CDNS::SpaceSaving::min_count)
+        .def("size", &CDNS::SpaceSaving::size)
+        .def("capacity", &CDNS::SpaceSaving::capacity)
+        .def("total", &CDNS::SpaceSaving::total);
+
+    py::class_<CDNS::SpaceSaving::Entry>(space_saving, "Entry")
+        .def_readwrite("key", &CDNS::SpaceSaving::Entry::key)
+        .def_readwrite("count", &CDNS::SpaceSaving::Entry::count)
+        .def_readwrite("error", &CDNS::SpaceSaving::Entry::error);
+
+    py::class_<CDNS::HyperLogLog>(m, "HyperLogLog")
+        .def(py::init<unsigned>(), py::arg("precision") = CDNS::HyperLogLog::DEFAULT_PRECISION)
+        .def_readonly_static("DEFAULT_PRECISION", &CDNS::HyperLogLog::DEFAULT_PRECISION)
+        .def_readonly_static("MIN_PRECISION", &CDNS::HyperLogLog::MIN_PRECISION)
+        .def_readonly_static("MAX_PRECISION", &CDNS::HyperLogLog::MAX_PRECISION)
+        .def("add", &CDNS::HyperLogLog::add)
+        .def("merge", &CDNS::HyperLogLog::merge)
+        .def("estimate", &CDNS::HyperLogLog::estimate)
+        .def("precision", &CDNS::HyperLogLog::precision);
+
+    py::class_<CDNS::TrafficAggregate>(m, "TrafficAggregate")
+        .def(py::init<uint64_t, std::size_t, unsigned>(),
+             py::arg("interval") = CDNS::TrafficAggregate::DEFAULT_INTERVAL,
+             py::arg("capacity") = CDNS::SpaceSaving::DEFAULT_CAPACITY,
+             py::arg("precision") = CDNS::HyperLogLog::DEFAULT_PRECISION)
+        .def_readonly_static("DEFAULT_INTERVAL", &CDNS::TrafficAggregate::DEFAULT_INTERVAL)
+        .def("add_block", &CDNS::TrafficAggregate::add_block, py::call_guard<py::gil_scoped_release>())
+        .def("add_blocks", &CDNS::TrafficAggregate::add_blocks, py::arg("reader"), py::arg("threads") = 0,
+             py::call_guard<py::gil_scoped_release>())
+        .def("merge", &CDNS::TrafficAggregate::merge)
+        .def("string", &CDNS::TrafficAggregate::string, py::arg("top") = 10)
+        .def("interval", &CDNS::TrafficAggregate::interval)
+        .def_readwrite("qr_count", &CDNS::TrafficAggregate::qr_count)
+        .def_readwrite("unanswered", &CDNS::TrafficAggregate::unanswered)
+        .def_readwrite("time_series", &CDNS::TrafficAggregate::time_series)
+        .def_readwrite("rcodes", &CDNS::TrafficAggregate::rcodes)
+        .def_readwrite("qtypes", &CDNS::TrafficAggregate::qtypes)
+        .def_readwrite("qnames", &CDNS::TrafficAggregate::qnames)
+        .def_readwrite("clients", &CDNS::TrafficAggregate::clients)
+        .def_readwrite("distinct_qnames", &CDNS::TrafficAggregate::distinct_qnames)
+        .def_readwrite("distinct_clients", &CDNS::TrafficAggregate::distinct_clients);
+}
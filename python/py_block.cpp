@@ -130,6 +130,47 @@ void init_block(py::module& m)
         .def_readwrite("discarded_opcode", &CDNS::BlockStatistics::discarded_opcode)
         .def_readwrite("malformed_items", &CDNS::BlockStatistics::malformed_items);
 
+    py::class_<CDNS::BloomFilter>(m, "BloomFilter")
+        .def(py::init())
+        .def(py::init<std::size_t, unsigned>(), py::arg("items"), py::arg("bits_per_item"))
+        .def_readonly_static("DEFAULT_BITS_PER_ITEM", &CDNS::BloomFilter::DEFAULT_BITS_PER_ITEM)
+        .def("add", &CDNS::BloomFilter::add)
+        .def("may_contain", &CDNS::BloomFilter::may_contain)
+        .def("hash_count", &CDNS::BloomFilter::hash_count)
+        .def("bit_count", &CDNS::BloomFilter::bit_count)
+        .def("bits_per_item", &CDNS::BloomFilter::bits_per_item, py::arg("items"))
+        .def("bits", [](const CDNS::BloomFilter& self) { return py::bytes(self.bits()); })
+        .def("write", &CDNS::BloomFilter::write)
+        .def("read", &CDNS::BloomFilter::read)
+        .def("reset", &CDNS::BloomFilter::reset);
+
+    py::class_<CDNS::BlockSummary>(m, "BlockSummary")
+        .def(py::init())
+        .def("write", &CDNS::BlockSummary::write)
+        .def("read", &CDNS::BlockSummary::read)
+        .def("reset", &CDNS::BlockSummary::reset)
+        .def("overlaps", &CDNS::BlockSummary::overlaps, py::arg("earliest"), py::arg("start"), py::arg("end"))
+        .def("has_rcode", &CDNS::BlockSummary::has_rcode)
+        .def_readwrite("latest_time", &CDNS::BlockSummary::latest_time)
+        .def_readwrite("qr_count", &CDNS::BlockSummary::qr_count)
+        .def_readwrite("aec_count", &CDNS::BlockSummary::aec_count)
+        .def_readwrite("mm_count", &CDNS::BlockSummary::mm_count)
+        .def_readwrite("min_client_address", &CDNS::BlockSummary::min_client_address)
+        .def_readwrite("max_client_address", &CDNS::BlockSummary::max_client_address)
+        .def_readwrite("rcode_counts", &CDNS::BlockSummary::rcode_counts)
+        .def_readwrite("body_size", &CDNS::BlockSummary::body_size)
+        .def_readwrite("filter", &CDNS::BlockSummary::filter)
+        .def("may_contain", &CDNS::BlockSummary::may_contain)
+        .def_static("name_hash", &CDNS::BlockSummary::name_hash)
+        .def_static("address_hash", &CDNS::BlockSummary::address_hash);
+
+    py::class_<CDNS::BlockLookup>(m, "BlockLookup")
+        .def(py::init())
+        .def("add_name", &CDNS::BlockLookup::add_name)
+        .def("add_address", &CDNS::BlockLookup::add_address)
+        .def("empty", &CDNS::BlockLookup::empty)
+        .def("matches", &CDNS::BlockLookup::matches);
+
     py::class_<CDNS::QueryResponse>(m, "QueryResponse")
         .def(py::init())
         .def("write", &CDNS::QueryResponse::write)
@@ -245,10 +286,23 @@ void init_block(py::module& m)
         .def("get_aec_count", &CDNS::CdnsBlock::get_aec_count)
         .def("get_mm_count", &CDNS::CdnsBlock::get_mm_count)
         .def("full", &CDNS::CdnsBlock::full)
+        .def("expired", &CDNS::CdnsBlock::expired)
+        .def("get_estimated_size", &CDNS::CdnsBlock::get_estimated_size)
+        .def("get_tables_stats", &CDNS::CdnsBlock::get_tables_stats)
+        .def("set_max_block_size", &CDNS::CdnsBlock::set_max_block_size)
+        .def("get_max_block_size", &CDNS::CdnsBlock::get_max_block_size)
+        .def("set_max_block_age", &CDNS::CdnsBlock::set_max_block_age)
+        .def("get_max_block_age", &CDNS::CdnsBlock::get_max_block_age)
+        .def("set_write_summary", &CDNS::CdnsBlock::set_write_summary)
+        .def("get_write_summary", &CDNS::CdnsBlock::get_write_summary)
+        .def("set_summary_filter", &CDNS::CdnsBlock::set_summary_filter)
+        .def("get_summary_filter", &CDNS::CdnsBlock::get_summary_filter)
+        .def("get_summary", &CDNS::CdnsBlock::get_summary)
         .def("set_block_parameters", &CDNS::CdnsBlock::set_block_parameters)
         .def("clear", &CDNS::CdnsBlock::clear)
         .def_readwrite("m_block_preamble", &CDNS::CdnsBlock::m_block_preamble)
         .def_readwrite("m_block_statistics", &CDNS::CdnsBlock::m_block_statistics)
+        .def_readwrite("m_block_summary", &CDNS::CdnsBlock::m_block_summary)
         .def_readwrite("m_ip_address", &CDNS::CdnsBlock::m_ip_address)
         .def_readwrite("m_classtype", &CDNS::CdnsBlock::m_classtype)
         .def_readwrite("m_name_rdata", &CDNS::CdnsBlock::m_name_rdata)
@@ -262,6 +316,86 @@ void init_block(py::module& m)
         .def_readwrite("m_address_event_counts", &CDNS::CdnsBlock::m_address_event_counts)
         .def_readwrite("m_malformed_messages", &CDNS::CdnsBlock::m_malformed_messages);
 
+    // View is valid only during the visitor call or while the Block isn't modified
+    py::class_<CDNS::QueryResponseView>(m, "QueryResponseView")
+        .def("item", &CDNS::QueryResponseView::item, py::return_value_policy::reference_internal)
+        .def("signature", [](const CDNS::QueryResponseView& self) -> boost::optional<CDNS::QueryResponseSignature> {
+            auto ret = self.signature();
+            if (!ret)
+                return boost::none;
+            return *ret;
+        })
+        .def("ts", &CDNS::QueryResponseView::ts)
+        .def("client_port", &CDNS::QueryResponseView::client_port)
+        .def("transaction_id", &CDNS::QueryResponseView::transaction_id)
+        .def("client_hoplimit", &CDNS::QueryResponseView::client_hoplimit)
+        .def("response_delay", &CDNS::QueryResponseView::response_delay)
+        .def("query_size", &CDNS::QueryResponseView::query_size)
+        .def("response_size", &CDNS::QueryResponseView::response_size)
+        .def("asn", &CDNS::QueryResponseView::asn)
+        .def("country_code", &CDNS::QueryResponseView::country_code)
+        .def("round_trip_time", &CDNS::QueryResponseView::round_trip_time)
+        .def("client_ip", [](const CDNS::QueryResponseView& self) -> boost::optional<std::string> {
+            auto ret = self.client_ip();
+            if (!ret)
+                return boost::none;
+            return std::string(*ret);
+        })
+        .def("query_name", [](const CDNS::QueryResponseView& self) -> boost::optional<std::string> {
+            auto ret = self.query_name();
+            if (!ret)
+                return boost::none;
+            return std::string(*ret);
+        })
+        .def("bailiwick", [](const CDNS::QueryResponseView& self) -> boost::optional<std::string> {
+            auto ret = self.bailiwick();
+            if (!ret)
+                return boost::none;
+            return std::string(*ret);
+        })
+        .def("server_ip", [](const CDNS::QueryResponseView& self) -> boost::optional<std::string> {
+            auto ret = self.server_ip();
+            if (!ret)
+                return boost::none;
+            return std::string(*ret);
+        })
+        .def("query_opt_rdata", [](const CDNS::QueryResponseView& self) -> boost::optional<std::string> {
+            auto ret = self.query_opt_rdata();
+            if (!ret)
+                return boost::none;
+            return std::string(*ret);
+        })
+        .def("query_classtype", [](const CDNS::QueryResponseView& self) -> boost::optional<CDNS::ClassType> {
+            auto ret = self.query_classtype();
+            if (!ret)
+                return boost::none;
+            return *ret;
+        })
+        .def("processing_flags", &CDNS::QueryResponseView::processing_flags)
+        .def("server_port", &CDNS::QueryResponseView::server_port)
+        .def("qr_transport_flags", &CDNS::QueryResponseView::qr_transport_flags)
+        .def("qr_type", &CDNS::QueryResponseView::qr_type)
+        .def("qr_sig_flags", &CDNS::QueryResponseView::qr_sig_flags)
+        .def("query_opcode", &CDNS::QueryResponseView::query_opcode)
+        .def("qr_dns_flags", &CDNS::QueryResponseView::qr_dns_flags)
+        .def("query_rcode", &CDNS::QueryResponseView::query_rcode)
+        .def("query_qdcount", &CDNS::QueryResponseView::query_qdcount)
+        .def("query_ancount", &CDNS::QueryResponseView::query_ancount)
+        .def("query_nscount", &CDNS::QueryResponseView::query_nscount)
+        .def("query_arcount", &CDNS::QueryResponseView::query_arcount)
+        .def("query_edns_version", &CDNS::QueryResponseView::query_edns_version)
+        .def("query_udp_size", &CDNS::QueryResponseView::query_udp_size)
+        .def("response_rcode", &CDNS::QueryResponseView::response_rcode)
+        .def("query_questions", &CDNS::QueryResponseView::query_questions)
+        .def("query_answers", &CDNS::QueryResponseView::query_answers)
+        .def("query_authority", &CDNS::QueryResponseView::query_authority)
+        .def("query_additional", &CDNS::QueryResponseView::query_additional)
+        .def("response_questions", &CDNS::QueryResponseView::response_questions)
+        .def("response_answers", &CDNS::QueryResponseView::response_answers)
+        .def("response_authority", &CDNS::QueryResponseView::response_authority)
+        .def("response_additional", &CDNS::QueryResponseView::response_additional)
+        .def("to_generic", &CDNS::QueryResponseView::to_generic);
+
     py::class_<CDNS::CdnsBlockRead>(m, "CdnsBlockRead")
         .def(py::init())
         .def(py::init<CDNS::CdnsDecoder&, std::vector<CDNS::BlockParameters>&>())
@@ -282,6 +416,23 @@ void init_block(py::module& m)
             auto ret = self.read_generic_mm(end);
             return std::make_tuple(std::move(ret), end);
         })
+        .def("for_each_qr", [](const CDNS::CdnsBlockRead& self, py::function visitor) {
+            return self.for_each_qr([&visitor](const CDNS::QueryResponseView& qr) {
+                py::object ret = visitor(qr);
+                return ret.is_none() || ret.cast<bool>();
+            });
+        })
+        .def("qr_view", &CDNS::CdnsBlockRead::qr_view, py::keep_alive<0, 1>())
+        .def("read_qr_columns", &CDNS::CdnsBlockRead::read_qr_columns, py::arg("columns"),
+            py::arg("append") = false, py::call_guard<py::gil_scoped_release>())
+        .def("read_qr_columns", [](CDNS::CdnsBlockRead& self) {
+            CDNS::QueryResponseColumns columns;
+            {
+                py::gil_scoped_release release;
+                self.read_qr_columns(columns);
+            }
+            return columns;
+        })
         .def("write", &CDNS::CdnsBlockRead::write)
         .def("get_block_parameters_index", &CDNS::CdnsBlockRead::get_block_parameters_index)
         .def("add_ip_address", &CDNS::CdnsBlockRead::add_ip_address)
@@ -327,10 +478,26 @@ void init_block(py::module& m)
         .def("get_aec_count", &CDNS::CdnsBlockRead::get_aec_count)
         .def("get_mm_count", &CDNS::CdnsBlockRead::get_mm_count)
         .def("full", &CDNS::CdnsBlockRead::full)
+        .def("expired", &CDNS::CdnsBlockRead::expired)
+        .def("get_estimated_size", &CDNS::CdnsBlockRead::get_estimated_size)
+        .def("get_tables_stats", &CDNS::CdnsBlockRead::get_tables_stats)
+        .def("set_timing", &CDNS::CdnsBlockRead::set_timing)
+        .def("get_read_stats", &CDNS::CdnsBlockRead::get_read_stats)
+        .def("set_max_block_size", &CDNS::CdnsBlockRead::set_max_block_size)
+        .def("get_max_block_size", &CDNS::CdnsBlockRead::get_max_block_size)
+        .def("set_max_block_age", &CDNS::CdnsBlockRead::set_max_block_age)
+        .def("get_max_block_age", &CDNS::CdnsBlockRead::get_max_block_age)
+        .def("set_write_summary", &CDNS::CdnsBlockRead::set_write_summary)
+        .def("get_write_summary", &CDNS::CdnsBlockRead::get_write_summary)
+        .def("set_summary_filter", &CDNS::CdnsBlockRead::set_summary_filter)
+        .def("get_summary_filter", &CDNS::CdnsBlockRead::get_summary_filter)
+        .def("get_read_summary_filter", &CDNS::CdnsBlockRead::get_read_summary_filter)
+        .def("get_summary", &CDNS::CdnsBlockRead::get_summary)
         .def("set_block_parameters", &CDNS::CdnsBlockRead::set_block_parameters)
         .def("clear", &CDNS::CdnsBlockRead::clear)
         .def_readwrite("m_block_preamble", &CDNS::CdnsBlockRead::m_block_preamble)
         .def_readwrite("m_block_statistics", &CDNS::CdnsBlockRead::m_block_statistics)
+        .def_readwrite("m_block_summary", &CDNS::CdnsBlockRead::m_block_summary)
         .def_readwrite("m_ip_address", &CDNS::CdnsBlockRead::m_ip_address)
         .def_readwrite("m_classtype", &CDNS::CdnsBlockRead::m_classtype)
         .def_readwrite("m_name_rdata", &CDNS::CdnsBlockRead::m_name_rdata)
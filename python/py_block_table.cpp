@@ -32,6 +32,8 @@ void declare_block_table(py::module& m, std::string typestr) {
         .def("clear", &Class::clear)
         .def("__getitem__", &Class::operator[], py::return_value_policy::reference_internal)
         .def("size", &Class::size)
+        .def("lookups", &Class::lookups)
+        .def("hits", &Class::hits)
         .def("begin", &Class::begin)
         .def("end", &Class::end);
 }
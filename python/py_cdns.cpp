@@ -15,11 +15,29 @@
 #include <pybind11/operators.h>
 #include <pybind11/stl.h>
 #include <pybind11/iostream.h>
+#include <pybind11/functional.h>
 #include "cdns.h"
 #include "py_common.h"
 
 namespace py = pybind11;
 
+namespace {
+    /**
+     * @brief CdnsBlockPrefetcher iterated from Python
+     *
+     * With reuse the iterator refills the same CdnsBlockRead object with each Block, so the prefetcher
+     * recycles capacity of its buffers for the following Blocks. The Block is valid only until the next
+     * iteration then. Without reuse each iteration returns a new Block object.
+     */
+    struct PyBlockPrefetcher : public CDNS::CdnsBlockPrefetcher {
+        PyBlockPrefetcher(CDNS::CdnsReader& reader, std::size_t depth, bool reuse)
+            : CDNS::CdnsBlockPrefetcher(reader, depth), reuse(reuse), block() {}
+
+        bool reuse;
+        py::object block; //!< Block returned by the previous iteration (with reuse)
+    };
+}
+
 void init_cdns(py::module& m)
 {
     py::class_<std::ifstream>(m, "Ifstream")
@@ -28,17 +46,38 @@ void init_cdns(py::module& m)
     py::class_<CDNS::CdnsExporter>(m, "CdnsExporter")
         .def(py::init<CDNS::FilePreamble&, const std::string&, CDNS::CborOutputCompression>())
         .def(py::init<CDNS::FilePreamble&, const int&, CDNS::CborOutputCompression>())
-        .def("buffer_qr", &CDNS::CdnsExporter::buffer_qr, py::arg("qr"),
-            py::arg("stats") = py::none())
-        .def("buffer_aec", &CDNS::CdnsExporter::buffer_aec, py::arg("aec"),
-            py::arg("stats") = py::none())
-        .def("buffer_mm", &CDNS::CdnsExporter::buffer_mm, py::arg("mm"),
-            py::arg("stats") = py::none())
-        .def("write_block", py::overload_cast<CDNS::CdnsBlock&>(&CDNS::CdnsExporter::write_block))
-        .def("write_block", py::overload_cast<>(&CDNS::CdnsExporter::write_block))
-        .def("rotate_output", &CDNS::CdnsExporter::rotate_output<std::string>)
-        .def("rotate_output", &CDNS::CdnsExporter::rotate_output<int>)
+        .def(py::init<CDNS::FilePreamble&, const CDNS::MemoryOutput&, CDNS::CborOutputCompression>())
+        // Buffering methods keep the GIL: they are called for every item, so releasing it would cost
+        // more than it saves, and the GIL serializes Python threads sharing the exporter (which isn't
+        // thread-safe). A full Block is then sealed with the GIL held, once per Block.
+        .def("buffer_qr", &CDNS::CdnsExporter::buffer_qr, py::arg("qr"), py::arg("stats") = py::none())
+        .def("buffer_aec", &CDNS::CdnsExporter::buffer_aec, py::arg("aec"), py::arg("stats") = py::none())
+        .def("buffer_mm", &CDNS::CdnsExporter::buffer_mm, py::arg("mm"), py::arg("stats") = py::none())
+        // Methods writing a Block release the GIL, the exporter mustn't be used from other threads meanwhile
+        .def("write_block", py::overload_cast<CDNS::CdnsBlock&>(&CDNS::CdnsExporter::write_block),
+            py::call_guard<py::gil_scoped_release>())
+        .def("write_block", py::overload_cast<>(&CDNS::CdnsExporter::write_block),
+            py::call_guard<py::gil_scoped_release>())
+        .def("rotate_output", &CDNS::CdnsExporter::rotate_output<std::string>,
+            py::call_guard<py::gil_scoped_release>())
+        .def("rotate_output", &CDNS::CdnsExporter::rotate_output<int>,
+            py::call_guard<py::gil_scoped_release>())
+        .def("rotate_output", &CDNS::CdnsExporter::rotate_output<CDNS::MemoryOutput>,
+            py::call_guard<py::gil_scoped_release>())
+        .def("write_block_if_expired", &CDNS::CdnsExporter::write_block_if_expired,
+            py::call_guard<py::gil_scoped_release>())
+        .def("swap_block", &CDNS::CdnsExporter::swap_block)
+        .def("recycle_block", [](CDNS::CdnsExporter& self, CDNS::CdnsBlock& block) {
+            self.recycle_block(std::move(block));
+        })
+        .def("set_max_block_size", &CDNS::CdnsExporter::set_max_block_size)
+        .def("set_max_block_age", &CDNS::CdnsExporter::set_max_block_age)
+        .def("set_string_interning", &CDNS::CdnsExporter::set_string_interning, py::arg("capacity"))
+        .def("set_block_summary", &CDNS::CdnsExporter::set_block_summary)
+        .def("set_block_filter", &CDNS::CdnsExporter::set_block_filter, py::arg("bits_per_item"))
         .def("get_block_item_count", &CDNS::CdnsExporter::get_block_item_count)
+        .def("get_stats", &CDNS::CdnsExporter::get_stats)
+        .def("reset_stats", &CDNS::CdnsExporter::reset_stats)
         .def("get_block_qr_count", &CDNS::CdnsExporter::get_block_qr_count)
         .def("get_block_aec_count", &CDNS::CdnsExporter::get_block_aec_count)
         .def("get_block_mm_count", &CDNS::CdnsExporter::get_block_mm_count)
@@ -55,8 +94,83 @@ void init_cdns(py::module& m)
         .def(py::init<std::istringstream&>())
         .def("read_block", [](CDNS::CdnsReader& self) {
             bool end = false;
-            auto ret = self.read_block(end);
+            CDNS::CdnsBlockRead ret;
+            {
+                py::gil_scoped_release release;
+                self.read_block_into(ret, end);
+            }
             return std::make_tuple(std::move(ret), end);
         })
-        .def_readwrite("m_file_preamble", &CDNS::CdnsReader::m_file_preamble);
+        .def("read_block_into", [](CDNS::CdnsReader& self, CDNS::CdnsBlockRead& block) {
+            bool end = false;
+            {
+                py::gil_scoped_release release;
+                self.read_block_into(block, end);
+            }
+            return end;
+        })
+        // Filter is Python callable, so the GIL is kept while the Block is read
+        .def("read_block_into", [](CDNS::CdnsReader& self, CDNS::CdnsBlockRead& block,
+                                   const CDNS::BlockSummaryFilter& filter) {
+            bool end = false;
+            bool decoded = self.read_block_into(block, end, filter);
+            return std::make_tuple(decoded, end);
+        }, py::arg("block"), py::arg("filter"))
+        .def("read_block_matching", [](CDNS::CdnsReader& self, CDNS::CdnsBlockRead& block,
+                                       const CDNS::BlockLookup& lookup) {
+            bool end = false;
+            {
+                py::gil_scoped_release release;
+                self.read_block_matching(block, end, lookup);
+            }
+            return end;
+        }, py::arg("block"), py::arg("lookup"))
+        .def("read_qr_columns", [](CDNS::CdnsReader& self) {
+            CDNS::QueryResponseColumns columns;
+            {
+                py::gil_scoped_release release;
+                self.read_qr_columns(columns);
+            }
+            return columns;
+        })
+        .def("set_timing", &CDNS::CdnsReader::set_timing)
+        .def("get_stats", &CDNS::CdnsReader::get_stats)
+        .def_readwrite("m_file_preamble", &CDNS::CdnsReader::m_file_preamble)
+        // Iterator over Blocks read ahead on a background thread, the reader mustn't be used
+        // directly while the iterator exists
+        .def("blocks", [](CDNS::CdnsReader& self, std::size_t prefetch, bool reuse) {
+            return std::unique_ptr<PyBlockPrefetcher>(new PyBlockPrefetcher(self, prefetch, reuse));
+        }, py::arg("prefetch") = static_cast<std::size_t>(CDNS::CdnsBlockPrefetcher::DEFAULT_DEPTH),
+            py::arg("reuse") = true, py::keep_alive<0, 1>());
+
+    py::class_<PyBlockPrefetcher>(m, "CdnsBlockPrefetcher")
+        .def(py::init<CDNS::CdnsReader&, std::size_t, bool>(), py::arg("reader"),
+            py::arg("depth") = static_cast<std::size_t>(CDNS::CdnsBlockPrefetcher::DEFAULT_DEPTH),
+            py::arg("reuse") = true, py::keep_alive<1, 2>())
+        .def("next", [](PyBlockPrefetcher& self, CDNS::CdnsBlockRead& block) {
+            bool end = false;
+            {
+                py::gil_scoped_release release;
+                self.next(block, end);
+            }
+            return end;
+        })
+        .def("__iter__", [](py::object self) { return self; })
+        .def("__next__", [](PyBlockPrefetcher& self) {
+            // Previous Block is refilled, so its buffers go back to the prefetcher's pool
+            py::object block = self.reuse && self.block ? self.block : py::cast(CDNS::CdnsBlockRead());
+            CDNS::CdnsBlockRead& ref = block.cast<CDNS::CdnsBlockRead&>();
+            bool end = false;
+            {
+                py::gil_scoped_release release;
+                self.next(ref, end);
+            }
+            if (end) {
+                self.block = py::object();
+                throw py::stop_iteration();
+            }
+            if (self.reuse)
+                self.block = block;
+            return block;
+        });
 }
@@ -0,0 +1,254 @@
+/**
+ * Copyright © 2026 CZ.NIC, z. s. p. o.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, you can obtain one at https://mozilla.org/MPL/2.0/.
+ */
+
+#include <string>
+#include <pybind11/pybind11.h>
+#include <pybind11/numpy.h>
+#include <pybind11/stl.h>
+#include "columns.h"
+#include "py_common.h"
+
+namespace py = pybind11;
+
+namespace {
+    /**
+     * @brief Create NumPy array viewing the values of the column without copying them
+     * @param column Column to view
+     * @param base Python object owning the column, kept alive by the array
+     */
+    template<typename T>
+    py::array values_array(const CDNS::Column<T>& column, py::handle base)
+    {
+        return py::array_t<T>({static_cast<py::ssize_t>(column.size())}, {static_cast<py::ssize_t>(sizeof(T))},
+                              column.values().data(), base);
+    }
+
+    /**
+     * @brief Create NumPy array of booleans with validity of the column's values
+     * @param column Column to get the validity of
+     */
+    template<typename T>
+    py::array_t<bool> validity_array(const CDNS::Column<T>& column)
+    {
+        py::array_t<bool> ret(static_cast<py::ssize_t>(column.size()));
+        bool* out = ret.mutable_data();
+        {
+            py::gil_scoped_release release;
+            for (std::size_t i = 0; i < column.size(); i++)
+                out[i] = column.valid(i);
+        }
+        return ret;
+    }
+
+    /**
+     * @brief Create pyarrow Buffer viewing given memory without copying it
+     * @param pa pyarrow module
+     * @param data Start of the memory
+     * @param size Size of the memory in bytes
+     * @param base Python object owning the memory, kept alive by the buffer
+     */
+    py::object arrow_buffer(py::module& pa, const void* data, std::size_t size, py::handle base)
+    {
+        return pa.attr("foreign_buffer")(reinterpret_cast<uintptr_t>(data), size, base);
+    }
+
+    /**
+     * @brief Create pyarrow Array viewing the column's values and validity bitmap without copying them
+     * @param pa pyarrow module
+     * @param type pyarrow data type of the values
+     * @param column Column to view
+     * @param base Python object owning the column, kept alive by the array
+     */
+    template<typename T>
+    py::object arrow_array(py::module& pa, py::object type, const CDNS::Column<T>& column, py::handle base)
+    {
+        py::object validity = py::none();
+        if (column.null_count() > 0)
+            validity = arrow_buffer(pa, column.validity().data(), column.validity().size(), base);
+
+        py::list buffers;
+        buffers.append(validity);
+        buffers.append(arrow_buffer(pa, column.values().data(), column.size() * sizeof(T), base));
+        return pa.attr("Array").attr("from_buffers")(type, column.size(), buffers, column.null_count());
+    }
+
+    /**
+     * @brief Create pyarrow large binary Array (64-bit offsets) viewing the dictionary without copying it
+     * @param pa pyarrow module
+     * @param dict Dictionary to view
+     * @param base Python object owning the dictionary, kept alive by the array
+     */
+    py::object arrow_dictionary(py::module& pa, const CDNS::StringDictionary& dict, py::handle base)
+    {
+        py::list buffers;
+        buffers.append(py::none());
+        buffers.append(arrow_buffer(pa, dict.offsets().data(),
+                                    dict.offsets().size() * sizeof(CDNS::StringDictionary::offset_type), base));
+        buffers.append(arrow_buffer(pa, dict.data().data(), dict.data().size(), base));
+        return pa.attr("Array").attr("from_buffers")(pa.attr("large_binary")(), dict.size(), buffers);
+    }
+
+    /**
+     * @brief Get pyarrow time unit for given number of ticks per second
+     * @return Name of the unit or empty string if Arrow doesn't have a unit for this resolution
+     */
+    std::string arrow_time_unit(uint64_t ticks_per_second)
+    {
+        switch (ticks_per_second) {
+            case 1: return "s";
+            case 1000: return "ms";
+            case 1000000: return "us";
+            case 1000000000: return "ns";
+            default: return "";
+        }
+    }
+
+    template<typename T>
+    void bind_column(py::module& m, const char* name)
+    {
+        py::class_<CDNS::Column<T>>(m, name, py::buffer_protocol())
+            .def(py::init())
+            .def("__len__", &CDNS::Column<T>::size)
+            .def("__getitem__", [](const CDNS::Column<T>& self, std::size_t pos) -> boost::optional<T> {
+                if (pos >= self.size())
+                    throw py::index_error("Column index out of range");
+                if (!self.valid(pos))
+                    return boost::none;
+                return self[pos];
+            })
+            .def("size", &CDNS::Column<T>::size)
+            .def("null_count", &CDNS::Column<T>::null_count)
+            .def("valid", &CDNS::Column<T>::valid)
+            .def("values", [](py::object self) {
+                return values_array(self.cast<const CDNS::Column<T>&>(), self);
+            })
+            .def("validity", [](const CDNS::Column<T>& self) {
+                return validity_array(self);
+            })
+            .def_buffer([](CDNS::Column<T>& self) -> py::buffer_info {
+                return py::buffer_info(const_cast<T*>(self.values().data()), sizeof(T),
+                                       py::format_descriptor<T>::format(), 1,
+                                       {static_cast<py::ssize_t>(self.size())},
+                                       {static_cast<py::ssize_t>(sizeof(T))}, true);
+            });
+    }
+}
+
+void init_columns(py::module& m)
+{
+    bind_column<int64_t>(m, "ColumnInt64");
+    bind_column<uint32_t>(m, "ColumnUInt32");
+    bind_column<uint16_t>(m, "ColumnUInt16");
+    bind_column<uint8_t>(m, "ColumnUInt8");
+
+    py::class_<CDNS::StringDictionary>(m, "StringDictionary")
+        .def(py::init())
+        .def("__len__", &CDNS::StringDictionary::size)
+        .def("__getitem__", [](const CDNS::StringDictionary& self, CDNS::index_t index) {
+            if (index >= self.size())
+                throw py::index_error("Dictionary index out of range");
+            return py::bytes(self.get(index));
+        })
+        .def("size", &CDNS::StringDictionary::size)
+        .def("to_list", [](const CDNS::StringDictionary& self) {
+            py::list ret;
+            for (std::size_t i = 0; i < self.size(); i++)
+                ret.append(py::bytes(self.get(i)));
+            return ret;
+        });
+
+    py::class_<CDNS::QueryResponseColumns>(m, "QueryResponseColumns")
+        .def(py::init())
+        .def("__len__", &CDNS::QueryResponseColumns::size)
+        .def("size", &CDNS::QueryResponseColumns::size)
+        .def("clear", &CDNS::QueryResponseColumns::clear)
+        .def_readonly("ticks_per_second", &CDNS::QueryResponseColumns::ticks_per_second)
+        .def_readonly("timestamp", &CDNS::QueryResponseColumns::timestamp)
+        .def_readonly("client_address", &CDNS::QueryResponseColumns::client_address)
+        .def_readonly("client_port", &CDNS::QueryResponseColumns::client_port)
+        .def_readonly("server_address", &CDNS::QueryResponseColumns::server_address)
+        .def_readonly("server_port", &CDNS::QueryResponseColumns::server_port)
+        .def_readonly("transport_flags", &CDNS::QueryResponseColumns::transport_flags)
+        .def_readonly("transaction_id", &CDNS::QueryResponseColumns::transaction_id)
+        .def_readonly("qtype", &CDNS::QueryResponseColumns::qtype)
+        .def_readonly("qclass", &CDNS::QueryResponseColumns::qclass)
+        .def_readonly("qname", &CDNS::QueryResponseColumns::qname)
+        .def_readonly("rcode", &CDNS::QueryResponseColumns::rcode)
+        .def_readonly("response_delay", &CDNS::QueryResponseColumns::response_delay)
+        .def_readonly("query_size", &CDNS::QueryResponseColumns::query_size)
+        .def_readonly("response_size", &CDNS::QueryResponseColumns::response_size)
+        .def_readonly("ip_address", &CDNS::QueryResponseColumns::ip_address)
+        .def_readonly("name_rdata", &CDNS::QueryResponseColumns::name_rdata)
+        // Dictionary of NumPy arrays viewing the columns (values of missing items are 0) and boolean
+        // arrays "<column>_valid" for columns with missing items
+        .def("to_numpy", [](py::object self) {
+            auto& c = self.cast<const CDNS::QueryResponseColumns&>();
+            py::dict ret;
+
+            auto add = [&ret, &self](const char* name, const auto& column) {
+                ret[name] = values_array(column, self);
+                if (column.null_count() > 0)
+                    ret[(std::string(name) + "_valid").c_str()] = validity_array(column);
+            };
+
+            add("timestamp", c.timestamp);
+            add("client_address", c.client_address);
+            add("client_port", c.client_port);
+            add("server_address", c.server_address);
+            add("server_port", c.server_port);
+            add("transport_flags", c.transport_flags);
+            add("transaction_id", c.transaction_id);
+            add("qtype", c.qtype);
+            add("qclass", c.qclass);
+            add("qname", c.qname);
+            add("rcode", c.rcode);
+            add("response_delay", c.response_delay);
+            add("query_size", c.query_size);
+            add("response_size", c.response_size);
+            return ret;
+        })
+        // pyarrow RecordBatch viewing the columns, IP addresses and QNAMEs are dictionary arrays
+        .def("to_arrow", [](py::object self) {
+            auto& c = self.cast<const CDNS::QueryResponseColumns&>();
+            py::module pa = py::module::import("pyarrow");
+            py::list arrays;
+            py::list names;
+
+            auto add = [&arrays, &names](const char* name, py::object array) {
+                names.append(name);
+                arrays.append(array);
+            };
+
+            auto dict_array = [&pa, &self](const CDNS::Column<CDNS::index_t>& column, py::object dictionary) {
+                py::object indices = arrow_array(pa, pa.attr("uint32")(), column, self);
+                return pa.attr("DictionaryArray").attr("from_arrays")(indices, dictionary);
+            };
+
+            std::string unit = arrow_time_unit(c.ticks_per_second);
+            py::object ts_type = unit.empty() ? pa.attr("int64")() : pa.attr("timestamp")(unit, "UTC");
+            py::object delay_type = unit.empty() ? pa.attr("int64")() : pa.attr("duration")(unit);
+            py::object ip_address = arrow_dictionary(pa, c.ip_address, self);
+
+            add("timestamp", arrow_array(pa, ts_type, c.timestamp, self));
+            add("client_address", dict_array(c.client_address, ip_address));
+            add("client_port", arrow_array(pa, pa.attr("uint16")(), c.client_port, self));
+            add("server_address", dict_array(c.server_address, ip_address));
+            add("server_port", arrow_array(pa, pa.attr("uint16")(), c.server_port, self));
+            add("transport_flags", arrow_array(pa, pa.attr("uint8")(), c.transport_flags, self));
+            add("transaction_id", arrow_array(pa, pa.attr("uint16")(), c.transaction_id, self));
+            add("qtype", arrow_array(pa, pa.attr("uint16")(), c.qtype, self));
+            add("qclass", arrow_array(pa, pa.attr("uint16")(), c.qclass, self));
+            add("qname", dict_array(c.qname, arrow_dictionary(pa, c.name_rdata, self)));
+            add("rcode", arrow_array(pa, pa.attr("uint16")(), c.rcode, self));
+            add("response_delay", arrow_array(pa, delay_type, c.response_delay, self));
+            add("query_size", arrow_array(pa, pa.attr("uint32")(), c.query_size, self));
+            add("response_size", arrow_array(pa, pa.attr("uint32")(), c.response_size, self));
+
+            return pa.attr("RecordBatch").attr("from_arrays")(arrays, py::arg("names") = names);
+        });
+}
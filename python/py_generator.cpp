@@ -0,0 +1,56 @@
+/**
+ * Copyright © 2026 CZ.NIC, z. s. p. o.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, you can obtain one at https://mozilla.org/MPL/2.0/.
+ */
+
+#include <pybind11/pybind11.h>
+#include <pybind11/stl.h>
+#include "cdns.h"
+#include "generator.h"
+#include "py_common.h"
+
+namespace py = pybind11;
+
+void init_generator(py::module& m)
+{
+    py::class_<CDNS::GeneratorConfig>(m, "GeneratorConfig")
+        .def(py::init())
+        .def_readwrite("seed", &CDNS::GeneratorConfig::seed)
+        .def_readwrite("start", &CDNS::GeneratorConfig::start)
+        .def_readwrite("rate", &CDNS::GeneratorConfig::rate)
+        .def_readwrite("qnames", &CDNS::GeneratorConfig::qnames)
+        .def_readwrite("qname_skew", &CDNS::GeneratorConfig::qname_skew)
+        .def_readwrite("ipv4_clients", &CDNS::GeneratorConfig::ipv4_clients)
+        .def_readwrite("ipv6_clients", &CDNS::GeneratorConfig::ipv6_clients)
+        .def_readwrite("client_skew", &CDNS::GeneratorConfig::client_skew)
+        .def_readwrite("servers", &CDNS::GeneratorConfig::servers)
+        .def_readwrite("tcp_ratio", &CDNS::GeneratorConfig::tcp_ratio)
+        .def_readwrite("edns_ratio", &CDNS::GeneratorConfig::edns_ratio)
+        .def_readwrite("do_ratio", &CDNS::GeneratorConfig::do_ratio)
+        .def_readwrite("nxdomain_ratio", &CDNS::GeneratorConfig::nxdomain_ratio)
+        .def_readwrite("servfail_ratio", &CDNS::GeneratorConfig::servfail_ratio)
+        .def_readwrite("unanswered_ratio", &CDNS::GeneratorConfig::unanswered_ratio)
+        .def_readwrite("max_answers", &CDNS::GeneratorConfig::max_answers)
+        .def_readwrite("address_event_ratio", &CDNS::GeneratorConfig::address_event_ratio)
+        .def_readwrite("malformed_ratio", &CDNS::GeneratorConfig::malformed_ratio);
+
+    py::enum_<CDNS::GeneratedItemType>(m, "GeneratedItemType")
+        .value("QUERY_RESPONSE", CDNS::GeneratedItemType::QUERY_RESPONSE)
+        .value("ADDRESS_EVENT_COUNT", CDNS::GeneratedItemType::ADDRESS_EVENT_COUNT)
+        .value("MALFORMED_MESSAGE", CDNS::GeneratedItemType::MALFORMED_MESSAGE);
+
+    py::class_<CDNS::TrafficGenerator>(m, "TrafficGenerator")
+        .def(py::init())
+        .def(py::init<const CDNS::GeneratorConfig&>())
+        .def("next_type", &CDNS::TrafficGenerator::next_type)
+        .def("next_qr", &CDNS::TrafficGenerator::next_qr)
+        .def("next_aec", &CDNS::TrafficGenerator::next_aec)
+        .def("next_mm", &CDNS::TrafficGenerator::next_mm)
+        .def("generate_qrs", &CDNS::TrafficGenerator::generate_qrs)
+        .def("generate", &CDNS::TrafficGenerator::generate)
+        .def("now", &CDNS::TrafficGenerator::now)
+        .def("get_config", &CDNS::TrafficGenerator::get_config);
+}
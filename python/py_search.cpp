@@ -0,0 +1,52 @@
+/**
+ * Copyright © 2026 CZ.NIC, z. s. p. o.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, you can obtain one at https://mozilla.org/MPL/2.0/.
+ */
+
+#include <pybind11/pybind11.h>
+#include <pybind11/stl.h>
+#include "cdns.h"
+#include "search.h"
+#include "py_common.h"
+
+namespace py = pybind11;
+
+void init_search(py::module& m)
+{
+    m.def("name_to_wire", &CDNS::name_to_wire);
+    m.def("wire_to_name", &CDNS::wire_to_name);
+    m.def("address_to_string", &CDNS::address_to_string);
+
+    py::class_<CDNS::AddressPrefix>(m, "AddressPrefix")
+        .def(py::init())
+        .def_static("parse", &CDNS::AddressPrefix::parse)
+        .def("is_address", &CDNS::AddressPrefix::is_address)
+        .def("matches", &CDNS::AddressPrefix::matches)
+        .def_readwrite("address", &CDNS::AddressPrefix::address)
+        .def_readwrite("length", &CDNS::AddressPrefix::length);
+
+    py::class_<CDNS::QueryResponseSearch>(m, "QueryResponseSearch")
+        .def(py::init())
+        .def("add_qname", &CDNS::QueryResponseSearch::add_qname)
+        .def("add_qname_suffix", &CDNS::QueryResponseSearch::add_qname_suffix)
+        .def("set_qname_regex", &CDNS::QueryResponseSearch::set_qname_regex)
+        .def("add_client", &CDNS::QueryResponseSearch::add_client)
+        .def("add_server", &CDNS::QueryResponseSearch::add_server)
+        .def("add_qtype", &CDNS::QueryResponseSearch::add_qtype)
+        .def("add_rcode", &CDNS::QueryResponseSearch::add_rcode)
+        .def("set_time_range", &CDNS::QueryResponseSearch::set_time_range)
+        .def("empty", &CDNS::QueryResponseSearch::empty)
+        .def("may_match", &CDNS::QueryResponseSearch::may_match)
+        // Returns positions of the matching Query/Response items in the Block
+        .def("search", [](const CDNS::QueryResponseSearch& self, const CDNS::CdnsBlockRead& block) {
+            std::vector<std::size_t> positions;
+            {
+                py::gil_scoped_release release;
+                self.search(block, positions);
+            }
+            return positions;
+        });
+}
@@ -0,0 +1,104 @@
+/**
+ * Copyright © 2026 CZ.NIC, z. s. p. o.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, you can obtain one at https://mozilla.org/MPL/2.0/.
+ */
+
+#include <pybind11/pybind11.h>
+#include "stats.h"
+#include "py_common.h"
+
+namespace py = pybind11;
+
+void init_stats(py::module& m)
+{
+    py::class_<CDNS::TableStats>(m, "TableStats")
+        .def(py::init())
+        .def("hit_ratio", &CDNS::TableStats::hit_ratio)
+        .def_readwrite("items", &CDNS::TableStats::items)
+        .def_readwrite("lookups", &CDNS::TableStats::lookups)
+        .def_readwrite("hits", &CDNS::TableStats::hits);
+
+    py::class_<CDNS::BlockTablesStats>(m, "BlockTablesStats")
+        .def(py::init())
+        .def("string", &CDNS::BlockTablesStats::string)
+        .def_readwrite("ip_address", &CDNS::BlockTablesStats::ip_address)
+        .def_readwrite("classtype", &CDNS::BlockTablesStats::classtype)
+        .def_readwrite("name_rdata", &CDNS::BlockTablesStats::name_rdata)
+        .def_readwrite("qr_sig", &CDNS::BlockTablesStats::qr_sig)
+        .def_readwrite("qlist", &CDNS::BlockTablesStats::qlist)
+        .def_readwrite("qrr", &CDNS::BlockTablesStats::qrr)
+        .def_readwrite("rrlist", &CDNS::BlockTablesStats::rrlist)
+        .def_readwrite("rr", &CDNS::BlockTablesStats::rr)
+        .def_readwrite("malformed_message_data", &CDNS::BlockTablesStats::malformed_message_data);
+
+    py::class_<CDNS::BlockWriteStats>(m, "BlockWriteStats")
+        .def(py::init())
+        .def("encode_ns", &CDNS::BlockWriteStats::encode_ns)
+        .def_readwrite("qr_count", &CDNS::BlockWriteStats::qr_count)
+        .def_readwrite("aec_count", &CDNS::BlockWriteStats::aec_count)
+        .def_readwrite("mm_count", &CDNS::BlockWriteStats::mm_count)
+        .def_readwrite("uncompressed_bytes", &CDNS::BlockWriteStats::uncompressed_bytes)
+        .def_readwrite("compressed_bytes", &CDNS::BlockWriteStats::compressed_bytes)
+        .def_readwrite("write_ns", &CDNS::BlockWriteStats::write_ns)
+        .def_readwrite("output_ns", &CDNS::BlockWriteStats::output_ns)
+        .def_readwrite("tables", &CDNS::BlockWriteStats::tables);
+
+    py::class_<CDNS::ExporterStats>(m, "ExporterStats")
+        .def(py::init())
+        .def("compression_ratio", &CDNS::ExporterStats::compression_ratio)
+        .def("encode_ns", &CDNS::ExporterStats::encode_ns)
+        .def("string", &CDNS::ExporterStats::string)
+        .def_readwrite("blocks_written", &CDNS::ExporterStats::blocks_written)
+        .def_readwrite("qr_count", &CDNS::ExporterStats::qr_count)
+        .def_readwrite("aec_count", &CDNS::ExporterStats::aec_count)
+        .def_readwrite("mm_count", &CDNS::ExporterStats::mm_count)
+        .def_readwrite("dropped_qrs", &CDNS::ExporterStats::dropped_qrs)
+        .def_readwrite("dropped_aecs", &CDNS::ExporterStats::dropped_aecs)
+        .def_readwrite("dropped_mms", &CDNS::ExporterStats::dropped_mms)
+        .def_readwrite("uncompressed_bytes", &CDNS::ExporterStats::uncompressed_bytes)
+        .def_readwrite("compressed_bytes", &CDNS::ExporterStats::compressed_bytes)
+        .def_readwrite("write_ns", &CDNS::ExporterStats::write_ns)
+        .def_readwrite("output_ns", &CDNS::ExporterStats::output_ns)
+        .def_readwrite("rotations", &CDNS::ExporterStats::rotations)
+        .def_readwrite("rotation_ns", &CDNS::ExporterStats::rotation_ns)
+        .def_readwrite("max_rotation_ns", &CDNS::ExporterStats::max_rotation_ns)
+        .def_readwrite("tables", &CDNS::ExporterStats::tables)
+        .def_readwrite("last_block", &CDNS::ExporterStats::last_block);
+
+    py::class_<CDNS::DecoderStats>(m, "DecoderStats")
+        .def(py::init())
+        .def_readwrite("bytes_read", &CDNS::DecoderStats::bytes_read)
+        .def_readwrite("buffer_refills", &CDNS::DecoderStats::buffer_refills)
+        .def_readwrite("input_ns", &CDNS::DecoderStats::input_ns)
+        .def_readwrite("strings", &CDNS::DecoderStats::strings)
+        .def_readwrite("string_bytes", &CDNS::DecoderStats::string_bytes)
+        .def_readwrite("string_allocations", &CDNS::DecoderStats::string_allocations);
+
+    py::class_<CDNS::BlockReadStats>(m, "BlockReadStats")
+        .def(py::init())
+        .def_readwrite("tables_ns", &CDNS::BlockReadStats::tables_ns)
+        .def_readwrite("items_ns", &CDNS::BlockReadStats::items_ns)
+        .def_readwrite("fixup_ns", &CDNS::BlockReadStats::fixup_ns)
+        .def_readwrite("materialize_ns", &CDNS::BlockReadStats::materialize_ns);
+
+    py::class_<CDNS::ReaderStats>(m, "ReaderStats")
+        .def(py::init())
+        .def("bytes_per_block", &CDNS::ReaderStats::bytes_per_block)
+        .def("decode_ns", &CDNS::ReaderStats::decode_ns)
+        .def("string", &CDNS::ReaderStats::string)
+        .def_readwrite("blocks_read", &CDNS::ReaderStats::blocks_read)
+        .def_readwrite("blocks_skipped", &CDNS::ReaderStats::blocks_skipped)
+        .def_readwrite("qr_count", &CDNS::ReaderStats::qr_count)
+        .def_readwrite("aec_count", &CDNS::ReaderStats::aec_count)
+        .def_readwrite("mm_count", &CDNS::ReaderStats::mm_count)
+        .def_readwrite("bytes_consumed", &CDNS::ReaderStats::bytes_consumed)
+        .def_readwrite("block_bytes", &CDNS::ReaderStats::block_bytes)
+        .def_readwrite("last_block_bytes", &CDNS::ReaderStats::last_block_bytes)
+        .def_readwrite("max_block_bytes", &CDNS::ReaderStats::max_block_bytes)
+        .def_readwrite("read_ns", &CDNS::ReaderStats::read_ns)
+        .def_readwrite("phases_ns", &CDNS::ReaderStats::phases_ns)
+        .def_readwrite("decoder", &CDNS::ReaderStats::decoder);
+}
@@ -13,6 +13,16 @@
 
 namespace py = pybind11;
 
+namespace {
+    /**
+     * @brief Data released from MemoryOutput, exposed to Python through the buffer protocol
+     * so the data isn't copied to a new bytes object
+     */
+    struct ReleasedMemory {
+        std::string data;
+    };
+}
+
 void init_writer(py::module& m)
 {
     py::enum_<CDNS::CborOutputCompression>(m, "CborOutputCompression")
@@ -33,6 +43,23 @@ void init_writer(py::module& m)
         .def("write", &CDNS::Writer<int>::write)
         .def("rotate_output", &CDNS::Writer<int>::rotate_output);
 
+    py::class_<ReleasedMemory>(m, "ReleasedMemory", py::buffer_protocol())
+        .def_buffer([](ReleasedMemory& self) {
+            return py::buffer_info(&self.data[0], sizeof(char), py::format_descriptor<uint8_t>::format(),
+                                   1, {self.data.size()}, {sizeof(char)});
+        });
+
+    py::class_<CDNS::MemoryOutput>(m, "MemoryOutput")
+        .def(py::init<std::size_t>(), py::arg("reserve") = 0)
+        .def("data", [](const CDNS::MemoryOutput& self) {
+            return py::bytes(self.data());
+        })
+        .def("size", &CDNS::MemoryOutput::size)
+        // Memoryview keeps the released data alive, call bytes() on it if a copy is needed
+        .def("release", [](CDNS::MemoryOutput& self) {
+            return py::memoryview(py::cast(ReleasedMemory{self.release()}));
+        });
+
     py::class_<CDNS::CborOutputWriter>(m, "CborOutputWriter")
         .def(py::init<const std::string&>())
         .def(py::init<const int&>())
@@ -18,11 +18,16 @@ void init_writer(py::module&);
 void init_cdns_encoder(py::module&);
 void init_cdns_decoder(py::module&);
 void init_timestamp(py::module&);
+void init_stats(py::module&);
+void init_columns(py::module&);
 void init_file_preamble(py::module&);
 void init_block_table(py::module&);
 void init_block(py::module&);
 void init_interface(py::module&);
 void init_cdns(py::module&);
+void init_generator(py::module&);
+void init_search(py::module&);
+void init_aggregate(py::module&);
 
 PYBIND11_MODULE(pycdns, m)
 {
@@ -32,9 +37,14 @@ PYBIND11_MODULE(pycdns, m)
     init_cdns_encoder(m);
     init_cdns_decoder(m);
     init_timestamp(m);
+    init_stats(m);
+    init_columns(m);
     init_file_preamble(m);
     init_block_table(m);
     init_block(m);
     init_interface(m);
     init_cdns(m);
+    init_generator(m);
+    init_search(m);
+    init_aggregate(m);
 }
@@ -0,0 +1,230 @@
+/**
+ * Copyright © 2026 CZ.NIC, z. s. p. o.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, you can obtain one at https://mozilla.org/MPL/2.0/.
+ */
+
+#include <algorithm>
+#include <cmath>
+#include <iomanip>
+#include <map>
+#include <mutex>
+#include <thread>
+#include <sstream>
+#include <stdexcept>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+#include "aggregate.h"
+#include "cdns.h"
+#include "hash.h"
+#include "search.h"
+
+constexpr uint64_t CDNS::TrafficAggregate::DEFAULT_INTERVAL;
+
+namespace {
+    /**
+     * @brief Add counts of Block table entries to Space-Saving summary and HyperLogLog estimate
+     *
+     * If the summary is empty, only the entries with the highest counts that fit to it are added,
+     * so the counts in the summary are exact. The other entries occurred at most as many times as
+     * the lowest count in the summary, which is the bound used when the summary is merged. Entries
+     * added to a summary that already has counters all go through Space-Saving replacement.
+     */
+    void add_counts(const CDNS::BlockTable<CDNS::StringItem>& table, const std::vector<uint64_t>& counts,
+                    CDNS::SpaceSaving& summary, CDNS::HyperLogLog& distinct)
+    {
+        std::vector<std::pair<uint64_t, CDNS::index_t>> used;
+        for (CDNS::index_t i = 0; i < counts.size(); i++) {
+            if (counts[i] == 0)
+                continue;
+
+            used.emplace_back(counts[i], i);
+            auto& data = table[i].data;
+            distinct.add(CDNS::stable_hash(data.data(), data.size()));
+        }
+
+        auto higher = [](const std::pair<uint64_t, CDNS::index_t>& lhs, const std::pair<uint64_t, CDNS::index_t>& rhs) {
+            return lhs.first > rhs.first;
+        };
+        if (summary.size() == 0 && used.size() > summary.capacity()) {
+            std::nth_element(used.begin(), used.begin() + summary.capacity(), used.end(), higher);
+            used.resize(summary.capacity());
+        }
+
+        for (auto& entry : used)
+            summary.add(table[entry.second].data, entry.first);
+    }
+
+    /**
+     * @brief Print count with its share of the total
+     */
+    void print_share(std::ostream& out, uint64_t count, uint64_t total)
+    {
+        out << count;
+        if (total > 0)
+            out << " (" << std::fixed << std::setprecision(2) << 100.0 * count / total << " %)";
+        out << std::endl;
+    }
+}
+
+CDNS::TrafficAggregate::TrafficAggregate(uint64_t interval, std::size_t capacity, unsigned precision)
+    : qr_count(0), unanswered(0), time_series(), rcodes(), qtypes(), qnames(capacity), clients(capacity),
+      distinct_qnames(precision), distinct_clients(precision), m_interval(interval)
+{
+    if (interval == 0)
+        throw std::invalid_argument("Time interval of traffic aggregate can't be 0");
+}
+
+void CDNS::TrafficAggregate::add_block(const CdnsBlockRead& block)
+{
+    // Count items by Block table indexes first, each Block table entry is resolved only once
+    std::vector<uint64_t> names(block.m_name_rdata.size(), 0);
+    std::vector<uint64_t> addresses(block.m_ip_address.size(), 0);
+    std::vector<uint64_t> signatures(block.m_qr_sig.size(), 0);
+
+    // Items of a Block are mostly ordered by time, so consecutive items usually fall to the same interval
+    uint64_t bucket = 0;
+    uint64_t bucket_count = 0;
+
+    for (auto& qr : block.m_query_responses) {
+        if (qr.query_name_index && *qr.query_name_index < names.size())
+            names[*qr.query_name_index]++;
+        if (qr.client_address_index && *qr.client_address_index < addresses.size())
+            addresses[*qr.client_address_index]++;
+        if (qr.qr_signature_index && *qr.qr_signature_index < signatures.size())
+            signatures[*qr.qr_signature_index]++;
+        else
+            unanswered++;
+
+        if (qr.time_offset) {
+            uint64_t start = qr.time_offset->m_secs - qr.time_offset->m_secs % m_interval;
+            if (bucket_count > 0 && start != bucket) {
+                time_series[bucket] += bucket_count;
+                bucket_count = 0;
+            }
+            bucket = start;
+            bucket_count++;
+        }
+    }
+
+    if (bucket_count > 0)
+        time_series[bucket] += bucket_count;
+
+    qr_count += block.m_query_responses.size();
+
+    for (index_t i = 0; i < signatures.size(); i++) {
+        if (signatures[i] == 0)
+            continue;
+
+        auto& sig = block.m_qr_sig[i];
+        if (sig.response_rcode)
+            rcodes[*sig.response_rcode] += signatures[i];
+        else
+            unanswered += signatures[i];
+
+        if (sig.query_classtype_index && *sig.query_classtype_index < block.m_classtype.size())
+            qtypes[block.m_classtype[*sig.query_classtype_index].type] += signatures[i];
+    }
+
+    add_counts(block.m_name_rdata, names, qnames, distinct_qnames);
+    add_counts(block.m_ip_address, addresses, clients, distinct_clients);
+}
+
+uint64_t CDNS::TrafficAggregate::add_blocks(CdnsReader& reader, std::size_t threads)
+{
+    std::size_t capacity = qnames.capacity();
+    unsigned precision = distinct_qnames.precision();
+    std::map<std::thread::id, TrafficAggregate> partial;
+    std::mutex mutex;
+
+    ParallelBlockReader<bool> parallel(reader, threads);
+    uint64_t blocks = parallel.run([&](CdnsBlockRead& block) {
+        TrafficAggregate* aggregate;
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            auto it = partial.find(std::this_thread::get_id());
+            if (it == partial.end())
+                it = partial.emplace(std::piecewise_construct, std::forward_as_tuple(std::this_thread::get_id()),
+                                     std::forward_as_tuple(m_interval, capacity, precision)).first;
+            aggregate = &it->second;
+        }
+
+        aggregate->add_block(block);
+        return true;
+    }, [](bool&) {});
+
+    for (auto& aggregate : partial)
+        merge(aggregate.second);
+
+    return blocks;
+}
+
+void CDNS::TrafficAggregate::merge(const TrafficAggregate& other)
+{
+    if (other.m_interval != m_interval)
+        throw std::invalid_argument("Can't merge traffic aggregates with different time intervals");
+
+    distinct_qnames.merge(other.distinct_qnames);
+    distinct_clients.merge(other.distinct_clients);
+    qnames.merge(other.qnames);
+    clients.merge(other.clients);
+
+    qr_count += other.qr_count;
+    unanswered += other.unanswered;
+    for (auto& count : other.time_series)
+        time_series[count.first] += count.second;
+    for (auto& count : other.rcodes)
+        rcodes[count.first] += count.second;
+    for (auto& count : other.qtypes)
+        qtypes[count.first] += count.second;
+}
+
+std::string CDNS::TrafficAggregate::string(std::size_t top) const
+{
+    std::stringstream ss;
+
+    ss << "Query/Response items: " << qr_count << std::endl;
+    ss << "Without response: ";
+    print_share(ss, unanswered, qr_count);
+    ss << "Distinct QNAMEs (estimate): " << std::llround(distinct_qnames.estimate()) << std::endl;
+    ss << "Distinct clients (estimate): " << std::llround(distinct_clients.estimate()) << std::endl;
+
+    ss << std::endl << "Items per second in " << m_interval << " s intervals:" << std::endl;
+    for (auto& count : time_series)
+        ss << "\t" << count.first << ": " << std::fixed << std::setprecision(2)
+           << static_cast<double>(count.second) / m_interval << std::endl;
+
+    ss << std::endl << "Response RCODEs:" << std::endl;
+    for (auto& count : rcodes) {
+        ss << "\t" << count.first << ": ";
+        print_share(ss, count.second, qr_count);
+    }
+
+    ss << std::endl << "QTYPEs:" << std::endl;
+    for (auto& count : qtypes) {
+        ss << "\t" << count.first << ": ";
+        print_share(ss, count.second, qr_count);
+    }
+
+    ss << std::endl << "Top QNAMEs:" << std::endl;
+    for (auto& entry : qnames.top(top)) {
+        ss << "\t" << wire_to_name(entry.key) << ": " << entry.count;
+        if (entry.error > 0)
+            ss << " (error " << entry.error << ")";
+        ss << std::endl;
+    }
+
+    ss << std::endl << "Top clients:" << std::endl;
+    for (auto& entry : clients.top(top)) {
+        ss << "\t" << address_to_string(entry.key) << ": " << entry.count;
+        if (entry.error > 0)
+            ss << " (error " << entry.error << ")";
+        ss << std::endl;
+    }
+
+    return ss.str();
+}
@@ -0,0 +1,103 @@
+/**
+ * Copyright © 2026 CZ.NIC, z. s. p. o.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, you can obtain one at https://mozilla.org/MPL/2.0/.
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <cstddef>
+#include <string>
+#include <map>
+
+#include "block.h"
+#include "sketch.h"
+
+namespace CDNS {
+    class CdnsReader;
+
+    /**
+     * @brief Aggregated statistics of Query/Response items: number of items over time, RCODE
+     * and QTYPE distribution, the most frequent QNAMEs and clients and the number of distinct
+     * QNAMEs and clients
+     *
+     * Items of a Block are first counted by their Block table indexes (QNAME, client address and
+     * Query/Response signature), so each distinct QNAME, address and signature of the Block is resolved
+     * only once. Aggregates can be built in parallel and merged afterwards (see add_blocks()),
+     * the result doesn't depend on the order of merging except for the error bounds of the most
+     * frequent QNAMEs and clients.
+     */
+    class TrafficAggregate {
+        public:
+        static constexpr uint64_t DEFAULT_INTERVAL = 60;
+
+        /**
+         * @brief Construct empty aggregate
+         * @param interval Length of time intervals for counting items over time in seconds
+         * @param capacity Number of counters for the most frequent QNAMEs and clients
+         * @param precision Precision of the estimates of distinct QNAMEs and clients
+         * @throw std::invalid_argument if the interval is 0 or the capacity or precision are invalid
+         */
+        explicit TrafficAggregate(uint64_t interval = DEFAULT_INTERVAL,
+                                  std::size_t capacity = SpaceSaving::DEFAULT_CAPACITY,
+                                  unsigned precision = HyperLogLog::DEFAULT_PRECISION);
+
+        /**
+         * @brief Add Query/Response items of the Block to the aggregate
+         * @param block Block to aggregate
+         */
+        void add_block(const CdnsBlockRead& block);
+
+        /**
+         * @brief Add Query/Response items of all remaining Blocks of the input to the aggregate
+         *
+         * Blocks are decoded with ParallelBlockReader and each worker thread adds them to its own
+         * aggregate, which are merged into this one at the end. The cost of merging therefore doesn't
+         * grow with the number of Blocks. Which Blocks end up in which partial aggregate depends
+         * on scheduling, so the error bounds of the most frequent QNAMEs and clients may differ
+         * between runs (exact counts don't).
+         * @param reader Reader of the input, used exclusively until the method returns
+         * @param threads Number of worker threads (0 for the number of CPUs)
+         * @throw Rethrows exceptions thrown while reading or decoding the Blocks
+         * @return Number of aggregated Blocks
+         */
+        uint64_t add_blocks(CdnsReader& reader, std::size_t threads = 0);
+
+        /**
+         * @brief Merge other aggregate into this one
+         * @param other Aggregate with the same interval and precision
+         * @throw std::invalid_argument if the aggregates have different interval or precision
+         */
+        void merge(const TrafficAggregate& other);
+
+        /**
+         * @brief Creates string representation of the aggregate
+         * @param top Number of the most frequent QNAMEs and clients to print
+         * @return Human readable multi-line string representation
+         */
+        std::string string(std::size_t top) const;
+
+        /**
+         * @brief Get the length of time intervals in seconds
+         */
+        uint64_t interval() const {
+            return m_interval;
+        }
+
+        uint64_t qr_count; //!< Number of aggregated Query/Response items
+        uint64_t unanswered; //!< Number of Query/Response items without response RCODE
+        std::map<uint64_t, uint64_t> time_series; //!< Number of items by start of their time interval (in seconds)
+        std::map<uint16_t, uint64_t> rcodes; //!< Number of items by response RCODE
+        std::map<uint16_t, uint64_t> qtypes; //!< Number of items by QTYPE
+        SpaceSaving qnames; //!< The most frequent QNAMEs (in uncompressed wire format)
+        SpaceSaving clients; //!< The most frequent client addresses (as stored in Blocks)
+        HyperLogLog distinct_qnames; //!< Number of distinct QNAMEs
+        HyperLogLog distinct_clients; //!< Number of distinct client addresses
+
+        private:
+        uint64_t m_interval;
+    };
+}
@@ -19,9 +19,10 @@
  * @brief Implementation of cdns-blocks command line tool.
  *
  * cdns-blocks command line tool prints summary information about individual Blocks in C-DNS file. \n
- * Usage: cdns-blocks [-n <BLOCK_NUMBER>] [-h] <INPUT_FILE> \n
+ * Usage: cdns-blocks [-n <BLOCK_NUMBER>] [--stats] [-h] <INPUT_FILE> \n
  * Options: \n
  *      -n <BLOCK_NUMBER>   : Print information only for specific block (starts at 0) \n
+ *      --stats             : Print reader statistics to standard error \n
  *      -h                  : Print this help message and exit \n
  */
 
@@ -29,26 +30,36 @@ static void print_help()
 {
     std::cout << "cdns-blocks:" << std::endl;
     std::cout << "Prints summary information about individual Blocks in C-DNS file" << std::endl;
-    std::cout << "Usage: cdns-blocks [-n <BLOCK_NUMBER>] [-h] <INPUT_FILE>" << std::endl;
+    std::cout << "Usage: cdns-blocks [-n <BLOCK_NUMBER>] [--stats] [-h] <INPUT_FILE>" << std::endl;
     std::cout << "Options:" << std::endl;
     std::cout << "\t-n <BLOCK_NUMBER>   : Print information only for specific block (starts at 0)" << std::endl;
+    std::cout << "\t--stats             : Print reader statistics to standard error" << std::endl;
     std::cout << "\t-h                  : Print this help message and exit" << std::endl;
 }
 
+static const struct option long_options[] = {
+    {"stats", no_argument, nullptr, 'S'},
+    {nullptr, 0, nullptr, 0}
+};
+
 int main(int argc, char** argv)
 {
     std::string input_file;
     bool one_block = false;
     unsigned block_number = 0;
+    bool stats = false;
     int opt;
 
     // Parse command line arguments
-    while ((opt = getopt(argc, argv, "n:h")) != EOF) {
+    while ((opt = getopt_long(argc, argv, "n:h", long_options, nullptr)) != EOF) {
         switch (opt) {
             case 'n':
                 one_block = true;
                 block_number = std::stoul(optarg);
                 break;
+            case 'S':
+                stats = true;
+                break;
             case 'h':
                 print_help();
                 exit(EXIT_SUCCESS);
@@ -77,11 +88,14 @@ int main(int argc, char** argv)
     try {
         std::ifstream ifs(input_file, std::ifstream::binary);
         CDNS::CdnsReader reader(ifs);
+        reader.set_timing(stats);
         bool end = false;
         unsigned i = 0;
 
+        CDNS::CdnsBlockRead block;
+
         while (true) {
-            auto block = reader.read_block(end);
+            reader.read_block_into(block, end);
 
             if (end)
                 break;
@@ -96,6 +110,9 @@ int main(int argc, char** argv)
 
             i++;
         }
+
+        if (stats)
+            std::cerr << reader.get_stats().string();
     }
     catch (std::exception& e) {
         std::cerr << "Couldn't process input file " << input_file << "! Reason: " << e.what() << std::endl;
@@ -0,0 +1,201 @@
+/**
+ * Copyright © 2026 CZ.NIC, z. s. p. o.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, you can obtain one at https://mozilla.org/MPL/2.0/.
+ */
+
+#include <iostream>
+#include <string>
+#include <chrono>
+#include <thread>
+#include <getopt.h>
+#include <sys/stat.h>
+
+#include "../cdns.h"
+
+
+/**
+ * @file cdns_gen.cpp
+ * @brief Implementation of cdns-gen command line tool.
+ *
+ * cdns-gen command line tool writes synthetic DNS traffic (Query/Response records, Address events
+ * and Malformed messages) to a C-DNS file. Generated traffic depends only on the given options,
+ * so it can be used for reproducible measurements of throughput, compression ratio and Block table
+ * deduplication. \n
+ * Usage: cdns-gen [-n COUNT] [-s SEED] [-r RATE] [-q QNAMES] [-c CLIENTS] [-b ITEMS] [-S] [-F BITS] [-z|-x] [-h] <OUTPUT_FILE> \n
+ * Options: \n
+ *      -n COUNT            : Number of generated items (default 100000) \n
+ *      -s SEED             : Seed of the generator (default 1) \n
+ *      -r RATE             : Write items at given rate per second in real time (default 0 = as fast as possible) \n
+ *      -q QNAMES           : Number of distinct QNAMEs (default 10000) \n
+ *      -c CLIENTS          : Number of distinct clients (default 6000) \n
+ *      -b ITEMS            : Maximum number of items in C-DNS block (default 10000) \n
+ *      -S                  : Write implementation-private Block summaries (for skipping Blocks when reading) \n
+ *      -F BITS             : Include Bloom filter of NAMEs and addresses with given bits per item in Block summaries \n
+ *      -z                  : Compress the output with GZIP \n
+ *      -x                  : Compress the output with XZ \n
+ *      -h                  : Print this help message and exit \n
+ */
+
+static void print_help()
+{
+    std::cout << "cdns-gen:" << std::endl;
+    std::cout << "Writes synthetic DNS traffic to a C-DNS file" << std::endl;
+    std::cout << "Usage: cdns-gen [-n COUNT] [-s SEED] [-r RATE] [-q QNAMES] [-c CLIENTS] [-b ITEMS] [-S] [-F BITS] [-z|-x] [-h] <OUTPUT_FILE>" << std::endl;
+    std::cout << "Options:" << std::endl;
+    std::cout << "\t-n COUNT            : Number of generated items (default 100000)" << std::endl;
+    std::cout << "\t-s SEED             : Seed of the generator (default 1)" << std::endl;
+    std::cout << "\t-r RATE             : Write items at given rate per second in real time (default 0 = as fast as possible)" << std::endl;
+    std::cout << "\t-q QNAMES           : Number of distinct QNAMEs (default 10000)" << std::endl;
+    std::cout << "\t-c CLIENTS          : Number of distinct clients (default 6000)" << std::endl;
+    std::cout << "\t-b ITEMS            : Maximum number of items in C-DNS block (default 10000)" << std::endl;
+    std::cout << "\t-S                  : Write implementation-private Block summaries (for skipping Blocks when reading)" << std::endl;
+    std::cout << "\t-F BITS             : Include Bloom filter of NAMEs and addresses with given bits per item in Block summaries" << std::endl;
+    std::cout << "\t-z                  : Compress the output with GZIP" << std::endl;
+    std::cout << "\t-x                  : Compress the output with XZ" << std::endl;
+    std::cout << "\t-h                  : Print this help message and exit" << std::endl;
+}
+
+int main(int argc, char** argv)
+{
+    std::string output_file;
+    std::size_t count = 100000;
+    double rate = 0;
+    uint64_t block_items = 10000;
+    std::size_t clients = 6000;
+    bool summary = false;
+    unsigned filter_bits = 0;
+    CDNS::GeneratorConfig config;
+    CDNS::CborOutputCompression compression = CDNS::CborOutputCompression::NO_COMPRESSION;
+    int opt;
+
+    // Parse command line arguments
+    try {
+        while ((opt = getopt(argc, argv, "n:s:r:q:c:b:SF:zxh")) != EOF) {
+            switch (opt) {
+                case 'n':
+                    count = std::stoull(optarg);
+                    break;
+                case 's':
+                    config.seed = std::stoull(optarg);
+                    break;
+                case 'r':
+                    rate = std::stod(optarg);
+                    break;
+                case 'q':
+                    config.qnames = std::stoull(optarg);
+                    break;
+                case 'c':
+                    clients = std::stoull(optarg);
+                    break;
+                case 'b':
+                    block_items = std::stoull(optarg);
+                    break;
+                case 'S':
+                    summary = true;
+                    break;
+                case 'F':
+                    filter_bits = std::stoul(optarg);
+                    break;
+                case 'z':
+                    compression = CDNS::CborOutputCompression::GZIP;
+                    break;
+                case 'x':
+                    compression = CDNS::CborOutputCompression::XZ;
+                    break;
+                case 'h':
+                    print_help();
+                    exit(EXIT_SUCCESS);
+                    break;
+                default:
+                    print_help();
+                    exit(EXIT_FAILURE);
+                    break;
+            }
+        }
+    }
+    catch (std::exception& e) {
+        std::cerr << "Invalid option value!" << std::endl << std::endl;
+        print_help();
+        return 1;
+    }
+
+    if (optind == argc) {
+        std::cerr << "No output file specified!" << std::endl << std::endl;
+        print_help();
+        return 1;
+    }
+
+    output_file = std::string(argv[optind++]);
+
+    if (optind < argc) {
+        std::cerr << "Invalid extra arguments!" << std::endl << std::endl;
+        print_help();
+        return 1;
+    }
+
+    // One IPv6 client for every 5 IPv4 clients
+    config.ipv6_clients = clients / 6;
+    config.ipv4_clients = clients - config.ipv6_clients;
+    if (rate > 0)
+        config.rate = rate;
+
+    std::size_t written = 0;
+    CDNS::ExporterStats stats;
+    auto start = std::chrono::steady_clock::now();
+
+    try {
+        CDNS::TrafficGenerator generator(config);
+        CDNS::FilePreamble fp;
+        fp.m_block_parameters[0].storage_parameters.max_block_items = block_items;
+        CDNS::CdnsExporter exporter(fp, output_file, compression);
+        exporter.set_block_summary(summary);
+        exporter.set_block_filter(filter_bits);
+
+        // Generate in small batches, so the real time rate can be kept
+        static constexpr std::size_t BATCH = 100;
+        for (std::size_t done = 0; done < count;) {
+            std::size_t batch = std::min(BATCH, count - done);
+            written += generator.generate(exporter, batch);
+            done += batch;
+
+            if (rate > 0) {
+                auto due = start + std::chrono::duration<double>(done / rate);
+                std::this_thread::sleep_until(due);
+            }
+        }
+
+        written += exporter.write_block();
+        stats = exporter.get_stats();
+    }
+    catch (std::exception& e) {
+        std::cerr << "Couldn't generate output file " << output_file << "! Reason: " << e.what() << std::endl;
+        return 1;
+    }
+
+    std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+
+    std::string written_file = output_file;
+    if (compression == CDNS::CborOutputCompression::GZIP)
+        written_file += ".gz";
+    else if (compression == CDNS::CborOutputCompression::XZ)
+        written_file += ".xz";
+
+    struct stat st;
+    uint64_t file_size = stat(written_file.c_str(), &st) == 0 ? st.st_size : 0;
+
+    std::cerr << "Items: " << count << std::endl;
+    std::cerr << "Uncompressed bytes: " << written << std::endl;
+    std::cerr << "Output bytes: " << file_size << std::endl;
+    if (file_size > 0)
+        std::cerr << "Compression ratio: " << static_cast<double>(written) / file_size << std::endl;
+    std::cerr << "Elapsed seconds: " << elapsed.count() << std::endl;
+    if (elapsed.count() > 0)
+        std::cerr << "Items per second: " << count / elapsed.count() << std::endl;
+    std::cerr << "Blocks: " << stats.blocks_written << std::endl;
+    std::cerr << "Block tables:" << std::endl << stats.tables.string();
+
+    return 0;
+}
@@ -0,0 +1,382 @@
+/**
+ * Copyright © 2026 CZ.NIC, z. s. p. o.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, you can obtain one at https://mozilla.org/MPL/2.0/.
+ */
+
+#include <iostream>
+#include <istream>
+#include <sstream>
+#include <iomanip>
+#include <string>
+#include <vector>
+#include <memory>
+#include <fstream>
+#include <stdexcept>
+#include <getopt.h>
+
+#include "../cdns.h"
+#include "../search.h"
+
+
+/**
+ * @file cdns_grep.cpp
+ * @brief Implementation of cdns-grep command line tool.
+ *
+ * cdns-grep command line tool prints or extracts Query/Response items of C-DNS files that match given
+ * conditions. Items have to match all given kinds of conditions and at least one value of each kind.
+ * Blocks are decoded and searched on multiple threads and the matching items are printed in the order
+ * of the input. Blocks written with Block summary (see cdns-gen -S and -F) that can't contain matching
+ * items are skipped without decoding. \n
+ * Usage: cdns-grep [-n QNAME] [-s DOMAIN] [-r REGEX] [-c ADDRESS[/LENGTH]] [-a ADDRESS[/LENGTH]] [-q QTYPE]
+ * [-R RCODE] [-f FROM] [-t TO] [-o <OUTPUT_FILE>] [-l] [-v] [-j THREADS] [--stats] [-h] <INPUT_FILE> [<INPUT_FILE> ...] \n
+ * Options: \n
+ *      -n QNAME            : Match QNAME (case-insensitive) \n
+ *      -s DOMAIN           : Match QNAME equal to or below DOMAIN \n
+ *      -r REGEX            : Match QNAME (with trailing dot) by case-insensitive ECMAScript regular expression \n
+ *      -c ADDRESS[/LENGTH] : Match client address or prefix \n
+ *      -a ADDRESS[/LENGTH] : Match server address or prefix \n
+ *      -q QTYPE            : Match numeric QTYPE \n
+ *      -R RCODE            : Match numeric response RCODE \n
+ *      -f FROM             : Match items since FROM (UNIX time in seconds, can have fraction) \n
+ *      -t TO               : Match items until TO (UNIX time in seconds, can have fraction) \n
+ *      -o <OUTPUT_FILE>    : Write matching items to C-DNS file instead of printing them \n
+ *      -l                  : Print only the number of matching items \n
+ *      -v                  : Print full contents of matching items \n
+ *      -j THREADS          : Number of threads decoding Blocks (default is the number of CPUs) \n
+ *      --stats             : Print reader statistics to standard error \n
+ *      -h                  : Print this help message and exit \n
+ * Options -n, -s, -c, -a, -q and -R can be repeated.
+ */
+
+static void print_help()
+{
+    std::cout << "cdns-grep:" << std::endl;
+    std::cout << "Prints or extracts Query/Response items of C-DNS files that match all given kinds" << std::endl;
+    std::cout << "of conditions (and any value of each kind)" << std::endl;
+    std::cout << "Usage: cdns-grep [-n QNAME] [-s DOMAIN] [-r REGEX] [-c ADDRESS[/LENGTH]] [-a ADDRESS[/LENGTH]] [-q QTYPE]";
+    std::cout << " [-R RCODE] [-f FROM] [-t TO] [-o <OUTPUT_FILE>] [-l] [-v] [-j THREADS] [--stats] [-h]";
+    std::cout << " <INPUT_FILE> [<INPUT_FILE> ...]" << std::endl;
+    std::cout << "Options:" << std::endl;
+    std::cout << "\t-n QNAME            : Match QNAME (case-insensitive)" << std::endl;
+    std::cout << "\t-s DOMAIN           : Match QNAME equal to or below DOMAIN" << std::endl;
+    std::cout << "\t-r REGEX            : Match QNAME (with trailing dot) by case-insensitive ECMAScript regular expression" << std::endl;
+    std::cout << "\t-c ADDRESS[/LENGTH] : Match client address or prefix" << std::endl;
+    std::cout << "\t-a ADDRESS[/LENGTH] : Match server address or prefix" << std::endl;
+    std::cout << "\t-q QTYPE            : Match numeric QTYPE" << std::endl;
+    std::cout << "\t-R RCODE            : Match numeric response RCODE" << std::endl;
+    std::cout << "\t-f FROM             : Match items since FROM (UNIX time in seconds, can have fraction)" << std::endl;
+    std::cout << "\t-t TO               : Match items until TO (UNIX time in seconds, can have fraction)" << std::endl;
+    std::cout << "\t-o <OUTPUT_FILE>    : Write matching items to C-DNS file instead of printing them" << std::endl;
+    std::cout << "\t-l                  : Print only the number of matching items" << std::endl;
+    std::cout << "\t-v                  : Print full contents of matching items" << std::endl;
+    std::cout << "\t-j THREADS          : Number of threads decoding Blocks (default is the number of CPUs)" << std::endl;
+    std::cout << "\t--stats             : Print reader statistics to standard error" << std::endl;
+    std::cout << "\t-h                  : Print this help message and exit" << std::endl;
+    std::cout << "Options -n, -s, -c, -a, -q and -R can be repeated." << std::endl;
+}
+
+enum class OutputMode : uint8_t {
+    TEXT = 0,
+    VERBOSE,
+    COUNT,
+    CDNS
+};
+
+/**
+ * @brief Matching items of one Block
+ */
+struct GrepResult {
+    GrepResult() : bp_index(0), matches(0), text(), qrs() {}
+
+    CDNS::index_t bp_index;
+    uint64_t matches;
+    std::string text;
+    std::vector<CDNS::GenericQueryResponse> qrs;
+};
+
+/**
+ * @brief Parse UNIX time in seconds with optional fraction to microseconds
+ */
+static uint64_t parse_time(const std::string& time)
+{
+    std::size_t dot = time.find('.');
+    std::string secs = time.substr(0, dot);
+    std::string fraction = dot == std::string::npos ? "" : time.substr(dot + 1);
+
+    if (secs.empty() || secs.find_first_not_of("0123456789") != std::string::npos ||
+        fraction.find_first_not_of("0123456789") != std::string::npos)
+        throw std::invalid_argument("Invalid time: " + time);
+
+    fraction.resize(6, '0');
+    return std::stoull(secs) * 1000000 + std::stoull(fraction);
+}
+
+/**
+ * @brief Get printable IP address stored in Block table
+ */
+static std::string readable_address(const boost::optional<const std::string&>& address)
+{
+    if (!address)
+        return "-";
+
+    std::string ret = CDNS::address_to_string(*address);
+    return ret.empty() ? "-" : ret;
+}
+
+/**
+ * @brief Print one line with the main fields of Query/Response item
+ */
+static void print_qr(std::ostream& out, const CDNS::QueryResponseView& qr, uint64_t ticks_per_second)
+{
+    if (qr.ts()) {
+        uint64_t us = ticks_per_second ? qr.ts()->m_ticks * 1000000 / ticks_per_second : 0;
+        out << qr.ts()->m_secs << "." << std::setw(6) << std::setfill('0') << us;
+    }
+    else {
+        out << "-";
+    }
+
+    out << "\t" << readable_address(qr.client_ip());
+    out << "\t" << readable_address(qr.server_ip());
+
+    auto qname = qr.query_name();
+    out << "\t" << (qname ? CDNS::wire_to_name(*qname) : "-");
+
+    auto classtype = qr.query_classtype();
+    out << "\t";
+    if (classtype)
+        out << classtype->type;
+    else
+        out << "-";
+
+    auto rcode = qr.response_rcode();
+    out << "\t";
+    if (rcode)
+        out << *rcode;
+    else
+        out << "-";
+
+    out << "\n";
+}
+
+static const struct option long_options[] = {
+    {"stats", no_argument, nullptr, 'S'},
+    {nullptr, 0, nullptr, 0}
+};
+
+int main(int argc, char** argv)
+{
+    CDNS::QueryResponseSearch search;
+    std::vector<std::string> input_files;
+    std::string output_file;
+    OutputMode mode = OutputMode::TEXT;
+    std::size_t threads = 0;
+    boost::optional<uint64_t> from;
+    boost::optional<uint64_t> to;
+    bool stats = false;
+    int opt;
+
+    // Parse command line arguments
+    while ((opt = getopt_long(argc, argv, "n:s:r:c:a:q:R:f:t:o:lvj:h", long_options, nullptr)) != EOF) {
+        try {
+            switch (opt) {
+                case 'n':
+                    search.add_qname(CDNS::name_to_wire(optarg));
+                    break;
+                case 's':
+                    search.add_qname_suffix(CDNS::name_to_wire(optarg));
+                    break;
+                case 'r':
+                    search.set_qname_regex(optarg);
+                    break;
+                case 'c':
+                    search.add_client(CDNS::AddressPrefix::parse(optarg));
+                    break;
+                case 'a':
+                    search.add_server(CDNS::AddressPrefix::parse(optarg));
+                    break;
+                case 'q':
+                    search.add_qtype(static_cast<uint16_t>(std::stoul(optarg)));
+                    break;
+                case 'R':
+                    search.add_rcode(static_cast<uint16_t>(std::stoul(optarg)));
+                    break;
+                case 'f':
+                    from = parse_time(optarg);
+                    break;
+                case 't':
+                    to = parse_time(optarg);
+                    break;
+                case 'o':
+                    output_file = optarg;
+                    mode = OutputMode::CDNS;
+                    break;
+                case 'l':
+                    mode = OutputMode::COUNT;
+                    break;
+                case 'v':
+                    mode = OutputMode::VERBOSE;
+                    break;
+                case 'j':
+                    threads = std::stoull(optarg);
+                    break;
+                case 'S':
+                    stats = true;
+                    break;
+                case 'h':
+                    print_help();
+                    exit(EXIT_SUCCESS);
+                    break;
+                default:
+                    print_help();
+                    exit(EXIT_FAILURE);
+                    break;
+            }
+        }
+        catch (std::exception& e) {
+            std::cerr << "Invalid option value! " << e.what() << std::endl << std::endl;
+            print_help();
+            return 1;
+        }
+    }
+
+    for (int i = optind; i < argc; i++) {
+        input_files.push_back(argv[i]);
+    }
+
+    if (input_files.empty()) {
+        std::cerr << "No input files specified!" << std::endl << std::endl;
+        print_help();
+        return 1;
+    }
+
+    if (from || to)
+        search.set_time_range(from ? *from : 0, to ? *to : UINT64_MAX);
+
+    // Open all input files first, Block parameters of all inputs have to be in the output's file preamble
+    std::vector<std::unique_ptr<std::ifstream>> streams;
+    std::vector<std::unique_ptr<CDNS::CdnsReader>> readers;
+    std::vector<std::string> inputs;
+    for (auto& input : input_files) {
+        try {
+            std::unique_ptr<std::ifstream> ifs(new std::ifstream(input, std::ifstream::binary));
+            if (!ifs->is_open())
+                throw std::runtime_error("Couldn't open file");
+
+            std::unique_ptr<CDNS::CdnsReader> reader(new CDNS::CdnsReader(*ifs));
+            reader->set_timing(stats);
+            streams.push_back(std::move(ifs));
+            readers.push_back(std::move(reader));
+            inputs.push_back(input);
+        }
+        catch (std::exception& e) {
+            std::cerr << "Couldn't read file " << input << "! Reason: " << e.what() << std::endl;
+        }
+    }
+
+    if (readers.empty())
+        return 1;
+
+    std::unique_ptr<CDNS::CdnsExporter> writer;
+    std::vector<std::vector<CDNS::index_t>> block_indexes;
+    if (mode == OutputMode::CDNS) {
+        CDNS::FilePreamble file_preamble = readers[0]->m_file_preamble;
+        for (std::size_t i = 0; i < readers.size(); i++) {
+            std::vector<CDNS::index_t> indexes;
+            for (unsigned j = 0; j < readers[i]->m_file_preamble.block_parameters_size(); j++) {
+                if (i == 0)
+                    indexes.push_back(j);
+                else
+                    indexes.push_back(file_preamble.add_block_parameters(readers[i]->m_file_preamble.get_block_parameters(j)));
+            }
+            block_indexes.push_back(std::move(indexes));
+        }
+
+        writer.reset(new CDNS::CdnsExporter(file_preamble, output_file, CDNS::CborOutputCompression::NO_COMPRESSION));
+    }
+
+    uint64_t matches = 0;
+    int ret = 0;
+    for (std::size_t i = 0; i < readers.size(); i++) {
+        try {
+            CDNS::CdnsReader& reader = *readers[i];
+            CDNS::ParallelBlockReader<GrepResult> parallel(reader, threads);
+            parallel.set_filter(search.filter(reader.m_file_preamble.m_block_parameters));
+
+            auto process = [&search, mode](CDNS::CdnsBlockRead& block) {
+                GrepResult result;
+                std::vector<std::size_t> positions;
+                result.bp_index = block.get_block_parameters_index();
+                result.matches = search.search(block, positions);
+                uint64_t ticks_per_second = block.get_block_parameters().storage_parameters.ticks_per_second;
+
+                if (mode == OutputMode::TEXT) {
+                    std::ostringstream ss;
+                    for (auto pos : positions)
+                        print_qr(ss, block.qr_view(pos), ticks_per_second);
+                    result.text = ss.str();
+                }
+                else if (mode == OutputMode::VERBOSE) {
+                    std::ostringstream ss;
+                    for (auto pos : positions)
+                        ss << block.qr_view(pos).to_generic().string() << std::endl;
+                    result.text = ss.str();
+                }
+                else if (mode == OutputMode::CDNS) {
+                    result.qrs.reserve(positions.size());
+                    for (auto pos : positions)
+                        result.qrs.push_back(block.qr_view(pos).to_generic());
+                }
+
+                return result;
+            };
+
+            auto consume = [&](GrepResult& result) {
+                matches += result.matches;
+                if (mode != OutputMode::CDNS) {
+                    std::cout << result.text;
+                    return;
+                }
+
+                if (result.qrs.empty())
+                    return;
+
+                // Timestamps of the items are in resolution of their Block parameters, so items
+                // with different Block parameters can't share output Block
+                CDNS::index_t bp_index = block_indexes[i][result.bp_index];
+                if (writer->get_active_block_parameters() != bp_index) {
+                    writer->set_active_block_parameters(bp_index);
+                    writer->write_block();
+                }
+
+                for (auto& qr : result.qrs)
+                    writer->buffer_qr(qr);
+            };
+
+            parallel.run(process, consume);
+
+            if (stats)
+                std::cerr << "Input " << inputs[i] << ":" << std::endl << reader.get_stats().string() << std::endl;
+        }
+        catch (std::exception& e) {
+            std::cerr << "Couldn't search file " << inputs[i] << "! Reason: " << e.what() << std::endl;
+            ret = 1;
+        }
+    }
+
+    if (writer) {
+        writer->write_block();
+        if (stats)
+            std::cerr << "Output " << output_file << ":" << std::endl << writer->get_stats().string();
+    }
+
+    if (mode == OutputMode::COUNT)
+        std::cout << matches << std::endl;
+    else if (stats)
+        std::cerr << "Matching items: " << matches << std::endl;
+
+    return ret;
+}
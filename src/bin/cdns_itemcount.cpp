@@ -20,10 +20,11 @@
  *
  * cdns-itemcount command line tool prints the counts of Query/Response, Address Event Count and
  * Malformed Message items in a C-DNS file. \n
- * Usage: cdns-itemcount [-b] [-p] [-h] <INPUT_FILE> \n
+ * Usage: cdns-itemcount [-b] [-p] [--stats] [-h] <INPUT_FILE> \n
  * Options: \n
  *      -b                  : Print per block count of Query/Response, Address Event Count and Malformed Message items \n
  *      -p                  : Pretty print the output \n
+ *      --stats             : Print reader statistics to standard error \n
  *      -h                  : Print this help message and exit \n
  */
 
@@ -32,22 +33,29 @@ static void print_help()
     std::cout << "cdns-itemcount:" << std::endl;
     std::cout << "Prints the counts of Query/Response, Address Event Count and Malformed Message" << std::endl;
     std::cout << "items in a C-DNS file" << std::endl;
-    std::cout << "Usage: cdns-itemcount [-b] [-p] [-h] <INPUT_FILE>" << std::endl;
+    std::cout << "Usage: cdns-itemcount [-b] [-p] [--stats] [-h] <INPUT_FILE>" << std::endl;
     std::cout << "Options:" << std::endl;
     std::cout << "\t-b                  : Print per block count of Query/Response, Address Event Count and Malformed Message items" << std::endl;
     std::cout << "\t-p                  : Pretty print the output" << std::endl;
+    std::cout << "\t--stats             : Print reader statistics to standard error" << std::endl;
     std::cout << "\t-h                  : Print this help message and exit" << std::endl;
 }
 
+static const struct option long_options[] = {
+    {"stats", no_argument, nullptr, 'S'},
+    {nullptr, 0, nullptr, 0}
+};
+
 int main(int argc, char** argv)
 {
     std::string input_file;
     bool pretty = false;
     bool perblock = false;
+    bool stats = false;
     int opt;
 
     // Parse command line arguments
-    while ((opt = getopt(argc, argv, "bph")) != EOF) {
+    while ((opt = getopt_long(argc, argv, "bph", long_options, nullptr)) != EOF) {
         switch (opt) {
             case 'b':
                 perblock = true;
@@ -55,6 +63,9 @@ int main(int argc, char** argv)
             case 'p':
                 pretty = true;
                 break;
+            case 'S':
+                stats = true;
+                break;
             case 'h':
                 print_help();
                 exit(EXIT_SUCCESS);
@@ -88,12 +99,15 @@ int main(int argc, char** argv)
     try {
         std::ifstream ifs(input_file, std::ifstream::binary);
         CDNS::CdnsReader reader(ifs);
+        reader.set_timing(stats);
 
         bool end = false;
         bool first = true;
 
+        CDNS::CdnsBlockRead block;
+
         while (true) {
-            auto block = reader.read_block(end);
+            reader.read_block_into(block, end);
 
             if (end)
                 break;
@@ -136,6 +150,9 @@ int main(int argc, char** argv)
                 std::cout << mm_count << std::endl;
             }
         }
+
+        if (stats)
+            std::cerr << reader.get_stats().string();
     }
     catch (std::exception& e) {
         std::cerr << "Couldn't process input file " << input_file << "! Reason: " << e.what() << std::endl;
@@ -21,12 +21,13 @@
  *
  * cdns-items command line tool prints full contents of individual Query/Response, Address Event Count
  * and Malformed Message items in a C-DNS file. \n
- * Usage: cdns-items [-n <ITEM_NUMBER>|<ITEM_RANGE>] [-q|-a|-m] [-h] <INPUT_FILE> \n
+ * Usage: cdns-items [-n <ITEM_NUMBER>|<ITEM_RANGE>] [-q|-a|-m] [--stats] [-h] <INPUT_FILE> \n
  * Options: \n
  *      -n <ITEM_NUMBER>|<ITEM_RANGE>   : Print contents only for specific item or item range (starts at 0) \n
  *      -q                              : Print contents of only Query/Response items \n
  *      -a                              : Print contents of only Address Event Count items \n
  *      -m                              : Print contents of only Malformed Message items \n
+ *      --stats                         : Print reader statistics to standard error \n
  *      -h                              : Print this help message and exit \n
  */
 
@@ -42,15 +43,21 @@ static void print_help()
     std::cout << "cdns-items:" << std::endl;
     std::cout << "Prints full contents of individual Query/Response, Address Event Count and";
     std::cout << " Malformed Message items in C-DNS file" << std::endl;
-    std::cout << "Usage: cdns-items [-n <ITEM_NUMBER>|<ITEM_RANGE>] [-q|-a|-m] [-h] <INPUT_FILE>" << std::endl;
+    std::cout << "Usage: cdns-items [-n <ITEM_NUMBER>|<ITEM_RANGE>] [-q|-a|-m] [--stats] [-h] <INPUT_FILE>" << std::endl;
     std::cout << "Options:" << std::endl;
     std::cout << "\t-n <ITEM_NUMBER>|<ITEM_RANGE>   : Print contents only for specific item or item range (starts at 0)" << std::endl;
     std::cout << "\t-q                              : Print contents of only Query/Response items" << std::endl;
     std::cout << "\t-a                              : Print contents of only Address Event Count items" << std::endl;
     std::cout << "\t-m                              : Print contents of only Malformed Message items" << std::endl;
+    std::cout << "\t--stats                         : Print reader statistics to standard error" << std::endl;
     std::cout << "\t-h                              : Print this help message and exit" << std::endl;
 }
 
+static const struct option long_options[] = {
+    {"stats", no_argument, nullptr, 'S'},
+    {nullptr, 0, nullptr, 0}
+};
+
 int main(int argc, char** argv)
 {
     std::string input_file;
@@ -59,10 +66,11 @@ int main(int argc, char** argv)
     std::string item_num;
     unsigned item_number_lower = 0;
     unsigned item_number_higher = 0;
+    bool stats = false;
     int opt;
 
     // Parse command line arguments
-    while ((opt = getopt(argc, argv, "qamn:h")) != EOF) {
+    while ((opt = getopt_long(argc, argv, "qamn:h", long_options, nullptr)) != EOF) {
         switch (opt) {
             case 'q':
                 item_type = ItemTypes::QR;
@@ -78,6 +86,9 @@ int main(int argc, char** argv)
                 // item_number = std::stoul(optarg);
                 item_num = optarg;
                 break;
+            case 'S':
+                stats = true;
+                break;
             case 'h':
                 print_help();
                 exit(EXIT_SUCCESS);
@@ -137,11 +148,14 @@ int main(int argc, char** argv)
     try {
         std::ifstream ifs(input_file, std::ifstream::binary);
         CDNS::CdnsReader reader(ifs);
+        reader.set_timing(stats);
         bool end = false;
         unsigned i = 0;
 
+        CDNS::CdnsBlockRead block;
+
         while (true) {
-            auto block = reader.read_block(end);
+            reader.read_block_into(block, end);
 
             if (end)
                 break;
@@ -207,6 +221,9 @@ int main(int argc, char** argv)
         if (i < item_number_higher) {
             std::cerr << "Not enough items in C-DNS file to show desired range!" << std::endl;
         }
+
+        if (stats)
+            std::cerr << reader.get_stats().string();
     }
     catch (std::exception& e) {
         std::cerr << "Couldn't process input file " << input_file << "! Reason: " << e.what() << std::endl;
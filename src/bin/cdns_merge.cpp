@@ -11,6 +11,7 @@
 #include <string>
 #include <vector>
 #include <memory>
+#include <fstream>
 #include <getopt.h>
 
 #include "../cdns.h"
@@ -21,10 +22,17 @@
  * @brief Implementation of cdns-merge command line tool.
  *
  * cdns-merge command line tool merges multiple C-DNS files into one. Can only merge files with compatible
- * 'major.minor.private' version. \n
- * Usage: cdns-merge -o <OUTPUT_FILE> [-h] <INPUT_FILE> [<INPUT_FILE> ...] \n
+ * 'major.minor.private' version. By default Blocks of the input files are copied one after another.
+ * With the -p option the Blocks are copied without decoding them, only their Block parameters index
+ * is rewritten. With the -t option items of all input files are merged by their timestamps and packed
+ * into new Blocks. \n
+ * Usage: cdns-merge -o <OUTPUT_FILE> [-t | -p] [-b ITEMS] [--stats] [-h] <INPUT_FILE> [<INPUT_FILE> ...] \n
  * Options: \n
  *      -o <OUTPUT_FILE>    : Output C-DNS file \n
+ *      -t                  : Merge items of the input files ordered by their timestamps \n
+ *      -p                  : Copy Blocks of the input files verbatim without decoding them \n
+ *      -b ITEMS            : Maximum number of items in output C-DNS block with -t (default from the first input file) \n
+ *      --stats             : Print reader (and writer) statistics to standard error \n
  *      -h                  : Print this help message and exit \n
  */
 
@@ -33,24 +41,130 @@ static void print_help()
     std::cout << "cdns-merge:" << std::endl;
     std::cout << "Merges multiple C-DNS files into one. Can only merge files with compatible" << std::endl;
     std::cout << "'major.minor.private' version." << std::endl;
-    std::cout << "Usage: cdns-merge -o <OUTPUT_FILE> [-h] <INPUT_FILE> [<INPUT_FILE> ...]" << std::endl;
+    std::cout << "Usage: cdns-merge -o <OUTPUT_FILE> [-t | -p] [-b ITEMS] [--stats] [-h] <INPUT_FILE> [<INPUT_FILE> ...]" << std::endl;
     std::cout << "Options:" << std::endl;
     std::cout << "\t-o <OUTPUT_FILE>    : Output C-DNS file" << std::endl;
+    std::cout << "\t-t                  : Merge items of the input files ordered by their timestamps" << std::endl;
+    std::cout << "\t-p                  : Copy Blocks of the input files verbatim without decoding them" << std::endl;
+    std::cout << "\t-b ITEMS            : Maximum number of items in output C-DNS block with -t (default from the first input file)" << std::endl;
+    std::cout << "\t--stats             : Print reader (and writer) statistics to standard error" << std::endl;
     std::cout << "\t-h                  : Print this help message and exit" << std::endl;
 }
 
+/**
+ * @brief Merge items of the input files ordered by their timestamps to new Blocks
+ * @return Exit code of the tool
+ */
+static int merge_time_ordered(const std::vector<std::string>& input_files, const std::string& output_file,
+                              uint64_t block_items, bool stats)
+{
+    std::vector<std::unique_ptr<std::ifstream>> streams;
+    std::vector<std::unique_ptr<CDNS::CdnsReader>> readers;
+    std::vector<std::string> inputs;
+
+    for (auto& input : input_files) {
+        try {
+            std::unique_ptr<std::ifstream> ifs(new std::ifstream(input, std::ifstream::binary));
+            std::unique_ptr<CDNS::CdnsReader> reader(new CDNS::CdnsReader(*ifs));
+            reader->set_timing(stats);
+
+            // Check for 'major.minor.private' version mismatch
+            if (!readers.empty()) {
+                auto& fp = readers[0]->m_file_preamble;
+                if (reader->m_file_preamble.m_major_format_version != fp.m_major_format_version ||
+                    reader->m_file_preamble.m_minor_format_version != fp.m_minor_format_version ||
+                    reader->m_file_preamble.m_private_version != fp.m_private_version) {
+                    throw std::runtime_error("'major.minor.private' version mismatch between " +
+                        inputs[0] + " and " + input);
+                }
+            }
+
+            streams.push_back(std::move(ifs));
+            readers.push_back(std::move(reader));
+            inputs.push_back(input);
+        }
+        catch (std::exception& e) {
+            std::cerr << "Couldn't merge file " << input << "! Reason: " << e.what() << std::endl;
+        }
+    }
+
+    if (readers.empty())
+        return 1;
+
+    // Items are re-encoded with the first Block parameters of the first input file
+    CDNS::FilePreamble file_preamble;
+    file_preamble.m_block_parameters[0] = readers[0]->m_file_preamble.get_block_parameters(0);
+    if (block_items > 0)
+        file_preamble.m_block_parameters[0].storage_parameters.max_block_items = block_items;
+
+    try {
+        CDNS::CdnsExporter writer(file_preamble, output_file, CDNS::CborOutputCompression::NO_COMPRESSION);
+        CDNS::TimeOrderedMerge merge;
+        for (auto& reader : readers)
+            merge.add_input(*reader);
+
+        merge.run(writer);
+        writer.write_block();
+
+        const CDNS::MergeStats& ms = merge.get_stats();
+        if (ms.out_of_order > 0)
+            std::cerr << "Warning: " << ms.out_of_order << " items couldn't be written in time order, "
+                      << "Blocks of some input file overlap in time" << std::endl;
+
+        if (stats) {
+            for (std::size_t i = 0; i < readers.size(); i++)
+                std::cerr << "Input " << inputs[i] << ":" << std::endl << readers[i]->get_stats().string() << std::endl;
+            std::cerr << "Output " << output_file << ":" << std::endl << writer.get_stats().string();
+        }
+    }
+    catch (std::exception& e) {
+        std::cerr << "Couldn't merge files! Reason: " << e.what() << std::endl;
+        return 1;
+    }
+
+    return 0;
+}
+
+static const struct option long_options[] = {
+    {"stats", no_argument, nullptr, 'S'},
+    {nullptr, 0, nullptr, 0}
+};
+
 int main(int argc, char** argv)
 {
     std::vector<std::string> input_files;
     std::string output_file;
+    bool stats = false;
+    bool time_order = false;
+    bool pass_through = false;
+    uint64_t block_items = 0;
     int opt;
 
     // Parse command line arguments
-    while ((opt = getopt(argc, argv, "o:h")) != EOF) {
+    while ((opt = getopt_long(argc, argv, "o:tpb:h", long_options, nullptr)) != EOF) {
         switch (opt) {
             case 'o':
                 output_file = optarg;
                 break;
+            case 't':
+                time_order = true;
+                break;
+            case 'p':
+                pass_through = true;
+                break;
+            case 'b':
+                try {
+                    block_items = std::stoull(optarg);
+                }
+                catch (std::exception& e) {
+                    std::cerr << "Invalid option value!" << std::endl << std::endl;
+                    print_help();
+                    return 1;
+                }
+                break;
+            case 'S':
+                stats = true;
+                break;
             case 'h':
                 print_help();
                 exit(EXIT_SUCCESS);
@@ -78,70 +192,105 @@ int main(int argc, char** argv)
         return 1;
     }
 
-    bool first = true;
-    std::unordered_map<std::string, std::unordered_map<CDNS::index_t, CDNS::index_t>> block_indexes;
+    if (time_order && pass_through) {
+        std::cerr << "Options -t and -p can't be used together!" << std::endl << std::endl;
+        print_help();
+        return 1;
+    }
+
+    if (time_order)
+        return merge_time_ordered(input_files, output_file, block_items, stats);
+
+    // Open all input files and read their file preambles, the Blocks are copied from the same readers
+    std::vector<std::unique_ptr<std::ifstream>> streams;
+    std::vector<std::unique_ptr<CDNS::CdnsReader>> readers;
+    std::vector<std::string> inputs;
+    std::vector<std::vector<CDNS::index_t>> block_indexes;
     CDNS::FilePreamble file_preamble;
 
-    for (auto input: input_files) {
+    for (auto& input : input_files) {
         try {
-            std::ifstream ifs(input, std::ifstream::binary);
-            CDNS::CdnsReader reader(ifs);
+            std::unique_ptr<std::ifstream> ifs(new std::ifstream(input, std::ifstream::binary));
+            std::unique_ptr<CDNS::CdnsReader> reader(new CDNS::CdnsReader(*ifs));
+            reader->set_timing(stats);
+            std::vector<CDNS::index_t> indexes;
 
-            if (first) {
+            if (readers.empty()) {
                 // Use file preamble from first input file for output
-                file_preamble = reader.m_file_preamble;
+                file_preamble = reader->m_file_preamble;
 
-                for (unsigned i = 0; i < reader.m_file_preamble.block_parameters_size(); i++) {
-                    block_indexes[input][i] = i;
+                for (unsigned i = 0; i < reader->m_file_preamble.block_parameters_size(); i++) {
+                    indexes.push_back(i);
                 }
-
-                first = false;
             }
             else {
                 // Check for 'major.minor.private' version mismatch
-                if (reader.m_file_preamble.m_major_format_version != file_preamble.m_major_format_version ||
-                    reader.m_file_preamble.m_minor_format_version != file_preamble.m_minor_format_version ||
-                    reader.m_file_preamble.m_private_version != file_preamble.m_private_version) {
+                if (reader->m_file_preamble.m_major_format_version != file_preamble.m_major_format_version ||
+                    reader->m_file_preamble.m_minor_format_version != file_preamble.m_minor_format_version ||
+                    reader->m_file_preamble.m_private_version != file_preamble.m_private_version) {
                     throw std::runtime_error("'major.minor.private' version mismatch between " +
-                        input_files[0] + " and " + input);
+                        inputs[0] + " and " + input);
                 }
 
                 // Generate new block parameters indexes for output file, because we will simply add
                 // all block parameters from all input files to output file
-                for (unsigned i = 0; i < reader.m_file_preamble.block_parameters_size(); i++) {
-                    block_indexes[input][i] = file_preamble.add_block_parameters(reader.m_file_preamble.get_block_parameters(i));
+                for (unsigned i = 0; i < reader->m_file_preamble.block_parameters_size(); i++) {
+                    indexes.push_back(file_preamble.add_block_parameters(reader->m_file_preamble.get_block_parameters(i)));
                 }
             }
+
+            streams.push_back(std::move(ifs));
+            readers.push_back(std::move(reader));
+            inputs.push_back(input);
+            block_indexes.push_back(std::move(indexes));
         }
         catch (std::exception& e) {
             std::cerr << "Couldn't merge file " << input << "! Reason: " << e.what() << std::endl;
         }
     }
 
+    if (readers.empty())
+        return 1;
+
     CDNS::CdnsExporter writer(file_preamble, output_file, CDNS::CborOutputCompression::NO_COMPRESSION);
+    CDNS::CdnsBlockRead block;
+    CDNS::RawBlock raw_block;
 
-    for (auto input: input_files) {
+    for (std::size_t i = 0; i < readers.size(); i++) {
         try {
-            std::ifstream ifs(input, std::ifstream::binary);
-            CDNS::CdnsReader reader(ifs);
             bool end = false;
 
             while (true) {
-                auto block = reader.read_block(end);
+                if (pass_through) {
+                    readers[i]->read_raw_block(raw_block, end);
+                    if (end)
+                        break;
 
-                if (end)
-                    break;
-
-                // Assign new block parameters index for this block in output file
-                block.m_block_preamble.block_parameters_index = block_indexes[input][block.get_block_parameters_index()];
+                    // Assign new block parameters index for this block in output file
+                    raw_block.preamble.block_parameters_index = block_indexes[i][raw_block.get_block_parameters_index()];
+                    writer.write_raw_block(raw_block);
+                }
+                else {
+                    readers[i]->read_block_into(block, end);
+                    if (end)
+                        break;
 
-                writer.write_block(block);
+                    // Assign new block parameters index for this block in output file
+                    block.m_block_preamble.block_parameters_index = block_indexes[i][block.get_block_parameters_index()];
+                    writer.write_block(block);
+                }
             }
+
+            if (stats)
+                std::cerr << "Input " << inputs[i] << ":" << std::endl << readers[i]->get_stats().string() << std::endl;
         }
         catch (std::exception& e) {
-            std::cerr << "Couldn't merge file " << input << "! Reason: " << e.what() << std::endl;
+            std::cerr << "Couldn't merge file " << inputs[i] << "! Reason: " << e.what() << std::endl;
         }
     }
 
+    if (stats)
+        std::cerr << "Output " << output_file << ":" << std::endl << writer.get_stats().string();
+
     return 0;
 }
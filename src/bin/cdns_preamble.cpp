@@ -83,8 +83,10 @@ int main(int argc, char** argv)
             bool end = false;
             unsigned block_count = 0;
 
+            CDNS::CdnsBlockRead block;
+
             while (true) {
-                auto block = reader.read_block(end);
+                reader.read_block_into(block, end);
 
                 if (end)
                     break;
@@ -0,0 +1,246 @@
+/**
+ * Copyright © 2026 CZ.NIC, z. s. p. o.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, you can obtain one at https://mozilla.org/MPL/2.0/.
+ */
+
+#include <iostream>
+#include <istream>
+#include <string>
+#include <vector>
+#include <fstream>
+#include <getopt.h>
+
+#include "../cdns.h"
+
+
+/**
+ * @file cdns_recompress.cpp
+ * @brief Implementation of cdns-recompress command line tool.
+ *
+ * cdns-recompress command line tool re-encodes C-DNS file to another compression. Compression of the input
+ * (none, GZIP or XZ) is detected automatically. By default Blocks are copied without decoding them, with -b
+ * items of the input are packed to new Blocks with the given maximum number of items (Blocks are decoded
+ * in parallel). The output is cut to chunks compressed in parallel. \n
+ * Usage: cdns-recompress -o OUTPUT [-z none|gzip|xz] [-b ITEMS] [-j THREADS] [--stats] [-h] <INPUT_FILE> \n
+ * Options: \n
+ *      -o OUTPUT           : Name of the output file (no extension is added) \n
+ *      -z none|gzip|xz     : Compression of the output (default is xz) \n
+ *      -b ITEMS            : Re-block the items to Blocks with at most ITEMS items of each type \n
+ *      -j THREADS          : Number of compressing and decoding threads (default is the number of CPUs) \n
+ *      --stats             : Print reader, writer and compression statistics to standard error \n
+ *      -h                  : Print this help message and exit \n
+ */
+
+static void print_help()
+{
+    std::cout << "cdns-recompress:" << std::endl;
+    std::cout << "Re-encodes C-DNS file to another compression, optionally with different Block size" << std::endl;
+    std::cout << "Usage: cdns-recompress -o OUTPUT [-z none|gzip|xz] [-b ITEMS] [-j THREADS] [--stats] [-h] <INPUT_FILE>" << std::endl;
+    std::cout << "Options:" << std::endl;
+    std::cout << "\t-o OUTPUT           : Name of the output file (no extension is added)" << std::endl;
+    std::cout << "\t-z none|gzip|xz     : Compression of the output (default is xz)" << std::endl;
+    std::cout << "\t-b ITEMS            : Re-block the items to Blocks with at most ITEMS items of each type" << std::endl;
+    std::cout << "\t-j THREADS          : Number of compressing and decoding threads (default is the number of CPUs)" << std::endl;
+    std::cout << "\t--stats             : Print reader, writer and compression statistics to standard error" << std::endl;
+    std::cout << "\t-h                  : Print this help message and exit" << std::endl;
+}
+
+static const struct option long_options[] = {
+    {"stats", no_argument, nullptr, 'S'},
+    {nullptr, 0, nullptr, 0}
+};
+
+/**
+ * @brief Items of one decoded input Block
+ */
+struct BlockItems {
+    CDNS::index_t bp_index;
+    bool summary;
+    unsigned filter_bits; //!< Bits per item of the Block's Bloom filter, 0 for none
+    std::vector<CDNS::GenericQueryResponse> qrs;
+    std::vector<CDNS::GenericAddressEventCount> aecs;
+    std::vector<CDNS::GenericMalformedMessage> mms;
+};
+
+/**
+ * @brief Pack items of all remaining Blocks of the input to new Blocks of the exporter
+ * @param reader Reader of the input
+ * @param exporter Exporter with the maximum number of Block items set in its Block parameters
+ * @param threads Number of decoding threads
+ */
+static void reblock(CDNS::CdnsReader& reader, CDNS::CdnsExporter& exporter, std::size_t threads)
+{
+    CDNS::ParallelBlockReader<BlockItems> parallel(reader, threads);
+    bool first = true;
+
+    parallel.run([](CDNS::CdnsBlockRead& block) {
+        BlockItems items;
+        items.bp_index = block.get_block_parameters_index();
+        items.summary = static_cast<bool>(block.m_block_summary);
+        items.filter_bits = block.get_read_summary_filter();
+
+        items.qrs.reserve(block.m_query_responses.size());
+        for (std::size_t i = 0; i < block.m_query_responses.size(); i++)
+            items.qrs.push_back(block.qr_view(i).to_generic());
+
+        bool end = false;
+        while (true) {
+            CDNS::GenericAddressEventCount aec = block.read_generic_aec(end);
+            if (end)
+                break;
+            items.aecs.push_back(std::move(aec));
+        }
+
+        while (true) {
+            CDNS::GenericMalformedMessage mm = block.read_generic_mm(end);
+            if (end)
+                break;
+            items.mms.push_back(std::move(mm));
+        }
+
+        return items;
+    }, [&](BlockItems& items) {
+        // Items with other Block parameters than the buffered ones start a new Block
+        if (first || items.bp_index != exporter.get_active_block_parameters()) {
+            exporter.set_active_block_parameters(items.bp_index);
+            exporter.write_block();
+            first = false;
+        }
+        exporter.set_block_summary(items.summary);
+        exporter.set_block_filter(items.filter_bits);
+
+        for (auto& aec : items.aecs)
+            exporter.buffer_aec(aec);
+        for (auto& qr : items.qrs)
+            exporter.buffer_qr(qr);
+        for (auto& mm : items.mms)
+            exporter.buffer_mm(mm);
+    });
+
+    exporter.write_block();
+}
+
+int main(int argc, char** argv)
+{
+    std::string output;
+    CDNS::CborOutputCompression compression = CDNS::CborOutputCompression::XZ;
+    uint64_t block_items = 0;
+    std::size_t threads = 0;
+    bool stats = false;
+    int opt;
+
+    // Parse command line arguments
+    while ((opt = getopt_long(argc, argv, "o:z:b:j:h", long_options, nullptr)) != EOF) {
+        try {
+            switch (opt) {
+                case 'o':
+                    output = optarg;
+                    break;
+                case 'z':
+                    if (std::string(optarg) == "none")
+                        compression = CDNS::CborOutputCompression::NO_COMPRESSION;
+                    else if (std::string(optarg) == "gzip")
+                        compression = CDNS::CborOutputCompression::GZIP;
+                    else if (std::string(optarg) == "xz")
+                        compression = CDNS::CborOutputCompression::XZ;
+                    else
+                        throw std::invalid_argument(optarg);
+                    break;
+                case 'b':
+                    block_items = std::stoull(optarg);
+                    if (block_items == 0)
+                        throw std::invalid_argument(optarg);
+                    break;
+                case 'j':
+                    threads = std::stoull(optarg);
+                    break;
+                case 'S':
+                    stats = true;
+                    break;
+                case 'h':
+                    print_help();
+                    exit(EXIT_SUCCESS);
+                    break;
+                default:
+                    print_help();
+                    exit(EXIT_FAILURE);
+                    break;
+            }
+        }
+        catch (std::exception& e) {
+            std::cerr << "Invalid option value!" << std::endl << std::endl;
+            print_help();
+            return 1;
+        }
+    }
+
+    if (optind + 1 != argc) {
+        std::cerr << "Exactly one input file has to be specified!" << std::endl << std::endl;
+        print_help();
+        return 1;
+    }
+    std::string input = argv[optind];
+
+    if (output.empty()) {
+        std::cerr << "No output file specified!" << std::endl << std::endl;
+        print_help();
+        return 1;
+    }
+
+    try {
+        std::ifstream ifs(input, std::ifstream::binary);
+        if (!ifs.is_open())
+            throw std::runtime_error("Couldn't open file");
+
+        CDNS::DecompressStreamBuf buffer(ifs);
+        std::istream decompressed(&buffer);
+        CDNS::CdnsReader reader(decompressed);
+        reader.set_timing(stats);
+
+        CDNS::FilePreamble fp = reader.m_file_preamble;
+        if (block_items) {
+            for (auto& bp : fp.m_block_parameters)
+                bp.storage_parameters.max_block_items = block_items;
+        }
+
+        CDNS::ParallelCompressor compressor(output, compression, threads);
+        std::string writer_stats;
+        {
+            CDNS::CdnsExporter exporter(fp, compressor.output(), CDNS::CborOutputCompression::NO_COMPRESSION);
+
+            if (block_items) {
+                reblock(reader, exporter, threads);
+            }
+            else {
+                CDNS::RawBlock raw;
+                bool eof = false;
+                while (true) {
+                    reader.read_raw_block(raw, eof);
+                    if (eof)
+                        break;
+                    exporter.write_raw_block(raw);
+                }
+            }
+
+            writer_stats = exporter.get_stats().string();
+        }
+        compressor.close();
+
+        if (stats) {
+            std::cerr << "Input " << input << ":" << std::endl << reader.get_stats().string() << std::endl;
+            std::cerr << "Output " << output << ":" << std::endl << writer_stats << std::endl;
+            std::cerr << "Bytes read: " << buffer.get_bytes_read() << std::endl;
+            std::cerr << "Uncompressed bytes: " << compressor.get_bytes_in() << std::endl;
+            std::cerr << "Bytes written: " << compressor.get_bytes_out() << std::endl;
+        }
+    }
+    catch (std::exception& e) {
+        std::cerr << "Couldn't recompress file " << input << "! Reason: " << e.what() << std::endl;
+        return 1;
+    }
+
+    return 0;
+}
@@ -0,0 +1,219 @@
+/**
+ * Copyright © 2026 CZ.NIC, z. s. p. o.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, you can obtain one at https://mozilla.org/MPL/2.0/.
+ */
+
+#include <iostream>
+#include <istream>
+#include <string>
+#include <vector>
+#include <memory>
+#include <fstream>
+#include <set>
+#include <ctime>
+#include <cstdio>
+#include <getopt.h>
+
+#include "../cdns.h"
+
+
+/**
+ * @file cdns_split.cpp
+ * @brief Implementation of cdns-split command line tool.
+ *
+ * cdns-split command line tool splits C-DNS file into multiple files by number of Blocks, by uncompressed
+ * size of Blocks or by time buckets. Blocks are copied without decoding them, when splitting by time only
+ * Blocks straddling a bucket boundary are decoded and their items re-encoded to the outputs of their
+ * buckets. Output files are written in parallel. \n
+ * Output files are named PREFIX.NNNN.cdns (numbered from 0) or with -t PREFIX.YYYYMMDD-HHMMSS.cdns
+ * by the start of their time bucket (in UTC), compressed files get .gz or .xz extension. \n
+ * Usage: cdns-split -o PREFIX (-b BLOCKS | -s BYTES | -t SECONDS) [-z gzip|xz] [-j THREADS] [--stats] [-h] <INPUT_FILE> \n
+ * Options: \n
+ *      -o PREFIX           : Prefix of output file names \n
+ *      -b BLOCKS           : Maximum number of Blocks in each output file \n
+ *      -s BYTES            : Maximum uncompressed size of Blocks in each output file (at least one Block is written) \n
+ *      -t SECONDS          : Split items to time buckets of given length (aligned to multiples of the length) \n
+ *      -z gzip|xz          : Compress output files \n
+ *      -j THREADS          : Maximum number of output files written at once (default is the number of CPUs) \n
+ *      --stats             : Print reader and split statistics to standard error \n
+ *      -h                  : Print this help message and exit \n
+ */
+
+static void print_help()
+{
+    std::cout << "cdns-split:" << std::endl;
+    std::cout << "Splits C-DNS file into multiple files by number of Blocks, size of Blocks or time buckets" << std::endl;
+    std::cout << "Usage: cdns-split -o PREFIX (-b BLOCKS | -s BYTES | -t SECONDS) [-z gzip|xz] [-j THREADS]";
+    std::cout << " [--stats] [-h] <INPUT_FILE>" << std::endl;
+    std::cout << "Options:" << std::endl;
+    std::cout << "\t-o PREFIX           : Prefix of output file names" << std::endl;
+    std::cout << "\t-b BLOCKS           : Maximum number of Blocks in each output file" << std::endl;
+    std::cout << "\t-s BYTES            : Maximum uncompressed size of Blocks in each output file (at least one Block is written)" << std::endl;
+    std::cout << "\t-t SECONDS          : Split items to time buckets of given length (aligned to multiples of the length)" << std::endl;
+    std::cout << "\t-z gzip|xz          : Compress output files" << std::endl;
+    std::cout << "\t-j THREADS          : Maximum number of output files written at once (default is the number of CPUs)" << std::endl;
+    std::cout << "\t--stats             : Print reader and split statistics to standard error" << std::endl;
+    std::cout << "\t-h                  : Print this help message and exit" << std::endl;
+}
+
+/**
+ * @brief Create name of output file
+ * @param prefix Prefix of output file names
+ * @param index Index of the output
+ * @param start Start of the output's time bucket in seconds, ignored if not splitting by time
+ * @param by_time Splitting by time
+ * @return File name without the extension of compressed output (added by the writer)
+ */
+static std::string output_name(const std::string& prefix, std::size_t index, uint64_t start, bool by_time)
+{
+    std::string name = prefix + ".";
+    char buffer[32];
+
+    if (by_time) {
+        std::time_t secs = static_cast<std::time_t>(start);
+        std::tm tm;
+        gmtime_r(&secs, &tm);
+        std::strftime(buffer, sizeof(buffer), "%Y%m%d-%H%M%S", &tm);
+    }
+    else {
+        std::snprintf(buffer, sizeof(buffer), "%04zu", index);
+    }
+    name += buffer;
+    name += ".cdns";
+
+    return name;
+}
+
+static const struct option long_options[] = {
+    {"stats", no_argument, nullptr, 'S'},
+    {nullptr, 0, nullptr, 0}
+};
+
+int main(int argc, char** argv)
+{
+    std::string prefix;
+    CDNS::SplitBy by = CDNS::SplitBy::BLOCKS;
+    uint64_t limit = 0;
+    unsigned criteria = 0;
+    CDNS::CborOutputCompression compression = CDNS::CborOutputCompression::NO_COMPRESSION;
+    std::size_t threads = 0;
+    bool stats = false;
+    int opt;
+
+    // Parse command line arguments
+    while ((opt = getopt_long(argc, argv, "o:b:s:t:z:j:h", long_options, nullptr)) != EOF) {
+        try {
+            switch (opt) {
+                case 'o':
+                    prefix = optarg;
+                    break;
+                case 'b':
+                    by = CDNS::SplitBy::BLOCKS;
+                    limit = std::stoull(optarg);
+                    criteria++;
+                    break;
+                case 's':
+                    by = CDNS::SplitBy::SIZE;
+                    limit = std::stoull(optarg);
+                    criteria++;
+                    break;
+                case 't':
+                    by = CDNS::SplitBy::TIME;
+                    limit = std::stoull(optarg);
+                    criteria++;
+                    break;
+                case 'z':
+                    if (std::string(optarg) == "gzip")
+                        compression = CDNS::CborOutputCompression::GZIP;
+                    else if (std::string(optarg) == "xz")
+                        compression = CDNS::CborOutputCompression::XZ;
+                    else
+                        throw std::invalid_argument(optarg);
+                    break;
+                case 'j':
+                    threads = std::stoull(optarg);
+                    break;
+                case 'S':
+                    stats = true;
+                    break;
+                case 'h':
+                    print_help();
+                    exit(EXIT_SUCCESS);
+                    break;
+                default:
+                    print_help();
+                    exit(EXIT_FAILURE);
+                    break;
+            }
+        }
+        catch (std::exception& e) {
+            std::cerr << "Invalid option value!" << std::endl << std::endl;
+            print_help();
+            return 1;
+        }
+    }
+
+    if (optind + 1 != argc) {
+        std::cerr << "Exactly one input file has to be specified!" << std::endl << std::endl;
+        print_help();
+        return 1;
+    }
+    std::string input = argv[optind];
+
+    if (prefix.empty()) {
+        std::cerr << "No output prefix specified!" << std::endl << std::endl;
+        print_help();
+        return 1;
+    }
+
+    if (criteria != 1 || limit == 0) {
+        std::cerr << "Exactly one of -b, -s and -t options with positive value has to be specified!"
+                  << std::endl << std::endl;
+        print_help();
+        return 1;
+    }
+
+    try {
+        std::ifstream ifs(input, std::ifstream::binary);
+        if (!ifs.is_open())
+            throw std::runtime_error("Couldn't open file");
+
+        CDNS::CdnsReader reader(ifs);
+        reader.set_timing(stats);
+        CDNS::CdnsSplit split(by, limit, threads);
+        std::set<std::string> names;
+
+        split.run(reader, [&](CDNS::FilePreamble& fp, std::size_t index, uint64_t start) {
+            std::string name = output_name(prefix, index, start, by == CDNS::SplitBy::TIME);
+
+            // Time bucket reached again by Blocks out of time order gets another file
+            if (!names.insert(name).second) {
+                name = output_name(prefix + "." + std::to_string(index), index, start, true);
+                names.insert(name);
+            }
+
+            return std::unique_ptr<CDNS::CdnsExporter>(new CDNS::CdnsExporter(fp, name, compression));
+        });
+
+        const CDNS::SplitStats& ss = split.get_stats();
+        if (ss.out_of_order > 0)
+            std::cerr << "Warning: " << ss.out_of_order << " Blocks started in time bucket that was already "
+                      << "written, Blocks of the input overlap in time" << std::endl;
+
+        if (stats) {
+            std::cerr << "Input " << input << ":" << std::endl << reader.get_stats().string() << std::endl;
+            std::cerr << "Outputs: " << ss.outputs << std::endl;
+            std::cerr << "Blocks copied: " << ss.blocks_copied << std::endl;
+            std::cerr << "Blocks split: " << ss.blocks_split << std::endl;
+        }
+    }
+    catch (std::exception& e) {
+        std::cerr << "Couldn't split file " << input << "! Reason: " << e.what() << std::endl;
+        return 1;
+    }
+
+    return 0;
+}
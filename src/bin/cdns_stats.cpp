@@ -0,0 +1,146 @@
+/**
+ * Copyright © 2026 CZ.NIC, z. s. p. o.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, you can obtain one at https://mozilla.org/MPL/2.0/.
+ */
+
+#include <iostream>
+#include <istream>
+#include <string>
+#include <vector>
+#include <fstream>
+#include <getopt.h>
+
+#include "../cdns.h"
+#include "../aggregate.h"
+
+
+/**
+ * @file cdns_stats.cpp
+ * @brief Implementation of cdns-stats command line tool.
+ *
+ * cdns-stats command line tool prints aggregated statistics of Query/Response items in C-DNS files:
+ * number of items per second over time, distribution of response RCODEs and QTYPEs, the most frequent
+ * QNAMEs and clients (Space-Saving summaries) and the number of distinct QNAMEs and clients (HyperLogLog
+ * estimates). Blocks are decoded and aggregated on multiple threads. \n
+ * Usage: cdns-stats [-i INTERVAL] [-k TOP] [-c COUNTERS] [-j THREADS] [--stats] [-h] <INPUT_FILE> [<INPUT_FILE> ...] \n
+ * Options: \n
+ *      -i INTERVAL         : Length of time intervals for items per second in seconds (default 60) \n
+ *      -k TOP              : Number of the most frequent QNAMEs and clients to print (default 10) \n
+ *      -c COUNTERS         : Number of counters for the most frequent QNAMEs and clients (default 10000) \n
+ *      -j THREADS          : Number of threads decoding Blocks (default is the number of CPUs) \n
+ *      --stats             : Print reader statistics to standard error \n
+ *      -h                  : Print this help message and exit \n
+ */
+
+static void print_help()
+{
+    std::cout << "cdns-stats:" << std::endl;
+    std::cout << "Prints aggregated statistics of Query/Response items in C-DNS files" << std::endl;
+    std::cout << "Usage: cdns-stats [-i INTERVAL] [-k TOP] [-c COUNTERS] [-j THREADS] [--stats] [-h]";
+    std::cout << " <INPUT_FILE> [<INPUT_FILE> ...]" << std::endl;
+    std::cout << "Options:" << std::endl;
+    std::cout << "\t-i INTERVAL         : Length of time intervals for items per second in seconds (default 60)" << std::endl;
+    std::cout << "\t-k TOP              : Number of the most frequent QNAMEs and clients to print (default 10)" << std::endl;
+    std::cout << "\t-c COUNTERS         : Number of counters for the most frequent QNAMEs and clients (default 10000)" << std::endl;
+    std::cout << "\t-j THREADS          : Number of threads decoding Blocks (default is the number of CPUs)" << std::endl;
+    std::cout << "\t--stats             : Print reader statistics to standard error" << std::endl;
+    std::cout << "\t-h                  : Print this help message and exit" << std::endl;
+}
+
+static const struct option long_options[] = {
+    {"stats", no_argument, nullptr, 'S'},
+    {nullptr, 0, nullptr, 0}
+};
+
+int main(int argc, char** argv)
+{
+    std::vector<std::string> input_files;
+    uint64_t interval = CDNS::TrafficAggregate::DEFAULT_INTERVAL;
+    std::size_t top = 10;
+    std::size_t counters = CDNS::SpaceSaving::DEFAULT_CAPACITY;
+    std::size_t threads = 0;
+    bool stats = false;
+    int opt;
+
+    // Parse command line arguments
+    while ((opt = getopt_long(argc, argv, "i:k:c:j:h", long_options, nullptr)) != EOF) {
+        try {
+            switch (opt) {
+                case 'i':
+                    interval = std::stoull(optarg);
+                    break;
+                case 'k':
+                    top = std::stoull(optarg);
+                    break;
+                case 'c':
+                    counters = std::stoull(optarg);
+                    break;
+                case 'j':
+                    threads = std::stoull(optarg);
+                    break;
+                case 'S':
+                    stats = true;
+                    break;
+                case 'h':
+                    print_help();
+                    exit(EXIT_SUCCESS);
+                    break;
+                default:
+                    print_help();
+                    exit(EXIT_FAILURE);
+                    break;
+            }
+        }
+        catch (std::exception& e) {
+            std::cerr << "Invalid option value!" << std::endl << std::endl;
+            print_help();
+            return 1;
+        }
+    }
+
+    for (int i = optind; i < argc; i++) {
+        input_files.push_back(argv[i]);
+    }
+
+    if (input_files.empty()) {
+        std::cerr << "No input files specified!" << std::endl << std::endl;
+        print_help();
+        return 1;
+    }
+
+    if (interval == 0 || counters == 0) {
+        std::cerr << "Interval and number of counters have to be positive!" << std::endl << std::endl;
+        print_help();
+        return 1;
+    }
+
+    CDNS::TrafficAggregate total(interval, counters);
+    int ret = 0;
+
+    for (auto& input : input_files) {
+        try {
+            std::ifstream ifs(input, std::ifstream::binary);
+            if (!ifs.is_open())
+                throw std::runtime_error("Couldn't open file");
+
+            CDNS::CdnsReader reader(ifs);
+            reader.set_timing(stats);
+
+            // Each worker aggregates its Blocks separately, the partial aggregates are merged at the end
+            total.add_blocks(reader, threads);
+
+            if (stats)
+                std::cerr << "Input " << input << ":" << std::endl << reader.get_stats().string() << std::endl;
+        }
+        catch (std::exception& e) {
+            std::cerr << "Couldn't read file " << input << "! Reason: " << e.what() << std::endl;
+            ret = 1;
+        }
+    }
+
+    std::cout << total.string(top);
+    return ret;
+}
@@ -7,13 +7,134 @@
  */
 
 #include <sstream>
+#include <iomanip>
 #include <bitset>
 #include <type_traits>
 
 #include "block.h"
+#include "string_interner.h"
 #include "cdns_encoder.h"
 #include "interface.h"
 
+namespace {
+    /**
+     * @brief Read-only stream buffer over existing memory
+     */
+    class MemoryStreamBuf : public std::streambuf {
+        public:
+        MemoryStreamBuf(const char* data, std::size_t size) {
+            char* p = const_cast<char*>(data);
+            setg(p, p, p + size);
+        }
+    };
+
+    /**
+     * @brief Get size and deduplication statistics of given Block table
+     * @param table Block table
+     * @return Statistics of the Block table
+     */
+    template<typename T, typename K>
+    CDNS::TableStats table_stats(const CDNS::BlockTable<T, K>& table)
+    {
+        CDNS::TableStats ret;
+        ret.items = table.size();
+        ret.lookups = table.lookups();
+        ret.hits = table.hits();
+        return ret;
+    }
+
+    /**
+     * @brief Append optional value to the column, or missing value if it isn't set
+     * @param column Column to append to
+     * @param value Optional value
+     */
+    template<typename T, typename U>
+    void push_optional(CDNS::Column<T>& column, const boost::optional<U>& value)
+    {
+        if (value)
+            column.push_back(static_cast<T>(*value));
+        else
+            column.push_null();
+    }
+
+    /**
+     * @brief Append index to the column if it's within bounds of the Block table
+     * @param column Column to append to
+     * @param index Optional index to the Block table
+     * @param size Size of the Block table
+     * @param table Name of the Block table for error message
+     * @param base Position of the Block table in the dictionary the column refers to
+     */
+    void push_index(CDNS::Column<CDNS::index_t>& column, const boost::optional<CDNS::index_t>& index,
+                    std::size_t size, const char* table, CDNS::index_t base)
+    {
+        if (!index) {
+            column.push_null();
+            return;
+        }
+
+        if (*index >= size)
+            throw std::runtime_error(std::string(table) + " block table index out of bounds");
+
+        column.push_back(base + *index);
+    }
+
+    /**
+     * @brief Get size of CBOR encoded unsigned integer (or map key)
+     * @param value Value to encode
+     * @return Number of bytes of the encoded integer
+     */
+    std::size_t cbor_int_size(uint64_t value)
+    {
+        if (value < 24)
+            return 1;
+        else if (value <= UINT8_MAX)
+            return 2;
+        else if (value <= UINT16_MAX)
+            return 3;
+        else if (value <= UINT32_MAX)
+            return 5;
+        else
+            return 9;
+    }
+
+    /**
+     * @brief Get size of CBOR encoded signed integer
+     * @param value Value to encode
+     * @return Number of bytes of the encoded integer
+     */
+    std::size_t cbor_signed_size(int64_t value)
+    {
+        return value < 0 ? cbor_int_size(static_cast<uint64_t>(-1 - value)) : cbor_int_size(value);
+    }
+
+    /**
+     * @brief Get size of CBOR encoded optional map item with integer value (including its key)
+     * @param value Optional value of the item
+     * @return Number of bytes of the encoded map item, 0 if the value isn't present
+     */
+    template<typename T>
+    std::size_t cbor_field_size(const boost::optional<T>& value)
+    {
+        return value ? 1 + cbor_int_size(static_cast<uint64_t>(*value)) : 0;
+    }
+
+    /**
+     * @brief Get size of CBOR encoded optional map item with string value (including its key)
+     * @param value Optional value of the item
+     * @return Number of bytes of the encoded map item, 0 if the value isn't present
+     */
+    std::size_t cbor_string_field_size(const boost::optional<std::string>& value)
+    {
+        return value ? 1 + cbor_int_size(value->size()) + value->size() : 0;
+    }
+
+    /**
+     * @brief Estimated size of CBOR encoded time offset against Block's earliest time
+     */
+    constexpr std::size_t TIME_OFFSET_ESTIMATE = 5;
+}
+
 std::string CDNS::ClassType::string()
 {
     std::stringstream ss;
@@ -42,6 +163,11 @@ std::size_t CDNS::ClassType::write(CdnsEncoder& enc)
     return written;
 }
 
+std::size_t CDNS::ClassType::estimated_size() const
+{
+    return 1 + 1 + cbor_int_size(type) + 1 + cbor_int_size(class_);
+}
+
 void CDNS::ClassType::read(CdnsDecoder& dec)
 {
     reset();
@@ -263,6 +389,17 @@ std::size_t CDNS::QueryResponseSignature::write(CdnsEncoder& enc)
     return written;
 }
 
+std::size_t CDNS::QueryResponseSignature::estimated_size() const
+{
+    return 1 + cbor_field_size(server_address_index) + cbor_field_size(server_port) +
+           cbor_field_size(qr_transport_flags) + cbor_field_size(qr_type) + cbor_field_size(qr_sig_flags) +
+           cbor_field_size(query_opcode) + cbor_field_size(qr_dns_flags) + cbor_field_size(query_rcode) +
+           cbor_field_size(query_classtype_index) + cbor_field_size(query_qdcount) +
+           cbor_field_size(query_ancount) + cbor_field_size(query_nscount) + cbor_field_size(query_arcount) +
+           cbor_field_size(query_edns_version) + cbor_field_size(query_udp_size) +
+           cbor_field_size(query_opt_rdata_index) + cbor_field_size(response_rcode);
+}
+
 void CDNS::QueryResponseSignature::read(CdnsDecoder& dec)
 {
     reset();
@@ -384,6 +521,11 @@ std::size_t CDNS::Question::write(CdnsEncoder& enc)
     return written;
 }
 
+std::size_t CDNS::Question::estimated_size() const
+{
+    return 1 + 1 + cbor_int_size(name_index) + 1 + cbor_int_size(classtype_index);
+}
+
 void CDNS::Question::read(CdnsDecoder& dec)
 {
     reset();
@@ -473,6 +615,12 @@ std::size_t CDNS::RR::write(CdnsEncoder& enc)
     return written;
 }
 
+std::size_t CDNS::RR::estimated_size() const
+{
+    return 1 + 1 + cbor_int_size(name_index) + 1 + cbor_int_size(classtype_index) + cbor_field_size(ttl) +
+           cbor_field_size(rdata_index);
+}
+
 void CDNS::RR::read(CdnsDecoder& dec)
 {
     reset();
@@ -581,6 +729,12 @@ std::size_t CDNS::MalformedMessageData::write(CdnsEncoder& enc)
     return written;
 }
 
+std::size_t CDNS::MalformedMessageData::estimated_size() const
+{
+    return 1 + cbor_field_size(server_address_index) + cbor_field_size(server_port) +
+           cbor_field_size(mm_transport_flags) + cbor_string_field_size(mm_payload);
+}
+
 void CDNS::MalformedMessageData::read(CdnsDecoder& dec)
 {
     reset();
@@ -866,6 +1020,107 @@ void CDNS::BlockPreamble::reset()
     block_parameters_index = boost::none;
 }
 
+std::size_t CDNS::RawBlock::write(CdnsEncoder& enc)
+{
+    std::size_t written = 0;
+
+    // Start Block map
+    written += enc.write_map_start(fields + 1);
+
+    // Write Block preamble
+    written += enc.write(get_map_index(CDNS::BlockMapIndex::block_preamble));
+    written += preamble.write(enc);
+
+    // Write the rest of the Block as it was read
+    written += enc.write_raw(data);
+
+    return written;
+}
+
+bool CDNS::RawBlock::read(CdnsDecoder& dec, const BlockSummaryFilter& filter)
+{
+    preamble.reset();
+    summary = boost::none;
+    fields = 0;
+    data.clear();
+    bool is_preamble = false;
+    bool skip = false;
+    bool indef = false;
+    uint64_t length = dec.read_map_start(indef);
+
+    try {
+        while (length > 0 || indef) {
+            if (indef && dec.peek_type() == CborType::BREAK) {
+                dec.read_break();
+                break;
+            }
+
+            if (skip) {
+                if (!indef && summary->body_size) {
+                    dec.skip_bytes(*summary->body_size);
+                    break;
+                }
+
+                dec.skip_item();
+                dec.skip_item();
+                length--;
+                continue;
+            }
+
+            // Record the map key and drop it again if it belongs to Block preamble
+            std::size_t key_start = data.size();
+            dec.start_recording(data);
+            int64_t key = dec.read_integer();
+            dec.stop_recording();
+
+            if (key == get_map_index(BlockMapIndex::block_preamble)) {
+                data.resize(key_start);
+                preamble.read(dec);
+                is_preamble = true;
+            }
+            else if (key == get_map_index(BlockMapIndex::block_summary) && is_preamble && fields == 0) {
+                dec.start_recording(data);
+                summary = BlockSummary();
+                summary->read(dec);
+                dec.stop_recording();
+                fields++;
+
+                if (filter && !filter(preamble, *summary)) {
+                    skip = true;
+                    fields = 0;
+                    data.clear();
+                }
+                else if (!indef && summary->body_size) {
+                    // The rest of the Block follows the summary, copy it without decoding
+                    dec.start_recording(data);
+                    dec.skip_bytes(*summary->body_size);
+                    dec.stop_recording();
+                    fields += length - 1;
+                    break;
+                }
+            }
+            else {
+                dec.start_recording(data);
+                dec.skip_item();
+                dec.stop_recording();
+                fields++;
+            }
+
+            length--;
+        }
+    }
+    catch (...) {
+        // Don't leave the decoder recording to this Block
+        dec.stop_recording();
+        throw;
+    }
+
+    if (!is_preamble)
+        throw CdnsDecoderException("C-DNS block doesn't contain Block preamble");
+
+    return !skip;
+}
+
 std::string CDNS::BlockStatistics::string()
 {
     std::stringstream ss;
@@ -993,6 +1248,196 @@ void CDNS::BlockStatistics::reset()
     malformed_items = boost::none;
 }
 
+constexpr uint64_t CDNS::BlockSummary::NAME_SEED;
+constexpr uint64_t CDNS::BlockSummary::ADDRESS_SEED;
+
+std::string CDNS::BlockSummary::string()
+{
+    std::stringstream ss;
+    auto hex = [](const std::string& data) {
+        std::stringstream hs;
+        hs << std::hex << std::setfill('0');
+        for (unsigned char c : data)
+            hs << std::setw(2) << static_cast<unsigned>(c);
+        return hs.str();
+    };
+
+    ss << "Latest time:" << std::endl;
+    ss << "\tSeconds: " << std::to_string(latest_time.m_secs) << std::endl;
+    ss << "\tTicks: " << std::to_string(latest_time.m_ticks) << std::endl;
+    ss << "Q/R items: " << std::to_string(qr_count) << std::endl;
+    ss << "AEC items: " << std::to_string(aec_count) << std::endl;
+    ss << "MM items: " << std::to_string(mm_count) << std::endl;
+
+    if (min_client_address)
+        ss << "Min client address: " << hex(min_client_address.value()) << std::endl;
+
+    if (max_client_address)
+        ss << "Max client address: " << hex(max_client_address.value()) << std::endl;
+
+    for (auto& rcode : rcode_counts)
+        ss << "RCODE " << std::to_string(rcode.first) << ": " << std::to_string(rcode.second) << std::endl;
+
+    if (body_size)
+        ss << "Body size: " << std::to_string(body_size.value()) << std::endl;
+
+    if (filter)
+        ss << filter->string();
+
+    return ss.str();
+}
+
+std::size_t CDNS::BlockSummary::write(CdnsEncoder& enc)
+{
+    std::size_t written = 0;
+    std::size_t fields = 4 + !!min_client_address + !!max_client_address + !rcode_counts.empty() + !!body_size
+                         + !!filter;
+
+    // Start Block summary map
+    written += enc.write_map_start(fields);
+
+    // Write Latest time
+    written += enc.write(get_map_index(CDNS::BlockSummaryMapIndex::latest_time));
+    written += latest_time.write(enc);
+
+    // Write item counts
+    written += enc.write(get_map_index(CDNS::BlockSummaryMapIndex::qr_count));
+    written += enc.write(qr_count);
+    written += enc.write(get_map_index(CDNS::BlockSummaryMapIndex::aec_count));
+    written += enc.write(aec_count);
+    written += enc.write(get_map_index(CDNS::BlockSummaryMapIndex::mm_count));
+    written += enc.write(mm_count);
+
+    // Write client address range
+    if (min_client_address) {
+        written += enc.write(get_map_index(CDNS::BlockSummaryMapIndex::min_client_address));
+        written += enc.write_bytestring(min_client_address.value());
+    }
+
+    if (max_client_address) {
+        written += enc.write(get_map_index(CDNS::BlockSummaryMapIndex::max_client_address));
+        written += enc.write_bytestring(max_client_address.value());
+    }
+
+    // Write RCODE histogram as map of RCODE -> number of Query/Response items
+    if (!rcode_counts.empty()) {
+        written += enc.write(get_map_index(CDNS::BlockSummaryMapIndex::rcode_counts));
+        written += enc.write_map_start(rcode_counts.size());
+        for (auto& rcode : rcode_counts) {
+            written += enc.write(rcode.first);
+            written += enc.write(rcode.second);
+        }
+    }
+
+    // Write Body size
+    if (body_size) {
+        written += enc.write(get_map_index(CDNS::BlockSummaryMapIndex::body_size));
+        written += enc.write(body_size.value());
+    }
+
+    // Write Bloom filter
+    if (filter) {
+        written += enc.write(get_map_index(CDNS::BlockSummaryMapIndex::filter));
+        written += filter->write(enc);
+    }
+
+    return written;
+}
+
+void CDNS::BlockSummary::read(CdnsDecoder& dec)
+{
+    reset();
+    bool indef = false;
+    uint64_t length = dec.read_map_start(indef);
+
+    while (length > 0 || indef) {
+        if (indef && dec.peek_type() == CborType::BREAK) {
+            dec.read_break();
+            break;
+        }
+
+        switch (dec.read_integer()) {
+            case get_map_index(BlockSummaryMapIndex::latest_time):
+                latest_time.read(dec);
+                break;
+            case get_map_index(BlockSummaryMapIndex::qr_count):
+                qr_count = dec.read_unsigned();
+                break;
+            case get_map_index(BlockSummaryMapIndex::aec_count):
+                aec_count = dec.read_unsigned();
+                break;
+            case get_map_index(BlockSummaryMapIndex::mm_count):
+                mm_count = dec.read_unsigned();
+                break;
+            case get_map_index(BlockSummaryMapIndex::min_client_address):
+                min_client_address = dec.read_bytestring();
+                break;
+            case get_map_index(BlockSummaryMapIndex::max_client_address):
+                max_client_address = dec.read_bytestring();
+                break;
+            case get_map_index(BlockSummaryMapIndex::rcode_counts): {
+                bool rc_indef = false;
+                uint64_t rc_length = dec.read_map_start(rc_indef);
+                while (rc_length > 0 || rc_indef) {
+                    if (rc_indef && dec.peek_type() == CborType::BREAK) {
+                        dec.read_break();
+                        break;
+                    }
+
+                    uint16_t rcode = dec.read_unsigned();
+                    rcode_counts[rcode] += dec.read_unsigned();
+                    rc_length--;
+                }
+                break;
+            }
+            case get_map_index(BlockSummaryMapIndex::body_size):
+                body_size = dec.read_unsigned();
+                break;
+            case get_map_index(BlockSummaryMapIndex::filter):
+                filter = BloomFilter();
+                filter->read(dec);
+                break;
+            default:
+                dec.skip_item();
+                break;
+        }
+
+        length--;
+    }
+}
+
+void CDNS::BlockSummary::reset()
+{
+    latest_time.reset();
+    qr_count = 0;
+    aec_count = 0;
+    mm_count = 0;
+    min_client_address = boost::none;
+    max_client_address = boost::none;
+    rcode_counts.clear();
+    body_size = boost::none;
+    filter = boost::none;
+}
+
+uint64_t CDNS::BlockSummary::name_hash(const std::string& name)
+{
+    // Lowercase ASCII letters (length octets of labels are below 64, so they aren't affected)
+    char buffer[256];
+    std::string long_name;
+    char* lower = buffer;
+    if (name.size() > sizeof(buffer)) {
+        long_name.resize(name.size());
+        lower = &long_name[0];
+    }
+
+    for (std::size_t i = 0; i < name.size(); i++) {
+        char c = name[i];
+        lower[i] = (c >= 'A' && c <= 'Z') ? c + ('a' - 'A') : c;
+    }
+
+    return stable_hash(lower, name.size(), NAME_SEED);
+}
+
 std::string CDNS::QueryResponse::string()
 {
     std::stringstream ss;
@@ -1166,6 +1611,34 @@ std::size_t CDNS::QueryResponse::write(CdnsEncoder& enc, const Timestamp& earlie
     return written;
 }
 
+std::size_t CDNS::QueryResponse::estimated_size() const
+{
+    std::size_t size = 1 + (time_offset ? 1 + TIME_OFFSET_ESTIMATE : 0) + cbor_field_size(client_address_index) +
+                       cbor_field_size(client_port) + cbor_field_size(transaction_id) +
+                       cbor_field_size(qr_signature_index) + cbor_field_size(client_hoplimit) +
+                       cbor_field_size(query_name_index) + cbor_field_size(query_size) +
+                       cbor_field_size(response_size) + cbor_string_field_size(asn) +
+                       cbor_string_field_size(country_code);
+
+    if (response_delay)
+        size += 1 + cbor_signed_size(*response_delay);
+
+    if (round_trip_time)
+        size += 1 + cbor_signed_size(*round_trip_time);
+
+    if (response_processing_data)
+        size += 2 + cbor_field_size(response_processing_data->bailiwick_index) +
+                cbor_field_size(response_processing_data->processing_flags);
+
+    for (auto extended : {&query_extended, &response_extended}) {
+        if (*extended)
+            size += 2 + cbor_field_size((*extended)->question_index) + cbor_field_size((*extended)->answer_index) +
+                    cbor_field_size((*extended)->authority_index) + cbor_field_size((*extended)->additional_index);
+    }
+
+    return size;
+}
+
 void CDNS::QueryResponse::read(CdnsDecoder& dec)
 {
     reset();
@@ -1313,6 +1786,12 @@ std::size_t CDNS::AddressEventCount::write(CdnsEncoder& enc)
     return written;
 }
 
+std::size_t CDNS::AddressEventCount::estimated_size() const
+{
+    return 1 + 1 + cbor_int_size(static_cast<uint8_t>(ae_type)) + cbor_field_size(ae_code) + 1 +
+           cbor_int_size(ae_address_index) + cbor_field_size(ae_transport_flags) + 1 + cbor_int_size(ae_count);
+}
+
 void CDNS::AddressEventCount::read(CdnsDecoder& dec)
 {
     reset();
@@ -1427,6 +1906,12 @@ std::size_t CDNS::MalformedMessage::write(CdnsEncoder& enc, const Timestamp& ear
     return written;
 }
 
+std::size_t CDNS::MalformedMessage::estimated_size() const
+{
+    return 1 + (time_offset ? 1 + TIME_OFFSET_ESTIMATE : 0) + cbor_field_size(client_address_index) +
+           cbor_field_size(client_port) + cbor_field_size(message_data_index);
+}
+
 void CDNS::MalformedMessage::read(CdnsDecoder& dec)
 {
     reset();
@@ -1475,10 +1960,15 @@ std::size_t CDNS::StringItem::write(CdnsEncoder& enc)
     return enc.write_bytestring(data);
 }
 
+std::size_t CDNS::StringItem::estimated_size() const
+{
+    return cbor_int_size(data.size()) + data.size();
+}
+
 void CDNS::StringItem::read(CdnsDecoder& dec)
 {
     reset();
-    data = dec.read_bytestring();
+    dec.read_bytestring(data);
 }
 
 void CDNS::StringItem::reset()
@@ -1501,6 +1991,15 @@ std::size_t CDNS::IndexListItem::write(CdnsEncoder& enc)
     return written;
 }
 
+std::size_t CDNS::IndexListItem::estimated_size() const
+{
+    std::size_t size = cbor_int_size(list.size());
+    for (auto& index : list)
+        size += cbor_int_size(index);
+
+    return size;
+}
+
 void CDNS::IndexListItem::read(CdnsDecoder& dec)
 {
     reset();
@@ -1533,6 +2032,9 @@ std::string CDNS::CdnsBlock::string()
     if (m_block_statistics)
         ss << m_block_statistics.value().string();
 
+    if (m_block_summary)
+        ss << m_block_summary.value().string();
+
     ss << "IP address BlockTable items: " << std::to_string(m_ip_address.size()) << std::endl;
     ss << "ClassType BlockTable items: " << std::to_string(m_classtype.size()) << std::endl;
     ss << "NAME/RDATA BlockTable items: " << std::to_string(m_name_rdata.size()) << std::endl;
@@ -1651,8 +2153,9 @@ std::size_t CDNS::CdnsBlock::write(CdnsEncoder& enc)
                          + !!m_qr_sig.size() + !!m_qlist.size() + !!m_qrr.size() + !!m_rrlist.size()
                          + !!m_rr.size() + !!m_malformed_message_data.size();
 
-    std::size_t fields = 1 + !!m_block_statistics + !!blocktable_fields + !!m_query_responses.size()
-                         + !!m_address_event_counts.size() + !!m_malformed_messages.size();
+    std::size_t fields = 1 + m_write_summary + !!m_block_statistics + !!blocktable_fields
+                         + !!m_query_responses.size() + !!m_address_event_counts.size()
+                         + !!m_malformed_messages.size();
 
     // Start C-DNS Block
     written += enc.write_map_start(fields);
@@ -1661,6 +2164,30 @@ std::size_t CDNS::CdnsBlock::write(CdnsEncoder& enc)
     written += enc.write(get_map_index(CDNS::BlockMapIndex::block_preamble));
     written += m_block_preamble.write(enc);
 
+    if (!m_write_summary)
+        return written + write_body(enc, blocktable_fields);
+
+    // Encode the rest of the Block first, so the summary right after the preamble can tell readers
+    // how many bytes to skip
+    MemoryOutput body;
+    {
+        CdnsEncoder body_enc(body, CborOutputCompression::NO_COMPRESSION);
+        write_body(body_enc, blocktable_fields);
+    }
+
+    BlockSummary summary = get_summary();
+    summary.body_size = body.size();
+    written += enc.write(get_map_index(CDNS::BlockMapIndex::block_summary));
+    written += summary.write(enc);
+    written += enc.write_raw(body.data());
+
+    return written;
+}
+
+std::size_t CDNS::CdnsBlock::write_body(CdnsEncoder& enc, std::size_t blocktable_fields)
+{
+    std::size_t written = 0;
+
     // Write Block statistics
     if (m_block_statistics) {
         written += enc.write(get_map_index(CDNS::BlockMapIndex::block_statistics));
@@ -1705,6 +2232,110 @@ std::size_t CDNS::CdnsBlock::write(CdnsEncoder& enc)
     return written;
 }
 
+CDNS::BlockSummary CDNS::CdnsBlock::get_summary() const
+{
+    BlockSummary ret;
+    ret.qr_count = m_query_responses.size();
+    ret.aec_count = m_address_event_counts.size();
+    ret.mm_count = m_malformed_messages.size();
+
+    if (m_latest_time) {
+        ret.latest_time = *m_latest_time;
+    }
+    else {
+        // Blocks read from input don't track their newest item
+        ret.latest_time = m_block_preamble.earliest_time;
+        for (auto& qr : m_query_responses) {
+            if (qr.time_offset && ret.latest_time < *qr.time_offset)
+                ret.latest_time = *qr.time_offset;
+        }
+        for (auto& mm : m_malformed_messages) {
+            if (mm.time_offset && ret.latest_time < *mm.time_offset)
+                ret.latest_time = *mm.time_offset;
+        }
+    }
+
+    // Count items by Block table indexes first, so each address and signature is resolved only once
+    std::vector<bool> clients(m_ip_address.size(), false);
+    std::vector<uint64_t> signatures(m_qr_sig.size(), 0);
+    for (auto& qr : m_query_responses) {
+        if (qr.client_address_index && *qr.client_address_index < clients.size())
+            clients[*qr.client_address_index] = true;
+        if (qr.qr_signature_index && *qr.qr_signature_index < signatures.size())
+            signatures[*qr.qr_signature_index]++;
+    }
+
+    const std::string* min = nullptr;
+    const std::string* max = nullptr;
+    for (index_t i = 0; i < clients.size(); i++) {
+        if (!clients[i])
+            continue;
+
+        const std::string& address = m_ip_address[i].data;
+        if (!min || address < *min)
+            min = &address;
+        if (!max || *max < address)
+            max = &address;
+    }
+
+    if (min) {
+        ret.min_client_address = *min;
+        ret.max_client_address = *max;
+    }
+
+    for (index_t i = 0; i < signatures.size(); i++) {
+        if (signatures[i] && m_qr_sig[i].response_rcode)
+            ret.rcode_counts[*m_qr_sig[i].response_rcode] += signatures[i];
+    }
+
+    if (m_filter_bits) {
+        ret.filter = BloomFilter(m_ip_address.size() + m_name_rdata.size(), m_filter_bits);
+        for (index_t i = 0; i < m_ip_address.size(); i++)
+            ret.filter->add(BlockSummary::address_hash(m_ip_address[i].data));
+        for (index_t i = 0; i < m_name_rdata.size(); i++)
+            ret.filter->add(BlockSummary::name_hash(m_name_rdata[i].data));
+    }
+
+    return ret;
+}
+
+void CDNS::CdnsBlock::set_string_interners(StringInterner* ip_address, StringInterner* name_rdata)
+{
+    if ((ip_address && m_ip_address.size() > 0) || (name_rdata && m_name_rdata.size() > 0))
+        throw std::runtime_error("String interners can be set only to Block with empty string Block tables");
+
+    m_ip_intern.interner = ip_address;
+    m_name_intern.interner = name_rdata;
+    restart_interning();
+}
+
+void CDNS::CdnsBlock::restart_interning()
+{
+    m_ip_intern.epoch = m_ip_intern.interner ? m_ip_intern.interner->start_block() : 0;
+    m_name_intern.epoch = m_name_intern.interner ? m_name_intern.interner->start_block() : 0;
+}
+
+CDNS::index_t CDNS::CdnsBlock::add_interned(BlockTable<StringItem>& table, detail::InternerRef& ref,
+                                            const std::string& data, std::size_t hash)
+{
+    StringInterner::Entry* entry = ref.interner->intern(data, hash);
+    if (!entry)
+        return add_to_string_table(table, data, hash);
+
+    if (entry->epoch == ref.epoch) {
+        table.record_lookup(true);
+        return entry->index;
+    }
+
+    // The string isn't in the Block table yet. Strings are added to the table directly only after
+    // all entries of the interner are used by this Block, so such strings can't be interned later.
+    table.record_lookup(false);
+    m_estimated_size += entry->item.estimated_size();
+    index_t ret = table.add_value(entry->item);
+    ref.interner->set_index(*entry, ref.epoch, ret);
+    return ret;
+}
+
 CDNS::index_t CDNS::CdnsBlock::add_generic_qlist(const std::vector<GenericResourceRecord>& glist) {
     std::vector<index_t> qlist;
 
@@ -2034,8 +2665,12 @@ bool CDNS::CdnsBlock::add_question_response_record(const GenericQueryResponse& g
     /**
      * Add Query Response to the Block
      */
-    if (qr_filled)
+    if (qr_filled) {
+        m_estimated_size += qr.estimated_size();
         m_query_responses.push_back(qr);
+        if (gr.ts)
+            update_latest_time(*gr.ts);
+    }
 
     // Update block statistics
     if (stats)
@@ -2061,7 +2696,10 @@ bool CDNS::CdnsBlock::add_question_response_record(const QueryResponse& qr,
                             (qr.time_offset < m_block_preamble.earliest_time)))
         m_block_preamble.earliest_time = *qr.time_offset;
 
+    m_estimated_size += qr.estimated_size();
     m_query_responses.push_back(qr);
+    if (qr.time_offset)
+        update_latest_time(*qr.time_offset);
 
     if (stats)
         m_block_statistics = stats;
@@ -2100,10 +2738,13 @@ bool CDNS::CdnsBlock::add_address_event_count(const GenericAddressEventCount& ga
      * Count Address Event to the Block
      */
     auto found = m_address_event_counts.find(aec);
-    if (found != m_address_event_counts.end())
+    if (found != m_address_event_counts.end()) {
         found->second++;
-    else
+    }
+    else {
         m_address_event_counts[aec] = 1;
+        m_estimated_size += aec.estimated_size();
+    }
 
     // Update block statistics
     if (stats)
@@ -2120,10 +2761,13 @@ bool CDNS::CdnsBlock::add_address_event_count(const AddressEventCount& aec,
         return false;
 
     auto found = m_address_event_counts.find(aec);
-    if (found != m_address_event_counts.end())
+    if (found != m_address_event_counts.end()) {
         found->second++;
-    else
+    }
+    else {
         m_address_event_counts[aec] = 1;
+        m_estimated_size += aec.estimated_size();
+    }
 
     if (stats)
         m_block_statistics = stats;
@@ -2205,8 +2849,12 @@ bool CDNS::CdnsBlock::add_malformed_message(const GenericMalformedMessage& gmm,
     /**
      * Add Malformed Message to the Block
      */
-    if (mm_filled)
+    if (mm_filled) {
+        m_estimated_size += mm.estimated_size();
         m_malformed_messages.push_back(mm);
+        if (gmm.ts)
+            update_latest_time(*gmm.ts);
+    }
 
     // Update block statistics
     if (stats)
@@ -2229,7 +2877,10 @@ bool CDNS::CdnsBlock::add_malformed_message(const MalformedMessage& mm,
                             (mm.time_offset < m_block_preamble.earliest_time)))
         m_block_preamble.earliest_time = *mm.time_offset;
 
+    m_estimated_size += mm.estimated_size();
     m_malformed_messages.push_back(mm);
+    if (mm.time_offset)
+        update_latest_time(*mm.time_offset);
 
     if (stats)
         m_block_statistics = stats;
@@ -2237,6 +2888,33 @@ bool CDNS::CdnsBlock::add_malformed_message(const MalformedMessage& mm,
     return full() ? true : false;
 }
 
+CDNS::BlockTablesStats CDNS::CdnsBlock::get_tables_stats() const
+{
+    BlockTablesStats ret;
+    ret.ip_address = table_stats(m_ip_address);
+    ret.classtype = table_stats(m_classtype);
+    ret.name_rdata = table_stats(m_name_rdata);
+    ret.qr_sig = table_stats(m_qr_sig);
+    ret.qlist = table_stats(m_qlist);
+    ret.qrr = table_stats(m_qrr);
+    ret.rrlist = table_stats(m_rrlist);
+    ret.rr = table_stats(m_rr);
+    ret.malformed_message_data = table_stats(m_malformed_message_data);
+    return ret;
+}
+
+uint64_t CDNS::CdnsBlock::age(const Timestamp& ts) const
+{
+    const Timestamp& earliest = m_block_preamble.earliest_time;
+    if (ts <= earliest)
+        return 0;
+
+    uint64_t ticks_per_second = m_block_parameters.storage_parameters.ticks_per_second;
+    int64_t ticks = static_cast<int64_t>(ts.m_ticks) - static_cast<int64_t>(earliest.m_ticks);
+
+    return (ts.m_secs - earliest.m_secs) * ticks_per_second + ticks;
+}
+
 void CDNS::CdnsBlockRead::read_blocktables(CdnsDecoder& dec)
 {
     bool indef = false;
@@ -2251,65 +2929,47 @@ void CDNS::CdnsBlockRead::read_blocktables(CdnsDecoder& dec)
         switch (dec.read_integer()) {
             case get_map_index(BlockTablesMapIndex::ip_address):
                 dec.read_array([this](CdnsDecoder& dec){
-                    StringItem tmp;
-                    tmp.data = dec.read_bytestring();
-                    m_ip_address.add_value(std::move(tmp));
+                    dec.read_bytestring(m_ip_address.add_item().data);
                 });
                 break;
             case get_map_index(BlockTablesMapIndex::classtype):
                 dec.read_array([this](CdnsDecoder& dec){
-                    ClassType tmp;
-                    tmp.read(dec);
-                    m_classtype.add_value(std::move(tmp));
+                    m_classtype.add_item().read(dec);
                 });
                 break;
             case get_map_index(BlockTablesMapIndex::name_rdata):
                 dec.read_array([this](CdnsDecoder& dec){
-                    StringItem tmp;
-                    tmp.data = dec.read_bytestring();
-                    m_name_rdata.add_value(std::move(tmp));
+                    dec.read_bytestring(m_name_rdata.add_item().data);
                 });
                 break;
             case get_map_index(BlockTablesMapIndex::qr_sig):
                 dec.read_array([this](CdnsDecoder& dec){
-                    QueryResponseSignature tmp;
-                    tmp.read(dec);
-                    m_qr_sig.add_value(std::move(tmp));
+                    m_qr_sig.add_item().read(dec);
                 });
                 break;
             case get_map_index(BlockTablesMapIndex::qlist):
                 dec.read_array([this](CdnsDecoder& dec){
-                    IndexListItem tmp;
-                    tmp.read(dec);
-                    m_qlist.add_value(std::move(tmp));
+                    m_qlist.add_item().read(dec);
                 });
                 break;
             case get_map_index(BlockTablesMapIndex::qrr):
                 dec.read_array([this](CdnsDecoder& dec){
-                    Question tmp;
-                    tmp.read(dec);
-                    m_qrr.add_value(std::move(tmp));
+                    m_qrr.add_item().read(dec);
                 });
                 break;
             case get_map_index(BlockTablesMapIndex::rrlist):
                 dec.read_array([this](CdnsDecoder& dec){
-                    IndexListItem tmp;
-                    tmp.read(dec);
-                    m_rrlist.add_value(std::move(tmp));
+                    m_rrlist.add_item().read(dec);
                 });
                 break;
             case get_map_index(BlockTablesMapIndex::rr):
                 dec.read_array([this](CdnsDecoder& dec){
-                    RR tmp;
-                    tmp.read(dec);
-                    m_rr.add_value(std::move(tmp));
+                    m_rr.add_item().read(dec);
                 });
                 break;
             case get_map_index(BlockTablesMapIndex::malformed_message_data):
                 dec.read_array([this](CdnsDecoder& dec){
-                    MalformedMessageData tmp;
-                    tmp.read(dec);
-                    m_malformed_message_data.add_value(std::move(tmp));
+                    m_malformed_message_data.add_item().read(dec);
                 });
                 break;
             default:
@@ -2321,49 +2981,32 @@ void CDNS::CdnsBlockRead::read_blocktables(CdnsDecoder& dec)
     }
 }
 
-std::vector<CDNS::GenericResourceRecord> CDNS::CdnsBlockRead::fill_generic_q_list(std::vector<index_t>& list)
-{
-    std::vector<GenericResourceRecord> gq_list;
-    gq_list.reserve(list.size());
-
-    for (auto qi : list) {
-        GenericResourceRecord gq;
-        Question q = get_question(qi);
-        gq.name = get_name_rdata(q.name_index);
-        gq.classtype = get_classtype(q.classtype_index);
-        gq_list.push_back(gq);
-    }
-
-    return gq_list;
-}
-
-std::vector<CDNS::GenericResourceRecord> CDNS::CdnsBlockRead::fill_generic_rr_list(std::vector<index_t>& list)
+bool CDNS::CdnsBlockRead::read(RawBlock& raw, std::vector<BlockParameters>& block_parameters,
+                               const BlockSummaryFilter& filter)
 {
-    std::vector<GenericResourceRecord> grr_list;
-    grr_list.reserve(list.size());
-
-    for (auto rri : list) {
-        GenericResourceRecord grr;
-        RR rr = get_rr(rri);
-        grr.name = get_name_rdata(rr.name_index);
-        grr.classtype = get_classtype(rr.classtype_index);
-        grr.ttl = rr.ttl;
-        if (rr.rdata_index)
-            grr.rdata = get_name_rdata(*rr.rdata_index);
-
-        grr_list.push_back(std::move(grr));
+    // Encode the Block preamble back in front of the other fields, the rest is decoded from memory
+    MemoryOutput buffer;
+    {
+        CdnsEncoder enc(buffer, CborOutputCompression::NO_COMPRESSION);
+        raw.write(enc);
     }
 
-    return grr_list;
+    MemoryStreamBuf streambuf(buffer.data().data(), buffer.data().size());
+    std::istream input(&streambuf);
+    CdnsDecoder dec(input);
+    return read(dec, block_parameters, filter);
 }
 
-void CDNS::CdnsBlockRead::read(CdnsDecoder& dec, std::vector<BlockParameters>& block_parameters)
+bool CDNS::CdnsBlockRead::read(CdnsDecoder& dec, std::vector<BlockParameters>& block_parameters,
+                               const BlockSummaryFilter& filter)
 {
     if (block_parameters.empty())
         throw CdnsDecoderException("Given Block parameters array is empty!");
 
     clear();
     bool is_m_block_preamble = false;
+    bool is_body = false;
+    bool skip = false;
     bool indef = false;
     uint64_t length = dec.read_map_start(indef);
 
@@ -2373,6 +3016,19 @@ void CDNS::CdnsBlockRead::read(CdnsDecoder& dec, std::vector<BlockParameters>& b
             break;
         }
 
+        // Skip keys and values of the remaining fields of a Block rejected by the filter
+        if (skip) {
+            if (!indef && m_block_summary->body_size) {
+                dec.skip_bytes(*m_block_summary->body_size);
+                break;
+            }
+
+            dec.skip_item();
+            dec.skip_item();
+            length--;
+            continue;
+        }
+
         switch (dec.read_integer()) {
             case get_map_index(BlockMapIndex::block_preamble):
                 m_block_preamble.read(dec);
@@ -2388,30 +3044,46 @@ void CDNS::CdnsBlockRead::read(CdnsDecoder& dec, std::vector<BlockParameters>& b
                 m_block_statistics = BlockStatistics();
                 m_block_statistics->read(dec);
                 break;
-            case get_map_index(BlockMapIndex::block_tables):
+            case get_map_index(BlockMapIndex::block_summary):
+                m_block_summary = BlockSummary();
+                m_block_summary->read(dec);
+                skip = filter && is_m_block_preamble && !is_body &&
+                       !filter(m_block_preamble, *m_block_summary);
+                break;
+            case get_map_index(BlockMapIndex::block_tables): {
+                is_body = true;
+                ScopedTimer timer(m_read_stats.tables_ns, m_timing);
                 read_blocktables(dec);
                 break;
-            case get_map_index(BlockMapIndex::query_responses):
+            }
+            case get_map_index(BlockMapIndex::query_responses): {
+                is_body = true;
+                ScopedTimer timer(m_read_stats.items_ns, m_timing);
                 dec.read_array([this](CdnsDecoder& dec){
-                    QueryResponse tmp;
-                    tmp.read(dec);
-                    m_query_responses.push_back(std::move(tmp));
+                    m_query_responses.emplace_back();
+                    m_query_responses.back().read(dec);
                 });
                 break;
-            case get_map_index(BlockMapIndex::address_event_counts):
+            }
+            case get_map_index(BlockMapIndex::address_event_counts): {
+                is_body = true;
+                ScopedTimer timer(m_read_stats.items_ns, m_timing);
                 dec.read_array([this](CdnsDecoder& dec){
                     AddressEventCount tmp;
                     tmp.read(dec);
                     m_address_event_counts[tmp] = tmp.ae_count;
                 });
                 break;
-            case get_map_index(BlockMapIndex::malformed_messages):
+            }
+            case get_map_index(BlockMapIndex::malformed_messages): {
+                is_body = true;
+                ScopedTimer timer(m_read_stats.items_ns, m_timing);
                 dec.read_array([this](CdnsDecoder& dec){
-                    MalformedMessage tmp;
-                    tmp.read(dec);
-                    m_malformed_messages.push_back(std::move(tmp));
+                    m_malformed_messages.emplace_back();
+                    m_malformed_messages.back().read(dec);
                 });
                 break;
+            }
             default:
                 dec.skip_item();
                 break;
@@ -2426,6 +3098,10 @@ void CDNS::CdnsBlockRead::read(CdnsDecoder& dec, std::vector<BlockParameters>& b
     if (!m_block_preamble.block_parameters_index)
         m_block_parameters = block_parameters[0];
 
+    if (skip)
+        return false;
+
+    ScopedTimer timer(m_read_stats.fixup_ns, m_timing);
     for (auto& qr : m_query_responses) {
         if (qr.time_offset) {
             uint64_t offset = qr.time_offset->m_secs;
@@ -2445,10 +3121,13 @@ void CDNS::CdnsBlockRead::read(CdnsDecoder& dec, std::vector<BlockParameters>& b
     m_qr_read = 0;
     m_aec_read = m_address_event_counts.begin();
     m_mm_read = 0;
+    return true;
 }
 
 CDNS::GenericQueryResponse CDNS::CdnsBlockRead::read_generic_qr(bool& end)
 {
+    ScopedTimer timer(m_read_stats.materialize_ns, m_timing);
+
     // Check if there are unread query responses in this block
     if (m_qr_read >= m_query_responses.size()) {
         end = true;
@@ -2456,115 +3135,7 @@ CDNS::GenericQueryResponse CDNS::CdnsBlockRead::read_generic_qr(bool& end)
     }
 
     end = false;
-    GenericQueryResponse gqr;
-    QueryResponse& qr = m_query_responses[m_qr_read];
-
-    gqr.ts = qr.time_offset;
-
-    if (qr.client_address_index)
-        gqr.client_ip = get_ip_address(*qr.client_address_index);
-
-    gqr.client_port = qr.client_port;
-    gqr.transaction_id = qr.transaction_id;
-
-    // Get Query Response Signature if present
-    if (qr.qr_signature_index) {
-        QueryResponseSignature qrs = get_qr_signature(*qr.qr_signature_index);
-
-        if (qrs.server_address_index)
-            gqr.server_ip = get_ip_address(*qrs.server_address_index);
-
-        gqr.server_port = qrs.server_port;
-        gqr.qr_transport_flags = qrs.qr_transport_flags;
-        gqr.qr_type = qrs.qr_type;
-        gqr.qr_sig_flags = qrs.qr_sig_flags;
-        gqr.query_opcode = qrs.query_opcode;
-        gqr.qr_dns_flags = qrs.qr_dns_flags;
-        gqr.query_rcode = qrs.query_rcode;
-
-        if (qrs.query_classtype_index)
-            gqr.query_classtype = get_classtype(*qrs.query_classtype_index);
-
-        gqr.query_qdcount = qrs.query_qdcount;
-        gqr.query_ancount = qrs.query_ancount;
-        gqr.query_nscount = qrs.query_nscount;
-        gqr.query_arcount = qrs.query_arcount;
-        gqr.query_edns_version = qrs.query_edns_version;
-        gqr.query_udp_size = qrs.query_udp_size;
-
-        if (qrs.query_opt_rdata_index)
-            gqr.query_opt_rdata = get_name_rdata(*qrs.query_opt_rdata_index);
-
-        gqr.response_rcode = qrs.response_rcode;
-    }
-
-    gqr.client_hoplimit = qr.client_hoplimit;
-    gqr.response_delay = qr.response_delay;
-
-    if (qr.query_name_index)
-        gqr.query_name = get_name_rdata(*qr.query_name_index);
-
-    gqr.query_size = qr.query_size;
-    gqr.response_size = qr.response_size;
-
-    // Get Response Processing Data if present
-    if (qr.response_processing_data) {
-        if (qr.response_processing_data->bailiwick_index)
-            gqr.bailiwick = get_name_rdata(*qr.response_processing_data->bailiwick_index);
-
-        gqr.processing_flags = qr.response_processing_data->processing_flags;
-    }
-
-    // Get Query Extended if present
-    if (qr.query_extended) {
-        if (qr.query_extended->question_index) {
-            auto qlist = get_question_list(*qr.query_extended->question_index);
-            gqr.query_questions = fill_generic_q_list(qlist);
-        }
-
-        if (qr.query_extended->answer_index) {
-            auto rrlist = get_rr_list(*qr.query_extended->answer_index);
-            gqr.query_answers = fill_generic_rr_list(rrlist);
-        }
-
-        if (qr.query_extended->authority_index) {
-            auto rrlist = get_rr_list(*qr.query_extended->authority_index);
-            gqr.query_authority = fill_generic_rr_list(rrlist);
-        }
-
-        if (qr.query_extended->additional_index) {
-            auto rrlist = get_rr_list(*qr.query_extended->additional_index);
-            gqr.query_additional = fill_generic_rr_list(rrlist);
-        }
-    }
-
-    // Get Response Extended if present
-    if (qr.response_extended) {
-        if (qr.response_extended->question_index) {
-            auto qlist = get_question_list(*qr.response_extended->question_index);
-            gqr.response_questions = fill_generic_q_list(qlist);
-        }
-
-        if (qr.response_extended->answer_index) {
-            auto rrlist = get_rr_list(*qr.response_extended->answer_index);
-            gqr.response_answers = fill_generic_rr_list(rrlist);
-        }
-
-        if (qr.response_extended->authority_index) {
-            auto rrlist = get_rr_list(*qr.response_extended->authority_index);
-            gqr.response_authority = fill_generic_rr_list(rrlist);
-        }
-
-        if (qr.response_extended->additional_index) {
-            auto rrlist = get_rr_list(*qr.response_extended->additional_index);
-            gqr.response_additional = fill_generic_rr_list(rrlist);
-        }
-    }
-
-    // Get implementation specific fields
-    gqr.asn = qr.asn;
-    gqr.country_code = qr.country_code;
-    gqr.round_trip_time = qr.round_trip_time;
+    GenericQueryResponse gqr = QueryResponseView(*this, m_query_responses[m_qr_read]).to_generic();
 
     m_qr_read++;
     return gqr;
@@ -2572,6 +3143,8 @@ CDNS::GenericQueryResponse CDNS::CdnsBlockRead::read_generic_qr(bool& end)
 
 CDNS::GenericQueryResponse CDNS::CdnsBlockRead::read_generic_qr_light(bool& end)
 {
+    ScopedTimer timer(m_read_stats.materialize_ns, m_timing);
+
     // Check if there are unread query responses in this block
     if (m_qr_read >= m_query_responses.size()) {
         end = true;
@@ -2604,6 +3177,8 @@ CDNS::GenericQueryResponse CDNS::CdnsBlockRead::read_generic_qr_light(bool& end)
 
 CDNS::GenericAddressEventCount CDNS::CdnsBlockRead::read_generic_aec(bool& end)
 {
+    ScopedTimer timer(m_read_stats.materialize_ns, m_timing);
+
     // Check if there are unread address event counts in this block
     if (m_aec_read == m_address_event_counts.end()) {
         end = true;
@@ -2627,6 +3202,8 @@ CDNS::GenericAddressEventCount CDNS::CdnsBlockRead::read_generic_aec(bool& end)
 
 CDNS::GenericMalformedMessage CDNS::CdnsBlockRead::read_generic_mm(bool& end)
 {
+    ScopedTimer timer(m_read_stats.materialize_ns, m_timing);
+
     // Check if there are unread malformed messages in this block
     if (m_mm_read >= m_malformed_messages.size()) {
         end = true;
@@ -2659,3 +3236,254 @@ CDNS::GenericMalformedMessage CDNS::CdnsBlockRead::read_generic_mm(bool& end)
     m_mm_read++;
     return gmm;
 }
+
+void CDNS::CdnsBlockRead::read_qr_columns(QueryResponseColumns& columns, bool append)
+{
+    ScopedTimer timer(m_read_stats.materialize_ns, m_timing);
+    uint64_t ticks_per_second = m_block_parameters.storage_parameters.ticks_per_second;
+
+    if (!append || columns.size() == 0) {
+        columns.clear();
+        columns.ticks_per_second = ticks_per_second;
+    }
+    else if (columns.ticks_per_second != ticks_per_second) {
+        throw std::runtime_error("Can't append Block with different ticks per second to Query/Response columns");
+    }
+
+    index_t ip_base = static_cast<index_t>(columns.ip_address.size());
+    index_t name_base = static_cast<index_t>(columns.name_rdata.size());
+    columns.reserve(columns.size() + m_query_responses.size());
+    int64_t tps = static_cast<int64_t>(ticks_per_second);
+
+    for (auto& ip : m_ip_address)
+        columns.ip_address.push_back(ip.data);
+
+    for (auto& nrd : m_name_rdata)
+        columns.name_rdata.push_back(nrd.data);
+
+    for (auto& qr : m_query_responses) {
+        if (qr.time_offset)
+            columns.timestamp.push_back(static_cast<int64_t>(qr.time_offset->m_secs) * tps +
+                                        static_cast<int64_t>(qr.time_offset->m_ticks));
+        else
+            columns.timestamp.push_null();
+
+        push_index(columns.client_address, qr.client_address_index, m_ip_address.size(), "IP address", ip_base);
+        push_optional(columns.client_port, qr.client_port);
+        push_optional(columns.transaction_id, qr.transaction_id);
+        push_index(columns.qname, qr.query_name_index, m_name_rdata.size(), "Name_rdata", name_base);
+        push_optional(columns.response_delay, qr.response_delay);
+        push_optional(columns.query_size, qr.query_size);
+        push_optional(columns.response_size, qr.response_size);
+
+        // Fields stored in Query Response Signature
+        const QueryResponseSignature* qrs = nullptr;
+        if (qr.qr_signature_index) {
+            if (*qr.qr_signature_index >= m_qr_sig.size())
+                throw std::runtime_error("QueryResponseSignature block table index out of bounds");
+            qrs = &m_qr_sig[*qr.qr_signature_index];
+        }
+
+        if (!qrs) {
+            columns.server_address.push_null();
+            columns.server_port.push_null();
+            columns.transport_flags.push_null();
+            columns.qtype.push_null();
+            columns.qclass.push_null();
+            columns.rcode.push_null();
+            continue;
+        }
+
+        push_index(columns.server_address, qrs->server_address_index, m_ip_address.size(), "IP address", ip_base);
+        push_optional(columns.server_port, qrs->server_port);
+        push_optional(columns.transport_flags, qrs->qr_transport_flags);
+        push_optional(columns.rcode, qrs->response_rcode);
+
+        if (qrs->query_classtype_index) {
+            if (*qrs->query_classtype_index >= m_classtype.size())
+                throw std::runtime_error("Classtype block table index out of bounds");
+            const ClassType& ct = m_classtype[*qrs->query_classtype_index];
+            columns.qtype.push_back(ct.type);
+            columns.qclass.push_back(ct.class_);
+        }
+        else {
+            columns.qtype.push_null();
+            columns.qclass.push_null();
+        }
+    }
+}
+
+std::vector<CDNS::GenericResourceRecord>
+CDNS::QueryResponseView::questions(const boost::optional<QueryResponseExtended>& ext) const
+{
+    std::vector<GenericResourceRecord> gq_list;
+    if (!ext || !ext->question_index)
+        return gq_list;
+
+    auto& list = lookup(m_block.m_qlist, *ext->question_index, "QuestionList").list;
+    gq_list.reserve(list.size());
+
+    for (auto qi : list) {
+        GenericResourceRecord gq;
+        auto& q = lookup(m_block.m_qrr, qi, "Question");
+        gq.name = lookup(m_block.m_name_rdata, q.name_index, "Name_rdata").data;
+        gq.classtype = lookup(m_block.m_classtype, q.classtype_index, "Classtype");
+        gq_list.push_back(std::move(gq));
+    }
+
+    return gq_list;
+}
+
+std::vector<CDNS::GenericResourceRecord>
+CDNS::QueryResponseView::rrs(const boost::optional<QueryResponseExtended>& ext,
+                             boost::optional<index_t> QueryResponseExtended::* section) const
+{
+    std::vector<GenericResourceRecord> grr_list;
+    if (!ext || !((*ext).*section))
+        return grr_list;
+
+    auto& list = lookup(m_block.m_rrlist, *((*ext).*section), "RRlist").list;
+    grr_list.reserve(list.size());
+
+    for (auto rri : list) {
+        GenericResourceRecord grr;
+        auto& rr = lookup(m_block.m_rr, rri, "Resource record");
+        grr.name = lookup(m_block.m_name_rdata, rr.name_index, "Name_rdata").data;
+        grr.classtype = lookup(m_block.m_classtype, rr.classtype_index, "Classtype");
+        grr.ttl = rr.ttl;
+        if (rr.rdata_index)
+            grr.rdata = lookup(m_block.m_name_rdata, *rr.rdata_index, "Name_rdata").data;
+
+        grr_list.push_back(std::move(grr));
+    }
+
+    return grr_list;
+}
+
+std::vector<CDNS::GenericResourceRecord> CDNS::QueryResponseView::query_questions() const
+{
+    return questions(m_qr.query_extended);
+}
+
+std::vector<CDNS::GenericResourceRecord> CDNS::QueryResponseView::query_answers() const
+{
+    return rrs(m_qr.query_extended, &QueryResponseExtended::answer_index);
+}
+
+std::vector<CDNS::GenericResourceRecord> CDNS::QueryResponseView::query_authority() const
+{
+    return rrs(m_qr.query_extended, &QueryResponseExtended::authority_index);
+}
+
+std::vector<CDNS::GenericResourceRecord> CDNS::QueryResponseView::query_additional() const
+{
+    return rrs(m_qr.query_extended, &QueryResponseExtended::additional_index);
+}
+
+std::vector<CDNS::GenericResourceRecord> CDNS::QueryResponseView::response_questions() const
+{
+    return questions(m_qr.response_extended);
+}
+
+std::vector<CDNS::GenericResourceRecord> CDNS::QueryResponseView::response_answers() const
+{
+    return rrs(m_qr.response_extended, &QueryResponseExtended::answer_index);
+}
+
+std::vector<CDNS::GenericResourceRecord> CDNS::QueryResponseView::response_authority() const
+{
+    return rrs(m_qr.response_extended, &QueryResponseExtended::authority_index);
+}
+
+std::vector<CDNS::GenericResourceRecord> CDNS::QueryResponseView::response_additional() const
+{
+    return rrs(m_qr.response_extended, &QueryResponseExtended::additional_index);
+}
+
+CDNS::GenericQueryResponse CDNS::QueryResponseView::to_generic() const
+{
+    GenericQueryResponse gqr;
+
+    gqr.ts = m_qr.time_offset;
+    if (auto ip = client_ip())
+        gqr.client_ip = *ip;
+    gqr.client_port = m_qr.client_port;
+    gqr.transaction_id = m_qr.transaction_id;
+
+    // Get Query Response Signature if present
+    if (auto qrs = signature()) {
+        if (auto ip = server_ip())
+            gqr.server_ip = *ip;
+
+        gqr.server_port = qrs->server_port;
+        gqr.qr_transport_flags = qrs->qr_transport_flags;
+        gqr.qr_type = qrs->qr_type;
+        gqr.qr_sig_flags = qrs->qr_sig_flags;
+        gqr.query_opcode = qrs->query_opcode;
+        gqr.qr_dns_flags = qrs->qr_dns_flags;
+        gqr.query_rcode = qrs->query_rcode;
+
+        if (auto ct = query_classtype())
+            gqr.query_classtype = *ct;
+
+        gqr.query_qdcount = qrs->query_qdcount;
+        gqr.query_ancount = qrs->query_ancount;
+        gqr.query_nscount = qrs->query_nscount;
+        gqr.query_arcount = qrs->query_arcount;
+        gqr.query_edns_version = qrs->query_edns_version;
+        gqr.query_udp_size = qrs->query_udp_size;
+
+        if (auto opt = query_opt_rdata())
+            gqr.query_opt_rdata = *opt;
+
+        gqr.response_rcode = qrs->response_rcode;
+    }
+
+    gqr.client_hoplimit = m_qr.client_hoplimit;
+    gqr.response_delay = m_qr.response_delay;
+
+    if (auto name = query_name())
+        gqr.query_name = *name;
+
+    gqr.query_size = m_qr.query_size;
+    gqr.response_size = m_qr.response_size;
+
+    // Get Response Processing Data if present
+    if (m_qr.response_processing_data) {
+        if (auto bw = bailiwick())
+            gqr.bailiwick = *bw;
+
+        gqr.processing_flags = m_qr.response_processing_data->processing_flags;
+    }
+
+    // Get Query Extended if present
+    if (m_qr.query_extended) {
+        if (m_qr.query_extended->question_index)
+            gqr.query_questions = query_questions();
+        if (m_qr.query_extended->answer_index)
+            gqr.query_answers = query_answers();
+        if (m_qr.query_extended->authority_index)
+            gqr.query_authority = query_authority();
+        if (m_qr.query_extended->additional_index)
+            gqr.query_additional = query_additional();
+    }
+
+    // Get Response Extended if present
+    if (m_qr.response_extended) {
+        if (m_qr.response_extended->question_index)
+            gqr.response_questions = response_questions();
+        if (m_qr.response_extended->answer_index)
+            gqr.response_answers = response_answers();
+        if (m_qr.response_extended->authority_index)
+            gqr.response_authority = response_authority();
+        if (m_qr.response_extended->additional_index)
+            gqr.response_additional = response_additional();
+    }
+
+    // Get implementation specific fields
+    gqr.asn = m_qr.asn;
+    gqr.country_code = m_qr.country_code;
+    gqr.round_trip_time = m_qr.round_trip_time;
+
+    return gqr;
+}
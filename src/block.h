@@ -11,23 +11,87 @@
 #include <cstdint>
 #include <string>
 #include <unordered_map>
+#include <map>
+#include <functional>
 #include <deque>
 #include <vector>
+#include <utility>
+#include <stdexcept>
+#include <type_traits>
 #include <boost/optional.hpp>
 
 #include "format_specification.h"
 #include "block_table.h"
 #include "hash.h"
+#include "bloom_filter.h"
 #include "file_preamble.h"
 #include "timestamp.h"
 #include "cdns_encoder.h"
 #include "cdns_decoder.h"
+#include "stats.h"
+#include "columns.h"
 
 namespace CDNS {
     struct GenericResourceRecord;
     struct GenericQueryResponse;
     struct GenericAddressEventCount;
     struct GenericMalformedMessage;
+    class QueryResponseView;
+    class StringInterner;
+
+    namespace detail {
+        /**
+         * @brief Fixed-layout key built from Block table item's fields, used to hash and compare
+         * the items at once instead of field by field. Fields are packed to 64-bit words with
+         * shifts, so the key never contains uninitialized padding.
+         */
+        template<std::size_t N>
+        struct PackedKey {
+            bool operator==(const PackedKey& rhs) const {
+                for (std::size_t i = 0; i < N; i++) {
+                    if (words[i] != rhs.words[i])
+                        return false;
+                }
+                return true;
+            }
+
+            uint64_t words[N];
+        };
+
+        /**
+         * @brief Get value of optional field for packed key and set its presence bit if the field is present
+         * @param field Field to pack
+         * @param present Presence bits of the packed key
+         * @param bit Presence bit of the field
+         * @return Value of the field or 0 if the field is absent
+         */
+        template<typename T>
+        inline uint64_t pack_field(const boost::optional<T>& field, uint64_t& present, uint64_t bit) {
+            if (!field)
+                return 0;
+
+            present |= bit;
+            return static_cast<uint64_t>(*field);
+        }
+
+        /**
+         * @brief Reference from CdnsBlock to StringInterner of one of its string Block tables.
+         * Copies of the reference are empty, so copied or moved Blocks never share the interner's
+         * indexes with the original Block.
+         */
+        struct InternerRef {
+            InternerRef() : interner(nullptr), epoch(0) {}
+            InternerRef(const InternerRef&) : InternerRef() {}
+            InternerRef& operator=(const InternerRef&) {
+                interner = nullptr;
+                epoch = 0;
+                return *this;
+            }
+
+            StringInterner* interner; //!< Interner of the Block table or `nullptr`
+            uint64_t epoch; //!< Identifier of the Block in the interner
+        };
+    }
 
     /**
      * @brief Block table's ClassType structure
@@ -73,6 +137,12 @@ namespace CDNS {
          */
         std::size_t write(CdnsEncoder& enc);
 
+        /**
+         * @brief Estimate size of the ClassType's C-DNS CBOR representation
+         * @return Estimated number of uncompressed bytes written by write()
+         */
+        std::size_t estimated_size() const;
+
         /**
          * @brief Read the ClassType from C-DNS CBOR input stream
          * @param dec C-DNS decoder
@@ -100,19 +170,7 @@ namespace CDNS {
          * @return `true` if the items are equal
          */
         bool operator==(const QueryResponseSignature& rhs) const {
-            return (server_address_index == rhs.server_address_index) &&
-                   (server_port == rhs.server_port) &&
-                   (qr_transport_flags == rhs.qr_transport_flags) &&
-                   (qr_type == rhs.qr_type) && (qr_sig_flags == rhs.qr_sig_flags) &&
-                   (query_opcode == rhs.query_opcode) &&  (qr_dns_flags == rhs.qr_dns_flags) &&
-                   (query_rcode == rhs.query_rcode) &&
-                   (query_classtype_index == rhs.query_classtype_index) &&
-                   (query_qdcount == rhs.query_qdcount) && (query_ancount == rhs.query_ancount) &&
-                   (query_nscount == rhs.query_nscount) && (query_arcount == rhs.query_arcount) &&
-                   (query_edns_version == rhs.query_edns_version) &&
-                   (query_udp_size == rhs.query_udp_size) &&
-                   (query_opt_rdata_index == rhs.query_opt_rdata_index) &&
-                   (response_rcode == rhs.response_rcode);
+            return pack() == rhs.pack();
         }
 
         /**
@@ -137,43 +195,35 @@ namespace CDNS {
          * @return Hash value for "qrs"
          */
         friend std::size_t hash_value(const QueryResponseSignature& qrs) {
-            std::size_t hash = ~0U;
-            if (qrs.server_address_index)
-                hash = hash_value(qrs.server_address_index.value());
-            if (qrs.server_port)
-                hash = hash_value(qrs.server_port.value(), hash);
-            if (qrs.qr_transport_flags)
-                hash = hash_value(qrs.qr_transport_flags.value(), hash);
-            if (qrs.qr_type)
-                hash = hash_value(qrs.qr_type.value(), hash);
-            if (qrs.qr_sig_flags)
-                hash = hash_value(qrs.qr_sig_flags.value(), hash);
-            if (qrs.query_opcode)
-                hash = hash_value(qrs.query_opcode.value(), hash);
-            if (qrs.qr_dns_flags)
-                hash = hash_value(qrs.qr_dns_flags.value(), hash);
-            if (qrs.query_rcode)
-                hash = hash_value(qrs.query_rcode.value(), hash);
-            if (qrs.query_classtype_index)
-                hash = hash_value(qrs.query_classtype_index.value(), hash);
-            if (qrs.query_qdcount)
-                hash = hash_value(qrs.query_qdcount.value(), hash);
-            if (qrs.query_ancount)
-                hash = hash_value(qrs.query_ancount.value(), hash);
-            if (qrs.query_nscount)
-                hash = hash_value(qrs.query_nscount.value(), hash);
-            if (qrs.query_arcount)
-                hash = hash_value(qrs.query_arcount.value(), hash);
-            if (qrs.query_edns_version)
-                hash = hash_value(qrs.query_edns_version.value(), hash);
-            if (qrs.query_udp_size)
-                hash = hash_value(qrs.query_udp_size.value(), hash);
-            if (qrs.query_opt_rdata_index)
-                hash = hash_value(qrs.query_opt_rdata_index.value(), hash);
-            if (qrs.response_rcode)
-                hash = hash_value(qrs.response_rcode.value(), hash);
-
-            return hash;
+            return hash_value(qrs.pack());
+        }
+
+        /**
+         * @brief Create fixed-layout key of the signature. Absent fields are zero and their presence
+         * is stored in the lowest 17 bits of the last word (in order of the fields in QueryResponseSignature).
+         */
+        detail::PackedKey<5> pack() const {
+            uint64_t present = 0;
+            detail::PackedKey<5> ret;
+            ret.words[0] = (detail::pack_field(server_address_index, present, 1u << 0) << 32) |
+                           detail::pack_field(query_classtype_index, present, 1u << 8);
+            ret.words[1] = (detail::pack_field(query_opt_rdata_index, present, 1u << 15) << 32) |
+                           detail::pack_field(query_ancount, present, 1u << 10);
+            ret.words[2] = (detail::pack_field(server_port, present, 1u << 1) << 48) |
+                           (detail::pack_field(qr_dns_flags, present, 1u << 6) << 32) |
+                           (detail::pack_field(query_rcode, present, 1u << 7) << 16) |
+                           detail::pack_field(query_qdcount, present, 1u << 9);
+            ret.words[3] = (detail::pack_field(query_nscount, present, 1u << 11) << 48) |
+                           (detail::pack_field(query_arcount, present, 1u << 12) << 32) |
+                           (detail::pack_field(query_udp_size, present, 1u << 14) << 16) |
+                           detail::pack_field(response_rcode, present, 1u << 16);
+            ret.words[4] = (detail::pack_field(qr_transport_flags, present, 1u << 2) << 56) |
+                           (detail::pack_field(qr_type, present, 1u << 3) << 48) |
+                           (detail::pack_field(qr_sig_flags, present, 1u << 4) << 40) |
+                           (detail::pack_field(query_opcode, present, 1u << 5) << 32) |
+                           (detail::pack_field(query_edns_version, present, 1u << 13) << 24);
+            ret.words[4] |= present;
+            return ret;
         }
 
         /**
@@ -189,6 +239,12 @@ namespace CDNS {
          */
         std::size_t write(CdnsEncoder& enc);
 
+        /**
+         * @brief Estimate size of the Query Response Signature's C-DNS CBOR representation
+         * @return Estimated number of uncompressed bytes written by write()
+         */
+        std::size_t estimated_size() const;
+
         /**
          * @brief Read the QueryResponseSignature from C-DNS CBOR input stream
          * @param dec C-DNS decoder
@@ -232,7 +288,7 @@ namespace CDNS {
          * @return `true` if the items are equal
          */
         bool operator==(const Question& rhs) const {
-            return (name_index == rhs.name_index) && (classtype_index == rhs.classtype_index);
+            return pack() == rhs.pack();
         }
 
         /**
@@ -251,6 +307,22 @@ namespace CDNS {
             return *this;
         }
 
+        /**
+         * @brief Calculate hash for Question
+         * @param q Data to calculate hash on
+         * @return Hash value for "q"
+         */
+        friend std::size_t hash_value(const Question& q) {
+            return hash_value(q.pack());
+        }
+
+        /**
+         * @brief Create fixed-layout representation of the Question (both indexes in one integer)
+         */
+        uint64_t pack() const {
+            return (static_cast<uint64_t>(name_index) << 32) | classtype_index;
+        }
+
         /**
          * @brief Creates string representation of Question
          * @return String representation of Question
@@ -264,6 +336,12 @@ namespace CDNS {
          */
         std::size_t write(CdnsEncoder& enc);
 
+        /**
+         * @brief Estimate size of the Question's C-DNS CBOR representation
+         * @return Estimated number of uncompressed bytes written by write()
+         */
+        std::size_t estimated_size() const;
+
         /**
          * @brief Read the Question from C-DNS CBOR input stream
          * @param dec C-DNS decoder
@@ -292,8 +370,7 @@ namespace CDNS {
          * @return `true` if the items are equal
          */
         bool operator==(const RR& rhs) const {
-            return (name_index == rhs.name_index) && (classtype_index == rhs.classtype_index) &&
-                   (ttl == rhs.ttl) && (rdata_index == rhs.rdata_index);
+            return pack() == rhs.pack();
         }
 
         /**
@@ -311,14 +388,21 @@ namespace CDNS {
          * @return Hash value for "rr"
          */
         friend std::size_t hash_value(const RR& rr) {
-            std::size_t hash = hash_value(rr.name_index);
-            hash = hash_value(rr.classtype_index, hash);
-            if (rr.ttl)
-                hash = hash_value(rr.ttl.value(), hash);
-            if (rr.rdata_index)
-                hash = hash_value(rr.rdata_index.value(), hash);
+            return hash_value(rr.pack());
+        }
 
-            return hash;
+        /**
+         * @brief Create fixed-layout key of the RR. Absent fields are zero and their presence
+         * is stored in the last word.
+         */
+        detail::PackedKey<3> pack() const {
+            uint64_t present = 0;
+            detail::PackedKey<3> ret;
+            ret.words[0] = (static_cast<uint64_t>(name_index) << 32) | classtype_index;
+            ret.words[1] = (detail::pack_field(ttl, present, 1u << 0) << 32) |
+                           detail::pack_field(rdata_index, present, 1u << 1);
+            ret.words[2] = present;
+            return ret;
         }
 
         /**
@@ -341,6 +425,12 @@ namespace CDNS {
          */
         std::size_t write(CdnsEncoder& enc);
 
+        /**
+         * @brief Estimate size of the RR's C-DNS CBOR representation
+         * @return Estimated number of uncompressed bytes written by write()
+         */
+        std::size_t estimated_size() const;
+
         /**
          * @brief Read the RR from C-DNS CBOR input stream
          * @param dec C-DNS decoder
@@ -424,6 +514,12 @@ namespace CDNS {
          */
         std::size_t write(CdnsEncoder& enc);
 
+        /**
+         * @brief Estimate size of the Malformed Message Data's C-DNS CBOR representation
+         * @return Estimated number of uncompressed bytes written by write()
+         */
+        std::size_t estimated_size() const;
+
         /**
          * @brief Read the MalformedMessageData from C-DNS CBOR input stream
          * @param dec C-DNS decoder
@@ -582,6 +678,154 @@ namespace CDNS {
         boost::optional<unsigned> malformed_items;
     };
 
+    /**
+     * @brief Implementation-private summary of C-DNS Block
+     *
+     * Written right after the Block preamble (under a private-use Block map key), so readers can
+     * decide whether they need the Block before decoding its tables and items, and skip the rest
+     * of the Block by its encoded size. Other implementations ignore it as an unknown map key.
+     */
+    struct BlockSummary {
+        static constexpr uint64_t NAME_SEED = 0; //!< Seed of hashes of NAMEs/RDATAs in the filter
+        static constexpr uint64_t ADDRESS_SEED = 1; //!< Seed of hashes of IP addresses in the filter
+
+        BlockSummary() : latest_time(), qr_count(0), aec_count(0), mm_count(0), min_client_address(),
+                         max_client_address(), rcode_counts(), body_size(), filter() {}
+
+        /**
+         * @brief Creates string representation of Block Summary
+         * @return String representation of Block Summary
+         */
+        std::string string();
+
+        /**
+         * @brief Serialize the BlockSummary to C-DNS CBOR representation
+         * @param enc C-DNS encoder
+         * @return Number of uncompressed bytes written
+         */
+        std::size_t write(CdnsEncoder& enc);
+
+        /**
+         * @brief Read the BlockSummary from C-DNS CBOR input stream
+         * @param dec C-DNS decoder
+         */
+        void read(CdnsDecoder& dec);
+
+        /**
+         * @brief Reset BlockSummary to default values.
+         * Is applied in every call of read() method.
+         */
+        void reset();
+
+        /**
+         * @brief Check if the Block can contain items from given time range
+         * @param earliest Earliest time of the Block from its Block preamble
+         * @param from Start of the time range (inclusive)
+         * @param to End of the time range (inclusive)
+         * @return `false` if all items of the Block are outside of the time range
+         */
+        bool overlaps(const Timestamp& earliest, const Timestamp& from, const Timestamp& to) const {
+            return earliest <= to && from <= latest_time;
+        }
+
+        /**
+         * @brief Check if the Block contains Query/Response item with given response RCODE
+         * @param rcode Response RCODE
+         */
+        bool has_rcode(uint16_t rcode) const {
+            return rcode_counts.find(rcode) != rcode_counts.end();
+        }
+
+        /**
+         * @brief Calculate hash of NAME or RDATA for the filter. ASCII letters are compared
+         * case-insensitively.
+         * @param name NAME (in uncompressed wire format, as stored in the Block table) or RDATA
+         */
+        static uint64_t name_hash(const std::string& name);
+
+        /**
+         * @brief Calculate hash of IP address for the filter
+         * @param address IP address as stored in the Block table (4 or 16 bytes unless shortened
+         * by client or server address prefix length in Block parameters)
+         */
+        static uint64_t address_hash(const std::string& address) {
+            return stable_hash(address.data(), address.size(), ADDRESS_SEED);
+        }
+
+        /**
+         * @brief Check if the Block may contain NAME/RDATA or IP address in its Block tables
+         * @param hash Hash of the NAME/RDATA calculated by name_hash() or of the IP address calculated
+         * by address_hash()
+         * @return `false` if the filter proves the Block doesn't contain the string, `true` otherwise
+         * (also if the summary has no filter)
+         */
+        bool may_contain(uint64_t hash) const {
+            return !filter || filter->may_contain(hash);
+        }
+
+        Timestamp latest_time; //!< Time of the newest item in the Block
+        uint64_t qr_count; //!< Number of Query/Response items
+        uint64_t aec_count; //!< Number of Address event count items
+        uint64_t mm_count; //!< Number of Malformed message items
+        boost::optional<std::string> min_client_address; //!< Lowest client address (compared as byte strings)
+        boost::optional<std::string> max_client_address; //!< Highest client address (compared as byte strings)
+        std::map<uint16_t, uint64_t> rcode_counts; //!< Number of Query/Response items for each response RCODE
+        boost::optional<uint64_t> body_size; //!< Encoded size of the Block map fields following the summary in bytes
+        boost::optional<BloomFilter> filter; //!< Bloom filter over NAME/RDATA and IP address Block tables
+    };
+
+    /**
+     * @brief Decides from Block preamble and BlockSummary whether a Block read from input is needed.
+     * Returns `false` to skip the rest of the Block without decoding it.
+     */
+    using BlockSummaryFilter = std::function<bool(const BlockPreamble&, const BlockSummary&)>;
+
+    /**
+     * @brief C-DNS Block with decoded Block preamble and all other fields kept as encoded CBOR
+     *
+     * Used to copy Blocks between C-DNS files without decoding and re-encoding their tables and
+     * items, e.g. when merging files. Only the Block preamble can be modified before writing
+     * the Block (usually to point it to different Block parameters in the output file).
+     */
+    struct RawBlock {
+        RawBlock() : preamble(), summary(), fields(0), data() {}
+
+        /**
+         * @brief Serialize the RawBlock to C-DNS CBOR representation
+         * @param enc C-DNS encoder
+         * @return Number of uncompressed bytes written
+         */
+        std::size_t write(CdnsEncoder& enc);
+
+        /**
+         * @brief Read the RawBlock from C-DNS CBOR input stream
+         *
+         * BlockSummary right after the Block preamble (see CdnsBlock::set_write_summary()) is decoded
+         * to `summary` and kept in `data` too. If the summary has the size of the rest of the Block,
+         * the rest is copied as a whole without walking through its CBOR items.
+         * If the filter rejects the summary, the rest of the Block is skipped and `data` is left empty.
+         *
+         * @param dec C-DNS decoder
+         * @param filter Optional filter of Blocks by their summary
+         * @throw CdnsDecoderException if the Block doesn't contain Block preamble
+         * @return `false` if the Block was skipped by the filter, `true` otherwise
+         */
+        bool read(CdnsDecoder& dec, const BlockSummaryFilter& filter = BlockSummaryFilter());
+
+        /**
+         * @brief Get Block parameters index of the Block (Block parameters at index 0 are used
+         * if the Block preamble doesn't contain the index)
+         */
+        index_t get_block_parameters_index() const {
+            return preamble.block_parameters_index ? *preamble.block_parameters_index : 0;
+        }
+
+        BlockPreamble preamble;
+        boost::optional<BlockSummary> summary; //!< Block summary if the Block has one (it's also part of `data`)
+        uint64_t fields; //!< Number of Block map fields (map keys and values) stored in `data`
+        std::string data; //!< Encoded CBOR of all Block map fields except the Block preamble
+    };
+
     /**
      * @brief QueryResponse item structure
      */
@@ -601,6 +845,12 @@ namespace CDNS {
          */
         std::size_t write(CdnsEncoder& enc, const Timestamp& earliest, const uint64_t& ticks_per_second);
 
+        /**
+         * @brief Estimate size of the QueryResponse's C-DNS CBOR representation
+         * @return Estimated number of uncompressed bytes written by write()
+         */
+        std::size_t estimated_size() const;
+
         /**
          * @brief Read the QueryResponse from C-DNS CBOR input stream
          * @param dec C-DNS decoder
@@ -643,10 +893,7 @@ namespace CDNS {
          * @return `true` if the items are equal
          */
         bool operator==(const AddressEventCount& rhs) const {
-            return (ae_type == rhs.ae_type) && (ae_code == rhs.ae_code) &&
-                   (ae_transport_flags == rhs.ae_transport_flags) &&
-                   (ae_address_index == rhs.ae_address_index) &&
-                   (ae_count == rhs.ae_count);
+            return (pack() == rhs.pack()) && (ae_count == rhs.ae_count);
         }
 
         /**
@@ -671,16 +918,19 @@ namespace CDNS {
          * @return Hash value for "aec"
          */
         friend std::size_t hash_value(const AddressEventCount& aec) {
-            std::size_t hash = hash_value(aec.ae_type);
-            if (aec.ae_code)
-                hash = hash_value(aec.ae_code.value(), hash);
-
-            hash = hash_value(aec.ae_address_index, hash);
-
-            if (aec.ae_transport_flags)
-                hash = hash_value(aec.ae_transport_flags.value(), hash);
+            return hash_value(aec.pack());
+        }
 
-            return hash;
+        /**
+         * @brief Create fixed-layout representation of the Address event (without its count) in one
+         * integer: address index, type, code, transport flags and presence bits of the optional fields
+         */
+        uint64_t pack() const {
+            uint64_t present = 0;
+            uint64_t code = detail::pack_field(ae_code, present, 1u << 0);
+            uint64_t flags = detail::pack_field(ae_transport_flags, present, 1u << 1);
+            return (static_cast<uint64_t>(ae_address_index) << 32) | (static_cast<uint64_t>(ae_type) << 24) |
+                   (code << 16) | (flags << 8) | present;
         }
 
         /**
@@ -696,6 +946,12 @@ namespace CDNS {
          */
         std::size_t write(CdnsEncoder& enc);
 
+        /**
+         * @brief Estimate size of the AddressEventCount's C-DNS CBOR representation
+         * @return Estimated number of uncompressed bytes written by write()
+         */
+        std::size_t estimated_size() const;
+
         /**
          * @brief Read the AddressEventCount from C-DNS CBOR input stream
          * @param dec C-DNS decoder
@@ -734,6 +990,12 @@ namespace CDNS {
          */
         std::size_t write(CdnsEncoder& enc, const Timestamp& earliest, const uint64_t& ticks_per_second);
 
+        /**
+         * @brief Estimate size of the Malformed Message's C-DNS CBOR representation
+         * @return Estimated number of uncompressed bytes written by write()
+         */
+        std::size_t estimated_size() const;
+
         /**
          * @brief Read the MalformedMessage from C-DNS CBOR input stream
          * @param dec C-DNS decoder
@@ -800,6 +1062,12 @@ namespace CDNS {
          */
         std::size_t write(CdnsEncoder& enc);
 
+        /**
+         * @brief Estimate size of the StringItem's C-DNS CBOR representation
+         * @return Estimated number of uncompressed bytes written by write()
+         */
+        std::size_t estimated_size() const;
+
         /**
          * @brief Read the StringItem from C-DNS CBOR input stream
          * @param dec C-DNS decoder
@@ -863,6 +1131,12 @@ namespace CDNS {
          */
         std::size_t write(CdnsEncoder& enc);
 
+        /**
+         * @brief Estimate size of the IndexListItem's C-DNS CBOR representation
+         * @return Estimated number of uncompressed bytes written by write()
+         */
+        std::size_t estimated_size() const;
+
         /**
          * @brief Read the IndexListItem from C-DNS CBOR input stream
          * @param dec C-DNS decoder
@@ -887,14 +1161,19 @@ namespace CDNS {
         /**
          * @brief Default CdnsBlock constructor. Uses BlockParameters initialized with default values.
          */
-        CdnsBlock() : m_block_preamble(), m_block_parameters() {}
+        CdnsBlock() : m_block_preamble(), m_block_parameters(), m_estimated_size(0), m_latest_time(),
+                      m_max_block_size(0), m_max_block_age(0), m_write_summary(false),
+                      m_filter_bits(0) {}
 
         /**
          * @brief Construct a new CdnsBlock object
          * @param bp Block parameters for this block
          * @param bp_index Index of the given Block parameters in corresponding File preamble
          */
-        CdnsBlock(BlockParameters& bp, index_t bp_index) : m_block_parameters(bp) {
+        CdnsBlock(BlockParameters& bp, index_t bp_index) : m_block_parameters(bp), m_estimated_size(0),
+                                                           m_latest_time(), m_max_block_size(0),
+                                                           m_max_block_age(0), m_write_summary(false),
+                                                           m_filter_bits(0) {
             m_block_preamble.block_parameters_index = bp_index;
         }
 
@@ -906,47 +1185,74 @@ namespace CDNS {
         /**
          * @brief Copy constructor
          */
-        CdnsBlock(CdnsBlock& copy) {
-            *this = copy;
-        }
-
-        /**
-         * @brief Move constructor
-         */
-        CdnsBlock(CdnsBlock&& copy) {
-            *this = copy;
+        CdnsBlock(const CdnsBlock& copy) = default;
+
+        /**
+         * @brief Move constructor. Moves all Block tables and item arrays in constant time,
+         * the moved-from Block is left empty.
+         */
+        CdnsBlock(CdnsBlock&& other)
+            : m_block_preamble(std::move(other.m_block_preamble)),
+              m_block_statistics(std::move(other.m_block_statistics)),
+              m_block_summary(std::move(other.m_block_summary)),
+              m_ip_address(std::move(other.m_ip_address)),
+              m_classtype(std::move(other.m_classtype)),
+              m_name_rdata(std::move(other.m_name_rdata)),
+              m_qr_sig(std::move(other.m_qr_sig)),
+              m_qlist(std::move(other.m_qlist)),
+              m_qrr(std::move(other.m_qrr)),
+              m_rrlist(std::move(other.m_rrlist)),
+              m_rr(std::move(other.m_rr)),
+              m_malformed_message_data(std::move(other.m_malformed_message_data)),
+              m_query_responses(std::move(other.m_query_responses)),
+              m_address_event_counts(std::move(other.m_address_event_counts)),
+              m_malformed_messages(std::move(other.m_malformed_messages)),
+              m_block_parameters(other.m_block_parameters),
+              m_estimated_size(other.m_estimated_size),
+              m_latest_time(other.m_latest_time),
+              m_max_block_size(other.m_max_block_size),
+              m_max_block_age(other.m_max_block_age),
+              m_write_summary(other.m_write_summary),
+              m_filter_bits(other.m_filter_bits) {
+            other.clear();
         }
 
         /**
          * @brief Assignment operator
          */
-        CdnsBlock& operator=(CdnsBlock& rhs) {
-            if (this != &rhs) {
-                this->m_block_preamble = rhs.m_block_preamble;
-                this->m_block_statistics = rhs.m_block_statistics;
-                this->m_ip_address = rhs.m_ip_address;
-                this->m_classtype = rhs.m_classtype;
-                this->m_name_rdata = rhs.m_name_rdata;
-                this->m_qr_sig = rhs.m_qr_sig;
-                this->m_qlist = rhs.m_qlist;
-                this->m_qrr = rhs.m_qrr;
-                this->m_rrlist = rhs.m_rrlist;
-                this->m_rr = rhs.m_rr;
-                this->m_malformed_message_data = rhs.m_malformed_message_data;
-                this->m_query_responses = rhs.m_query_responses;
-                this->m_address_event_counts = rhs.m_address_event_counts;
-                this->m_malformed_messages = rhs.m_malformed_messages;
-                this->m_block_parameters = rhs.m_block_parameters;
-            }
-            return *this;
-        }
+        CdnsBlock& operator=(const CdnsBlock& rhs) = default;
 
         /**
-         * @brief Move assignment operator
+         * @brief Move assignment operator. Moves all Block tables and item arrays in constant time,
+         * the moved-from Block is left empty.
          */
         CdnsBlock& operator=(CdnsBlock&& rhs) {
             if (this != &rhs) {
-                *this = rhs;
+                m_block_preamble = std::move(rhs.m_block_preamble);
+                m_block_statistics = std::move(rhs.m_block_statistics);
+                m_block_summary = std::move(rhs.m_block_summary);
+                m_ip_address = std::move(rhs.m_ip_address);
+                m_classtype = std::move(rhs.m_classtype);
+                m_name_rdata = std::move(rhs.m_name_rdata);
+                m_qr_sig = std::move(rhs.m_qr_sig);
+                m_qlist = std::move(rhs.m_qlist);
+                m_qrr = std::move(rhs.m_qrr);
+                m_rrlist = std::move(rhs.m_rrlist);
+                m_rr = std::move(rhs.m_rr);
+                m_malformed_message_data = std::move(rhs.m_malformed_message_data);
+                m_query_responses = std::move(rhs.m_query_responses);
+                m_address_event_counts = std::move(rhs.m_address_event_counts);
+                m_malformed_messages = std::move(rhs.m_malformed_messages);
+                m_block_parameters = rhs.m_block_parameters;
+                m_estimated_size = rhs.m_estimated_size;
+                m_latest_time = rhs.m_latest_time;
+                m_max_block_size = rhs.m_max_block_size;
+                m_max_block_age = rhs.m_max_block_age;
+                m_write_summary = rhs.m_write_summary;
+                m_filter_bits = rhs.m_filter_bits;
+                m_ip_intern = detail::InternerRef();
+                m_name_intern = detail::InternerRef();
+                rhs.clear();
             }
             return *this;
         }
@@ -975,21 +1281,49 @@ namespace CDNS {
                 return 0;
         }
 
+        /**
+         * @brief Add IP addresses and NAMEs/RDATAs to Block tables through given interners shared with
+         * other Blocks. Only one Block at a time can use the interners. Block tables of the Block have
+         * to be empty (e.g. right after clear()), the interners are used until the Block is moved,
+         * copied or detached by calling this method with `nullptr` arguments.
+         * @param ip_address Interner of IP addresses or `nullptr`
+         * @param name_rdata Interner of NAMEs and RDATAs or `nullptr`
+         * @throw std::runtime_error if string Block tables of the Block aren't empty
+         */
+        void set_string_interners(StringInterner* ip_address, StringInterner* name_rdata);
+
+        /**
+         * @brief Calculate hash of IP address or NAME/RDATA for add_ip_address() and add_name_rdata().
+         * The hash doesn't depend on the Block, so callers adding the same string repeatedly (e.g.
+         * tracking flows or QNAMEs) can calculate it once and reuse it for every Block. It changes
+         * only when the hash backend is switched by set_hash_backend().
+         * @param data IP address or NAME/RDATA
+         * @return Hash of the string, equal to the hash of StringItem with the same data
+         */
+        static std::size_t string_hash(const std::string& data) {
+            return CDNS::hash_value(data.data(), data.size());
+        }
+
         /**
          * @brief Add IP address to IP address Block table
          * @param address IP address to add to the Block table
          * @return Index of the IP address in Block table
          */
         index_t add_ip_address(const std::string& address) {
-            index_t ret;
+            return add_ip_address(address, string_hash(address));
+        }
 
-            if (!m_ip_address.find(reinterpret_cast<const StringItem&>(address), ret)) {
-                StringItem tmp;
-                tmp.data = address;
-                ret = m_ip_address.add_value(std::move(tmp));
-            }
+        /**
+         * @brief Add IP address to IP address Block table using its precomputed hash
+         * @param address IP address to add to the Block table
+         * @param hash Hash of the IP address calculated by string_hash()
+         * @return Index of the IP address in Block table
+         */
+        index_t add_ip_address(const std::string& address, std::size_t hash) {
+            if (m_ip_intern.interner)
+                return add_interned(m_ip_address, m_ip_intern, address, hash);
 
-            return ret;
+            return add_to_string_table(m_ip_address, address, hash);
         }
 
         /**
@@ -1011,7 +1345,7 @@ namespace CDNS {
          * @return Index of the Classtype in Block table
          */
         index_t add_classtype(const ClassType& classtype) {
-            return m_classtype.add(classtype);
+            return add_to_table(m_classtype, classtype);
         }
 
         /**
@@ -1033,15 +1367,20 @@ namespace CDNS {
          * @return Index of the NAME or RDATA in Block table
          */
         index_t add_name_rdata(const std::string& nrd) {
-            index_t ret;
+            return add_name_rdata(nrd, string_hash(nrd));
+        }
 
-            if (!m_name_rdata.find(reinterpret_cast<const StringItem&>(nrd), ret)) {
-                StringItem tmp;
-                tmp.data = nrd;
-                ret = m_name_rdata.add_value(std::move(tmp));
-            }
+        /**
+         * @brief Add NAME or RDATA to name_rdata Block table using its precomputed hash
+         * @param nrd NAME or RDATA to add to the Block table
+         * @param hash Hash of the NAME or RDATA calculated by string_hash()
+         * @return Index of the NAME or RDATA in Block table
+         */
+        index_t add_name_rdata(const std::string& nrd, std::size_t hash) {
+            if (m_name_intern.interner)
+                return add_interned(m_name_rdata, m_name_intern, nrd, hash);
 
-            return ret;
+            return add_to_string_table(m_name_rdata, nrd, hash);
         }
 
         /**
@@ -1063,7 +1402,7 @@ namespace CDNS {
          * @return Index of the Query Response Signature in Block table
          */
         index_t add_qr_signature(const QueryResponseSignature& qr_sig) {
-            return m_qr_sig.add(qr_sig);
+            return add_to_table(m_qr_sig, qr_sig);
         }
 
         /**
@@ -1090,6 +1429,7 @@ namespace CDNS {
             if (!m_qlist.find(reinterpret_cast<const IndexListItem&>(qlist), ret)) {
                 IndexListItem tmp;
                 tmp.list = qlist;
+                m_estimated_size += tmp.estimated_size();
                 ret = m_qlist.add_value(std::move(tmp));
             }
 
@@ -1115,7 +1455,7 @@ namespace CDNS {
          * @return Index of the Question record in Block table
          */
         index_t add_question(const Question& qrr) {
-            return m_qrr.add(qrr);
+            return add_to_table(m_qrr, qrr);
         }
 
         /**
@@ -1142,6 +1482,7 @@ namespace CDNS {
             if (!m_rrlist.find(reinterpret_cast<const IndexListItem&>(rrlist), ret)) {
                 IndexListItem tmp;
                 tmp.list = rrlist;
+                m_estimated_size += tmp.estimated_size();
                 ret = m_rrlist.add_value(std::move(tmp));
             }
 
@@ -1167,7 +1508,7 @@ namespace CDNS {
          * @return Index of the Resource record in Block table
          */
         index_t add_rr(const RR& rr) {
-            return m_rr.add(rr);
+            return add_to_table(m_rr, rr);
         }
 
         /**
@@ -1189,7 +1530,7 @@ namespace CDNS {
          * @return Index of the Malformed message data in Block table
          */
         index_t add_malformed_message_data(const MalformedMessageData& mmd) {
-            return m_malformed_message_data.add(mmd);
+            return add_to_table(m_malformed_message_data, mmd);
         }
 
         /**
@@ -1323,6 +1664,14 @@ namespace CDNS {
             return m_malformed_messages.size();
         }
 
+        /**
+         * @brief Get Block parameters used by the Block
+         * @return Block parameters of the Block
+         */
+        const BlockParameters& get_block_parameters() const {
+            return m_block_parameters;
+        }
+
         /**
          * @brief Check if the Block is full (one of the QueryResponse, AddressEventCount or
          * MalformedMessage arrays reached <max_block_items> limit)
@@ -1331,9 +1680,121 @@ namespace CDNS {
         bool full() const {
             return m_query_responses.size() >= m_block_parameters.storage_parameters.max_block_items ||
                    m_address_event_counts.size() >= m_block_parameters.storage_parameters.max_block_items ||
-                   m_malformed_messages.size() >= m_block_parameters.storage_parameters.max_block_items;
+                   m_malformed_messages.size() >= m_block_parameters.storage_parameters.max_block_items ||
+                   (m_max_block_size > 0 && m_estimated_size >= m_max_block_size) ||
+                   (m_max_block_age > 0 && m_latest_time && age(*m_latest_time) >= m_max_block_age);
         }
 
+        /**
+         * @brief Check if the Block exceeded its maximum age at the given time. Allows sealing of Blocks
+         * when no new items arrive to trigger full().
+         * @param now Current time
+         * @return 'true' if maximum Block age is set, the Block contains timestamped items and the time since
+         * Block's earliest time reached the maximum age, 'false' otherwise
+         */
+        bool expired(const Timestamp& now) const {
+            return m_max_block_age > 0 && m_latest_time && age(now) >= m_max_block_age;
+        }
+
+        /**
+         * @brief Get estimated size of the Block's C-DNS CBOR representation. The estimate is updated
+         * incrementally as items and Block table entries are added to the Block.
+         * @return Estimated number of uncompressed bytes of the Block's items and Block tables
+         */
+        std::size_t get_estimated_size() const {
+            return m_estimated_size;
+        }
+
+        /**
+         * @brief Get sizes and deduplication statistics of the Block's Block tables
+         * @return Statistics of all Block tables
+         */
+        BlockTablesStats get_tables_stats() const;
+
+        /**
+         * @brief Set byte budget for the Block. Block is full when its estimated size reaches the budget.
+         * @param size Maximum estimated size of the Block in bytes (0 means unlimited)
+         */
+        void set_max_block_size(std::size_t size) {
+            m_max_block_size = size;
+        }
+
+        /**
+         * @brief Get byte budget for the Block
+         * @return Maximum estimated size of the Block in bytes (0 means unlimited)
+         */
+        std::size_t get_max_block_size() const {
+            return m_max_block_size;
+        }
+
+        /**
+         * @brief Set maximum age of the Block. Block is full when the time between its earliest time and
+         * the newest item reaches the maximum age.
+         * @param ticks Maximum age in ticks of the Block's Block parameters (0 means unlimited)
+         */
+        void set_max_block_age(uint64_t ticks) {
+            m_max_block_age = ticks;
+        }
+
+        /**
+         * @brief Get maximum age of the Block
+         * @return Maximum age in ticks of the Block's Block parameters (0 means unlimited)
+         */
+        uint64_t get_max_block_age() const {
+            return m_max_block_age;
+        }
+
+        /**
+         * @brief Enable or disable writing of implementation-private BlockSummary with the Block
+         * @param enable `true` to write the summary calculated by get_summary() in write()
+         */
+        void set_write_summary(bool enable) {
+            m_write_summary = enable;
+        }
+
+        /**
+         * @brief Check if BlockSummary is written with the Block
+         */
+        bool get_write_summary() const {
+            return m_write_summary;
+        }
+
+        /**
+         * @brief Set size of the Bloom filter over NAME/RDATA and IP address Block tables included
+         * in BlockSummary. The filter lets readers skip Blocks that don't contain given QNAMEs or
+         * addresses (see BlockLookup), it's written only if the summary is written.
+         * @param bits_per_item Bits of the filter per string in the Block tables, 0 disables the filter
+         */
+        void set_summary_filter(unsigned bits_per_item) {
+            m_filter_bits = bits_per_item;
+        }
+
+        /**
+         * @brief Get bits per item of Bloom filter included in BlockSummary (0 if disabled)
+         */
+        unsigned get_summary_filter() const {
+            return m_filter_bits;
+        }
+
+        /**
+         * @brief Get bits per item of Bloom filter in the BlockSummary read with the Block, derived from
+         * the size of the filter and the number of strings in the Block tables
+         * @return Bits per item to write the same filter with set_summary_filter(), 0 if the Block was
+         * read without filter
+         */
+        unsigned get_read_summary_filter() const {
+            if (!m_block_summary || !m_block_summary->filter)
+                return 0;
+
+            return m_block_summary->filter->bits_per_item(m_ip_address.size() + m_name_rdata.size());
+        }
+
+        /**
+         * @brief Calculate summary of the Block's current content
+         * @return Summary of the Block
+         */
+        BlockSummary get_summary() const;
+
         /**
          * @brief Set Block parameters for this Block. Block parameters can be set only if the Block is empty.
          * @param bp New Block parameters
@@ -1354,8 +1815,15 @@ namespace CDNS {
          */
         void clear() {
             m_block_preamble.earliest_time = {0, 0};
+            m_latest_time = boost::none;
+            m_estimated_size = 0;
             if (m_block_statistics)
                 m_block_statistics = boost::none;
+            if (m_block_summary)
+                m_block_summary = boost::none;
+
+            if (m_ip_intern.interner || m_name_intern.interner)
+                restart_interning();
 
             m_ip_address.clear();
             m_classtype.clear();
@@ -1374,6 +1842,7 @@ namespace CDNS {
 
         BlockPreamble m_block_preamble; //!< C-DNS block preamble
         boost::optional<BlockStatistics> m_block_statistics; //!< C-DNS block statistics
+        boost::optional<BlockSummary> m_block_summary; //!< Block summary read from input (see set_write_summary() for writing)
 
         // Block Tables
         BlockTable<StringItem> m_ip_address; //!< IP addresses Block table
@@ -1400,7 +1869,154 @@ namespace CDNS {
          */
         std::size_t write_blocktables(CdnsEncoder& enc, std::size_t& fields);
 
+        /**
+         * @brief Add item to Block table and account for its size if it's a new entry
+         * @param table Block table to add the item to
+         * @param item Item to add
+         * @return Index of the item in Block table
+         */
+        template<typename T, typename K>
+        index_t add_to_table(BlockTable<T, K>& table, const T& item) {
+            std::size_t size = table.size();
+            index_t ret = table.add(item);
+            if (table.size() > size)
+                m_estimated_size += item.estimated_size();
+
+            return ret;
+        }
+
+        /**
+         * @brief Add byte string to Block table of StringItems
+         * @param table Block table to add the string to
+         * @param data Byte string to add
+         * @param hash Hash of the byte string calculated by string_hash()
+         * @return Index of the string in Block table
+         */
+        index_t add_to_string_table(BlockTable<StringItem>& table, const std::string& data, std::size_t hash) {
+            index_t ret;
+
+            if (!table.find(reinterpret_cast<const StringItem&>(data), ret, hash)) {
+                StringItem tmp;
+                tmp.data = data;
+                m_estimated_size += tmp.estimated_size();
+                ret = table.add_indexed(std::move(tmp), hash);
+            }
+
+            return ret;
+        }
+
+        /**
+         * @brief Add byte string to Block table of StringItems through the table's StringInterner
+         * @param table Block table to add the string to
+         * @param ref Interner of the Block table
+         * @param data Byte string to add
+         * @param hash Hash of the byte string calculated by string_hash()
+         * @return Index of the string in Block table
+         */
+        index_t add_interned(BlockTable<StringItem>& table, detail::InternerRef& ref, const std::string& data,
+                             std::size_t hash);
+
+        /**
+         * @brief Start new Block in the interners of string Block tables
+         */
+        void restart_interning();
+
+        /**
+         * @brief Serialize all Block map fields except Block preamble and summary
+         * @param enc C-DNS encoder
+         * @param blocktable_fields Number of non-empty Block tables
+         * @return Number of uncompressed bytes written
+         */
+        std::size_t write_body(CdnsEncoder& enc, std::size_t blocktable_fields);
+
+        /**
+         * @brief Update timestamp of the newest item in the Block
+         * @param ts Timestamp of the added item
+         */
+        void update_latest_time(const Timestamp& ts) {
+            if (!m_latest_time || *m_latest_time < ts)
+                m_latest_time = ts;
+        }
+
+        /**
+         * @brief Calculate time elapsed since Block's earliest time
+         * @param ts Time to calculate the age at
+         * @return Age of the Block in ticks (0 if given time is before Block's earliest time)
+         */
+        uint64_t age(const Timestamp& ts) const;
+
         BlockParameters m_block_parameters;
+        std::size_t m_estimated_size;
+        boost::optional<Timestamp> m_latest_time;
+        std::size_t m_max_block_size;
+        uint64_t m_max_block_age;
+        bool m_write_summary;
+        unsigned m_filter_bits; //!< Bits per item of Bloom filter in the summary, 0 if disabled
+        detail::InternerRef m_ip_intern; //!< Interner of IP addresses Block table
+        detail::InternerRef m_name_intern; //!< Interner of NAME or RDATA Block table
+    };
+
+    /**
+     * @brief Set of NAMEs and IP addresses to look for in C-DNS Blocks
+     *
+     * Blocks whose BlockSummary has a Bloom filter (see CdnsBlock::set_summary_filter()) are matched
+     * only if the filter may contain at least one of the NAMEs or addresses, so needle-in-haystack
+     * searches decode only few Blocks. Blocks without the filter always match. Matched Blocks still
+     * have to be searched for the items, the filter has false positives and doesn't tell which items
+     * use the NAMEs or addresses.
+     */
+    class BlockLookup {
+        public:
+        /**
+         * @brief Look for NAME (e.g. QNAME) or RDATA
+         * @param name NAME in uncompressed wire format, ASCII letters are compared case-insensitively
+         */
+        void add_name(const std::string& name) {
+            m_hashes.push_back(BlockSummary::name_hash(name));
+        }
+
+        /**
+         * @brief Look for IP address (client or server)
+         * @param address IP address in the form stored in the Block table
+         */
+        void add_address(const std::string& address) {
+            m_hashes.push_back(BlockSummary::address_hash(address));
+        }
+
+        /**
+         * @brief Check if no NAMEs or addresses were added
+         */
+        bool empty() const {
+            return m_hashes.empty();
+        }
+
+        /**
+         * @brief Check if the Block may contain any of the NAMEs or addresses
+         * @param summary Summary of the Block
+         * @return `false` if the Block certainly doesn't contain any of them, `true` otherwise
+         * (also if nothing was added to the lookup)
+         */
+        bool matches(const BlockSummary& summary) const {
+            if (m_hashes.empty())
+                return true;
+
+            for (auto hash : m_hashes) {
+                if (summary.may_contain(hash))
+                    return true;
+            }
+
+            return false;
+        }
+
+        /**
+         * @brief Match the Block as BlockSummaryFilter
+         */
+        bool operator()(const BlockPreamble&, const BlockSummary& summary) const {
+            return matches(summary);
+        }
+
+        private:
+        std::vector<uint64_t> m_hashes;
     };
 
     /**
@@ -1415,7 +2031,7 @@ namespace CDNS {
         /**
          * @brief Default constructor
          */
-        CdnsBlockRead() : CdnsBlock(), m_qr_read(0), m_aec_read(), m_mm_read(0) {}
+        CdnsBlockRead() : CdnsBlock(), m_qr_read(0), m_aec_read(), m_mm_read(0), m_read_stats(), m_timing(false) {}
 
         /**
          * @brief Construct a new CdnsBlockRead object. Automatically reads a C-DNS block
@@ -1424,26 +2040,36 @@ namespace CDNS {
          * @param block_parameters Array of Block parameters retreived from C-DNS file preamble
          */
         CdnsBlockRead(CdnsDecoder& dec, std::vector<BlockParameters>& block_parameters)
-            : CdnsBlock(), m_qr_read(0), m_aec_read(), m_mm_read(0) { read(dec, block_parameters); }
+            : CdnsBlock(), m_qr_read(0), m_aec_read(), m_mm_read(0), m_read_stats(), m_timing(false) {
+            read(dec, block_parameters);
+        }
 
         /**
-         * @brief Copy constructor
+         * @brief Copy constructor. Reading of generic items starts from the beginning
+         * in the copied block.
          */
-        CdnsBlockRead(CdnsBlockRead& copy) {
-            *this = copy;
-        }
+        CdnsBlockRead(const CdnsBlockRead& copy)
+            : CdnsBlock(copy), m_qr_read(0), m_aec_read(m_address_event_counts.begin()), m_mm_read(0),
+              m_read_stats(), m_timing(copy.m_timing) {}
 
         /**
-         * @brief Move constructor
+         * @brief Move constructor. The position of reading generic items is preserved
+         * (moving the items doesn't relocate them), the moved-from block is left empty.
          */
-        CdnsBlockRead(CdnsBlockRead&& copy) {
-            *this = copy;
+        CdnsBlockRead(CdnsBlockRead&& other)
+            : CdnsBlock(std::move(other)), m_qr_read(other.m_qr_read), m_aec_read(other.m_aec_read),
+              m_mm_read(other.m_mm_read), m_read_stats(other.m_read_stats), m_timing(other.m_timing) {
+            other.m_read_stats = BlockReadStats();
+            other.m_qr_read = 0;
+            other.m_aec_read = other.m_address_event_counts.begin();
+            other.m_mm_read = 0;
         }
 
         /**
-         * @brief Assignment operator
+         * @brief Assignment operator. Reading of generic items starts from the beginning
+         * in the copied block.
          */
-        CdnsBlockRead& operator=(CdnsBlockRead& rhs) {
+        CdnsBlockRead& operator=(const CdnsBlockRead& rhs) {
             if (this != &rhs) {
                 CdnsBlock::operator=(rhs);
 
@@ -1456,20 +2082,82 @@ namespace CDNS {
         }
 
         /**
-         * @brief Move assignment operator
+         * @brief Move assignment operator. The position of reading generic items is preserved,
+         * the moved-from block is left empty.
          */
         CdnsBlockRead& operator=(CdnsBlockRead&& rhs) {
             if (this != &rhs) {
-                *this = rhs;
+                m_qr_read = rhs.m_qr_read;
+                m_aec_read = rhs.m_aec_read;
+                m_mm_read = rhs.m_mm_read;
+                m_read_stats = rhs.m_read_stats;
+                m_timing = rhs.m_timing;
+                CdnsBlock::operator=(std::move(rhs));
+                rhs.m_read_stats = BlockReadStats();
+
+                rhs.m_qr_read = 0;
+                rhs.m_aec_read = rhs.m_address_event_counts.begin();
+                rhs.m_mm_read = 0;
             }
             return *this;
         }
 
+        /**
+         * @brief Clear the Block and reset the position of reading generic items.
+         *
+         * Capacity of the Block's tables and arrays is kept, so the Block can be reused for reading
+         * of the next C-DNS block without new allocations.
+         */
+        void clear() {
+            CdnsBlock::clear();
+            m_qr_read = 0;
+            m_aec_read = m_address_event_counts.begin();
+            m_mm_read = 0;
+            m_read_stats = BlockReadStats();
+        }
+
+        /**
+         * @brief Enable or disable measuring of time spent reading the Block and its items
+         * @param enable `true` to enable timing
+         */
+        void set_timing(bool enable) {
+            m_timing = enable;
+        }
+
+        /**
+         * @brief Get time spent in individual phases of reading the Block and its items since the Block
+         * was last cleared (or read). Measured only if timing is enabled by set_timing().
+         * @return Timing of the Block
+         */
+        const BlockReadStats& get_read_stats() const {
+            return m_read_stats;
+        }
+
         /**
          * @brief Read the C-DNS block from C-DNS CBOR input stream
+         *
+         * If the filter is given and the Block has BlockSummary right after its Block preamble (as written
+         * by CdnsBlock with set_write_summary()), the filter is called before anything else is decoded.
+         * If it rejects the Block, the rest of the Block is skipped and the Block contains only its
+         * Block preamble and summary. Blocks without summary are always decoded.
          * @param dec C-DNS decoder
+         * @param block_parameters Array of Block parameters retreived from C-DNS file preamble
+         * @param filter Optional filter of Blocks by their summary
+         * @return `false` if the Block was skipped by the filter, `true` otherwise
          */
-        void read(CdnsDecoder& dec, std::vector<BlockParameters>& block_parameters);
+        bool read(CdnsDecoder& dec, std::vector<BlockParameters>& block_parameters,
+                  const BlockSummaryFilter& filter = BlockSummaryFilter());
+
+        /**
+         * @brief Decode Block read by CdnsReader::read_raw_block(). Unlike reading from CdnsReader
+         * it doesn't touch the reader, so Blocks read on one thread can be decoded on other threads.
+         * @param raw Raw Block to decode
+         * @param block_parameters Array of Block parameters retreived from C-DNS file preamble
+         * @param filter Optional filter of Blocks by their summary
+         * @return `false` if the Block was skipped by the filter, `true` otherwise
+         */
+        bool read(RawBlock& raw, std::vector<BlockParameters>& block_parameters,
+                  const BlockSummaryFilter& filter = BlockSummaryFilter());
 
         /**
          * @brief Read next generic QueryResponse from the block, light version
@@ -1516,6 +2204,42 @@ namespace CDNS {
          */
         GenericMalformedMessage read_generic_mm(bool& end);
 
+        /**
+         * @brief Decode all Query/Response items of the Block to struct-of-arrays columns.
+         *
+         * By default previous content of the columns is replaced, but their capacity is kept, so one
+         * QueryResponseColumns object can be reused for all Blocks of a file. In append mode the Block's
+         * items are added after the existing ones, the Block's tables are appended to the dictionaries
+         * and its indexes are shifted accordingly. Doesn't change the position of reading generic items.
+         * @param columns Columns to fill with the Block's Query/Response items
+         * @param append Append the Block's items to the existing content of the columns
+         * @throw std::runtime_error if an item refers to a Block table index out of bounds or if appended
+         * Block uses different time resolution than the columns
+         */
+        void read_qr_columns(QueryResponseColumns& columns, bool append = false);
+
+        /**
+         * @brief Call visitor for each Query/Response item of the Block
+         *
+         * The visitor receives a read-only QueryResponseView of the item, which resolves Block table
+         * indexes only for the fields it is asked for, so nothing is copied or allocated for fields
+         * the visitor doesn't touch. The view is valid only during the call of the visitor.
+         * Doesn't change the position of reading generic items.
+         * @param visitor Callable taking `const QueryResponseView&`. If it returns `bool`,
+         * returning `false` stops the iteration.
+         * @return Number of visited Query/Response items
+         */
+        template<typename Visitor>
+        std::size_t for_each_qr(Visitor&& visitor) const;
+
+        /**
+         * @brief Get read-only view of the Query/Response item at given position in the Block
+         * @param index Position of the Query/Response item in the Block
+         * @throw std::out_of_range if the position is out of bounds
+         * @return View of the Query/Response item, valid until the Block is modified
+         */
+        QueryResponseView qr_view(std::size_t index) const;
+
         private:
         /**
          * @brief Read the Block tables from C-DNS CBOR input stream
@@ -1523,22 +2247,224 @@ namespace CDNS {
          */
         void read_blocktables(CdnsDecoder& dec);
 
+        uint64_t m_qr_read;
+        std::unordered_map<AddressEventCount, uint64_t, CDNS::hash<AddressEventCount>>::iterator m_aec_read;
+        uint64_t m_mm_read;
+        BlockReadStats m_read_stats;
+        bool m_timing;
+    };
+
+    /**
+     * @brief Read-only view of one Query/Response item in CdnsBlockRead
+     *
+     * Fields stored directly in the Query/Response item are returned by reference. Fields stored
+     * in Block tables are resolved when they are accessed, strings and structures are returned
+     * as references into the Block's tables. Accessing a field with Block table index out of bounds
+     * throws std::runtime_error.
+     *
+     * The view doesn't own any data and is valid only until the Block it was created from
+     * is modified, cleared or destroyed.
+     */
+    class QueryResponseView {
+        public:
         /**
-         * @brief Fill GenericResourceRecord list with questions from given list
-         * @param list List with indexes to Question Block table
-         * @return Vector of Generic Resource Records
+         * @brief Construct a new QueryResponseView object
+         * @param block Block containing the Query/Response item
+         * @param qr Query/Response item of the Block
          */
-        std::vector<GenericResourceRecord> fill_generic_q_list(std::vector<index_t>& list);
+        QueryResponseView(const CdnsBlockRead& block, const QueryResponse& qr) : m_block(block), m_qr(qr) {}
 
         /**
-         * @brief Fill GenericResourceRecord list with resource records from given list
-         * @param list List with indexes to RR Block table
-         * @return Vector of Generic Resource Records
+         * @brief Get the underlying Query/Response item with raw Block table indexes
          */
-        std::vector<GenericResourceRecord> fill_generic_rr_list(std::vector<index_t>& list);
+        const QueryResponse& item() const {
+            return m_qr;
+        }
 
-        uint64_t m_qr_read;
-        std::unordered_map<AddressEventCount, uint64_t, CDNS::hash<AddressEventCount>>::iterator m_aec_read;
-        uint64_t m_mm_read;
+        /**
+         * @brief Get Query/Response signature of the item
+         */
+        boost::optional<const QueryResponseSignature&> signature() const {
+            if (!m_qr.qr_signature_index)
+                return boost::none;
+
+            return lookup(m_block.m_qr_sig, *m_qr.qr_signature_index, "QueryResponseSignature");
+        }
+
+        // Fields of Query/Response item
+        const boost::optional<Timestamp>& ts() const { return m_qr.time_offset; }
+        const boost::optional<uint16_t>& client_port() const { return m_qr.client_port; }
+        const boost::optional<uint16_t>& transaction_id() const { return m_qr.transaction_id; }
+        const boost::optional<uint8_t>& client_hoplimit() const { return m_qr.client_hoplimit; }
+        const boost::optional<int64_t>& response_delay() const { return m_qr.response_delay; }
+        const boost::optional<std::size_t>& query_size() const { return m_qr.query_size; }
+        const boost::optional<std::size_t>& response_size() const { return m_qr.response_size; }
+        const boost::optional<std::string>& asn() const { return m_qr.asn; }
+        const boost::optional<std::string>& country_code() const { return m_qr.country_code; }
+        const boost::optional<int64_t>& round_trip_time() const { return m_qr.round_trip_time; }
+
+        boost::optional<const std::string&> client_ip() const {
+            return string_field(m_block.m_ip_address, m_qr.client_address_index, "IP address");
+        }
+
+        boost::optional<const std::string&> query_name() const {
+            return string_field(m_block.m_name_rdata, m_qr.query_name_index, "Name_rdata");
+        }
+
+        boost::optional<const std::string&> bailiwick() const {
+            if (!m_qr.response_processing_data)
+                return boost::none;
+
+            return string_field(m_block.m_name_rdata, m_qr.response_processing_data->bailiwick_index, "Name_rdata");
+        }
+
+        boost::optional<ResponseProcessingFlagsMask> processing_flags() const {
+            if (!m_qr.response_processing_data)
+                return boost::none;
+
+            return m_qr.response_processing_data->processing_flags;
+        }
+
+        // Fields of Query/Response signature
+        boost::optional<const std::string&> server_ip() const {
+            auto qrs = signature();
+            if (!qrs)
+                return boost::none;
+
+            return string_field(m_block.m_ip_address, qrs->server_address_index, "IP address");
+        }
+
+        boost::optional<const ClassType&> query_classtype() const {
+            auto qrs = signature();
+            if (!qrs || !qrs->query_classtype_index)
+                return boost::none;
+
+            return lookup(m_block.m_classtype, *qrs->query_classtype_index, "Classtype");
+        }
+
+        boost::optional<const std::string&> query_opt_rdata() const {
+            auto qrs = signature();
+            if (!qrs)
+                return boost::none;
+
+            return string_field(m_block.m_name_rdata, qrs->query_opt_rdata_index, "Name_rdata");
+        }
+
+        boost::optional<uint16_t> server_port() const { return sig_field(&QueryResponseSignature::server_port); }
+        boost::optional<QueryResponseTransportFlagsMask> qr_transport_flags() const {
+            return sig_field(&QueryResponseSignature::qr_transport_flags);
+        }
+        boost::optional<QueryResponseTypeValues> qr_type() const { return sig_field(&QueryResponseSignature::qr_type); }
+        boost::optional<QueryResponseFlagsMask> qr_sig_flags() const {
+            return sig_field(&QueryResponseSignature::qr_sig_flags);
+        }
+        boost::optional<uint8_t> query_opcode() const { return sig_field(&QueryResponseSignature::query_opcode); }
+        boost::optional<DNSFlagsMask> qr_dns_flags() const { return sig_field(&QueryResponseSignature::qr_dns_flags); }
+        boost::optional<uint16_t> query_rcode() const { return sig_field(&QueryResponseSignature::query_rcode); }
+        boost::optional<uint16_t> query_qdcount() const { return sig_field(&QueryResponseSignature::query_qdcount); }
+        boost::optional<uint32_t> query_ancount() const { return sig_field(&QueryResponseSignature::query_ancount); }
+        boost::optional<uint16_t> query_nscount() const { return sig_field(&QueryResponseSignature::query_nscount); }
+        boost::optional<uint16_t> query_arcount() const { return sig_field(&QueryResponseSignature::query_arcount); }
+        boost::optional<uint8_t> query_edns_version() const {
+            return sig_field(&QueryResponseSignature::query_edns_version);
+        }
+        boost::optional<uint16_t> query_udp_size() const { return sig_field(&QueryResponseSignature::query_udp_size); }
+        boost::optional<uint16_t> response_rcode() const { return sig_field(&QueryResponseSignature::response_rcode); }
+
+        // Extended Query and Response sections, materialized on every call
+        std::vector<GenericResourceRecord> query_questions() const;
+        std::vector<GenericResourceRecord> query_answers() const;
+        std::vector<GenericResourceRecord> query_authority() const;
+        std::vector<GenericResourceRecord> query_additional() const;
+        std::vector<GenericResourceRecord> response_questions() const;
+        std::vector<GenericResourceRecord> response_answers() const;
+        std::vector<GenericResourceRecord> response_authority() const;
+        std::vector<GenericResourceRecord> response_additional() const;
+
+        /**
+         * @brief Resolve all fields of the item to GenericQueryResponse
+         * @return Fully populated GenericQueryResponse, same as CdnsBlockRead::read_generic_qr()
+         */
+        GenericQueryResponse to_generic() const;
+
+        private:
+        template<typename T, typename K>
+        static const T& lookup(const BlockTable<T, K>& table, index_t index, const char* name) {
+            if (index >= table.size())
+                throw std::runtime_error(std::string(name) + " block table index out of bounds");
+
+            return table[index];
+        }
+
+        template<typename K>
+        static boost::optional<const std::string&> string_field(const BlockTable<StringItem, K>& table,
+                                                                const boost::optional<index_t>& index,
+                                                                const char* name) {
+            if (!index)
+                return boost::none;
+
+            return lookup(table, *index, name).data;
+        }
+
+        template<typename T>
+        boost::optional<T> sig_field(boost::optional<T> QueryResponseSignature::* field) const {
+            auto qrs = signature();
+            if (!qrs)
+                return boost::none;
+
+            return (*qrs).*field;
+        }
+
+        std::vector<GenericResourceRecord> questions(const boost::optional<QueryResponseExtended>& ext) const;
+        std::vector<GenericResourceRecord> rrs(const boost::optional<QueryResponseExtended>& ext,
+                                               boost::optional<index_t> QueryResponseExtended::* section) const;
+
+        const CdnsBlockRead& m_block;
+        const QueryResponse& m_qr;
     };
+
+    namespace detail {
+        /**
+         * @brief Call visitor that doesn't return a value
+         * @return Always `true` (continue visiting)
+         */
+        template<typename Visitor, typename Item>
+        auto visit_continues(Visitor& visitor, const Item& item)
+            -> typename std::enable_if<std::is_void<decltype(visitor(item))>::value, bool>::type {
+            visitor(item);
+            return true;
+        }
+
+        /**
+         * @brief Call visitor that returns a value convertible to `bool`
+         * @return Value returned by the visitor (`false` to stop visiting)
+         */
+        template<typename Visitor, typename Item>
+        auto visit_continues(Visitor& visitor, const Item& item)
+            -> typename std::enable_if<!std::is_void<decltype(visitor(item))>::value, bool>::type {
+            return static_cast<bool>(visitor(item));
+        }
+    }
+
+    template<typename Visitor>
+    std::size_t CdnsBlockRead::for_each_qr(Visitor&& visitor) const
+    {
+        std::size_t visited = 0;
+
+        for (auto& qr : m_query_responses) {
+            visited++;
+            if (!detail::visit_continues(visitor, QueryResponseView(*this, qr)))
+                break;
+        }
+
+        return visited;
+    }
+
+    inline QueryResponseView CdnsBlockRead::qr_view(std::size_t index) const
+    {
+        if (index >= m_query_responses.size())
+            throw std::out_of_range("Query/Response index " + std::to_string(index) + " out of bounds");
+
+        return QueryResponseView(*this, m_query_responses[index]);
+    }
 }
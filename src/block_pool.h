@@ -0,0 +1,96 @@
+/**
+ * Copyright © 2026 CZ.NIC, z. s. p. o.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, you can obtain one at https://mozilla.org/MPL/2.0/.
+ */
+
+#pragma once
+
+#include <vector>
+#include <mutex>
+#include <utility>
+#include <cstddef>
+
+namespace CDNS {
+
+    /**
+     * @brief Thread-safe pool of spare C-DNS blocks (CdnsBlock or CdnsBlockRead)
+     *
+     * Blocks returned to the pool are cleared, but keep the capacity of their tables and arrays.
+     * Blocks are moved in and out of the pool, which is a constant time operation that doesn't
+     * touch the allocator, so once the pool reaches steady state acquiring a Block, filling it
+     * and releasing it again doesn't allocate any memory for the Block's structure.
+     *
+     * Typical use is double-buffering: one thread fills a Block acquired from the pool while
+     * another thread writes or processes the previous one and then releases it back to the pool.
+     *
+     * @tparam T Type of the pooled Blocks
+     */
+    template<typename T>
+    class BlockPool {
+        public:
+        static constexpr std::size_t DEFAULT_MAX_SPARE = 4;
+
+        /**
+         * @brief Construct a new BlockPool object
+         * @param max_spare Maximum number of spare Blocks kept by the pool. Blocks released
+         * to a full pool are destroyed.
+         */
+        explicit BlockPool(std::size_t max_spare = DEFAULT_MAX_SPARE) : m_max_spare(max_spare), m_blocks() {
+            m_blocks.reserve(max_spare);
+        }
+
+        /** Delete copy constructor and assignment operator */
+        BlockPool(const BlockPool& copy) = delete;
+        BlockPool& operator=(const BlockPool& rhs) = delete;
+
+        /**
+         * @brief Get a Block from the pool
+         * @return Empty spare Block or newly constructed Block if the pool is empty
+         */
+        T acquire() {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            if (m_blocks.empty())
+                return T();
+
+            T block(std::move(m_blocks.back()));
+            m_blocks.pop_back();
+            return block;
+        }
+
+        /**
+         * @brief Return a Block to the pool. The Block is cleared.
+         * @param block Block to return to the pool, left empty
+         */
+        void release(T&& block) {
+            block.clear();
+            std::lock_guard<std::mutex> lock(m_mutex);
+            if (m_blocks.size() < m_max_spare)
+                m_blocks.push_back(std::move(block));
+        }
+
+        /**
+         * @brief Get the number of spare Blocks currently held by the pool
+         * @return Number of spare Blocks
+         */
+        std::size_t size() const {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            return m_blocks.size();
+        }
+
+        /**
+         * @brief Get the maximum number of spare Blocks kept by the pool
+         * @return Maximum number of spare Blocks
+         */
+        std::size_t max_spare() const {
+            return m_max_spare;
+        }
+
+        private:
+        std::size_t m_max_spare;
+        std::vector<T> m_blocks;
+        mutable std::mutex m_mutex;
+    };
+}
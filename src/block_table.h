@@ -14,6 +14,7 @@
 #pragma once
 
 #include <deque>
+#include <utility>
 #include <unordered_map>
 #include <stdexcept>
 
@@ -25,6 +26,9 @@ namespace CDNS {
     /**
      * @class KeyRef
      * @brief A class to let a reference act as a map key.
+     *
+     * The hash of the referenced item is calculated once and stored with the reference, so
+     * rehashing of the map and comparisons of keys with different hashes never touch the item.
      */
     template<typename T>
     class KeyRef
@@ -35,7 +39,15 @@ namespace CDNS {
          * 
          * @param key a reference to the key item.
          */
-        explicit KeyRef(const T& key) : key_(key) { }
+        explicit KeyRef(const T& key) : key_(key), hash_(CDNS::hash<T>()(key)) { }
+
+        /**
+         * @brief Constructor with precomputed hash.
+         *
+         * @param key a reference to the key item.
+         * @param hash hash of the key item, has to be equal to `CDNS::hash<T>()(key)`.
+         */
+        KeyRef(const T& key, std::size_t hash) : key_(key), hash_(hash) { }
 
         /**
          * @brief Equality operator.
@@ -45,7 +57,7 @@ namespace CDNS {
          */
         bool operator==(const KeyRef<T>& rhs) const
         {
-            return ( key_ == rhs.key_ );
+            return ( hash_ == rhs.hash_ && key_ == rhs.key_ );
         }
 
         /**
@@ -60,14 +72,21 @@ namespace CDNS {
         }
 
         /**
-         * @brief Calculate a hash value for the referenced item.
+         * @brief Get the stored hash value of the referenced item.
+         */
+        std::size_t hash() const noexcept
+        {
+            return hash_;
+        }
+
+        /**
+         * @brief Get the hash value for the referenced item.
          * 
          * @returns hash value.
          */
         friend std::size_t hash_value(const KeyRef<T>& k)
         {
-            CDNS::hash<T> hash_func;
-            return hash_func(k.key_);
+            return k.hash_;
         }
 
     private:
@@ -75,10 +94,35 @@ namespace CDNS {
          * @brief reference to the item
          */
         const T& key_;
+
+        /**
+         * @brief hash of the item
+         */
+        std::size_t hash_;
+    };
+
+    /**
+     * @brief Hash function for KeyRef returning the stored hash. It doesn't throw, so
+     * std::unordered_map doesn't store another copy of the hash in its nodes.
+     */
+    template<typename T>
+    struct KeyRefHash {
+        std::size_t operator()(const KeyRef<T>& k) const noexcept {
+            return k.hash();
+        }
     };
 
     /**
      * @brief Representation of one block table's table
+     *
+     * Clearing the table only resets its logical size. Already allocated items are kept and
+     * reused by subsequent additions, so a table that is cleared and refilled (e.g. when reading
+     * Blocks one after another) reuses the capacity of its items' strings and vectors.
+     *
+     * The index map used for deduplication is updated lazily by find(), so tables that are only
+     * filled and read (e.g. Blocks read from input) never build it. Each entry of the index map
+     * stores the hash of its item, so the items are hashed only once. Callers that already have
+     * the hash of an item can pass it to find() and add() to skip hashing altogether.
      */
     template<typename T, typename K = T>
     class BlockTable {
@@ -86,7 +130,74 @@ namespace CDNS {
         /**
          * @brief Default constructor.
          */
-        explicit BlockTable() {}
+        explicit BlockTable() : items_(), size_(0), indexed_(0), indexes_(), lookups_(0), hits_(0) {}
+
+        /**
+         * @brief Copy constructor.
+         *
+         * The index map holds references to the stored items, so it has to be
+         * rebuilt for the copied items instead of being copied.
+         *
+         * @param copy the table to copy.
+         */
+        BlockTable(const BlockTable& copy) : items_(copy.items_.begin(), copy.items_.begin() + copy.size_),
+                                             size_(copy.size_), indexed_(0), indexes_(),
+                                             lookups_(copy.lookups_), hits_(copy.hits_) {}
+
+        /**
+         * @brief Move constructor.
+         *
+         * Moving a deque doesn't relocate its items, so references held by the
+         * index map stay valid and the whole table is moved in constant time.
+         *
+         * @param other the table to move from, left empty.
+         */
+        BlockTable(BlockTable&& other) : items_(std::move(other.items_)), size_(other.size_),
+                                         indexed_(other.indexed_), indexes_(std::move(other.indexes_)),
+                                         lookups_(other.lookups_), hits_(other.hits_)
+        {
+            other.items_.clear();
+            other.clear();
+        }
+
+        /**
+         * @brief Copy assignment operator.
+         *
+         * @param rhs the table to copy.
+         */
+        BlockTable& operator=(const BlockTable& rhs)
+        {
+            if ( this != &rhs )
+            {
+                clear();
+                for ( CDNS::index_t i = 0; i < rhs.size_; i++ )
+                    store(rhs.items_[i]);
+                lookups_ = rhs.lookups_;
+                hits_ = rhs.hits_;
+            }
+            return *this;
+        }
+
+        /**
+         * @brief Move assignment operator.
+         *
+         * @param rhs the table to move from, left empty.
+         */
+        BlockTable& operator=(BlockTable&& rhs)
+        {
+            if ( this != &rhs )
+            {
+                items_ = std::move(rhs.items_);
+                size_ = rhs.size_;
+                indexed_ = rhs.indexed_;
+                indexes_ = std::move(rhs.indexes_);
+                lookups_ = rhs.lookups_;
+                hits_ = rhs.hits_;
+                rhs.items_.clear();
+                rhs.clear();
+            }
+            return *this;
+        }
 
         /**
          * @brief Find if a key value is in the list
@@ -97,10 +208,26 @@ namespace CDNS {
          */
         bool find(const K& key, index_t& index)
         {
-            auto find = indexes_.find(KeyRef<K>(key));
+            return find(key, index, CDNS::hash<K>()(key));
+        }
+
+        /**
+         * @brief Find if a key value is in the list using its precomputed hash
+         *
+         * @param key the key value to search for.
+         * @param index the index of the item, if found.
+         * @param hash hash of the key, has to be equal to `CDNS::hash<K>()(key)`.
+         * @returns `true` if the item is found.
+         */
+        bool find(const K& key, index_t& index, std::size_t hash)
+        {
+            update_index();
+            lookups_++;
+            auto find = indexes_.find(KeyRef<K>(key, hash));
             if ( find != indexes_.end() )
             {
                 index = find->second;
+                hits_++;
                 return true;
             }
             else
@@ -120,8 +247,7 @@ namespace CDNS {
          */
         CDNS::index_t add_value(const T& val)
         {
-            items_.push_back(val);
-            return record_last_key();
+            return store(val);
         }
 
         /**
@@ -135,8 +261,23 @@ namespace CDNS {
          */
         CDNS::index_t add_value(T&& val)
         {
-            items_.push_back(val);
-            return record_last_key();
+            return store(std::move(val));
+        }
+
+        /**
+         * @brief Add a new item to the list and return it for filling in place
+         *
+         * The returned item is either default constructed or recycled from before the last
+         * clear() and keeps its previous content. Caller has to overwrite all of its fields
+         * (e.g. by calling item's read() method, which resets the item first).
+         *
+         * @returns reference to the new item, valid until the table is cleared.
+         */
+        T& add_item()
+        {
+            if ( size_ == items_.size() )
+                items_.emplace_back();
+            return items_[size_++];
         }
 
         /**
@@ -150,10 +291,47 @@ namespace CDNS {
          */
         CDNS::index_t add(const T& val)
         {
-            const K& key = val.key();
+            return add(val, CDNS::hash<K>()(val.key()));
+        }
+
+        /**
+         * @brief Add a new value to the list using precomputed hash of its key.
+         *
+         * If the value is present in the list already, return existing
+         * value index. Otherwise add the value to the list.
+         *
+         * @param val the value to add.
+         * @param hash hash of the value's key, has to be equal to `CDNS::hash<K>()(val.key())`.
+         * @returns index reference to the value.
+         */
+        CDNS::index_t add(const T& val, std::size_t hash)
+        {
             CDNS::index_t res;
-            if ( !find(key, res) )
-                res = add_value(val);
+            if ( !find(val.key(), res, hash) )
+                res = add_indexed(val, hash);
+            return res;
+        }
+
+        /**
+         * @brief Add a new value, that isn't in the list yet, to the list and to the index map
+         *
+         * Should be called only right after find() of the value's key failed, otherwise the value
+         * is added without indexing and hashed again by the next find().
+         *
+         * @param val the value to add.
+         * @param hash hash of the value's key, has to be equal to `CDNS::hash<K>()(val.key())`.
+         * @returns index reference to the value.
+         */
+        template<typename U>
+        CDNS::index_t add_indexed(U&& val, std::size_t hash)
+        {
+            bool indexed = ( indexed_ == size_ );
+            CDNS::index_t res = store(std::forward<U>(val));
+            if ( indexed )
+            {
+                indexes_.emplace(KeyRef<K>(items_[res].key(), hash), res);
+                indexed_++;
+            }
             return res;
         }
 
@@ -162,8 +340,11 @@ namespace CDNS {
          */
         void clear()
         {
-            items_.clear();
+            size_ = 0;
+            indexed_ = 0;
             indexes_.clear();
+            lookups_ = 0;
+            hits_ = 0;
         }
 
         /**
@@ -174,7 +355,7 @@ namespace CDNS {
          */
         const T& operator[](CDNS::index_t pos) const
         {
-            if ( pos < items_.size() )
+            if ( pos < size_ )
                 return items_[pos];
             
             throw std::runtime_error("Block index out of range");
@@ -185,7 +366,37 @@ namespace CDNS {
          */
         typename std::deque<T>::size_type size() const
         {
-            return items_.size();
+            return size_;
+        }
+
+        /**
+         * @brief Get the number of find() calls since the last clear().
+         */
+        uint64_t lookups() const
+        {
+            return lookups_;
+        }
+
+        /**
+         * @brief Get the number of find() calls since the last clear() that found the key,
+         * i.e. the number of values deduplicated by the table.
+         */
+        uint64_t hits() const
+        {
+            return hits_;
+        }
+
+        /**
+         * @brief Count lookup of a value done outside of the table (e.g. by StringInterner)
+         * in the table's statistics.
+         *
+         * @param hit `true` if the value was found.
+         */
+        void record_lookup(bool hit)
+        {
+            lookups_++;
+            if ( hit )
+                hits_++;
         }
 
         /**
@@ -205,24 +416,41 @@ namespace CDNS {
          */
         typename std::deque<T>::iterator end()
         {
-            return items_.end();
+            return items_.begin() + size_;
         }
 
     private:
         /**
-         * @brief Record the key to the latest item in the vector.
-         * 
+         * @brief Store value to the next free item, recycling items left over from before
+         * the last clear().
+         *
+         * @param val the value to store.
          * @returns index reference to the value.
          */
-        CDNS::index_t record_last_key()
+        template<typename U>
+        CDNS::index_t store(U&& val)
         {
-            CDNS::index_t res = items_.size();
-            res -= 1;
-            indexes_[KeyRef<K>(items_.back().key())] = res;
-            return res;
+            if ( size_ == items_.size() )
+                items_.push_back(std::forward<U>(val));
+            else
+                items_[size_] = std::forward<U>(val);
+            return size_++;
+        }
+
+        /**
+         * @brief Add items not yet in the index map to it.
+         */
+        void update_index()
+        {
+            for ( ; indexed_ < size_; indexed_++ )
+                indexes_[KeyRef<K>(items_[indexed_].key())] = indexed_;
         }
 
         std::deque<T> items_;
-        std::unordered_map<KeyRef<K>, CDNS::index_t, CDNS::hash<KeyRef<K>>> indexes_;
+        CDNS::index_t size_;
+        CDNS::index_t indexed_;
+        std::unordered_map<KeyRef<K>, CDNS::index_t, KeyRefHash<K>> indexes_;
+        uint64_t lookups_;
+        uint64_t hits_;
     };
 }
\ No newline at end of file
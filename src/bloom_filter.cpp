@@ -0,0 +1,110 @@
+/**
+ * Copyright © 2026 CZ.NIC, z. s. p. o.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, you can obtain one at https://mozilla.org/MPL/2.0/.
+ */
+
+#include <sstream>
+#include <algorithm>
+#include <stdexcept>
+
+#include "bloom_filter.h"
+
+constexpr unsigned CDNS::BloomFilter::DEFAULT_BITS_PER_ITEM;
+constexpr unsigned CDNS::BloomFilter::MAX_HASH_COUNT;
+
+CDNS::BloomFilter::BloomFilter(std::size_t items, unsigned bits_per_item)
+    : m_hash_count(0), m_bits()
+{
+    if (bits_per_item == 0)
+        throw std::invalid_argument("Bloom filter needs at least 1 bit per item");
+
+    m_hash_count = hash_count_for(bits_per_item);
+
+    if (items == 0)
+        return;
+
+    // Bit positions are calculated from 32-bit hashes, so the filter can't have more than 2^32 bits
+    uint64_t bytes = (static_cast<uint64_t>(items) * bits_per_item + 7) / 8;
+    bytes = std::min<uint64_t>(std::max<uint64_t>(bytes, 8), UINT32_MAX / 8 + 1);
+    m_bits.assign(bytes, 0);
+}
+
+unsigned CDNS::BloomFilter::bits_per_item(std::size_t items) const
+{
+    if (m_hash_count == 0)
+        return 0;
+
+    // Size is rounded up to whole bytes, so integer division gives the original bits per item
+    // unless the size was clamped to the minimum or maximum
+    if (items > 0 && !m_bits.empty()) {
+        uint64_t bits = std::min<uint64_t>(std::max<uint64_t>(bit_count() / items, 1), UINT32_MAX);
+        if (hash_count_for(static_cast<unsigned>(bits)) == m_hash_count)
+            return static_cast<unsigned>(bits);
+    }
+
+    return std::max((m_hash_count * 1000 + 346) / 693, 1U);
+}
+
+std::string CDNS::BloomFilter::string() const
+{
+    std::stringstream ss;
+
+    ss << "Bloom filter: " << std::to_string(bit_count()) << " bits, "
+       << std::to_string(m_hash_count) << " hash functions" << std::endl;
+
+    return ss.str();
+}
+
+std::size_t CDNS::BloomFilter::write(CdnsEncoder& enc) const
+{
+    std::size_t written = 0;
+
+    // Start Bloom filter map
+    written += enc.write_map_start(get_map_index(BloomFilterMapIndex::bloom_filter_size));
+
+    written += enc.write(get_map_index(BloomFilterMapIndex::hash_count));
+    written += enc.write(m_hash_count);
+    written += enc.write(get_map_index(BloomFilterMapIndex::bits));
+    written += enc.write_bytestring(m_bits);
+
+    return written;
+}
+
+void CDNS::BloomFilter::read(CdnsDecoder& dec)
+{
+    reset();
+    bool indef = false;
+    uint64_t length = dec.read_map_start(indef);
+    uint64_t hash_count = 0;
+
+    while (length > 0 || indef) {
+        if (indef && dec.peek_type() == CborType::BREAK) {
+            dec.read_break();
+            break;
+        }
+
+        switch (dec.read_integer()) {
+            case get_map_index(BloomFilterMapIndex::hash_count):
+                hash_count = dec.read_unsigned();
+                break;
+            case get_map_index(BloomFilterMapIndex::bits):
+                dec.read_bytestring(m_bits);
+                break;
+            default:
+                dec.skip_item();
+                break;
+        }
+
+        length--;
+    }
+
+    if (hash_count > MAX_HASH_COUNT)
+        throw CdnsDecoderException("Bloom filter uses too many hash functions");
+    if (m_bits.size() > UINT32_MAX / 8 + 1)
+        throw CdnsDecoderException("Bloom filter is too large");
+
+    m_hash_count = static_cast<unsigned>(hash_count);
+}
@@ -0,0 +1,164 @@
+/**
+ * Copyright © 2026 CZ.NIC, z. s. p. o.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, you can obtain one at https://mozilla.org/MPL/2.0/.
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <cstddef>
+#include <string>
+#include <algorithm>
+
+#include "format_specification.h"
+#include "hash.h"
+#include "cdns_encoder.h"
+#include "cdns_decoder.h"
+
+namespace CDNS {
+
+    /**
+     * @brief Bloom filter of byte strings that can be written to C-DNS output
+     *
+     * Strings are added and looked up by their stable_hash(), so filters written on one host can be
+     * used on any other. Bit positions are derived from the 64-bit hash by double hashing. Bit `i`
+     * of the filter is stored in byte `i / 8` as the bit with value `1 << (i % 8)`.
+     */
+    class BloomFilter {
+        public:
+        static constexpr unsigned DEFAULT_BITS_PER_ITEM = 10;
+        static constexpr unsigned MAX_HASH_COUNT = 16;
+
+        /**
+         * @brief Construct empty filter that doesn't contain anything
+         */
+        BloomFilter() : m_hash_count(0), m_bits() {}
+
+        /**
+         * @brief Construct filter sized for given number of items
+         * @param items Expected number of items in the filter
+         * @param bits_per_item Size of the filter in bits per item, 10 bits give about 1 % false positives
+         * @throw std::invalid_argument if bits_per_item is 0
+         */
+        BloomFilter(std::size_t items, unsigned bits_per_item);
+
+        /**
+         * @brief Add string's hash to the filter
+         * @param hash Hash of the string calculated by stable_hash()
+         */
+        void add(uint64_t hash) {
+            if (m_bits.empty())
+                return;
+
+            uint64_t size = bit_count();
+            uint32_t h1 = static_cast<uint32_t>(hash);
+            uint32_t h2 = static_cast<uint32_t>(hash >> 32);
+            for (unsigned i = 0; i < m_hash_count; i++) {
+                uint64_t bit = position(h1 + i * h2, size);
+                m_bits[bit >> 3] |= static_cast<char>(1 << (bit & 7));
+            }
+        }
+
+        /**
+         * @brief Check if the filter may contain string with given hash
+         * @param hash Hash of the string calculated by stable_hash()
+         * @return `false` if the string certainly wasn't added to the filter
+         */
+        bool may_contain(uint64_t hash) const {
+            if (m_bits.empty())
+                return false;
+
+            uint64_t size = bit_count();
+            uint32_t h1 = static_cast<uint32_t>(hash);
+            uint32_t h2 = static_cast<uint32_t>(hash >> 32);
+            for (unsigned i = 0; i < m_hash_count; i++) {
+                uint64_t bit = position(h1 + i * h2, size);
+                if (!(m_bits[bit >> 3] & (1 << (bit & 7))))
+                    return false;
+            }
+
+            return true;
+        }
+
+        /**
+         * @brief Get the number of hash functions
+         */
+        unsigned hash_count() const {
+            return m_hash_count;
+        }
+
+        /**
+         * @brief Get the size of the filter in bits
+         */
+        uint64_t bit_count() const {
+            return static_cast<uint64_t>(m_bits.size()) * 8;
+        }
+
+        /**
+         * @brief Get bits per item the filter was constructed with
+         * @param items Number of items the filter was sized for
+         * @return Bits per item that give a filter of the same size for the same number of items, 0 for empty
+         * filter constructed without items. Derived from the number of hash functions if the size of the filter
+         * was clamped.
+         */
+        unsigned bits_per_item(std::size_t items) const;
+
+        /**
+         * @brief Get bits of the filter
+         */
+        const std::string& bits() const {
+            return m_bits;
+        }
+
+        /**
+         * @brief Creates string representation of Bloom filter
+         * @return String representation of Bloom filter
+         */
+        std::string string() const;
+
+        /**
+         * @brief Serialize the BloomFilter to CBOR representation
+         * @param enc C-DNS encoder
+         * @return Number of uncompressed bytes written
+         */
+        std::size_t write(CdnsEncoder& enc) const;
+
+        /**
+         * @brief Read the BloomFilter from CBOR input stream
+         * @param dec C-DNS decoder
+         * @throw CdnsDecoderException if the number of hash functions is invalid
+         */
+        void read(CdnsDecoder& dec);
+
+        /**
+         * @brief Reset BloomFilter to empty filter.
+         * Is applied in every call of read() method.
+         */
+        void reset() {
+            m_hash_count = 0;
+            m_bits.clear();
+        }
+
+        private:
+        /**
+         * @brief Get optimal number of hash functions for given bits per item
+         */
+        static unsigned hash_count_for(unsigned bits_per_item) {
+            // Optimal number of hash functions is bits per item * ln 2
+            return std::min(std::max((bits_per_item * 693 + 500) / 1000, 1U), MAX_HASH_COUNT);
+        }
+
+        /**
+         * @brief Map 32-bit hash to bit of the filter without division
+         */
+        static uint64_t position(uint32_t hash, uint64_t size) {
+            return (static_cast<uint64_t>(hash) * size) >> 32;
+        }
+
+        unsigned m_hash_count;
+        std::string m_bits;
+    };
+}
@@ -15,6 +15,9 @@ std::size_t CDNS::CdnsExporter::write_block(CdnsBlock& block)
     if (block.get_item_count() == 0)
         return 0;
 
+    uint64_t start = monotonic_ns();
+    uint64_t output_ns = m_encoder.get_output_ns();
+    uint64_t output_bytes = m_encoder.get_output_bytes();
     std::size_t written = 0;
 
     // If it's the first Block in current output write start of the C-DNS file
@@ -25,6 +28,56 @@ std::size_t CDNS::CdnsExporter::write_block(CdnsBlock& block)
     written += block.write(m_encoder);
     m_blocks_written++;
 
+    // Update statistics
+    BlockWriteStats& last = m_stats.last_block;
+    last.qr_count = block.get_qr_count();
+    last.aec_count = block.get_aec_count();
+    last.mm_count = block.get_mm_count();
+    last.uncompressed_bytes = written;
+    last.compressed_bytes = m_encoder.get_output_bytes() - output_bytes;
+    last.output_ns = m_encoder.get_output_ns() - output_ns;
+    last.tables = block.get_tables_stats();
+    last.write_ns = monotonic_ns() - start;
+
+    m_stats.blocks_written++;
+    m_stats.qr_count += last.qr_count;
+    m_stats.aec_count += last.aec_count;
+    m_stats.mm_count += last.mm_count;
+    m_stats.uncompressed_bytes += last.uncompressed_bytes;
+    m_stats.write_ns += last.write_ns;
+    m_stats.output_ns += last.output_ns;
+    m_stats.tables += last.tables;
+
+    return written;
+}
+
+std::size_t CDNS::CdnsExporter::write_raw_block(RawBlock& block)
+{
+    uint64_t start = monotonic_ns();
+    uint64_t output_ns = m_encoder.get_output_ns();
+    uint64_t output_bytes = m_encoder.get_output_bytes();
+    std::size_t written = 0;
+
+    // If it's the first Block in current output write start of the C-DNS file
+    if (m_blocks_written == 0)
+        written += write_file_header();
+
+    written += block.write(m_encoder);
+    m_blocks_written++;
+
+    // Update statistics, item counts and Block tables of raw Block are unknown
+    BlockWriteStats& last = m_stats.last_block;
+    last = BlockWriteStats();
+    last.uncompressed_bytes = written;
+    last.compressed_bytes = m_encoder.get_output_bytes() - output_bytes;
+    last.output_ns = m_encoder.get_output_ns() - output_ns;
+    last.write_ns = monotonic_ns() - start;
+
+    m_stats.blocks_written++;
+    m_stats.uncompressed_bytes += last.uncompressed_bytes;
+    m_stats.write_ns += last.write_ns;
+    m_stats.output_ns += last.output_ns;
+
     return written;
 }
 
@@ -71,22 +124,202 @@ void CDNS::CdnsReader::read_file_header()
 CDNS::CdnsBlockRead CDNS::CdnsReader::read_block(bool& eof)
 {
     CdnsBlockRead block;
+    read_block_into(block, eof);
+    return block;
+}
+
+void CDNS::CdnsReader::read_block_into(CdnsBlockRead& block, bool& eof)
+{
+    read_block_into(block, eof, BlockSummaryFilter());
+}
+
+bool CDNS::CdnsReader::read_block_into(CdnsBlockRead& block, bool& eof, const BlockSummaryFilter& filter)
+{
+    ScopedTimer timer(m_stats.read_ns, m_timing);
+    eof = false;
+
+    // Collect time spent converting items of the previous Block before the Block is cleared
+    m_stats.phases_ns.materialize_ns += block.get_read_stats().materialize_ns;
+    block.set_timing(m_timing);
+
+    if (blocks_end()) {
+        eof = true;
+        block.clear();
+        return false;
+    }
+
+    uint64_t consumed = m_decoder.get_consumed_bytes();
+    bool decoded = block.read(m_decoder, m_file_preamble.m_block_parameters, filter);
+    m_blocks_read++;
+
+    // Update statistics
+    if (decoded) {
+        m_stats.blocks_read++;
+        m_stats.qr_count += block.get_qr_count();
+        m_stats.aec_count += block.get_aec_count();
+        m_stats.mm_count += block.get_mm_count();
+    }
+    else {
+        m_stats.blocks_skipped++;
+    }
+    m_stats.last_block_bytes = m_decoder.get_consumed_bytes() - consumed;
+    m_stats.block_bytes += m_stats.last_block_bytes;
+    m_stats.max_block_bytes = std::max(m_stats.max_block_bytes, m_stats.last_block_bytes);
+    m_stats.phases_ns += block.get_read_stats();
+    return decoded;
+}
+
+void CDNS::CdnsReader::read_block_matching(CdnsBlockRead& block, bool& eof, const BlockLookup& lookup)
+{
+    BlockSummaryFilter filter(std::cref(lookup));
+    while (!read_block_into(block, eof, filter) && !eof);
+}
+
+void CDNS::CdnsReader::read_raw_block(RawBlock& block, bool& eof)
+{
+    read_raw_block(block, eof, BlockSummaryFilter());
+}
+
+bool CDNS::CdnsReader::read_raw_block(RawBlock& block, bool& eof, const BlockSummaryFilter& filter)
+{
+    ScopedTimer timer(m_stats.read_ns, m_timing);
     eof = false;
 
+    if (blocks_end()) {
+        eof = true;
+        return false;
+    }
+
+    uint64_t consumed = m_decoder.get_consumed_bytes();
+    bool copied = block.read(m_decoder, filter);
+    if (block.get_block_parameters_index() >= m_file_preamble.m_block_parameters.size())
+        throw CdnsDecoderException("Block parameters index for C-DNS block is too high");
+    m_blocks_read++;
+
+    // Update statistics
+    if (copied)
+        m_stats.blocks_read++;
+    else
+        m_stats.blocks_skipped++;
+    m_stats.last_block_bytes = m_decoder.get_consumed_bytes() - consumed;
+    m_stats.block_bytes += m_stats.last_block_bytes;
+    m_stats.max_block_bytes = std::max(m_stats.max_block_bytes, m_stats.last_block_bytes);
+    return copied;
+}
+
+bool CDNS::CdnsReader::blocks_end()
+{
     if (m_indef_blocks && m_decoder.peek_type() == CborType::BREAK) {
         m_decoder.read_break();
-        eof = true;
         m_indef_blocks = false;
         m_blocks_count = m_blocks_read;
-        return block;
+        return true;
     }
-    else if (!m_indef_blocks && m_blocks_read == m_blocks_count) {
-        eof = true;
-        return block;
+
+    return !m_indef_blocks && m_blocks_read == m_blocks_count;
+}
+
+std::size_t CDNS::CdnsReader::read_qr_columns(QueryResponseColumns& columns)
+{
+    CdnsBlockRead block;
+    bool eof = false;
+    std::size_t blocks = 0;
+
+    columns.clear();
+    while (true) {
+        read_block_into(block, eof);
+        if (eof)
+            break;
+
+        block.read_qr_columns(columns, true);
+        blocks++;
     }
 
-    block.read(m_decoder, m_file_preamble.m_block_parameters);
-    m_blocks_read++;
+    return blocks;
+}
 
-    return block;
-}
\ No newline at end of file
+CDNS::CdnsBlockPrefetcher::CdnsBlockPrefetcher(CdnsReader& reader, std::size_t depth)
+    : m_reader(reader), m_depth(depth), m_pool(depth), m_ready(), m_eof(false), m_stop(false), m_error()
+{
+    if (depth == 0)
+        throw std::invalid_argument("Prefetch depth has to be at least 1");
+
+    m_thread = std::thread(&CdnsBlockPrefetcher::run, this);
+}
+
+CDNS::CdnsBlockPrefetcher::~CdnsBlockPrefetcher()
+{
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_stop = true;
+    }
+    m_space_cv.notify_all();
+
+    if (m_thread.joinable())
+        m_thread.join();
+}
+
+void CDNS::CdnsBlockPrefetcher::next(CdnsBlockRead& block, bool& eof)
+{
+    std::unique_lock<std::mutex> lock(m_mutex);
+    m_ready_cv.wait(lock, [this]{ return !m_ready.empty() || m_eof; });
+
+    if (!m_ready.empty()) {
+        CdnsBlockRead next = std::move(m_ready.front());
+        m_ready.pop_front();
+        lock.unlock();
+        m_space_cv.notify_one();
+
+        m_pool.release(std::move(block));
+        block = std::move(next);
+        eof = false;
+        return;
+    }
+
+    block.clear();
+    eof = true;
+
+    if (m_error) {
+        std::exception_ptr error = m_error;
+        m_error = nullptr;
+        std::rethrow_exception(error);
+    }
+}
+
+void CDNS::CdnsBlockPrefetcher::run()
+{
+    while (true) {
+        {
+            std::unique_lock<std::mutex> lock(m_mutex);
+            m_space_cv.wait(lock, [this]{ return m_stop || m_ready.size() < m_depth; });
+            if (m_stop)
+                return;
+        }
+
+        CdnsBlockRead block = m_pool.acquire();
+        bool eof = false;
+        std::exception_ptr error;
+
+        try {
+            m_reader.read_block_into(block, eof);
+        }
+        catch (...) {
+            error = std::current_exception();
+        }
+
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            if (error || eof) {
+                m_error = error;
+                m_eof = true;
+            }
+            else {
+                m_ready.push_back(std::move(block));
+            }
+        }
+        m_ready_cv.notify_one();
+
+        if (error || eof)
+            return;
+    }
+}
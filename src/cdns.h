@@ -15,18 +15,37 @@
 #include <istream>
 #include <iostream>
 #include <sys/socket.h>
+#include <algorithm>
+#include <deque>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <exception>
+#include <memory>
+#include <map>
+#include <vector>
+#include <functional>
 
 #include "format_specification.h"
 #include "dns.h"
 #include "block_table.h"
 #include "file_preamble.h"
 #include "block.h"
+#include "block_pool.h"
+#include "string_interner.h"
 #include "hash.h"
 #include "interface.h"
 #include "timestamp.h"
 #include "writer.h"
+#include "io_uring_writer.h"
 #include "cdns_encoder.h"
 #include "cdns_decoder.h"
+#include "stats.h"
+#include "columns.h"
+#include "generator.h"
+#include "merge.h"
+#include "split.h"
+#include "compression.h"
 
 namespace CDNS {
 
@@ -43,6 +62,10 @@ namespace CDNS {
      * To enforce writing of not fully buffered block to output write_block() method is provided.
      * This method can also write to output an externally created C-DNS block. (WARNING: External
      * blocks aren't checked against CdnsExporter's Block parameters. This is up to the user!!!)
+     *
+     * For double-buffering user can take the buffered block out with swap_block(), which replaces
+     * it with a spare block from exporter's pool, and hand it back with recycle_block() once it's
+     * written or otherwise processed.
      */
     class CdnsExporter {
         public:
@@ -55,13 +78,15 @@ namespace CDNS {
         template<typename T>
         CdnsExporter(FilePreamble& fp, const T& out, CborOutputCompression compression)
             : m_file_preamble(fp), m_block(fp.get_block_parameters(0), 0), m_encoder(out, compression),
-              m_active_block_parameters(0), m_blocks_written(0) {}
+              m_active_block_parameters(0), m_blocks_written(0), m_spare_blocks(), m_stats(),
+              m_output_bytes_base(0), m_ip_interner(), m_name_interner() {}
 
         /**
          * @brief Destroy the CdnsExporter object and write the end of C-DNS output
          * if any output is currently open
          */
         ~CdnsExporter() {
+            m_block.set_string_interners(nullptr, nullptr);
             try {
                 if (m_blocks_written > 0)
                     m_encoder.write_break();
@@ -88,7 +113,11 @@ namespace CDNS {
          */
         std::size_t buffer_qr(const GenericQueryResponse& qr, const boost::optional<BlockStatistics>& stats = boost::none) {
             std::size_t written = 0;
-            if (m_block.add_question_response_record(qr, stats))
+            std::size_t count = m_block.get_qr_count();
+            bool full = m_block.add_question_response_record(qr, stats);
+            if (m_block.get_qr_count() == count)
+                m_stats.dropped_qrs++;
+            if (full)
                 written = write_block();
 
             return written;
@@ -105,6 +134,9 @@ namespace CDNS {
          */
         std::size_t buffer_aec(const GenericAddressEventCount& aec, const boost::optional<BlockStatistics>& stats = boost::none) {
             std::size_t written = 0;
+            const BlockParameters& bp = m_file_preamble.get_block_parameters(m_block.get_block_parameters_index());
+            if (!(bp.storage_parameters.storage_hints.other_data_hints & OtherDataHintsMask::address_event_counts))
+                m_stats.dropped_aecs++;
             if (m_block.add_address_event_count(aec, stats))
                 written = write_block();
 
@@ -122,7 +154,11 @@ namespace CDNS {
          */
         std::size_t buffer_mm(const GenericMalformedMessage& mm, const boost::optional<BlockStatistics>& stats = boost::none) {
             std::size_t written = 0;
-            if (m_block.add_malformed_message(mm, stats))
+            std::size_t count = m_block.get_mm_count();
+            bool full = m_block.add_malformed_message(mm, stats);
+            if (m_block.get_mm_count() == count)
+                m_stats.dropped_mms++;
+            if (full)
                 written = write_block();
 
             return written;
@@ -137,6 +173,17 @@ namespace CDNS {
          */
         std::size_t write_block(CdnsBlock& block);
 
+        /**
+         * @brief Write C-DNS Block read by CdnsReader::read_raw_block() to output without re-encoding it
+         *
+         * The Block's preamble has to refer to Block parameters of this exporter's file preamble.
+         * Item counts in exporter statistics aren't updated for raw Blocks.
+         * @param block Raw C-DNS block to output
+         * @throw std::exception if writing Block to output fails.
+         * @return Number of uncompressed bytes written
+         */
+        std::size_t write_raw_block(RawBlock& block);
+
         /**
          * @brief Write the internally buffered C-DNS block to output
          * @throw std::exception if writing Block to output fails.
@@ -148,9 +195,127 @@ namespace CDNS {
             m_block.clear();
             m_block.set_block_parameters(m_file_preamble.get_block_parameters(m_active_block_parameters),
                                          m_active_block_parameters);
+            m_block.set_string_interners(m_ip_interner.get(), m_name_interner.get());
             return written;
         }
 
+        /**
+         * @brief Take the internally buffered C-DNS block out of the exporter and replace it with
+         * an empty spare Block using the active Block parameters
+         *
+         * The Blocks are moved in constant time. The returned Block can be filled or written to output
+         * (e.g. with write_block(CdnsBlock&) from another thread while buffering continues) and should
+         * be returned with recycle_block() afterwards to reuse its allocated capacity.
+         *
+         * @return Previously buffered C-DNS block
+         */
+        CdnsBlock swap_block() {
+            CdnsBlock block(std::move(m_block));
+            m_block = m_spare_blocks.acquire();
+            m_block.set_block_parameters(m_file_preamble.get_block_parameters(m_active_block_parameters),
+                                         m_active_block_parameters);
+            m_block.set_max_block_size(block.get_max_block_size());
+            m_block.set_max_block_age(block.get_max_block_age());
+            m_block.set_write_summary(block.get_write_summary());
+            m_block.set_summary_filter(block.get_summary_filter());
+            m_block.set_string_interners(m_ip_interner.get(), m_name_interner.get());
+            return block;
+        }
+
+        /**
+         * @brief Return a Block obtained by swap_block() to exporter's pool of spare Blocks.
+         * This method is thread-safe.
+         * @param block Block to recycle, left empty
+         */
+        void recycle_block(CdnsBlock&& block) {
+            m_spare_blocks.release(std::move(block));
+        }
+
+        /**
+         * @brief Write the internally buffered C-DNS block to output if it exceeded maximum Block age
+         *
+         * Full Blocks are sealed when new items are buffered. This method should be called periodically
+         * to also bound the latency of Blocks that stopped receiving new items.
+         *
+         * @param now Current time
+         * @throw std::exception if writing Block to output fails.
+         * @return Number of uncompressed bytes written, 0 if the Block wasn't written
+         */
+        std::size_t write_block_if_expired(const Timestamp& now) {
+            if (m_block.get_item_count() == 0 || !m_block.expired(now))
+                return 0;
+
+            return write_block();
+        }
+
+        /**
+         * @brief Set byte budget for internally buffered Blocks. Block is written to output when its
+         * estimated encoded size reaches the budget.
+         * @param size Maximum estimated size of Block in bytes (0 means unlimited)
+         */
+        void set_max_block_size(std::size_t size) {
+            m_block.set_max_block_size(size);
+        }
+
+        /**
+         * @brief Set maximum age of internally buffered Blocks. Block is written to output when the time
+         * between its earliest time and the newest buffered item reaches the maximum age.
+         * @param ticks Maximum age in ticks of the active Block parameters (0 means unlimited)
+         */
+        void set_max_block_age(uint64_t ticks) {
+            m_block.set_max_block_age(ticks);
+        }
+
+        /**
+         * @brief Enable or disable writing of implementation-private BlockSummary (latest time, item counts,
+         * client address range and RCODE histogram) with each Block. Readers can use it to skip Blocks
+         * without decoding them, see CdnsReader::read_block_into(). Disabled by default.
+         * @param enable `true` to write the summary
+         */
+        void set_block_summary(bool enable) {
+            m_block.set_write_summary(enable);
+        }
+
+        /**
+         * @brief Include Bloom filter over NAME/RDATA and IP address Block tables in BlockSummary written
+         * with each Block, so readers can skip Blocks that don't contain given QNAMEs or addresses
+         * (see CdnsReader::read_block_matching()). Enabling the filter also enables the summary.
+         * Disabled by default.
+         * @param bits_per_item Size of the filter in bits per string in the Block tables
+         * (BloomFilter::DEFAULT_BITS_PER_ITEM gives about 1 % false positives), 0 disables the filter
+         */
+        void set_block_filter(unsigned bits_per_item) {
+            m_block.set_summary_filter(bits_per_item);
+            if (bits_per_item)
+                m_block.set_write_summary(true);
+        }
+
+        /**
+         * @brief Intern IP addresses and NAMEs/RDATAs across internally buffered Blocks
+         *
+         * Strings repeated in consecutive Blocks (popular QNAMEs, resolver addresses) are then hashed
+         * and copied to the interner once and adding them to a Block takes one lookup in the interner
+         * instead of building Block table's index map in every Block. Encoded Blocks are the same
+         * as without interning. Memory use is bounded by the capacity of the interners.
+         *
+         * Interning pays off for large Blocks with many repeated strings. With small Blocks the lookups
+         * in the interners (much larger than Block tables) miss CPU caches more often than Block tables'
+         * own index maps and buffering is slower.
+         *
+         * If some items are already buffered, the currently buffered Block doesn't use the interners
+         * and interning starts with the next Block.
+         *
+         * @param capacity Maximum number of interned IP addresses and of interned NAMEs/RDATAs,
+         * 0 disables interning (default)
+         */
+        void set_string_interning(std::size_t capacity) {
+            m_block.set_string_interners(nullptr, nullptr);
+            m_ip_interner.reset(capacity ? new StringInterner(capacity) : nullptr);
+            m_name_interner.reset(capacity ? new StringInterner(capacity) : nullptr);
+            if (m_block.get_item_count() == 0)
+                m_block.set_string_interners(m_ip_interner.get(), m_name_interner.get());
+        }
+
         /**
          * @brief Close the current output and open a new one with given file name or file descriptor
          * @param out New output to open (file name[std::string] or file descriptor[int])
@@ -161,15 +326,24 @@ namespace CDNS {
          */
         template<typename T>
         std::size_t rotate_output(const T& out, bool export_current_block) {
+            uint64_t start = monotonic_ns();
             std::size_t written = 0;
             if (export_current_block)
                 written += write_block();
 
-            if (m_blocks_written > 0)
-                written += m_encoder.write_break();
+            if (m_blocks_written > 0) {
+                std::size_t end = m_encoder.write_break();
+                m_stats.uncompressed_bytes += end;
+                written += end;
+            }
 
             m_encoder.rotate_output(out);
             m_blocks_written = 0;
+
+            uint64_t duration = monotonic_ns() - start;
+            m_stats.rotations++;
+            m_stats.rotation_ns += duration;
+            m_stats.max_rotation_ns = std::max(m_stats.max_rotation_ns, duration);
             return written;
         }
 
@@ -217,6 +391,28 @@ namespace CDNS {
             return m_blocks_written;
         }
 
+        /**
+         * @brief Get runtime statistics of the exporter
+         *
+         * The statistics are updated by the thread buffering items and by the thread writing Blocks,
+         * so they shouldn't be read concurrently with write_block() called from another thread.
+         *
+         * @return Cumulative statistics since the exporter was created or since the last reset_stats()
+         */
+        ExporterStats get_stats() const {
+            ExporterStats ret = m_stats;
+            ret.compressed_bytes = m_encoder.get_output_bytes() - m_output_bytes_base;
+            return ret;
+        }
+
+        /**
+         * @brief Reset all runtime statistics of the exporter to 0
+         */
+        void reset_stats() {
+            m_stats = ExporterStats();
+            m_output_bytes_base = m_encoder.get_output_bytes();
+        }
+
         /**
          * @brief Add another Block parameters to File preamble
          *
@@ -283,6 +479,23 @@ namespace CDNS {
          * @brief Number of Blocks written to the currently open output (gets reset on output rotation)
          */
         std::size_t m_blocks_written;
+
+        /**
+         * @brief Spare Blocks for swap_block()
+         */
+        BlockPool<CdnsBlock> m_spare_blocks;
+
+        /**
+         * @brief Runtime statistics, compressed bytes are taken from the encoder on request
+         */
+        ExporterStats m_stats;
+        uint64_t m_output_bytes_base;
+
+        /**
+         * @brief Interners of IP addresses and NAMEs/RDATAs used by the internally buffered Block
+         */
+        std::unique_ptr<StringInterner> m_ip_interner;
+        std::unique_ptr<StringInterner> m_name_interner;
     };
 
     /**
@@ -295,6 +508,8 @@ namespace CDNS {
      * From these Blocks user can extract Query Response pairs and other data. When CdnsReader
      * reaches the end of C-DNS data it sets the "eof" parameter in read_block() method to TRUE.
      * CdnsBlockRead returned by this call is then empty.
+     *
+     * To reuse one Block object for reading of all Blocks use read_block_into() method instead.
      */
     class CdnsReader {
         public:
@@ -308,16 +523,129 @@ namespace CDNS {
                                           m_decoder(input),
                                           m_blocks_count(0),
                                           m_blocks_read(0),
-                                          m_indef_blocks(false) { read_file_header(); }
+                                          m_indef_blocks(false),
+                                          m_stats(),
+                                          m_timing(false) { read_file_header(); }
 
         /**
          * @brief Read whole C-DNS Block from input stream
+         *
+         * Time spent converting items of the returned Block to generic structures isn't included
+         * in the reader's statistics (ReaderStats::phases_ns), because the conversion happens after
+         * the Block is handed out. It's available in the Block's CdnsBlockRead::get_read_stats().
+         * Use read_block_into() to have it accounted by the reader.
+         *
          * @param eof If set by this method to TRUE, then reader has reached the end
          * of C-DNS file and the returned C-DNS block is empty. Otherwise set to FALSE.
          * @return New C-DNS Block read from input stream
          */
         CdnsBlockRead read_block(bool& eof);
 
+        /**
+         * @brief Read whole C-DNS Block from input stream into existing Block
+         *
+         * The given Block is cleared and refilled, reusing the capacity of its tables and arrays.
+         * Reading all Blocks of the input into the same Block (or Blocks from BlockPool) avoids
+         * most allocations once the Block grows to the size of the largest Block in the input.
+         *
+         * @param block C-DNS block to fill with Block read from input stream
+         * @param eof If set by this method to TRUE, then reader has reached the end
+         * of C-DNS file and the given C-DNS block is left empty. Otherwise set to FALSE.
+         */
+        void read_block_into(CdnsBlockRead& block, bool& eof);
+
+        /**
+         * @brief Read C-DNS Block from input stream into existing Block unless the Block's summary
+         * is rejected by the filter
+         *
+         * Blocks written with BlockSummary (see CdnsExporter::set_block_summary()) are passed to the filter
+         * after their Block preamble and summary are decoded. Rejected Blocks are skipped without decoding
+         * their tables and items and only their Block preamble and summary are filled in the given Block.
+         * Blocks without summary are always decoded.
+         *
+         * @param block C-DNS block to fill with Block read from input stream
+         * @param eof If set by this method to TRUE, then reader has reached the end
+         * of C-DNS file and the given C-DNS block is left empty. Otherwise set to FALSE.
+         * @param filter Filter deciding from Block preamble and summary whether the Block is decoded
+         * @return `true` if the Block was decoded, `false` if it was skipped by the filter or at the end of input
+         */
+        bool read_block_into(CdnsBlockRead& block, bool& eof, const BlockSummaryFilter& filter);
+
+        /**
+         * @brief Read next C-DNS Block that may contain any of the NAMEs or IP addresses of the lookup
+         * into existing Block
+         *
+         * Blocks whose Bloom filter in BlockSummary (see CdnsExporter::set_block_filter()) rules out
+         * all NAMEs and addresses of the lookup are skipped without decoding them and counted in
+         * ReaderStats::blocks_skipped. Blocks without the filter are always decoded.
+         *
+         * @param block C-DNS block to fill with Block read from input stream
+         * @param eof If set by this method to TRUE, then reader has reached the end
+         * of C-DNS file and the given C-DNS block is left empty. Otherwise set to FALSE.
+         * @param lookup NAMEs and IP addresses to look for
+         */
+        void read_block_matching(CdnsBlockRead& block, bool& eof, const BlockLookup& lookup);
+
+        /**
+         * @brief Read C-DNS Block from input stream without decoding anything but its Block preamble
+         *
+         * The rest of the Block is kept as encoded CBOR, so the Block can be copied to another
+         * output with CdnsExporter::write_raw_block() at the cost of copying its bytes. Item counts
+         * in reader statistics aren't updated for raw Blocks.
+         *
+         * @param block Raw Block to fill with Block read from input stream
+         * @param eof If set by this method to TRUE, then reader has reached the end
+         * of C-DNS file and the given Block is left unchanged. Otherwise set to FALSE.
+         */
+        void read_raw_block(RawBlock& block, bool& eof);
+
+        /**
+         * @brief Read C-DNS Block from input stream without decoding anything but its Block preamble
+         * and summary, unless the Block's summary is rejected by the filter
+         *
+         * Rejected Blocks are skipped and counted in ReaderStats::blocks_skipped, see RawBlock::read().
+         * Blocks without summary are always read.
+         *
+         * @param block Raw Block to fill with Block read from input stream
+         * @param eof If set by this method to TRUE, then reader has reached the end
+         * of C-DNS file and the given Block is left unchanged. Otherwise set to FALSE.
+         * @param filter Filter deciding from Block preamble and summary whether the Block is read
+         * @return `true` if the Block was read, `false` if it was skipped by the filter or at the end of input
+         */
+        bool read_raw_block(RawBlock& block, bool& eof, const BlockSummaryFilter& filter);
+
+        /**
+         * @brief Read all remaining C-DNS Blocks from input stream and decode their Query/Response
+         * items to struct-of-arrays columns
+         *
+         * Columns of all Blocks are concatenated. Dictionaries contain the IP address and NAME/RDATA
+         * tables of all Blocks one after another, so one value may appear in them multiple times.
+         * @param columns Columns to fill, their previous content is replaced
+         * @return Number of Blocks read
+         * @throw std::runtime_error if the Blocks use different time resolutions
+         */
+        std::size_t read_qr_columns(QueryResponseColumns& columns);
+
+        /**
+         * @brief Enable or disable timers in reader statistics (counters are always collected)
+         * @param enable `true` to enable measuring of time spent in individual phases of reading
+         */
+        void set_timing(bool enable) {
+            m_timing = enable;
+            m_decoder.set_timing(enable);
+        }
+
+        /**
+         * @brief Get runtime statistics of the reader
+         * @return Cumulative statistics since the reader was created
+         */
+        ReaderStats get_stats() const {
+            ReaderStats ret = m_stats;
+            ret.bytes_consumed = m_decoder.get_consumed_bytes();
+            ret.decoder = m_decoder.get_stats();
+            return ret;
+        }
+
         FilePreamble m_file_preamble; //!< C-DNS file preamble
 
         private:
@@ -327,9 +655,306 @@ namespace CDNS {
          */
         void read_file_header();
 
+        /**
+         * @brief Check if all Blocks were read from input stream (reads the end of indefinite
+         * length Block array if it's reached)
+         * @return `true` if there are no more Blocks to read
+         */
+        bool blocks_end();
+
         CdnsDecoder m_decoder;
         uint64_t m_blocks_count;
         uint64_t m_blocks_read;
         bool m_indef_blocks;
+        ReaderStats m_stats;
+        bool m_timing;
+    };
+
+    /**
+     * @brief Reads C-DNS Blocks from CdnsReader ahead of time on a background thread
+     *
+     * Decoding of the next Blocks overlaps with processing of the current one. The prefetcher
+     * takes over the reader for its whole life, so the reader mustn't be used directly until
+     * the prefetcher is destroyed. Reader statistics are updated by the background thread and
+     * don't include time spent converting items of the prefetched Blocks to generic structures.
+     */
+    class CdnsBlockPrefetcher {
+        public:
+        static constexpr std::size_t DEFAULT_DEPTH = 2;
+
+        /**
+         * @brief Construct a new CdnsBlockPrefetcher object and start reading Blocks on background thread
+         * @param reader Reader to read the Blocks from
+         * @param depth Maximum number of Blocks read ahead
+         * @throw std::invalid_argument if depth is 0
+         */
+        CdnsBlockPrefetcher(CdnsReader& reader, std::size_t depth = DEFAULT_DEPTH);
+
+        /**
+         * @brief Stop the background thread. Waits until the Block being read is finished.
+         */
+        ~CdnsBlockPrefetcher();
+
+        /** Delete copy constructor and assignment operator */
+        CdnsBlockPrefetcher(const CdnsBlockPrefetcher& copy) = delete;
+        CdnsBlockPrefetcher& operator=(const CdnsBlockPrefetcher& rhs) = delete;
+
+        /**
+         * @brief Get next Block read by the background thread, waiting for it if necessary
+         *
+         * Previous content of the given Block is recycled for reading of the following Blocks.
+         * @param block C-DNS block to fill with the next Block
+         * @param eof If set by this method to TRUE, then the reader has reached the end of C-DNS
+         * file and the given Block is left empty. Otherwise set to FALSE.
+         * @throw Rethrows exception thrown by the reader on the background thread
+         */
+        void next(CdnsBlockRead& block, bool& eof);
+
+        private:
+        /**
+         * @brief Main loop of the background thread
+         */
+        void run();
+
+        CdnsReader& m_reader;
+        std::size_t m_depth;
+        BlockPool<CdnsBlockRead> m_pool;
+        std::deque<CdnsBlockRead> m_ready;
+        bool m_eof;
+        bool m_stop;
+        std::exception_ptr m_error;
+        std::mutex m_mutex;
+        std::condition_variable m_ready_cv;
+        std::condition_variable m_space_cv;
+        std::thread m_thread;
+    };
+
+    /**
+     * @brief Decodes and processes Blocks of one C-DNS input on multiple threads
+     *
+     * The calling thread reads the Blocks with CdnsReader::read_raw_block(), which only copies their
+     * bytes (or skips them if they are rejected by the summary filter). Worker threads decode the Blocks
+     * and process them with the given function. Results of the processing are passed to the consumer
+     * on the calling thread in the order of the Blocks in the input, so the output is the same as
+     * if the Blocks were processed one by one. Memory use is bounded by the number of Blocks being
+     * processed at once (twice the number of workers).
+     *
+     * The reader is used exclusively by run() until it returns. Reader statistics don't include
+     * decoding of the Blocks, which happens on the workers.
+     *
+     * @tparam Result Type of the result of processing of one Block
+     */
+    template<typename Result>
+    class ParallelBlockReader {
+        public:
+        /**
+         * @brief Function processing decoded Block on a worker thread, called concurrently for
+         * different Blocks
+         */
+        using Process = std::function<Result(CdnsBlockRead& block)>;
+
+        /**
+         * @brief Function consuming results of processed Blocks in the input order on the calling thread
+         */
+        using Consume = std::function<void(Result& result)>;
+
+        /**
+         * @brief Construct a new ParallelBlockReader object
+         * @param reader Reader of the input
+         * @param threads Number of worker threads (0 for the number of CPUs)
+         */
+        explicit ParallelBlockReader(CdnsReader& reader, std::size_t threads = 0)
+            : m_reader(reader), m_threads(threads ? threads : std::max(std::thread::hardware_concurrency(), 1U)),
+              m_filter() {}
+
+        /** Delete copy constructor and assignment operator */
+        ParallelBlockReader(const ParallelBlockReader& copy) = delete;
+        ParallelBlockReader& operator=(const ParallelBlockReader& rhs) = delete;
+
+        /**
+         * @brief Set filter of the Blocks by their summary. Rejected Blocks aren't decoded nor processed.
+         * @param filter Filter deciding from Block preamble and summary whether the Block is processed
+         */
+        void set_filter(const BlockSummaryFilter& filter) {
+            m_filter = filter;
+        }
+
+        /**
+         * @brief Get the number of worker threads
+         */
+        std::size_t threads() const {
+            return m_threads;
+        }
+
+        /**
+         * @brief Process all remaining Blocks of the input
+         * @param process Function processing decoded Block on a worker thread
+         * @param consume Function consuming results in the input order on the calling thread
+         * @throw Rethrows exceptions thrown while reading, decoding, processing or consuming the Blocks
+         * @return Number of processed Blocks
+         */
+        uint64_t run(const Process& process, const Consume& consume) {
+            State state(m_threads);
+            std::vector<BlockParameters> block_parameters = m_reader.m_file_preamble.m_block_parameters;
+
+            for (std::size_t i = 0; i < m_threads; i++)
+                state.workers.emplace_back(&ParallelBlockReader::work, std::ref(state), std::cref(process),
+                                           std::ref(block_parameters));
+
+            try {
+                read(state, consume);
+            }
+            catch (...) {
+                state.stop(std::current_exception());
+            }
+
+            state.join();
+            if (state.error)
+                std::rethrow_exception(state.error);
+
+            return state.consumed;
+        }
+
+        private:
+        /**
+         * @brief Raw Block waiting for a worker
+         */
+        struct Task {
+            uint64_t index;
+            RawBlock raw;
+        };
+
+        /**
+         * @brief State shared by the calling thread and the workers during run()
+         */
+        struct State {
+            explicit State(std::size_t threads) : tasks(), done(), spare(), workers(), max_pending(2 * threads),
+                                                  consumed(0), finished(false), error() {}
+
+            /**
+             * @brief Stop the workers after an error (keeps the first error)
+             */
+            void stop(std::exception_ptr e) {
+                std::lock_guard<std::mutex> lock(mutex);
+                if (!error)
+                    error = e;
+                finished = true;
+                task_cv.notify_all();
+                done_cv.notify_all();
+            }
+
+            /**
+             * @brief Wait for the workers to finish
+             */
+            void join() {
+                {
+                    std::lock_guard<std::mutex> lock(mutex);
+                    finished = true;
+                }
+                task_cv.notify_all();
+                for (auto& worker : workers) {
+                    if (worker.joinable())
+                        worker.join();
+                }
+            }
+
+            std::deque<Task> tasks; //!< Blocks waiting for a worker
+            std::map<uint64_t, Result> done; //!< Results waiting for the consumer, by Block position
+            std::vector<RawBlock> spare; //!< Raw Blocks to reuse
+            std::vector<std::thread> workers;
+            std::size_t max_pending; //!< Maximum number of Blocks read but not yet consumed
+            uint64_t consumed;
+            bool finished;
+            std::exception_ptr error;
+            std::mutex mutex;
+            std::condition_variable task_cv;
+            std::condition_variable done_cv;
+        };
+
+        /**
+         * @brief Read Blocks for the workers and consume their results on the calling thread
+         */
+        void read(State& state, const Consume& consume) {
+            uint64_t read = 0;
+            bool eof = false;
+            std::unique_lock<std::mutex> lock(state.mutex);
+
+            while (!state.error) {
+                // Consume finished Blocks in the input order
+                auto it = state.done.find(state.consumed);
+                if (it != state.done.end()) {
+                    Result result(std::move(it->second));
+                    state.done.erase(it);
+                    lock.unlock();
+                    consume(result);
+                    lock.lock();
+                    state.consumed++;
+                    continue;
+                }
+
+                if (eof && state.consumed == read)
+                    break;
+
+                if (eof || read - state.consumed >= state.max_pending) {
+                    state.done_cv.wait(lock);
+                    continue;
+                }
+
+                RawBlock raw;
+                if (!state.spare.empty()) {
+                    raw = std::move(state.spare.back());
+                    state.spare.pop_back();
+                }
+                lock.unlock();
+
+                bool copied = m_reader.read_raw_block(raw, eof, m_filter);
+
+                lock.lock();
+                if (copied) {
+                    state.tasks.push_back(Task{read++, std::move(raw)});
+                    state.task_cv.notify_one();
+                }
+                else {
+                    state.spare.push_back(std::move(raw));
+                }
+            }
+        }
+
+        /**
+         * @brief Main loop of worker threads
+         */
+        static void work(State& state, const Process& process, std::vector<BlockParameters>& block_parameters) {
+            CdnsBlockRead block;
+
+            try {
+                while (true) {
+                    Task task;
+                    {
+                        std::unique_lock<std::mutex> lock(state.mutex);
+                        state.task_cv.wait(lock, [&state]{ return !state.tasks.empty() || state.finished; });
+                        if (state.tasks.empty() || state.error)
+                            return;
+
+                        task = std::move(state.tasks.front());
+                        state.tasks.pop_front();
+                    }
+
+                    block.read(task.raw, block_parameters);
+                    Result result = process(block);
+
+                    std::lock_guard<std::mutex> lock(state.mutex);
+                    state.done.emplace(task.index, std::move(result));
+                    state.spare.push_back(std::move(task.raw));
+                    state.done_cv.notify_one();
+                }
+            }
+            catch (...) {
+                state.stop(std::current_exception());
+            }
+        }
+
+        CdnsReader& m_reader;
+        std::size_t m_threads;
+        BlockSummaryFilter m_filter;
     };
 }
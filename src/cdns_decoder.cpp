@@ -6,6 +6,8 @@
  * file, you can obtain one at https://mozilla.org/MPL/2.0/.
  */
 
+#include <algorithm>
+
 #include "cdns_decoder.h"
 
 CDNS::CborType CDNS::CdnsDecoder::peek_type()
@@ -94,6 +96,13 @@ bool CDNS::CdnsDecoder::read_bool()
 }
 
 std::string CDNS::CdnsDecoder::read_bytestring()
+{
+    std::string ret;
+    read_bytestring(ret);
+    return ret;
+}
+
+void CDNS::CdnsDecoder::read_bytestring(std::string& str)
 {
     CborType cbor_type;
     uint8_t item_length;
@@ -107,11 +116,17 @@ std::string CDNS::CdnsDecoder::read_bytestring()
                                     std::to_string(item_length)).c_str());
     }
 
-    return read_string(CborType::BYTE_STRING, read_int(item_length), item_length == 31 ? true : false);
-
+    read_string(CborType::BYTE_STRING, read_int(item_length), item_length == 31 ? true : false, str);
 }
 
 std::string CDNS::CdnsDecoder::read_textstring()
+{
+    std::string ret;
+    read_textstring(ret);
+    return ret;
+}
+
+void CDNS::CdnsDecoder::read_textstring(std::string& str)
 {
     CborType cbor_type;
     uint8_t item_length;
@@ -125,7 +140,7 @@ std::string CDNS::CdnsDecoder::read_textstring()
                                     std::to_string(item_length)).c_str());
     }
 
-    return read_string(CborType::TEXT_STRING, read_int(item_length), item_length == 31 ? true : false);
+    read_string(CborType::TEXT_STRING, read_int(item_length), item_length == 31 ? true : false, str);
 }
 
 uint64_t CDNS::CdnsDecoder::read_array_start(bool& indef)
@@ -216,7 +231,7 @@ void CDNS::CdnsDecoder::skip_item()
                 throw CdnsDecoderException(("Unsupported CBOR additional information value: " +
                                             std::to_string(item_length)).c_str());
             }
-            read_string(cbor_type, read_int(item_length), item_length == 31 ? true : false);
+            read_string_data(cbor_type, read_int(item_length), item_length == 31 ? true : false, nullptr);
             break;
 
         case CborType::ARRAY:
@@ -227,7 +242,7 @@ void CDNS::CdnsDecoder::skip_item()
             }
             if (item_length == 31) {
                 while(true) {
-                    if (peek_type() == CborType::SIMPLE && (m_p[0] & 0x1F) == 31) {
+                    if (peek_type() == CborType::BREAK) {
                         m_p++;
                         break;
                     }
@@ -279,20 +294,28 @@ uint64_t CDNS::CdnsDecoder::read_int(uint8_t item_length)
     return value;
 }
 
-std::string CDNS::CdnsDecoder::read_string(CborType cbor_type, uint64_t length, bool indef)
+void CDNS::CdnsDecoder::read_string(CborType cbor_type, uint64_t length, bool indef, std::string& ret)
 {
-    std::string ret;
+    ret.clear();
+    std::size_t capacity = ret.capacity();
+
+    read_string_data(cbor_type, length, indef, &ret);
 
+    m_stats.strings++;
+    m_stats.string_bytes += ret.size();
+    if (ret.capacity() > capacity)
+        m_stats.string_allocations++;
+}
+
+void CDNS::CdnsDecoder::read_string_data(CborType cbor_type, uint64_t length, bool indef, std::string* ret)
+{
     if (!indef) {
-        ret.reserve(length);
-        for (unsigned i = 0; i < length; i++) {
-            read_to_buffer();
-            ret.push_back(m_p[0]);
-            m_p++;
-        }
+        if (ret)
+            ret->reserve(length);
+        read_bytes(length, ret);
     }
     else {
-        while (peek_type() != CborType::SIMPLE) {
+        while (peek_type() != CborType::BREAK) {
             CborType chunk_type;
             uint8_t chunk_length_value;
             read_cbor_type(chunk_type, chunk_length_value);
@@ -305,18 +328,41 @@ std::string CDNS::CdnsDecoder::read_string(CborType cbor_type, uint64_t length,
             }
 
             uint64_t chunk_length = read_int(chunk_length_value);
-            ret.reserve(ret.size() + chunk_length);
-            for (unsigned i = 0; i < chunk_length; i++) {
-                read_to_buffer();
-                ret.push_back(m_p[0]);
-                m_p++;
-            }
+            if (ret)
+                ret->reserve(ret->size() + chunk_length);
+            read_bytes(chunk_length, ret);
         }
 
         read_break();
     }
+}
 
-    return ret;
+void CDNS::CdnsDecoder::read_bytes(uint64_t length, std::string* ret)
+{
+    while (length > 0) {
+        read_to_buffer();
+        std::size_t chunk = std::min(static_cast<uint64_t>(m_end - m_p), length);
+        if (ret)
+            ret->append(reinterpret_cast<const char*>(m_p), chunk);
+        m_p += chunk;
+        length -= chunk;
+    }
+}
+
+void CDNS::CdnsDecoder::start_recording(std::string& out)
+{
+    m_record = &out;
+    m_record_start = m_p;
+}
+
+void CDNS::CdnsDecoder::stop_recording()
+{
+    if (!m_record)
+        return;
+
+    m_record->append(reinterpret_cast<const char*>(m_record_start), m_p - m_record_start);
+    m_record = nullptr;
+    m_record_start = nullptr;
 }
 
 void CDNS::CdnsDecoder::read_to_buffer()
@@ -325,8 +371,18 @@ void CDNS::CdnsDecoder::read_to_buffer()
         if (m_input.eof())
             throw CdnsDecoderEnd("End of input stream");
 
-        m_input.read(reinterpret_cast<char*>(m_buffer), BUFFER_SIZE);
+        if (m_record)
+            m_record->append(reinterpret_cast<const char*>(m_record_start), m_end - m_record_start);
+
+        {
+            ScopedTimer timer(m_stats.input_ns, m_timing);
+            m_input.read(reinterpret_cast<char*>(m_buffer), BUFFER_SIZE);
+        }
         m_p = m_buffer;
         m_end = m_buffer + m_input.gcount();
+        m_record_start = m_buffer;
+
+        m_stats.buffer_refills++;
+        m_stats.bytes_read += m_input.gcount();
     }
 }
\ No newline at end of file
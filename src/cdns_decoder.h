@@ -14,6 +14,7 @@
 #include <functional>
 
 #include "format_specification.h"
+#include "stats.h"
 
 namespace CDNS {
 
@@ -48,7 +49,8 @@ namespace CDNS {
          * @param input Valid input stream to read C-DNS data from
          * @throw CdnsDecoderException if the input stream isn't valid
          */
-        CdnsDecoder(std::istream& input) : m_input(input) {
+        CdnsDecoder(std::istream& input) : m_input(input), m_stats(), m_timing(false), m_record(nullptr),
+                                           m_record_start(nullptr) {
             m_p = m_end = m_buffer;
             if (input.bad())
                 throw CdnsDecoderException("Bad input stream");
@@ -101,6 +103,14 @@ namespace CDNS {
          */
         std::string read_bytestring();
 
+        /**
+         * @brief Read a byte string item from input stream into existing string, reusing its capacity
+         * @param str String to overwrite with the byte string read from input stream
+         * @throw CdnsDecoderEnd if the end of input stream is reached
+         * @throw CdnsDecoderException if an error is encountered decoding CBOR data
+         */
+        void read_bytestring(std::string& str);
+
         /**
          * @brief Read a text string item from input stream
          * @throw CdnsDecoderEnd if the end of input stream is reached
@@ -109,6 +119,14 @@ namespace CDNS {
          */
         std::string read_textstring();
 
+        /**
+         * @brief Read a text string item from input stream into existing string, reusing its capacity
+         * @param str String to overwrite with the text string read from input stream
+         * @throw CdnsDecoderEnd if the end of input stream is reached
+         * @throw CdnsDecoderException if an error is encountered decoding CBOR data
+         */
+        void read_textstring(std::string& str);
+
         /**
          * @brief Read a start of an array from input stream
          * @param indef Set by this method to TRUE if the array start read from input stream is
@@ -168,6 +186,53 @@ namespace CDNS {
          */
         void skip_item();
 
+        /**
+         * @brief Skip over given number of bytes in input stream without decoding them
+         * @param length Number of bytes to skip
+         * @throw CdnsDecoderEnd if the end of input stream is reached
+         */
+        void skip_bytes(uint64_t length) {
+            read_bytes(length, nullptr);
+        }
+
+        /**
+         * @brief Start appending all bytes consumed from the input stream to given string, until
+         * stop_recording() is called. Used to copy encoded CBOR items verbatim without decoding them.
+         * @param out String to append the consumed bytes to (has to outlive the recording)
+         */
+        void start_recording(std::string& out);
+
+        /**
+         * @brief Stop recording started by start_recording() and append the remaining consumed
+         * bytes to the output string. Does nothing if no recording is in progress.
+         */
+        void stop_recording();
+
+        /**
+         * @brief Enable or disable measuring of time spent reading from the input stream
+         * @param enable `true` to enable timing
+         */
+        void set_timing(bool enable) {
+            m_timing = enable;
+        }
+
+        /**
+         * @brief Get input statistics of the decoder
+         * @return Statistics since the decoder was created
+         */
+        const DecoderStats& get_stats() const {
+            return m_stats;
+        }
+
+        /**
+         * @brief Get the number of bytes decoded from the input stream (bytes read from the input
+         * stream without the ones still waiting in decoder's buffer)
+         * @return Number of decoded bytes
+         */
+        uint64_t get_consumed_bytes() const {
+            return m_stats.bytes_read - (m_end - m_p);
+        }
+
         private:
 
         /**
@@ -197,7 +262,41 @@ namespace CDNS {
          * @throw CdnsDecoderException if an error is encountered decoding CBOR data
          * @return String read from the input stream
          */
-        std::string read_string(CborType cbor_type, uint64_t length, bool indef);
+        std::string read_string(CborType cbor_type, uint64_t length, bool indef) {
+            std::string ret;
+            read_string(cbor_type, length, indef, ret);
+            return ret;
+        }
+
+        /**
+         * @brief Read string from the input stream into existing string
+         * @param cbor_type CborType::BYTE_STRING or CborType::TEXT_STRING
+         * @param length Length of the string to read
+         * @param indef TRUE if it's indefinite length string, FALSE otherwise
+         * @param ret String to overwrite with the string read from the input stream
+         * @throw CdnsDecoderEnd if the end of input stream is reached
+         * @throw CdnsDecoderException if an error is encountered decoding CBOR data
+         */
+        void read_string(CborType cbor_type, uint64_t length, bool indef, std::string& ret);
+
+        /**
+         * @brief Read data of string from the input stream (without updating string statistics)
+         * @param cbor_type CborType::BYTE_STRING or CborType::TEXT_STRING
+         * @param length Length of the string to read
+         * @param indef TRUE if it's indefinite length string, FALSE otherwise
+         * @param ret String to append the data to or `nullptr` to skip over the data
+         * @throw CdnsDecoderEnd if the end of input stream is reached
+         * @throw CdnsDecoderException if an error is encountered decoding CBOR data
+         */
+        void read_string_data(CborType cbor_type, uint64_t length, bool indef, std::string* ret);
+
+        /**
+         * @brief Read given number of bytes from the input stream, copying whole buffer chunks at once
+         * @param length Number of bytes to read
+         * @param ret String to append the bytes to or `nullptr` to skip over them
+         * @throw CdnsDecoderEnd if the end of input stream is reached
+         */
+        void read_bytes(uint64_t length, std::string* ret);
 
         /**
          * @brief Read more data from input stream to decoder's buffer
@@ -209,5 +308,9 @@ namespace CDNS {
         unsigned char m_buffer[BUFFER_SIZE];
         unsigned char* m_p;
         unsigned char* m_end;
+        DecoderStats m_stats;
+        bool m_timing;
+        std::string* m_record; //!< Output of recording in progress or `nullptr`
+        unsigned char* m_record_start; //!< Start of not yet recorded bytes in the buffer
     };
 }
\ No newline at end of file
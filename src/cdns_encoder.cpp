@@ -273,7 +273,9 @@ std::size_t CDNS::CdnsEncoder::write(int64_t value)
 void CDNS::CdnsEncoder::flush_buffer()
 {
     if (m_p != m_buffer) {
+        uint64_t start = monotonic_ns();
         m_cos->write(reinterpret_cast<const char*>(m_buffer), m_p - m_buffer);
+        m_output_ns += monotonic_ns() - start;
         m_p = m_buffer;
         m_avail = BUFFER_SIZE;
     }
@@ -16,6 +16,7 @@
 
 #include "format_specification.h"
 #include "writer.h"
+#include "stats.h"
 
 namespace CDNS {
 
@@ -45,7 +46,8 @@ namespace CDNS {
          */
         template<typename T>
         CdnsEncoder(const T& output, CborOutputCompression compression) : m_p(m_buffer),
-                                                                          m_avail(BUFFER_SIZE) {
+                                                                          m_avail(BUFFER_SIZE),
+                                                                          m_output_ns(0) {
             switch (compression) {
                 case CborOutputCompression::NO_COMPRESSION:
                     m_cos = std::make_unique<CborOutputWriter>(output);
@@ -125,6 +127,16 @@ namespace CDNS {
             return write_bytestring(reinterpret_cast<const unsigned char*>(str.data()), str.size());
         }
 
+        /**
+         * @brief Write already encoded CBOR data verbatim
+         * @param data Encoded CBOR data
+         * @return Number of uncompressed bytes written
+         */
+        std::size_t write_raw(const std::string& data) {
+            write_string(reinterpret_cast<const unsigned char*>(data.data()), data.size());
+            return data.size();
+        }
+
         /**
          * @brief Write CBOR Text string
          * @param char Pointer to start of the text string
@@ -221,6 +233,24 @@ namespace CDNS {
             m_cos->rotate_output(out);
         }
 
+        /**
+         * @brief Get the number of bytes written to the output (after compression) since the encoder
+         * was created. Data still held in encoder's buffer or by the compressor aren't counted.
+         * @return Number of bytes written to the output
+         */
+        uint64_t get_output_bytes() const {
+            return m_cos->get_bytes_written();
+        }
+
+        /**
+         * @brief Get the time spent passing encoded data to the output (i.e. compressing and writing them)
+         * since the encoder was created
+         * @return Time in nanoseconds
+         */
+        uint64_t get_output_ns() const {
+            return m_output_ns;
+        }
+
         private:
         /**
          * @brief Write contents of internal buffer to ouptut C-DNS file
@@ -256,5 +286,6 @@ namespace CDNS {
         unsigned char m_buffer[BUFFER_SIZE];
         unsigned char *m_p;
         std::size_t m_avail;
+        uint64_t m_output_ns;
     };
 }
\ No newline at end of file
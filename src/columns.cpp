@@ -0,0 +1,50 @@
+/**
+ * Copyright © 2026 CZ.NIC, z. s. p. o.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, you can obtain one at https://mozilla.org/MPL/2.0/.
+ */
+
+#include "columns.h"
+
+void CDNS::QueryResponseColumns::clear()
+{
+    ticks_per_second = 0;
+
+    timestamp.clear();
+    client_address.clear();
+    client_port.clear();
+    server_address.clear();
+    server_port.clear();
+    transport_flags.clear();
+    transaction_id.clear();
+    qtype.clear();
+    qclass.clear();
+    qname.clear();
+    rcode.clear();
+    response_delay.clear();
+    query_size.clear();
+    response_size.clear();
+
+    ip_address.clear();
+    name_rdata.clear();
+}
+
+void CDNS::QueryResponseColumns::reserve(std::size_t count)
+{
+    timestamp.reserve(count);
+    client_address.reserve(count);
+    client_port.reserve(count);
+    server_address.reserve(count);
+    server_port.reserve(count);
+    transport_flags.reserve(count);
+    transaction_id.reserve(count);
+    qtype.reserve(count);
+    qclass.reserve(count);
+    qname.reserve(count);
+    rcode.reserve(count);
+    response_delay.reserve(count);
+    query_size.reserve(count);
+    response_size.reserve(count);
+}
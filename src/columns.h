@@ -0,0 +1,264 @@
+/**
+ * Copyright © 2026 CZ.NIC, z. s. p. o.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, you can obtain one at https://mozilla.org/MPL/2.0/.
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <cstddef>
+#include <string>
+#include <vector>
+#include <stdexcept>
+
+#include "format_specification.h"
+
+namespace CDNS {
+
+    /**
+     * @brief Column of fixed width values with validity bitmap
+     *
+     * Values and the validity bitmap are stored in contiguous arrays using the same layout as Apache
+     * Arrow: bit `i % 8` of byte `i / 8` of the bitmap is set if the `i`-th value is present. Missing
+     * values are stored as zero, so aggregations can run over the values array without branching and
+     * use the bitmap (or null_count() == 0) to mask out missing ones.
+     *
+     * Clearing the column keeps the capacity of both arrays, so the column can be refilled with the
+     * next Block without new allocations.
+     *
+     * @tparam T Type of the column values
+     */
+    template<typename T>
+    class Column {
+        public:
+        Column() : m_values(), m_validity(), m_null_count(0) {}
+
+        /**
+         * @brief Remove all values from the column, keeping its capacity
+         */
+        void clear() {
+            m_values.clear();
+            m_validity.clear();
+            m_null_count = 0;
+        }
+
+        /**
+         * @brief Reserve space for given number of values
+         * @param count Number of values
+         */
+        void reserve(std::size_t count) {
+            m_values.reserve(count);
+            m_validity.reserve((count + 7) / 8);
+        }
+
+        /**
+         * @brief Append present value to the column
+         * @param value Value to append
+         */
+        void push_back(T value) {
+            set_bit(m_values.size(), true);
+            m_values.push_back(value);
+        }
+
+        /**
+         * @brief Append missing value to the column
+         */
+        void push_null() {
+            set_bit(m_values.size(), false);
+            m_values.push_back(T());
+            m_null_count++;
+        }
+
+        /**
+         * @brief Get number of values (including missing ones) in the column
+         */
+        std::size_t size() const {
+            return m_values.size();
+        }
+
+        /**
+         * @brief Get number of missing values in the column
+         */
+        std::size_t null_count() const {
+            return m_null_count;
+        }
+
+        /**
+         * @brief Check if the value at given position is present
+         * @param pos Position in the column
+         * @return `true` if the value is present
+         */
+        bool valid(std::size_t pos) const {
+            return (m_validity[pos / 8] >> (pos % 8)) & 1;
+        }
+
+        /**
+         * @brief Get value at given position (0 if the value is missing)
+         * @param pos Position in the column
+         */
+        T operator[](std::size_t pos) const {
+            return m_values[pos];
+        }
+
+        /**
+         * @brief Get value at given position with bounds and validity check
+         * @param pos Position in the column
+         * @throw std::out_of_range if the position is out of bounds or the value is missing
+         */
+        T at(std::size_t pos) const {
+            if (pos >= m_values.size() || !valid(pos))
+                throw std::out_of_range("Column value at position " + std::to_string(pos) + " is not present");
+
+            return m_values[pos];
+        }
+
+        /**
+         * @brief Get the contiguous array of values
+         */
+        const std::vector<T>& values() const {
+            return m_values;
+        }
+
+        /**
+         * @brief Get the validity bitmap (`(size() + 7) / 8` bytes)
+         */
+        const std::vector<uint8_t>& validity() const {
+            return m_validity;
+        }
+
+        private:
+        void set_bit(std::size_t pos, bool value) {
+            if (pos % 8 == 0)
+                m_validity.push_back(0);
+
+            if (value)
+                m_validity.back() |= static_cast<uint8_t>(1 << (pos % 8));
+        }
+
+        std::vector<T> m_values;
+        std::vector<uint8_t> m_validity;
+        std::size_t m_null_count;
+    };
+
+    /**
+     * @brief Dictionary of byte strings stored in one contiguous buffer
+     *
+     * String `i` occupies bytes `[offsets[i], offsets[i + 1])` of the data buffer (Apache Arrow
+     * large binary layout). Used to export C-DNS Block tables of strings; index columns of
+     * QueryResponseColumns point into these dictionaries. Offsets are 64-bit because dictionaries
+     * filled from many Blocks (see CdnsReader::read_qr_columns()) can exceed 2 GiB of strings.
+     */
+    class StringDictionary {
+        public:
+        using offset_type = int64_t;
+
+        StringDictionary() : m_offsets(1, 0), m_data() {}
+
+        /**
+         * @brief Remove all strings from the dictionary, keeping its capacity
+         */
+        void clear() {
+            m_offsets.resize(1);
+            m_data.clear();
+        }
+
+        /**
+         * @brief Append string to the dictionary
+         * @param str String to append
+         */
+        void push_back(const std::string& str) {
+            m_data.append(str);
+            m_offsets.push_back(static_cast<offset_type>(m_data.size()));
+        }
+
+        /**
+         * @brief Get number of strings in the dictionary
+         */
+        std::size_t size() const {
+            return m_offsets.size() - 1;
+        }
+
+        /**
+         * @brief Get copy of the string at given index
+         * @param index Index of the string in the dictionary
+         * @throw std::out_of_range if the index is out of bounds
+         */
+        std::string get(index_t index) const {
+            if (index >= size())
+                throw std::out_of_range("Dictionary index " + std::to_string(index) + " out of bounds");
+
+            return m_data.substr(m_offsets[index], m_offsets[index + 1] - m_offsets[index]);
+        }
+
+        /**
+         * @brief Get the offsets array (`size() + 1` items)
+         */
+        const std::vector<offset_type>& offsets() const {
+            return m_offsets;
+        }
+
+        /**
+         * @brief Get the buffer with all strings concatenated
+         */
+        const std::string& data() const {
+            return m_data;
+        }
+
+        private:
+        std::vector<offset_type> m_offsets;
+        std::string m_data;
+    };
+
+    /**
+     * @brief Query/Response items of one C-DNS Block decoded to struct-of-arrays columns
+     *
+     * Filled by CdnsBlockRead::read_qr_columns(). Fields stored in Query/Response signatures
+     * and Classtype Block table are resolved for each item, IP addresses and QNAMEs are kept
+     * as indexes to dictionaries exported from the Block's tables. Indexes are valid only
+     * within one Block.
+     */
+    struct QueryResponseColumns {
+        QueryResponseColumns() : ticks_per_second(0) {}
+
+        /**
+         * @brief Remove all values from all columns and dictionaries, keeping their capacity
+         */
+        void clear();
+
+        /**
+         * @brief Reserve space for given number of Query/Response items in all columns
+         * @param count Number of Query/Response items
+         */
+        void reserve(std::size_t count);
+
+        /**
+         * @brief Get number of Query/Response items (rows)
+         */
+        std::size_t size() const {
+            return timestamp.size();
+        }
+
+        uint64_t ticks_per_second; //!< Resolution of timestamps and response delays
+
+        Column<int64_t> timestamp; //!< Ticks since the start of UNIX epoch
+        Column<index_t> client_address; //!< Index to `ip_address` dictionary
+        Column<uint16_t> client_port;
+        Column<index_t> server_address; //!< Index to `ip_address` dictionary
+        Column<uint16_t> server_port;
+        Column<uint8_t> transport_flags; //!< QueryResponseTransportFlagsMask bits
+        Column<uint16_t> transaction_id;
+        Column<uint16_t> qtype;
+        Column<uint16_t> qclass;
+        Column<index_t> qname; //!< Index to `name_rdata` dictionary
+        Column<uint16_t> rcode; //!< Response RCODE
+        Column<int64_t> response_delay; //!< Response delay in ticks
+        Column<uint32_t> query_size;
+        Column<uint32_t> response_size;
+
+        StringDictionary ip_address; //!< IP address Block table
+        StringDictionary name_rdata; //!< NAME and RDATA Block table
+    };
+}
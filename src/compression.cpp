@@ -0,0 +1,349 @@
+/**
+ * Copyright © 2026 CZ.NIC, z. s. p. o.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, you can obtain one at https://mozilla.org/MPL/2.0/.
+ */
+
+#include <cstring>
+#include <iostream>
+#include <limits>
+#include <stdexcept>
+#include <algorithm>
+
+#include "compression.h"
+
+constexpr std::size_t CDNS::DecompressStreamBuf::BUFFER_SIZE;
+constexpr std::size_t CDNS::ParallelCompressor::DEFAULT_CHUNK_SIZE;
+
+CDNS::CborOutputCompression CDNS::detect_compression(const char* data, std::size_t size)
+{
+    static const char gzip_magic[] = {'\x1f', '\x8b'};
+    static const char xz_magic[] = {'\xfd', '7', 'z', 'X', 'Z', '\x00'};
+
+    if (size >= sizeof(gzip_magic) && std::memcmp(data, gzip_magic, sizeof(gzip_magic)) == 0)
+        return CborOutputCompression::GZIP;
+    if (size >= sizeof(xz_magic) && std::memcmp(data, xz_magic, sizeof(xz_magic)) == 0)
+        return CborOutputCompression::XZ;
+
+    return CborOutputCompression::NO_COMPRESSION;
+}
+
+CDNS::DecompressStreamBuf::DecompressStreamBuf(std::istream& input)
+    : m_input(input), m_compression(CborOutputCompression::NO_COMPRESSION), m_in(BUFFER_SIZE), m_out(BUFFER_SIZE),
+      m_in_pos(0), m_in_size(0), m_bytes_read(0), m_input_end(false), m_end(false), m_in_member(false), m_gzip(),
+      m_lzma(LZMA_STREAM_INIT)
+{
+    if (!fill_input())
+        m_input_end = true;
+
+    m_compression = detect_compression(m_in.data(), m_in_size);
+    if (m_compression == CborOutputCompression::GZIP) {
+        m_gzip.zalloc = Z_NULL;
+        m_gzip.zfree = Z_NULL;
+        m_gzip.opaque = Z_NULL;
+        m_gzip.next_in = reinterpret_cast<Bytef*>(m_in.data());
+        m_gzip.avail_in = m_in_size;
+        if (inflateInit2(&m_gzip, 31) != Z_OK)
+            throw std::runtime_error("Couldn't initialize GZIP decompression");
+    }
+    else if (m_compression == CborOutputCompression::XZ) {
+        if (lzma_stream_decoder(&m_lzma, std::numeric_limits<uint64_t>::max(), LZMA_CONCATENATED) != LZMA_OK)
+            throw std::runtime_error("Couldn't initialize LZMA decompression");
+        m_lzma.next_in = reinterpret_cast<const uint8_t*>(m_in.data());
+        m_lzma.avail_in = m_in_size;
+    }
+}
+
+CDNS::DecompressStreamBuf::~DecompressStreamBuf()
+{
+    if (m_compression == CborOutputCompression::GZIP)
+        inflateEnd(&m_gzip);
+    else if (m_compression == CborOutputCompression::XZ)
+        lzma_end(&m_lzma);
+}
+
+bool CDNS::DecompressStreamBuf::fill_input()
+{
+    m_input.read(m_in.data(), m_in.size());
+    m_in_pos = 0;
+    m_in_size = static_cast<std::size_t>(m_input.gcount());
+    m_bytes_read += m_in_size;
+    return m_in_size > 0;
+}
+
+CDNS::DecompressStreamBuf::int_type CDNS::DecompressStreamBuf::underflow()
+{
+    if (gptr() < egptr())
+        return traits_type::to_int_type(*gptr());
+
+    // Uncompressed input is passed through the input buffer
+    if (m_compression == CborOutputCompression::NO_COMPRESSION) {
+        if (m_in_pos == m_in_size && (m_input_end || !fill_input())) {
+            m_input_end = true;
+            return traits_type::eof();
+        }
+
+        setg(m_in.data() + m_in_pos, m_in.data() + m_in_pos, m_in.data() + m_in_size);
+        m_in_pos = m_in_size;
+        return traits_type::to_int_type(*gptr());
+    }
+
+    std::size_t produced = 0;
+    while (produced == 0 && !m_end) {
+        if (m_compression == CborOutputCompression::GZIP) {
+            if (m_gzip.avail_in == 0) {
+                if (m_input_end || !fill_input()) {
+                    m_input_end = true;
+                    if (m_in_member)
+                        throw std::runtime_error("GZIP input is truncated");
+                    m_end = true;
+                    break;
+                }
+                m_gzip.next_in = reinterpret_cast<Bytef*>(m_in.data());
+                m_gzip.avail_in = m_in_size;
+            }
+
+            m_gzip.next_out = reinterpret_cast<Bytef*>(m_out.data());
+            m_gzip.avail_out = m_out.size();
+            int ret = inflate(&m_gzip, Z_NO_FLUSH);
+            produced = m_out.size() - m_gzip.avail_out;
+
+            // Next GZIP member may follow the finished one
+            if (ret == Z_STREAM_END) {
+                m_in_member = false;
+                inflateReset(&m_gzip);
+            }
+            else if (ret == Z_OK || ret == Z_BUF_ERROR)
+                m_in_member = true;
+            else
+                throw std::runtime_error("Couldn't decompress GZIP input");
+        }
+        else {
+            if (m_lzma.avail_in == 0 && !m_input_end) {
+                if (fill_input()) {
+                    m_lzma.next_in = reinterpret_cast<const uint8_t*>(m_in.data());
+                    m_lzma.avail_in = m_in_size;
+                }
+                else
+                    m_input_end = true;
+            }
+
+            m_lzma.next_out = reinterpret_cast<uint8_t*>(m_out.data());
+            m_lzma.avail_out = m_out.size();
+            lzma_ret ret = lzma_code(&m_lzma, m_input_end ? LZMA_FINISH : LZMA_RUN);
+            produced = m_out.size() - m_lzma.avail_out;
+
+            if (ret == LZMA_STREAM_END)
+                m_end = true;
+            else if (ret != LZMA_OK)
+                throw std::runtime_error(ret == LZMA_BUF_ERROR ? "XZ input is truncated" : "Couldn't decompress XZ input");
+        }
+    }
+
+    if (produced == 0)
+        return traits_type::eof();
+
+    setg(m_out.data(), m_out.data(), m_out.data() + produced);
+    return traits_type::to_int_type(*gptr());
+}
+
+CDNS::ParallelCompressor::ParallelCompressor(const std::string& output, CborOutputCompression compression,
+                                             std::size_t threads, std::size_t chunk_size)
+    : m_output(output, std::ofstream::binary | std::ofstream::trunc), m_compression(compression),
+      m_chunk_size(chunk_size), m_max_pending(0), m_current(), m_chunks(), m_queue(), m_bytes_in(0), m_bytes_out(0),
+      m_stop(false), m_closed(false), m_error(), m_workers()
+{
+    if (chunk_size == 0)
+        throw std::invalid_argument("Chunk size has to be positive");
+
+    if (!m_output.is_open())
+        throw CborOutputException("Couldn't open output file " + output);
+
+    if (threads == 0)
+        threads = std::max(std::thread::hardware_concurrency(), 1U);
+    m_max_pending = 2 * threads;
+
+    for (std::size_t i = 0; i < threads; i++)
+        m_workers.emplace_back(&ParallelCompressor::work, this);
+}
+
+CDNS::ParallelCompressor::~ParallelCompressor()
+{
+    try {
+        close();
+    }
+    catch (std::exception& e) {
+        std::cerr << e.what() << std::endl;
+    }
+}
+
+void CDNS::ParallelCompressor::write(const char* p, std::size_t size)
+{
+    if (m_closed)
+        throw CborOutputException("Output was already closed!");
+
+    m_current.append(p, size);
+    m_bytes_in += size;
+    if (m_current.size() >= m_chunk_size)
+        submit();
+}
+
+void CDNS::ParallelCompressor::close()
+{
+    if (m_closed)
+        return;
+
+    m_closed = true;
+    std::exception_ptr error;
+    try {
+        if (!m_current.empty())
+            submit();
+        flush(0);
+    }
+    catch (...) {
+        error = std::current_exception();
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_stop = true;
+    }
+    m_queue_cv.notify_all();
+    for (auto& worker : m_workers)
+        worker.join();
+
+    m_output.close();
+    if (error)
+        std::rethrow_exception(error);
+    if (m_output.fail())
+        throw CborOutputException("Couldn't write to output file!");
+}
+
+void CDNS::ParallelCompressor::submit()
+{
+    std::shared_ptr<Chunk> chunk = std::make_shared<Chunk>();
+    chunk->data.swap(m_current);
+    chunk->done = false;
+
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_chunks.push_back(chunk);
+        m_queue.push_back(chunk);
+    }
+    m_queue_cv.notify_one();
+
+    flush(m_max_pending);
+}
+
+void CDNS::ParallelCompressor::flush(std::size_t max_pending)
+{
+    std::unique_lock<std::mutex> lock(m_mutex);
+
+    while (!m_chunks.empty()) {
+        if (!m_chunks.front()->done) {
+            if (m_chunks.size() <= max_pending)
+                break;
+
+            m_done_cv.wait(lock, [this]() { return m_chunks.front()->done || m_error; });
+        }
+
+        if (m_error)
+            std::rethrow_exception(m_error);
+
+        std::shared_ptr<Chunk> chunk = std::move(m_chunks.front());
+        m_chunks.pop_front();
+        lock.unlock();
+
+        m_output.write(chunk->compressed.data(), chunk->compressed.size());
+        if (m_output.fail())
+            throw CborOutputException("Couldn't write to output file!");
+        m_bytes_out += chunk->compressed.size();
+
+        lock.lock();
+    }
+}
+
+void CDNS::ParallelCompressor::work()
+{
+    while (true) {
+        std::shared_ptr<Chunk> chunk;
+        {
+            std::unique_lock<std::mutex> lock(m_mutex);
+            m_queue_cv.wait(lock, [this]() { return !m_queue.empty() || m_stop; });
+            if (m_queue.empty())
+                return;
+
+            chunk = std::move(m_queue.front());
+            m_queue.pop_front();
+        }
+
+        std::string compressed;
+        std::exception_ptr error;
+        try {
+            compressed = compress(chunk->data, m_compression);
+        }
+        catch (...) {
+            error = std::current_exception();
+        }
+
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if (error && !m_error)
+            m_error = error;
+        chunk->compressed.swap(compressed);
+        chunk->data.clear();
+        chunk->data.shrink_to_fit();
+        chunk->done = true;
+        m_done_cv.notify_all();
+    }
+}
+
+std::string CDNS::ParallelCompressor::compress(const std::string& data, CborOutputCompression compression)
+{
+    std::string ret;
+
+    switch (compression) {
+        case CborOutputCompression::NO_COMPRESSION:
+            ret = data;
+            break;
+        case CborOutputCompression::GZIP: {
+            if (data.size() > std::numeric_limits<uInt>::max())
+                throw CborOutputException("Chunk is too large for GZIP compression!");
+
+            z_stream gzip;
+            gzip.zalloc = Z_NULL;
+            gzip.zfree = Z_NULL;
+            gzip.opaque = Z_NULL;
+            if (deflateInit2(&gzip, Z_DEFAULT_COMPRESSION, Z_DEFLATED, 31, 8, Z_DEFAULT_STRATEGY) != Z_OK)
+                throw CborOutputException("Couldn't initialize GZIP compression");
+
+            ret.resize(deflateBound(&gzip, data.size()));
+            gzip.next_in = reinterpret_cast<Bytef*>(const_cast<char*>(data.data()));
+            gzip.avail_in = data.size();
+            gzip.next_out = reinterpret_cast<Bytef*>(&ret[0]);
+            gzip.avail_out = ret.size();
+            int result = deflate(&gzip, Z_FINISH);
+            ret.resize(ret.size() - gzip.avail_out);
+            deflateEnd(&gzip);
+            if (result != Z_STREAM_END)
+                throw CborOutputException("Couldn't compress data with GZIP!");
+            break;
+        }
+        case CborOutputCompression::XZ: {
+            std::size_t written = 0;
+            ret.resize(lzma_stream_buffer_bound(data.size()));
+            lzma_ret result = lzma_easy_buffer_encode(6 /* XZ utils default */, LZMA_CHECK_CRC64, nullptr,
+                                                      reinterpret_cast<const uint8_t*>(data.data()), data.size(),
+                                                      reinterpret_cast<uint8_t*>(&ret[0]), &written, ret.size());
+            if (result != LZMA_OK)
+                throw CborOutputException("Couldn't compress data with LZMA!");
+            ret.resize(written);
+            break;
+        }
+        default:
+            throw CborOutputException("Unknown type of compression");
+    }
+
+    return ret;
+}
@@ -0,0 +1,237 @@
+/**
+ * Copyright © 2026 CZ.NIC, z. s. p. o.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, you can obtain one at https://mozilla.org/MPL/2.0/.
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <cstddef>
+#include <string>
+#include <vector>
+#include <deque>
+#include <memory>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <exception>
+#include <istream>
+#include <fstream>
+#include <streambuf>
+#include <zlib.h>
+#include <lzma.h>
+
+#include "writer.h"
+
+namespace CDNS {
+
+    /**
+     * @brief Detect compression of C-DNS data by the magic bytes at its start
+     * @param data Start of the data
+     * @param size Size of the data in bytes (at least 6 bytes are needed to detect XZ)
+     * @return GZIP or XZ if the data start with their magic bytes, NO_COMPRESSION otherwise
+     */
+    CborOutputCompression detect_compression(const char* data, std::size_t size);
+
+    /**
+     * @brief Input stream buffer decompressing C-DNS data written with any CborOutputCompression
+     *
+     * The compression is detected by the magic bytes at the start of the input, uncompressed input
+     * is passed through. Concatenated GZIP members and XZ streams (e.g. written by ParallelCompressor)
+     * are decompressed as one input. Use it to read compressed files with CdnsReader:
+     *
+     *     std::ifstream file("input.cdns.xz", std::ifstream::binary);
+     *     CDNS::DecompressStreamBuf buffer(file);
+     *     std::istream input(&buffer);
+     *     CDNS::CdnsReader reader(input);
+     */
+    class DecompressStreamBuf : public std::streambuf {
+        public:
+        static constexpr std::size_t BUFFER_SIZE = 256 * 1024;
+
+        /**
+         * @brief Construct a new DecompressStreamBuf object and detect compression of the input
+         * @param input Compressed or uncompressed input, has to outlive the stream buffer
+         * @throw std::runtime_error if initialization of the decompression fails
+         */
+        explicit DecompressStreamBuf(std::istream& input);
+
+        ~DecompressStreamBuf() override;
+
+        /** Delete copy constructor and assignment operator */
+        DecompressStreamBuf(const DecompressStreamBuf& copy) = delete;
+        DecompressStreamBuf& operator=(const DecompressStreamBuf& rhs) = delete;
+
+        /**
+         * @brief Get detected compression of the input
+         */
+        CborOutputCompression compression() const {
+            return m_compression;
+        }
+
+        /**
+         * @brief Get number of bytes read from the input
+         */
+        uint64_t get_bytes_read() const {
+            return m_bytes_read;
+        }
+
+        protected:
+        /**
+         * @brief Decompress next part of the input
+         * @throw std::runtime_error if the input is corrupted
+         */
+        int_type underflow() override;
+
+        private:
+        /**
+         * @brief Read next part of the input to input buffer
+         * @return `false` if the end of the input was reached
+         */
+        bool fill_input();
+
+        std::istream& m_input;
+        CborOutputCompression m_compression;
+        std::vector<char> m_in;
+        std::vector<char> m_out;
+        std::size_t m_in_pos; //!< Start of unprocessed data in input buffer
+        std::size_t m_in_size; //!< End of data in input buffer
+        uint64_t m_bytes_read;
+        bool m_input_end; //!< End of the input was reached
+        bool m_end; //!< All data of the input were decompressed
+        bool m_in_member; //!< GZIP member started but not finished
+        z_stream m_gzip;
+        lzma_stream m_lzma;
+    };
+
+    /**
+     * @brief Compresses output on multiple threads
+     *
+     * Written data are cut to chunks of fixed size and each chunk is compressed on a worker thread to
+     * an independent GZIP member or XZ stream. The compressed chunks are written to the output file
+     * in order, so the file is one valid GZIP or XZ file (concatenated members and streams are part
+     * of both formats, see DecompressStreamBuf) at the cost of slightly worse compression ratio
+     * at chunk boundaries. Memory use is bounded by twice the number of threads of chunks.
+     *
+     * Use output() as the output of CdnsExporter without compression:
+     *
+     *     CDNS::ParallelCompressor compressor("output.cdns.xz", CDNS::CborOutputCompression::XZ);
+     *     {
+     *         CDNS::CdnsExporter exporter(fp, compressor.output(), CDNS::CborOutputCompression::NO_COMPRESSION);
+     *         ...
+     *     }
+     *     compressor.close();
+     */
+    class ParallelCompressor {
+        public:
+        static constexpr std::size_t DEFAULT_CHUNK_SIZE = 8 * 1024 * 1024;
+
+        /**
+         * @brief Construct a new ParallelCompressor object and open the output file
+         * @param output Name of the output file (no extension is added)
+         * @param compression Compression of the output
+         * @param threads Number of compressing threads (0 for the number of CPUs)
+         * @param chunk_size Size of independently compressed chunks in bytes
+         * @throw CborOutputException if the output file can't be opened
+         * @throw std::invalid_argument if chunk_size is 0
+         */
+        ParallelCompressor(const std::string& output, CborOutputCompression compression, std::size_t threads = 0,
+                           std::size_t chunk_size = DEFAULT_CHUNK_SIZE);
+
+        /**
+         * @brief Destroy the ParallelCompressor object and close the output if it wasn't closed
+         */
+        ~ParallelCompressor();
+
+        /** Delete copy constructor and assignment operator */
+        ParallelCompressor(const ParallelCompressor& copy) = delete;
+        ParallelCompressor& operator=(const ParallelCompressor& rhs) = delete;
+
+        /**
+         * @brief Get output for CdnsExporter (or CdnsEncoder) writing to this compressor.
+         * The compressor has to outlive the exporter.
+         */
+        CallbackOutput output() {
+            return CallbackOutput([this](const char* p, std::size_t size) { write(p, size); });
+        }
+
+        /**
+         * @brief Compress data and write them to output
+         * @param p Start of the data
+         * @param size Size of the data in bytes
+         * @throw Rethrows exceptions thrown while compressing or writing the output
+         */
+        void write(const char* p, std::size_t size);
+
+        /**
+         * @brief Compress remaining data, write them to output and close the output
+         * @throw Rethrows exceptions thrown while compressing or writing the output
+         */
+        void close();
+
+        /**
+         * @brief Get number of uncompressed bytes written to the compressor
+         */
+        uint64_t get_bytes_in() const {
+            return m_bytes_in;
+        }
+
+        /**
+         * @brief Get number of compressed bytes written to the output file
+         */
+        uint64_t get_bytes_out() const {
+            return m_bytes_out;
+        }
+
+        private:
+        /**
+         * @brief Chunk of data compressed by a worker
+         */
+        struct Chunk {
+            std::string data;
+            std::string compressed;
+            bool done;
+        };
+
+        /**
+         * @brief Queue current chunk for compression
+         */
+        void submit();
+
+        /**
+         * @brief Write compressed chunks from the front of the queue to output
+         * @param max_pending Wait until at most this many chunks are queued
+         */
+        void flush(std::size_t max_pending);
+
+        /**
+         * @brief Main loop of worker threads
+         */
+        void work();
+
+        /**
+         * @brief Compress chunk of data
+         */
+        static std::string compress(const std::string& data, CborOutputCompression compression);
+
+        std::ofstream m_output;
+        CborOutputCompression m_compression;
+        std::size_t m_chunk_size;
+        std::size_t m_max_pending;
+        std::string m_current; //!< Chunk being filled
+        std::deque<std::shared_ptr<Chunk>> m_chunks; //!< Chunks not yet written, in output order
+        std::deque<std::shared_ptr<Chunk>> m_queue; //!< Chunks waiting for a worker
+        uint64_t m_bytes_in;
+        uint64_t m_bytes_out;
+        bool m_stop;
+        bool m_closed;
+        std::exception_ptr m_error;
+        std::vector<std::thread> m_workers;
+        std::mutex m_mutex;
+        std::condition_variable m_queue_cv;
+        std::condition_variable m_done_cv;
+    };
+}
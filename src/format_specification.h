@@ -138,15 +138,16 @@ namespace CDNS {
      * @enum BlockMapIndex
      * @brief Block map indexes
      */
-    enum class BlockMapIndex : uint8_t {
+    enum class BlockMapIndex : int8_t {
         block_preamble = 0,
         block_statistics = 1,
         block_tables = 2,
         query_responses = 3,
         address_event_counts = 4,
         malformed_messages = 5,
+        block_summary = -1, //!< Implementation-private summary of the Block for skipping Blocks when reading
 
-        block_size
+        block_size = 6
     };
 
     /**
@@ -160,6 +161,35 @@ namespace CDNS {
         block_preamble_size
     };
 
+    /**
+     * @enum BlockSummaryMapIndex
+     * @brief Block Summary map indexes (implementation-private Block map field)
+     */
+    enum class BlockSummaryMapIndex : uint8_t {
+        latest_time = 0,
+        qr_count = 1,
+        aec_count = 2,
+        mm_count = 3,
+        min_client_address = 4,
+        max_client_address = 5,
+        rcode_counts = 6,
+        body_size = 7,
+        filter = 8,
+
+        block_summary_size
+    };
+
+    /**
+     * @enum BloomFilterMapIndex
+     * @brief Bloom filter map indexes (in implementation-private Block Summary)
+     */
+    enum class BloomFilterMapIndex : uint8_t {
+        hash_count = 0,
+        bits = 1,
+
+        bloom_filter_size
+    };
+
     /**
      * @enum BlockStatisticsMapIndex
      * @brief Block Statistics map indexes
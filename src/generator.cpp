@@ -0,0 +1,443 @@
+/**
+ * Copyright © 2026 CZ.NIC, z. s. p. o.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, you can obtain one at https://mozilla.org/MPL/2.0/.
+ */
+
+#include <cmath>
+#include <algorithm>
+#include <stdexcept>
+
+#include "cdns.h"
+#include "generator.h"
+
+namespace {
+    /**
+     * @brief DNS RR types of generated queries with their cumulative probability
+     */
+    const std::pair<uint16_t, double> QTYPES[] = {
+        {1, 0.55}, // A
+        {28, 0.80}, // AAAA
+        {65, 0.87}, // HTTPS
+        {15, 0.90}, // MX
+        {16, 0.93}, // TXT
+        {12, 0.95}, // PTR
+        {2, 0.97}, // NS
+        {6, 0.98}, // SOA
+        {43, 0.99}, // DS
+        {48, 1.00} // DNSKEY
+    };
+
+    const char* const TLDS[] = {"com", "net", "org", "cz", "de", "uk", "io"};
+    const char* const PREFIXES[] = {"", "www", "mail", "api", "cdn"};
+    const uint32_t TTLS[] = {60, 300, 3600, 86400};
+
+    /**
+     * @brief Bijective 64-bit mixing function (SplitMix64 finalizer)
+     */
+    uint64_t mix(uint64_t x)
+    {
+        x = (x ^ (x >> 30)) * 0xBF58476D1CE4E5B9ULL;
+        x = (x ^ (x >> 27)) * 0x94D049BB133111EBULL;
+        return x ^ (x >> 31);
+    }
+
+    /**
+     * @brief Convert lowest bytes of given value to string in network byte order
+     */
+    std::string to_bytes(uint64_t value, std::size_t count)
+    {
+        std::string ret;
+        for (std::size_t i = count; i > 0; i--)
+            ret.push_back(static_cast<char>(value >> ((i - 1) * 8)));
+        return ret;
+    }
+
+    /**
+     * @brief Append DNS label to name in wire format
+     */
+    void append_label(std::string& name, const std::string& label)
+    {
+        name.push_back(static_cast<char>(label.size()));
+        name.append(label);
+    }
+
+    /**
+     * @brief Fill cumulative Zipfian distribution
+     */
+    void fill_zipf(std::vector<double>& cdf, std::size_t size, double skew)
+    {
+        cdf.resize(size);
+        double sum = 0;
+        for (std::size_t i = 0; i < size; i++) {
+            sum += 1.0 / std::pow(static_cast<double>(i + 1), skew);
+            cdf[i] = sum;
+        }
+    }
+}
+
+CDNS::TrafficGenerator::TrafficGenerator(const GeneratorConfig& config)
+    : m_config(config), m_state(config.seed), m_elapsed(0), m_qname_cdf(), m_client_cdf()
+{
+    if (m_config.qnames == 0)
+        throw std::invalid_argument("Traffic generator needs at least one QNAME");
+
+    if (m_config.ipv4_clients + m_config.ipv6_clients == 0)
+        throw std::invalid_argument("Traffic generator needs at least one client");
+
+    if (m_config.servers == 0 || m_config.servers > 255)
+        throw std::invalid_argument("Number of servers has to be in range 1-255");
+
+    if (m_config.rate <= 0)
+        throw std::invalid_argument("Traffic rate has to be positive");
+
+    for (double ratio : {m_config.tcp_ratio, m_config.edns_ratio, m_config.do_ratio, m_config.nxdomain_ratio,
+                         m_config.servfail_ratio, m_config.unanswered_ratio, m_config.address_event_ratio,
+                         m_config.malformed_ratio}) {
+        if (ratio < 0 || ratio > 1)
+            throw std::invalid_argument("Traffic ratios have to be in range [0, 1]");
+    }
+
+    if (m_config.address_event_ratio + m_config.malformed_ratio > 1)
+        throw std::invalid_argument("Ratios of Address events and Malformed messages can't exceed 1 in sum");
+
+    fill_zipf(m_qname_cdf, m_config.qnames, m_config.qname_skew);
+    fill_zipf(m_client_cdf, m_config.ipv4_clients + m_config.ipv6_clients, m_config.client_skew);
+}
+
+CDNS::GeneratedItemType CDNS::TrafficGenerator::next_type()
+{
+    advance_time();
+
+    double type = uniform();
+    if (type < m_config.address_event_ratio)
+        return GeneratedItemType::ADDRESS_EVENT_COUNT;
+    else if (type < m_config.address_event_ratio + m_config.malformed_ratio)
+        return GeneratedItemType::MALFORMED_MESSAGE;
+
+    return GeneratedItemType::QUERY_RESPONSE;
+}
+
+CDNS::GenericQueryResponse CDNS::TrafficGenerator::next_qr()
+{
+    GenericQueryResponse qr;
+    qr.ts = now();
+
+    std::size_t client = pick(m_client_cdf);
+    std::string cip = client_ip(client);
+    bool ipv6 = cip.size() == 16;
+    bool tcp = chance(m_config.tcp_ratio);
+    bool edns = chance(m_config.edns_ratio);
+
+    qr.client_ip = cip;
+    qr.client_port = static_cast<uint16_t>(tcp ? 32768 + uniform(28232) : 1024 + uniform(64511));
+    qr.transaction_id = static_cast<uint16_t>(uniform(65536));
+    qr.server_ip = server_ip(client % m_config.servers, ipv6);
+    qr.server_port = 53;
+    qr.qr_transport_flags = static_cast<QueryResponseTransportFlagsMask>(
+        (ipv6 ? QueryResponseTransportFlagsMask::ip_address : 0) |
+        (tcp ? QueryResponseTransportFlagsMask::tcp : QueryResponseTransportFlagsMask::udp));
+    qr.qr_type = QueryResponseTypeValues::resolver;
+    qr.client_hoplimit = static_cast<uint8_t>((ipv6 || client % 2 ? 64 : 128) - uniform(20));
+    if (tcp)
+        qr.round_trip_time = static_cast<int64_t>(1000 + uniform(80000));
+
+    // Question
+    std::size_t name_index = pick(m_qname_cdf);
+    std::string name = qname(name_index);
+    double type_pick = uniform();
+    ClassType ct;
+    ct.class_ = 1;
+    for (auto& qtype : QTYPES) {
+        ct.type = qtype.first;
+        if (type_pick < qtype.second)
+            break;
+    }
+
+    qr.query_name = name;
+    qr.query_classtype = ct;
+    qr.query_opcode = 0;
+    qr.query_rcode = 0;
+    qr.query_qdcount = 1;
+    qr.query_ancount = 0;
+    qr.query_nscount = 0;
+    qr.query_arcount = edns ? 1 : 0;
+
+    std::size_t query_size = 12 + name.size() + 4;
+    uint16_t dns_flags = chance(0.95) ? DNSFlagsMask::query_rd : 0;
+    uint8_t sig_flags = QueryResponseFlagsMask::has_query;
+    bool dnssec_ok = false;
+
+    if (edns) {
+        sig_flags |= QueryResponseFlagsMask::query_has_opt;
+        double udp = uniform();
+        qr.query_edns_version = 0;
+        qr.query_udp_size = udp < 0.6 ? 1232 : (udp < 0.9 ? 4096 : 512);
+        if (chance(0.3)) // EDNS client cookie
+            qr.query_opt_rdata = std::string("\x00\x0a\x00\x08", 4) + random_bytes(8);
+        dnssec_ok = chance(m_config.do_ratio);
+        if (dnssec_ok)
+            dns_flags |= DNSFlagsMask::query_do;
+        query_size += 11 + (qr.query_opt_rdata ? qr.query_opt_rdata->size() : 0);
+    }
+    qr.query_size = query_size;
+
+    // Response
+    if (!chance(m_config.unanswered_ratio)) {
+        sig_flags |= QueryResponseFlagsMask::has_response;
+        if (edns)
+            sig_flags |= QueryResponseFlagsMask::response_has_opt;
+        dns_flags |= DNSFlagsMask::response_ra;
+        if (dns_flags & DNSFlagsMask::query_rd)
+            dns_flags |= DNSFlagsMask::response_rd;
+
+        std::size_t response_size = query_size;
+        double rcode = uniform();
+        uint32_t ttl = TTLS[name_index % 4];
+
+        if (rcode < m_config.servfail_ratio) {
+            qr.response_rcode = 2;
+            qr.response_delay = static_cast<int64_t>(100000 + uniform(1900000));
+        }
+        else if (rcode < m_config.servfail_ratio + m_config.nxdomain_ratio) {
+            qr.response_rcode = 3;
+
+            // SOA record of the TLD in authority section
+            std::string tld;
+            append_label(tld, TLDS[name_index % 7]);
+            tld.push_back('\0');
+            GenericResourceRecord soa;
+            soa.name = tld;
+            soa.classtype.type = 6;
+            soa.classtype.class_ = 1;
+            soa.ttl = 900;
+            soa.rdata = std::string("\x01" "a\x0bnic-servers", 14) + tld + std::string("\x0ahostmaster", 11) + tld
+                        + std::string("\x78\x9a\xbc\xde\x00\x00\x0e\x10\x00\x00\x03\x84\x00\x09\x3a\x80\x00\x00\x03\x84", 20);
+            response_size += 12 + soa.rdata->size();
+            qr.response_authority = std::vector<GenericResourceRecord>{soa};
+        }
+        else {
+            qr.response_rcode = 0;
+
+            std::size_t answers = 1;
+            while (answers < m_config.max_answers && chance(0.35))
+                answers++;
+
+            std::vector<GenericResourceRecord> rrs;
+            rrs.reserve(answers);
+            for (std::size_t a = 0; a < answers; a++) {
+                GenericResourceRecord rr;
+                rr.name = name;
+                rr.classtype = ct;
+                rr.ttl = ttl;
+                uint64_t addr = mix(name_index * 16 + a);
+
+                switch (ct.type) {
+                    case 1:
+                        rr.rdata = to_bytes(addr, 4);
+                        break;
+                    case 28:
+                        rr.rdata = std::string("\x20\x01\x0d\xb8\x00\x00\x00\x00", 8) + to_bytes(addr, 8);
+                        break;
+                    case 15:
+                        rr.rdata = std::string("\x00\x0a", 2) + qname(mix(name_index + a) % m_config.qnames);
+                        break;
+                    case 16:
+                        rr.rdata = std::string("\x0fv=spf1 mx -all", 16);
+                        break;
+                    default:
+                        rr.rdata = qname(mix(name_index + a) % m_config.qnames);
+                        break;
+                }
+
+                response_size += 12 + rr.rdata->size();
+                rrs.push_back(std::move(rr));
+            }
+            qr.response_answers = std::move(rrs);
+
+            if (dnssec_ok) {
+                dns_flags |= DNSFlagsMask::response_ad;
+                response_size += 150;
+            }
+        }
+
+        if (!qr.response_delay) {
+            // Mostly cache hits with occasional recursion
+            qr.response_delay = static_cast<int64_t>(chance(0.8) ? 20 + uniform(500) : 5000 + uniform(150000));
+        }
+
+        qr.response_size = response_size + (edns ? 11 : 0);
+    }
+
+    qr.qr_sig_flags = static_cast<QueryResponseFlagsMask>(sig_flags);
+    qr.qr_dns_flags = static_cast<DNSFlagsMask>(dns_flags);
+
+    return qr;
+}
+
+CDNS::GenericAddressEventCount CDNS::TrafficGenerator::next_aec()
+{
+    GenericAddressEventCount aec;
+    aec.ip_address = client_ip(pick(m_client_cdf));
+    bool ipv6 = aec.ip_address.size() == 16;
+
+    switch (uniform(3)) {
+        case 0:
+            aec.ae_type = AddressEventTypeValues::tcp_reset;
+            break;
+        case 1:
+            aec.ae_type = ipv6 ? AddressEventTypeValues::icmpv6_time_exceeded
+                               : AddressEventTypeValues::icmp_time_exceeded;
+            aec.ae_code = 0;
+            break;
+        default:
+            aec.ae_type = ipv6 ? AddressEventTypeValues::icmpv6_dest_unreachable
+                               : AddressEventTypeValues::icmp_dest_unreachable;
+            aec.ae_code = 3;
+            break;
+    }
+
+    if (ipv6)
+        aec.ae_transport_flags = QueryResponseTransportFlagsMask::ip_address;
+    aec.ae_count = 1;
+
+    return aec;
+}
+
+CDNS::GenericMalformedMessage CDNS::TrafficGenerator::next_mm()
+{
+    GenericMalformedMessage mm;
+    std::size_t client = pick(m_client_cdf);
+    std::string cip = client_ip(client);
+    bool ipv6 = cip.size() == 16;
+
+    mm.ts = now();
+    mm.client_ip = cip;
+    mm.client_port = static_cast<uint16_t>(1024 + uniform(64511));
+    mm.server_ip = server_ip(client % m_config.servers, ipv6);
+    mm.server_port = 53;
+    mm.mm_transport_flags = static_cast<QueryResponseTransportFlagsMask>(
+        (ipv6 ? QueryResponseTransportFlagsMask::ip_address : 0) | QueryResponseTransportFlagsMask::udp);
+    mm.mm_payload = random_bytes(12 + uniform(68));
+
+    return mm;
+}
+
+std::vector<CDNS::GenericQueryResponse> CDNS::TrafficGenerator::generate_qrs(std::size_t count)
+{
+    std::vector<GenericQueryResponse> ret;
+    ret.reserve(count);
+
+    for (std::size_t i = 0; i < count; i++) {
+        advance_time();
+        ret.push_back(next_qr());
+    }
+
+    return ret;
+}
+
+std::size_t CDNS::TrafficGenerator::generate(CdnsExporter& exporter, std::size_t count)
+{
+    std::size_t written = 0;
+
+    for (std::size_t i = 0; i < count; i++) {
+        switch (next_type()) {
+            case GeneratedItemType::ADDRESS_EVENT_COUNT:
+                written += exporter.buffer_aec(next_aec());
+                break;
+            case GeneratedItemType::MALFORMED_MESSAGE:
+                written += exporter.buffer_mm(next_mm());
+                break;
+            default:
+                written += exporter.buffer_qr(next_qr());
+                break;
+        }
+    }
+
+    return written;
+}
+
+CDNS::Timestamp CDNS::TrafficGenerator::now() const
+{
+    uint64_t ticks = m_config.start.m_ticks + static_cast<uint64_t>(m_elapsed);
+    return Timestamp(m_config.start.m_secs + ticks / MICROS_PER_SEC, ticks % MICROS_PER_SEC);
+}
+
+void CDNS::TrafficGenerator::advance_time()
+{
+    m_elapsed -= std::log(1.0 - uniform()) * MICROS_PER_SEC / m_config.rate;
+}
+
+uint64_t CDNS::TrafficGenerator::random()
+{
+    m_state += 0x9E3779B97F4A7C15ULL;
+    return mix(m_state);
+}
+
+uint64_t CDNS::TrafficGenerator::uniform(uint64_t n)
+{
+    return n ? random() % n : 0;
+}
+
+double CDNS::TrafficGenerator::uniform()
+{
+    return (random() >> 11) * (1.0 / 9007199254740992.0);
+}
+
+std::size_t CDNS::TrafficGenerator::pick(const std::vector<double>& cdf)
+{
+    double value = uniform() * cdf.back();
+    std::size_t index = std::upper_bound(cdf.begin(), cdf.end(), value) - cdf.begin();
+    return std::min(index, cdf.size() - 1);
+}
+
+std::string CDNS::TrafficGenerator::qname(std::size_t index) const
+{
+    std::string name;
+    const char* prefix = PREFIXES[index % 5];
+    if (*prefix)
+        append_label(name, prefix);
+
+    append_label(name, "domain" + std::to_string(index));
+    append_label(name, TLDS[index % 7]);
+    name.push_back('\0');
+    return name;
+}
+
+std::string CDNS::TrafficGenerator::client_ip(std::size_t index) const
+{
+    // Spread IPv6 clients evenly among IPv4 ones, so both are present among the most active clients
+    std::size_t total = m_config.ipv4_clients + m_config.ipv6_clients;
+    std::size_t v6_before = index * m_config.ipv6_clients / total;
+    bool ipv6 = (index + 1) * m_config.ipv6_clients / total > v6_before;
+    if (ipv6)
+        return std::string("\x20\x01\x0d\xb8", 4) + to_bytes(mix(v6_before), 8) + std::string("\x00\x00\x00\x01", 4);
+
+    // Multiplication by odd constant is a bijection, so the addresses are unique
+    return to_bytes(static_cast<uint32_t>(index - v6_before) * 2654435761U, 4);
+}
+
+std::string CDNS::TrafficGenerator::server_ip(std::size_t index, bool ipv6) const
+{
+    if (ipv6)
+        return std::string("\x20\x01\x0d\xb8\x00\x35\x00\x00\x00\x00\x00\x00\x00\x00\x00", 15)
+               + static_cast<char>(index + 1);
+
+    return std::string("\xc0\x00\x02", 3) + static_cast<char>(index + 1);
+}
+
+std::string CDNS::TrafficGenerator::random_bytes(std::size_t length)
+{
+    std::string ret;
+    ret.reserve(length);
+
+    while (ret.size() < length) {
+        uint64_t value = random();
+        for (int i = 0; i < 8 && ret.size() < length; i++)
+            ret.push_back(static_cast<char>(value >> (i * 8)));
+    }
+
+    return ret;
+}
@@ -0,0 +1,192 @@
+/**
+ * Copyright © 2026 CZ.NIC, z. s. p. o.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, you can obtain one at https://mozilla.org/MPL/2.0/.
+ */
+
+#pragma once
+
+#include <string>
+#include <vector>
+#include <cstdint>
+
+#include "format_specification.h"
+#include "interface.h"
+#include "timestamp.h"
+
+namespace CDNS {
+
+    class CdnsExporter;
+
+    /**
+     * @brief Configuration of synthetic DNS traffic produced by TrafficGenerator
+     *
+     * Ratios are probabilities in range [0, 1]. Timestamps of generated items use microsecond
+     * ticks (default ticks per second in C-DNS Block parameters).
+     */
+    struct GeneratorConfig {
+        GeneratorConfig() : seed(1), start(1700000000, 0), rate(10000), qnames(10000), qname_skew(1.0),
+                            ipv4_clients(5000), ipv6_clients(1000), client_skew(0.8), servers(4),
+                            tcp_ratio(0.05), edns_ratio(0.8), do_ratio(0.4), nxdomain_ratio(0.1),
+                            servfail_ratio(0.01), unanswered_ratio(0.005), max_answers(4),
+                            address_event_ratio(0.002), malformed_ratio(0.001) {}
+
+        uint64_t seed; //!< Seed of the pseudo-random generator, same seed produces the same traffic
+        Timestamp start; //!< Timestamp of the start of generated traffic
+        double rate; //!< Mean number of generated items per second of traffic time
+        std::size_t qnames; //!< Number of distinct QNAMEs
+        double qname_skew; //!< Exponent of Zipfian QNAME popularity (0 is uniform)
+        std::size_t ipv4_clients; //!< Number of distinct IPv4 clients
+        std::size_t ipv6_clients; //!< Number of distinct IPv6 clients
+        double client_skew; //!< Exponent of Zipfian client activity (0 is uniform)
+        std::size_t servers; //!< Number of distinct server addresses (for each IP version)
+        double tcp_ratio; //!< Ratio of queries over TCP
+        double edns_ratio; //!< Ratio of queries with EDNS OPT record
+        double do_ratio; //!< Ratio of EDNS queries with DO bit set
+        double nxdomain_ratio; //!< Ratio of NXDOMAIN responses
+        double servfail_ratio; //!< Ratio of SERVFAIL responses
+        double unanswered_ratio; //!< Ratio of queries without response
+        std::size_t max_answers; //!< Maximum number of records in answer section
+        double address_event_ratio; //!< Ratio of Address events among generated items
+        double malformed_ratio; //!< Ratio of Malformed messages among generated items
+    };
+
+    /**
+     * @brief Types of items produced by TrafficGenerator
+     */
+    enum class GeneratedItemType : uint8_t {
+        QUERY_RESPONSE = 0,
+        ADDRESS_EVENT_COUNT,
+        MALFORMED_MESSAGE
+    };
+
+    /**
+     * @brief Seedable generator of synthetic DNS traffic for benchmarks and load tests
+     *
+     * Generates streams of Query/Response records with Zipfian QNAME popularity and client
+     * activity, answer and authority sections, EDNS and a mix of Address events and Malformed
+     * messages. The traffic depends only on the configuration (including the seed). The generator
+     * uses its own pseudo-random number generator and distributions instead of the implementation
+     * defined ones from <random>, so the traffic doesn't change with the standard library.
+     */
+    class TrafficGenerator {
+        public:
+        /**
+         * @brief Construct a new TrafficGenerator object
+         * @param config Configuration of the generated traffic
+         * @throw std::invalid_argument if the configuration is invalid (e.g. no QNAMEs or clients)
+         */
+        explicit TrafficGenerator(const GeneratorConfig& config = GeneratorConfig());
+
+        /**
+         * @brief Advance the traffic time and pick type of the next item according to configured ratios
+         * @return Type of the next item
+         */
+        GeneratedItemType next_type();
+
+        /**
+         * @brief Generate Query/Response record with the current traffic time
+         * @return Generated Query/Response
+         */
+        GenericQueryResponse next_qr();
+
+        /**
+         * @brief Generate Address event with the current traffic time
+         * @return Generated Address event
+         */
+        GenericAddressEventCount next_aec();
+
+        /**
+         * @brief Generate Malformed message with the current traffic time
+         * @return Generated Malformed message
+         */
+        GenericMalformedMessage next_mm();
+
+        /**
+         * @brief Generate given number of Query/Response records in memory
+         * @param count Number of records to generate
+         * @return Generated records
+         */
+        std::vector<GenericQueryResponse> generate_qrs(std::size_t count);
+
+        /**
+         * @brief Generate given number of items of all types and buffer them to C-DNS exporter
+         * @param exporter Exporter to buffer the items to
+         * @param count Number of items to generate
+         * @throw std::exception if writing of Block to exporter's output fails
+         * @return Number of uncompressed bytes written by the exporter
+         */
+        std::size_t generate(CdnsExporter& exporter, std::size_t count);
+
+        /**
+         * @brief Get current traffic time (Timestamp of the last generated item)
+         * @return Current traffic time
+         */
+        Timestamp now() const;
+
+        /**
+         * @brief Get configuration of the generator
+         * @return Configuration of the generator
+         */
+        const GeneratorConfig& get_config() const { return m_config; }
+
+        private:
+        /**
+         * @brief Advance the traffic time by exponentially distributed inter-arrival time
+         */
+        void advance_time();
+
+        /**
+         * @brief Get next 64-bit pseudo-random number (SplitMix64)
+         */
+        uint64_t random();
+
+        /**
+         * @brief Get pseudo-random number uniformly distributed in [0, n)
+         */
+        uint64_t uniform(uint64_t n);
+
+        /**
+         * @brief Get pseudo-random number uniformly distributed in [0, 1)
+         */
+        double uniform();
+
+        /**
+         * @brief Return `true` with given probability
+         */
+        bool chance(double probability) { return uniform() < probability; }
+
+        /**
+         * @brief Pick index from cumulative distribution
+         */
+        std::size_t pick(const std::vector<double>& cdf);
+
+        /**
+         * @brief Get QNAME with given index in DNS wire format
+         */
+        std::string qname(std::size_t index) const;
+
+        /**
+         * @brief Get client IP address with given index
+         */
+        std::string client_ip(std::size_t index) const;
+
+        /**
+         * @brief Get server IP address with given index and IP version
+         */
+        std::string server_ip(std::size_t index, bool ipv6) const;
+
+        /**
+         * @brief Get pseudo-random string of given length
+         */
+        std::string random_bytes(std::size_t length);
+
+        GeneratorConfig m_config;
+        uint64_t m_state;
+        double m_elapsed; //!< Traffic time since the start in microseconds
+        std::vector<double> m_qname_cdf;
+        std::vector<double> m_client_cdf;
+    };
+}
@@ -0,0 +1,294 @@
+/**
+ * Copyright © 2026 CZ.NIC, z. s. p. o.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, you can obtain one at https://mozilla.org/MPL/2.0/.
+ */
+
+#include <cstring>
+#include <stdexcept>
+
+#include "hash.h"
+
+#if (defined(__x86_64__) || defined(__i386__)) && (defined(__GNUC__) || defined(__clang__))
+#define CDNS_HASH_X86_CRC32C
+#include <nmmintrin.h>
+#endif
+
+#if defined(__aarch64__) && defined(__linux__) && (defined(__GNUC__) || defined(__clang__))
+#define CDNS_HASH_ARM_CRC32C
+#include <sys/auxv.h>
+#include <asm/hwcap.h>
+#ifndef __clang__
+// GCC declares the CRC32 intrinsics only if the CRC extension is enabled when the header is included
+#pragma GCC push_options
+#pragma GCC target("+crc")
+#endif
+#include <arm_acle.h>
+#ifndef __clang__
+#pragma GCC pop_options
+#endif
+#endif
+
+namespace {
+    template<typename T>
+    inline T load(const unsigned char* p) {
+        T ret;
+        std::memcpy(&ret, p, sizeof(T));
+        return ret;
+    }
+
+    /**
+     * @brief Multiply 64-bit values to 128-bit result and fold it back to 64 bits
+     */
+    inline uint64_t mum(uint64_t a, uint64_t b) {
+#ifdef __SIZEOF_INT128__
+        __uint128_t r = static_cast<__uint128_t>(a) * b;
+        return static_cast<uint64_t>(r) ^ static_cast<uint64_t>(r >> 64);
+#else
+        uint64_t ha = a >> 32, hb = b >> 32, la = static_cast<uint32_t>(a), lb = static_cast<uint32_t>(b);
+        uint64_t rh = ha * hb, rm0 = ha * lb, rm1 = hb * la, rl = la * lb;
+        uint64_t t = rl + (rm0 << 32);
+        uint64_t c = t < rl;
+        uint64_t lo = t + (rm1 << 32);
+        c += lo < t;
+        uint64_t hi = rh + (rm0 >> 32) + (rm1 >> 32) + c;
+        return lo ^ hi;
+#endif
+    }
+
+    constexpr uint64_t P0 = 0xa0761d6478bd642full;
+    constexpr uint64_t P1 = 0xe7037ed1a0b428dbull;
+    constexpr uint64_t P2 = 0x8ebc6af09c88c6e3ull;
+
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+    inline uint64_t bswap(uint64_t v) { return __builtin_bswap64(v); }
+    inline uint32_t bswap(uint32_t v) { return __builtin_bswap32(v); }
+#endif
+
+    /**
+     * @brief Load integer stored in little-endian byte order
+     */
+    template<typename T>
+    inline T load_le(const unsigned char* p) {
+        T ret = load<T>(p);
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+        ret = bswap(ret);
+#endif
+        return ret;
+    }
+
+    template<bool LittleEndian, typename T>
+    inline T load_as(const unsigned char* p) {
+        return LittleEndian ? load_le<T>(p) : load<T>(p);
+    }
+
+    /**
+     * @brief Portable multiply-mix hash with the structure of wyhash
+     * @tparam LittleEndian Read the data as little-endian integers, so the hash doesn't depend on the host
+     */
+    template<bool LittleEndian>
+    uint64_t hash_mix(const void* data, std::size_t size, uint64_t seed)
+    {
+        const unsigned char* p = static_cast<const unsigned char*>(data);
+        uint64_t state = seed ^ P0;
+        std::size_t left = size;
+        uint64_t a = 0;
+        uint64_t b = 0;
+
+        while (left > 16) {
+            state = mum(load_as<LittleEndian, uint64_t>(p) ^ P1, load_as<LittleEndian, uint64_t>(p + 8) ^ state);
+            p += 16;
+            left -= 16;
+        }
+
+        // Last 1 - 16 bytes are read with possibly overlapping loads
+        if (left >= 8) {
+            a = load_as<LittleEndian, uint64_t>(p);
+            b = load_as<LittleEndian, uint64_t>(p + left - 8);
+        }
+        else if (left >= 4) {
+            a = load_as<LittleEndian, uint32_t>(p);
+            b = load_as<LittleEndian, uint32_t>(p + left - 4);
+        }
+        else if (left > 0) {
+            a = (static_cast<uint64_t>(p[0]) << 16) | (static_cast<uint64_t>(p[left >> 1]) << 8) | p[left - 1];
+        }
+
+        uint64_t ret = mum(P1 ^ size, mum(a ^ P1, b ^ state));
+        return mum(ret ^ P2, ret);
+    }
+
+    /**
+     * @brief Portable multiply-mix hash folded to 32 bits
+     */
+    uint32_t hash_portable(const void* data, std::size_t size, uint32_t seed)
+    {
+        uint64_t ret = hash_mix<false>(data, size, seed);
+        return static_cast<uint32_t>(ret ^ (ret >> 32));
+    }
+
+#ifdef CDNS_HASH_X86_CRC32C
+    __attribute__((target("sse4.2")))
+    uint32_t hash_sse42(const void* data, std::size_t size, uint32_t seed)
+    {
+        const unsigned char* p = static_cast<const unsigned char*>(data);
+        const unsigned char* end = p + size;
+        uint32_t ret = seed;
+
+#ifdef __x86_64__
+        for ( ; p + 8 <= end; p += 8)
+            ret = static_cast<uint32_t>(_mm_crc32_u64(ret, load<uint64_t>(p)));
+#endif
+        for ( ; p + 4 <= end; p += 4)
+            ret = _mm_crc32_u32(ret, load<uint32_t>(p));
+
+        if (p + 2 <= end) {
+            ret = _mm_crc32_u16(ret, load<uint16_t>(p));
+            p += 2;
+        }
+
+        if (p < end)
+            ret = _mm_crc32_u8(ret, *p);
+
+        return ~ret;
+    }
+#endif
+
+#ifdef CDNS_HASH_ARM_CRC32C
+#ifdef __clang__
+    __attribute__((target("crc")))
+#else
+    __attribute__((target("+crc")))
+#endif
+    uint32_t hash_armv8(const void* data, std::size_t size, uint32_t seed)
+    {
+        const unsigned char* p = static_cast<const unsigned char*>(data);
+        const unsigned char* end = p + size;
+        uint32_t ret = seed;
+
+        for ( ; p + 8 <= end; p += 8)
+            ret = __crc32cd(ret, load<uint64_t>(p));
+
+        if (p + 4 <= end) {
+            ret = __crc32cw(ret, load<uint32_t>(p));
+            p += 4;
+        }
+
+        if (p + 2 <= end) {
+            ret = __crc32ch(ret, load<uint16_t>(p));
+            p += 2;
+        }
+
+        if (p < end)
+            ret = __crc32cb(ret, *p);
+
+        return ~ret;
+    }
+#endif
+
+    /**
+     * @brief Get hash function of the backend or `nullptr` if the backend isn't compiled in
+     */
+    CDNS::HashFunction backend_function(CDNS::HashBackend backend)
+    {
+        switch (backend) {
+            case CDNS::HashBackend::PORTABLE:
+                return hash_portable;
+#ifdef CDNS_HASH_X86_CRC32C
+            case CDNS::HashBackend::SSE42_CRC32C:
+                return hash_sse42;
+#endif
+#ifdef CDNS_HASH_ARM_CRC32C
+            case CDNS::HashBackend::ARMV8_CRC32C:
+                return hash_armv8;
+#endif
+            default:
+                return nullptr;
+        }
+    }
+
+    /**
+     * @brief Choose the best hash backend supported by the CPU
+     */
+    CDNS::HashBackend detect_backend()
+    {
+        if (CDNS::hash_backend_supported(CDNS::HashBackend::SSE42_CRC32C))
+            return CDNS::HashBackend::SSE42_CRC32C;
+        if (CDNS::hash_backend_supported(CDNS::HashBackend::ARMV8_CRC32C))
+            return CDNS::HashBackend::ARMV8_CRC32C;
+
+        return CDNS::HashBackend::PORTABLE;
+    }
+
+    /**
+     * @brief Initial hash function, selects the backend and forwards the first call to it
+     */
+    uint32_t hash_resolve(const void* data, std::size_t size, uint32_t seed)
+    {
+        CDNS::HashFunction function = backend_function(detect_backend());
+        CDNS::detail::hash_function.store(function, std::memory_order_relaxed);
+        return function(data, size, seed);
+    }
+}
+
+std::atomic<CDNS::HashFunction> CDNS::detail::hash_function(hash_resolve);
+
+bool CDNS::hash_backend_supported(HashBackend backend)
+{
+    switch (backend) {
+        case HashBackend::PORTABLE:
+            return true;
+#ifdef CDNS_HASH_X86_CRC32C
+        case HashBackend::SSE42_CRC32C:
+            __builtin_cpu_init();
+            return __builtin_cpu_supports("sse4.2");
+#endif
+#ifdef CDNS_HASH_ARM_CRC32C
+        case HashBackend::ARMV8_CRC32C:
+            return getauxval(AT_HWCAP) & HWCAP_CRC32;
+#endif
+        default:
+            return false;
+    }
+}
+
+CDNS::HashBackend CDNS::get_hash_backend()
+{
+    HashFunction function = detail::hash_function.load(std::memory_order_relaxed);
+    if (function == hash_resolve) {
+        function = backend_function(detect_backend());
+        detail::hash_function.store(function, std::memory_order_relaxed);
+    }
+
+    for (auto backend : {HashBackend::SSE42_CRC32C, HashBackend::ARMV8_CRC32C}) {
+        if (function == backend_function(backend))
+            return backend;
+    }
+
+    return HashBackend::PORTABLE;
+}
+
+void CDNS::set_hash_backend(HashBackend backend)
+{
+    if (!hash_backend_supported(backend))
+        throw std::invalid_argument("Hash backend " + hash_backend_name(backend) + " isn't supported on this CPU");
+
+    detail::hash_function.store(backend_function(backend), std::memory_order_relaxed);
+}
+
+std::string CDNS::hash_backend_name(HashBackend backend)
+{
+    switch (backend) {
+        case HashBackend::PORTABLE: return "portable";
+        case HashBackend::SSE42_CRC32C: return "sse4.2-crc32c";
+        case HashBackend::ARMV8_CRC32C: return "armv8-crc32c";
+        default: return "unknown";
+    }
+}
+
+uint64_t CDNS::stable_hash(const void* data, std::size_t size, uint64_t seed)
+{
+    return hash_mix<true>(data, size, seed);
+}
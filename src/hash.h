@@ -10,13 +10,80 @@
 
 #include <cstdint>
 #include <cstddef>
-#include <smmintrin.h>
+#include <atomic>
+#include <string>
 #include <boost/optional.hpp>
 
 namespace CDNS {
 
     /**
-     * @brief CRC32 calculation for hashes on std::unordered_map non-primitive keys
+     * @brief Implementations of the hash function used for Block tables and other in-memory hash maps
+     *
+     * All backends produce 32-bit hash values. CRC32C backends produce identical values, the portable
+     * backend produces different ones. Hash values are never written to C-DNS output, so the choice of
+     * backend doesn't change the encoded data.
+     */
+    enum class HashBackend : uint8_t {
+        PORTABLE = 0, //!< Multiply-mix hash in plain C++ (wyhash-like), available everywhere
+        SSE42_CRC32C, //!< CRC32C using SSE4.2 instructions on x86 CPUs
+        ARMV8_CRC32C //!< CRC32C using ARMv8 CRC32 instructions on ARM CPUs
+    };
+
+    /**
+     * @brief Function computing hash of given data
+     * @param data Pointer to the start of data to calculate hash on
+     * @param size Size of the data in bytes
+     * @param seed Initial seed value for hash calculation
+     * @return 32-bit hash value
+     */
+    using HashFunction = uint32_t (*)(const void* data, std::size_t size, uint32_t seed);
+
+    namespace detail {
+        /**
+         * @brief Hash function of the active backend. Initially points to a function that detects
+         * the best backend supported by the CPU on its first call.
+         */
+        extern std::atomic<HashFunction> hash_function;
+    }
+
+    /**
+     * @brief Check if the hash backend can be used on this CPU
+     * @param backend Hash backend to check
+     * @return `true` if the backend was compiled in and the CPU supports it
+     */
+    bool hash_backend_supported(HashBackend backend);
+
+    /**
+     * @brief Get the active hash backend (detects the best supported backend if none is active yet)
+     */
+    HashBackend get_hash_backend();
+
+    /**
+     * @brief Switch all hashing to given backend. Mostly useful for benchmarks and tests. Hash tables
+     * mustn't contain any items when the backend is switched, because their hashes would change.
+     * @param backend Hash backend to use
+     * @throw std::invalid_argument if the backend isn't supported on this CPU
+     */
+    void set_hash_backend(HashBackend backend);
+
+    /**
+     * @brief Get name of the hash backend
+     * @param backend Hash backend
+     */
+    std::string hash_backend_name(HashBackend backend);
+
+    /**
+     * @brief 64-bit hash that doesn't depend on the hash backend, CPU or byte order of the host.
+     * Unlike hash_value() it can be used for hash values that are written to C-DNS output.
+     * @param data Pointer to the start of data to calculate hash on
+     * @param size Size of the data in bytes
+     * @param seed Initial seed value for hash calculation
+     * @return 64-bit hash value
+     */
+    uint64_t stable_hash(const void* data, std::size_t size, uint64_t seed = 0);
+
+    /**
+     * @brief Hash calculation for hashes on std::unordered_map non-primitive keys
      * @param data Pointer to the start of data to calculate hash on
      * @param size Size of the data in bytes
      * @param seed Initial seed value for hash calculation
@@ -24,38 +91,11 @@ namespace CDNS {
      */
     template<class T>
     std::size_t hash_value(T const* data, std::size_t size, uint32_t seed = ~0U) {
-        const char* start = reinterpret_cast<const char*>(data);
-        const char* end = start + size;
-        uint32_t ret = seed;
-
-        for ( ; start < end; ) {
-            // At least 8 bytes of data left
-            if (start + 8 <= end) {
-                ret = _mm_crc32_u64(ret, *reinterpret_cast<const uint64_t*>(start));
-                start += 8;
-            }
-            // At least 4 bytes of data left
-            else if (start + 4 <= end) {
-                ret = _mm_crc32_u32(ret, *reinterpret_cast<const uint32_t*>(start));
-                start += 4;
-            }
-            // At least 2 bytes of data left
-            else if (start + 2 <= end) {
-                ret = _mm_crc32_u16(ret, *reinterpret_cast<const uint16_t*>(start));
-                start += 2;
-            }
-            // 1 byte of data left
-            else {
-                ret = _mm_crc32_u8(ret, *reinterpret_cast<const uint8_t*>(start));
-                start += 1;
-            }
-        }
-
-        return static_cast<std::size_t>(~ret);
+        return static_cast<std::size_t>(detail::hash_function.load(std::memory_order_relaxed)(data, size, seed));
     }
 
     /**
-     * @brief CRC32 calculation for hashes on std::unordered_map non-primitive keys
+     * @brief Hash calculation for hashes on std::unordered_map non-primitive keys
      * @param data Data to calculate hash on
      * @param seed Initial seed value for hash calculation
      * @return Hash value for "data"
@@ -66,7 +106,7 @@ namespace CDNS {
     }
 
     /**
-     * @brief CRC32 calculation for hashes on std::unordered_map non-primitive keys
+     * @brief Hash calculation for hashes on std::unordered_map non-primitive keys
      * @param data Optional data to calculate hash on
      * @param seed Initial seed value for hash calculation
      * @return Hash value for "data"
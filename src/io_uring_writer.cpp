@@ -0,0 +1,498 @@
+/**
+ * Copyright © 2026 CZ.NIC, z. s. p. o.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, you can obtain one at https://mozilla.org/MPL/2.0/.
+ */
+
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+#include <cerrno>
+#include <exception>
+#include <iostream>
+#include <unistd.h>
+#include <fcntl.h>
+#include <sys/uio.h>
+
+#ifdef CDNS_HAVE_IO_URING
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <linux/io_uring.h>
+#endif
+
+#include "io_uring_writer.h"
+
+namespace {
+    constexpr std::size_t BUFFER_ALIGNMENT = 4096;
+}
+
+#ifdef CDNS_HAVE_IO_URING
+
+/**
+ * @brief Minimal io_uring instance driven by raw system calls (no liburing dependency)
+ */
+struct CDNS::Writer<CDNS::IoUringOutput>::Ring {
+    /**
+     * @brief Create io_uring instance and register given buffers with the kernel
+     * @param entries Number of submission queue entries
+     * @param iovecs Write buffers to register
+     * @return FALSE if io_uring isn't usable on this system
+     */
+    bool setup(unsigned entries, std::vector<struct iovec>& iovecs) {
+        struct io_uring_params params;
+        std::memset(&params, 0, sizeof(params));
+
+        fd = static_cast<int>(syscall(__NR_io_uring_setup, entries, &params));
+        if (fd < 0)
+            return false;
+
+        sq_len = params.sq_off.array + params.sq_entries * sizeof(unsigned);
+        cq_len = params.cq_off.cqes + params.cq_entries * sizeof(struct io_uring_cqe);
+        if (params.features & IORING_FEAT_SINGLE_MMAP)
+            sq_len = cq_len = std::max(sq_len, cq_len);
+
+        sq_ptr = mmap(nullptr, sq_len, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, fd,
+                      IORING_OFF_SQ_RING);
+        if (sq_ptr == MAP_FAILED)
+            return false;
+
+        if (params.features & IORING_FEAT_SINGLE_MMAP) {
+            cq_ptr = sq_ptr;
+        }
+        else {
+            cq_ptr = mmap(nullptr, cq_len, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, fd,
+                          IORING_OFF_CQ_RING);
+            if (cq_ptr == MAP_FAILED)
+                return false;
+        }
+
+        sqes_len = params.sq_entries * sizeof(struct io_uring_sqe);
+        sqes = static_cast<struct io_uring_sqe*>(mmap(nullptr, sqes_len, PROT_READ | PROT_WRITE,
+                                                      MAP_SHARED | MAP_POPULATE, fd, IORING_OFF_SQES));
+        if (sqes == MAP_FAILED) {
+            sqes = nullptr;
+            return false;
+        }
+
+        char* sq = static_cast<char*>(sq_ptr);
+        sq_tail = reinterpret_cast<unsigned*>(sq + params.sq_off.tail);
+        sq_mask = reinterpret_cast<unsigned*>(sq + params.sq_off.ring_mask);
+        sq_array = reinterpret_cast<unsigned*>(sq + params.sq_off.array);
+
+        char* cq = static_cast<char*>(cq_ptr);
+        cq_head = reinterpret_cast<unsigned*>(cq + params.cq_off.head);
+        cq_tail = reinterpret_cast<unsigned*>(cq + params.cq_off.tail);
+        cq_mask = reinterpret_cast<unsigned*>(cq + params.cq_off.ring_mask);
+        cqes = reinterpret_cast<struct io_uring_cqe*>(cq + params.cq_off.cqes);
+
+        // Registered buffers save the kernel from mapping user pages on every write. Registration
+        // can fail due to RLIMIT_MEMLOCK, in which case plain vectored writes are used instead.
+        fixed_buffers = syscall(__NR_io_uring_register, fd, IORING_REGISTER_BUFFERS, iovecs.data(),
+                                static_cast<unsigned>(iovecs.size())) == 0;
+
+        return true;
+    }
+
+    /**
+     * @brief Queue write of buffer to the submission ring and submit it to the kernel
+     * @param out Output file descriptor
+     * @param index Index of the buffer (stored as user data of the request)
+     * @param iov Buffer's data to write
+     * @param offset Offset in the output file
+     * @return 0 on success, negative errno value otherwise
+     */
+    int submit_write(int out, unsigned index, struct iovec* iov, off_t offset) {
+        unsigned tail = *sq_tail;
+        unsigned slot = tail & *sq_mask;
+        struct io_uring_sqe* sqe = &sqes[slot];
+
+        std::memset(sqe, 0, sizeof(*sqe));
+        sqe->fd = out;
+        sqe->off = static_cast<uint64_t>(offset);
+        sqe->user_data = index;
+        if (fixed_buffers) {
+            sqe->opcode = IORING_OP_WRITE_FIXED;
+            sqe->addr = reinterpret_cast<uint64_t>(iov->iov_base);
+            sqe->len = static_cast<uint32_t>(iov->iov_len);
+            sqe->buf_index = static_cast<uint16_t>(index);
+        }
+        else {
+            sqe->opcode = IORING_OP_WRITEV;
+            sqe->addr = reinterpret_cast<uint64_t>(iov);
+            sqe->len = 1;
+        }
+
+        sq_array[slot] = slot;
+        __atomic_store_n(sq_tail, tail + 1, __ATOMIC_RELEASE);
+
+        int ret;
+        int error = 0;
+        do {
+            ret = static_cast<int>(syscall(__NR_io_uring_enter, fd, 1, 0, 0, nullptr, 0));
+            error = ret < 0 ? errno : 0;
+        } while (ret < 0 && error == EINTR);
+
+        if (ret == 1)
+            return 0;
+
+        // The kernel didn't consume the entry, remove it from the submission ring so it isn't
+        // submitted later with the next write
+        __atomic_store_n(sq_tail, tail, __ATOMIC_RELEASE);
+        return ret < 0 ? -error : -EAGAIN;
+    }
+
+    /**
+     * @brief Get next completion from the completion ring
+     * @param wait Block until there is at least one completion available
+     * @param cqe Copy of the completion entry
+     * @return TRUE if a completion was retrieved
+     */
+    bool next_completion(bool wait, struct io_uring_cqe& cqe) {
+        while (true) {
+            unsigned head = *cq_head;
+            if (head != __atomic_load_n(cq_tail, __ATOMIC_ACQUIRE)) {
+                cqe = cqes[head & *cq_mask];
+                __atomic_store_n(cq_head, head + 1, __ATOMIC_RELEASE);
+                return true;
+            }
+
+            if (!wait)
+                return false;
+
+            int ret = static_cast<int>(syscall(__NR_io_uring_enter, fd, 0, 1, IORING_ENTER_GETEVENTS,
+                                               nullptr, 0));
+            if (ret < 0 && errno != EINTR)
+                throw CborOutputException("Waiting for io_uring completion failed: " +
+                                          std::string(std::strerror(errno)));
+        }
+    }
+
+    ~Ring() {
+        if (sqes)
+            munmap(sqes, sqes_len);
+        if (cq_ptr && cq_ptr != MAP_FAILED && cq_ptr != sq_ptr)
+            munmap(cq_ptr, cq_len);
+        if (sq_ptr && sq_ptr != MAP_FAILED)
+            munmap(sq_ptr, sq_len);
+        if (fd >= 0)
+            ::close(fd);
+    }
+
+    int fd = -1;
+    bool fixed_buffers = false;
+    void* sq_ptr = nullptr;
+    void* cq_ptr = nullptr;
+    std::size_t sq_len = 0;
+    std::size_t cq_len = 0;
+    std::size_t sqes_len = 0;
+    unsigned* sq_tail = nullptr;
+    unsigned* sq_mask = nullptr;
+    unsigned* sq_array = nullptr;
+    unsigned* cq_head = nullptr;
+    unsigned* cq_tail = nullptr;
+    unsigned* cq_mask = nullptr;
+    struct io_uring_cqe* cqes = nullptr;
+    struct io_uring_sqe* sqes = nullptr;
+    std::vector<struct iovec> iovecs;
+};
+
+#else
+
+/**
+ * @brief Placeholder for builds without io_uring support, writer always uses blocking writes
+ */
+struct CDNS::Writer<CDNS::IoUringOutput>::Ring {};
+
+#endif
+
+CDNS::Writer<CDNS::IoUringOutput>::Writer(const IoUringOutput& output, const std::string extension)
+    : BaseCborOutputWriter(), m_value(output), m_extension(extension), m_fd(-1), m_seekable(false),
+      m_offset(0), m_buffers(), m_current(0), m_in_flight(0), m_ring(nullptr)
+{
+    if (m_value.buffer_size == 0)
+        m_value.buffer_size = IoUringOutput::DEFAULT_BUFFER_SIZE;
+    if (m_value.queue_depth == 0)
+        m_value.queue_depth = 1;
+
+    allocate_buffers();
+
+#ifdef CDNS_HAVE_IO_URING
+    std::unique_ptr<Ring> ring = std::make_unique<Ring>();
+    ring->iovecs.resize(m_buffers.size());
+    for (std::size_t i = 0; i < m_buffers.size(); i++) {
+        ring->iovecs[i].iov_base = m_buffers[i].data;
+        ring->iovecs[i].iov_len = m_value.buffer_size;
+    }
+
+    if (ring->setup(m_value.queue_depth, ring->iovecs))
+        m_ring = std::move(ring);
+#endif
+
+    try {
+        open();
+    }
+    catch (...) {
+        release_buffers();
+        throw;
+    }
+}
+
+CDNS::Writer<CDNS::IoUringOutput>::~Writer()
+{
+    try {
+        close();
+    }
+    catch (std::exception& e) {
+        std::cerr << e.what() << std::endl;
+    }
+    // Unregister buffers by closing the ring before the memory is freed
+    m_ring.reset();
+    release_buffers();
+}
+
+void CDNS::Writer<CDNS::IoUringOutput>::write(const char* p, std::size_t size)
+{
+    while (size > 0) {
+        Buffer& buffer = m_buffers[m_current];
+        std::size_t len = std::min(size, m_value.buffer_size - buffer.used);
+
+        std::memcpy(buffer.data + buffer.used, p, len);
+        buffer.used += len;
+        p += len;
+        size -= len;
+
+        if (buffer.used == m_value.buffer_size)
+            submit_current();
+    }
+}
+
+void CDNS::Writer<CDNS::IoUringOutput>::rotate_output(const boost::any& value)
+{
+    if (value.type() != typeid(IoUringOutput))
+        return;
+
+    // New output is opened even if writing of the previous one failed, the failure is reported afterwards
+    std::exception_ptr error;
+    try {
+        close();
+    }
+    catch (...) {
+        error = std::current_exception();
+    }
+
+    // Buffer configuration is fixed for the lifetime of the writer, only the output changes
+    const IoUringOutput& output = boost::any_cast<const IoUringOutput&>(value);
+    m_value.filename = output.filename;
+    m_value.fd = output.fd;
+    open();
+
+    if (error)
+        std::rethrow_exception(error);
+}
+
+void CDNS::Writer<CDNS::IoUringOutput>::open()
+{
+    if (m_value.filename.empty()) {
+        struct stat buffer;
+        if (fstat(m_value.fd, &buffer) != 0)
+            throw CborOutputException("Given file descriptor is invalid!");
+        m_fd = m_value.fd;
+    }
+    else {
+        m_fd = ::open((m_value.filename + m_extension + ".part").c_str(), O_WRONLY | O_CREAT | O_TRUNC,
+                      0644);
+        if (m_fd < 0)
+            throw CborOutputException("Couldn't open the output file!");
+    }
+
+    // Writes are issued with explicit offsets so they can complete in any order. Non-seekable
+    // outputs (pipes, sockets) have to be written sequentially.
+    m_offset = lseek(m_fd, 0, SEEK_CUR);
+    m_seekable = m_offset >= 0;
+    if (!m_seekable)
+        m_offset = 0;
+}
+
+void CDNS::Writer<CDNS::IoUringOutput>::close()
+{
+    if (m_fd < 0)
+        return;
+
+    std::exception_ptr error;
+    try {
+        if (m_buffers[m_current].used > 0)
+            submit_current();
+    }
+    catch (...) {
+        error = std::current_exception();
+    }
+
+    // All writes have to finish before the buffers are reused, even if some of them failed
+    try {
+        drain(true);
+    }
+    catch (...) {
+        if (!error)
+            error = std::current_exception();
+    }
+
+    for (auto& buffer : m_buffers) {
+        buffer.used = 0;
+        buffer.busy = false;
+    }
+    m_current = 0;
+
+    ::close(m_fd);
+    m_fd = -1;
+
+    // Incomplete output keeps the .part extension
+    if (!m_value.filename.empty() && !error) {
+        if (std::rename((m_value.filename + m_extension + ".part").c_str(),
+                        (m_value.filename + m_extension).c_str()))
+            error = std::make_exception_ptr(CborOutputException("Couldn't rename the output file!"));
+    }
+
+    if (error)
+        std::rethrow_exception(error);
+}
+
+void CDNS::Writer<CDNS::IoUringOutput>::submit_current()
+{
+    Buffer& buffer = m_buffers[m_current];
+    buffer.offset = m_offset;
+
+#ifdef CDNS_HAVE_IO_URING
+    if (m_ring && m_seekable) {
+        struct iovec& iov = m_ring->iovecs[m_current];
+        iov.iov_base = buffer.data;
+        iov.iov_len = buffer.used;
+
+        // Buffer keeps its data if the submission fails, so the following writes don't leave a hole
+        int ret = m_ring->submit_write(m_fd, static_cast<unsigned>(m_current), &iov, buffer.offset);
+        if (ret < 0)
+            throw CborOutputException("Couldn't submit write to io_uring: " +
+                                      std::string(std::strerror(-ret)));
+
+        m_offset += buffer.used;
+        buffer.busy = true;
+        m_in_flight++;
+
+        // Move to the next buffer, waiting for its previous write to finish if necessary
+        m_current = (m_current + 1) % m_buffers.size();
+        drain(false);
+        return;
+    }
+#endif
+
+    write_sync(buffer.data, buffer.used, m_seekable ? buffer.offset : -1);
+    m_offset += buffer.used;
+    buffer.used = 0;
+}
+
+void CDNS::Writer<CDNS::IoUringOutput>::drain(bool all)
+{
+    std::exception_ptr error;
+    bool wait = false;
+
+    // Completions are processed even after a write failed, the kernel may still read the other buffers
+    do {
+        unsigned in_flight = m_in_flight;
+        try {
+            reap(wait);
+        }
+        catch (...) {
+            if (!error)
+                error = std::current_exception();
+
+            // Waiting for completions failed, pending writes can't be tracked anymore
+            if (wait && m_in_flight == in_flight)
+                abandon_ring();
+        }
+        wait = true;
+    } while (all ? m_in_flight > 0 : m_buffers[m_current].busy);
+
+    if (error)
+        std::rethrow_exception(error);
+}
+
+void CDNS::Writer<CDNS::IoUringOutput>::abandon_ring()
+{
+    // Closing the ring cancels the pending writes, the writer continues with blocking writes
+    m_ring.reset();
+    for (auto& buffer : m_buffers) {
+        if (buffer.busy) {
+            buffer.busy = false;
+            buffer.used = 0;
+        }
+    }
+    m_in_flight = 0;
+}
+
+void CDNS::Writer<CDNS::IoUringOutput>::reap(bool wait)
+{
+#ifdef CDNS_HAVE_IO_URING
+    struct io_uring_cqe cqe;
+
+    while (m_in_flight > 0 && m_ring->next_completion(wait, cqe)) {
+        wait = false;
+        Buffer& buffer = m_buffers[cqe.user_data];
+        buffer.busy = false;
+        m_in_flight--;
+
+        if (cqe.res < 0)
+            throw CborOutputException("Asynchronous write to output failed: " +
+                                      std::string(std::strerror(-cqe.res)));
+
+        // Finish short writes synchronously, they are rare for regular files
+        std::size_t written = static_cast<std::size_t>(cqe.res);
+        if (written < buffer.used)
+            write_sync(buffer.data + written, buffer.used - written, buffer.offset + written);
+
+        buffer.used = 0;
+    }
+#endif
+}
+
+void CDNS::Writer<CDNS::IoUringOutput>::write_sync(const char* p, std::size_t size, off_t offset)
+{
+    while (size > 0) {
+        ssize_t ret = offset >= 0 ? ::pwrite(m_fd, p, size, offset) : ::write(m_fd, p, size);
+        if (ret < 0) {
+            if (errno == EINTR)
+                continue;
+            throw CborOutputException("Couldn't write to output: " + std::string(std::strerror(errno)));
+        }
+
+        p += ret;
+        size -= ret;
+        if (offset >= 0)
+            offset += ret;
+    }
+}
+
+void CDNS::Writer<CDNS::IoUringOutput>::allocate_buffers()
+{
+    m_buffers.resize(m_value.queue_depth);
+    for (auto& buffer : m_buffers) {
+        void* mem = nullptr;
+        if (posix_memalign(&mem, BUFFER_ALIGNMENT, m_value.buffer_size) != 0) {
+            buffer.data = nullptr;
+            release_buffers();
+            throw CborOutputException("Couldn't allocate io_uring write buffers!");
+        }
+
+        buffer.data = static_cast<char*>(mem);
+        buffer.used = 0;
+        buffer.offset = 0;
+        buffer.busy = false;
+    }
+}
+
+void CDNS::Writer<CDNS::IoUringOutput>::release_buffers()
+{
+    for (auto& buffer : m_buffers)
+        std::free(buffer.data);
+    m_buffers.clear();
+}
@@ -0,0 +1,187 @@
+/**
+ * Copyright © 2026 CZ.NIC, z. s. p. o.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, you can obtain one at https://mozilla.org/MPL/2.0/.
+ */
+
+#pragma once
+
+#include <string>
+#include <vector>
+#include <memory>
+#include <cstdint>
+#include <boost/any.hpp>
+#include <sys/types.h>
+
+#include "writer.h"
+
+namespace CDNS {
+
+    /**
+     * @brief Identifies output written asynchronously through Linux io_uring
+     *
+     * Passing IoUringOutput instead of a file name or file descriptor to CdnsEncoder or CdnsExporter
+     * constructors selects Writer<IoUringOutput>. Data is gathered into large page aligned buffers
+     * and up to `queue_depth` buffers are written in parallel while the caller keeps filling
+     * the next one. If io_uring isn't available (old kernel, seccomp filter, library built without
+     * io_uring support) or the output isn't seekable, the writer falls back to plain blocking
+     * writes of the same large buffers.
+     */
+    struct IoUringOutput {
+        static constexpr std::size_t DEFAULT_BUFFER_SIZE = 1024 * 1024;
+        static constexpr unsigned DEFAULT_QUEUE_DEPTH = 4;
+
+        /**
+         * @brief Construct output identifier for file with given name
+         * @param name Name of the output file
+         * @param buffer_size Size of one write buffer in bytes
+         * @param depth Number of write buffers (maximum number of writes in flight)
+         */
+        IoUringOutput(const std::string& name, std::size_t buffer_size = DEFAULT_BUFFER_SIZE,
+                      unsigned depth = DEFAULT_QUEUE_DEPTH)
+            : filename(name), fd(-1), buffer_size(buffer_size), queue_depth(depth) {}
+
+        /**
+         * @brief Construct output identifier for already opened file descriptor
+         * @param fd File descriptor of the output (closed by the writer same as with Writer<int>)
+         * @param buffer_size Size of one write buffer in bytes
+         * @param depth Number of write buffers (maximum number of writes in flight)
+         */
+        IoUringOutput(int fd, std::size_t buffer_size = DEFAULT_BUFFER_SIZE,
+                      unsigned depth = DEFAULT_QUEUE_DEPTH)
+            : filename(), fd(fd), buffer_size(buffer_size), queue_depth(depth) {}
+
+        std::string filename;
+        int fd;
+        std::size_t buffer_size;
+        unsigned queue_depth;
+    };
+
+    /**
+     * @brief Writes data to output file or file descriptor using asynchronous io_uring writes
+     * @tparam IoUringOutput Output specification
+     */
+    template<>
+    class Writer<IoUringOutput> : public BaseCborOutputWriter {
+        public:
+        /**
+         * @brief Construct a new Writer<IoUringOutput> object
+         * @param output Output file name or file descriptor with buffer configuration
+         * @param extension Extension for the output file's name (NOT USED for file descriptors)
+         * @throw CborOutputException if opening of the output fails
+         */
+        Writer(const IoUringOutput& output, const std::string extension = "");
+
+        /**
+         * @brief Destroy the Writer object, wait for all pending writes and close the current output
+         */
+        ~Writer() override;
+
+        /** Delete copy and move constructors */
+        Writer(Writer& copy) = delete;
+        Writer(Writer&& copy) = delete;
+
+        /**
+         * @brief Buffer data and submit full buffers to the kernel
+         * @param p Start of the buffer with data
+         * @param size Size of the data in bytes
+         * @throw CborOutputException if any of the submitted writes fails
+         */
+        void write(const char* p, std::size_t size) override;
+
+        /**
+         * @brief Rotate the output (all pending writes are finished and current output is closed)
+         * @param value IoUringOutput specification of the new output
+         * @throw CborOutputException if opening of the new output fails or writes to the previous
+         * output failed (the new output is opened anyway)
+         */
+        void rotate_output(const boost::any& value) override;
+
+        /**
+         * @brief Check if writes are really submitted through io_uring
+         * @return FALSE if the writer fell back to blocking writes
+         */
+        bool is_async() const { return m_ring != nullptr && m_seekable; }
+
+        protected:
+        /**
+         * @brief Open the output file or check the given file descriptor
+         * @throw CborOutputException if opening of the output fails
+         */
+        void open() override;
+
+        /**
+         * @brief Write out all buffered data, wait for pending writes and close the output
+         *
+         * All pending writes are waited for even if some of them failed. Output file with failed
+         * writes keeps its ".part" extension.
+         * @throw CborOutputException with the first failure of the writes
+         */
+        void close() override;
+
+        private:
+        /**
+         * @brief One page aligned write buffer
+         */
+        struct Buffer {
+            char* data;
+            std::size_t used;
+            off_t offset;
+            bool busy;
+        };
+
+        /** io_uring instance, defined only in the translation unit */
+        struct Ring;
+
+        /**
+         * @brief Submit current buffer for writing and advance to the next free buffer
+         * @throw CborOutputException if writing fails
+         */
+        void submit_current();
+
+        /**
+         * @brief Reap completed writes
+         * @param wait Block until at least one write completes
+         * @throw CborOutputException if any of the completed writes failed
+         */
+        void reap(bool wait);
+
+        /**
+         * @brief Reap completed writes until the current buffer is free or until no writes are in flight.
+         * Failed writes don't stop the waiting.
+         * @param all Wait for all writes in flight
+         * @throw CborOutputException with the first failure of the reaped writes
+         */
+        void drain(bool all);
+
+        /**
+         * @brief Close the io_uring instance after waiting for its completions failed and continue
+         * with blocking writes
+         */
+        void abandon_ring();
+
+        /**
+         * @brief Blocking write of the whole buffer at given offset (or current position)
+         * @param p Start of the data
+         * @param size Size of the data in bytes
+         * @param offset Offset in the output or -1 for non-seekable outputs
+         * @throw CborOutputException if writing fails
+         */
+        void write_sync(const char* p, std::size_t size, off_t offset);
+
+        void allocate_buffers();
+        void release_buffers();
+
+        IoUringOutput m_value;
+        std::string m_extension;
+        int m_fd;
+        bool m_seekable;
+        off_t m_offset;
+        std::vector<Buffer> m_buffers;
+        std::size_t m_current;
+        unsigned m_in_flight;
+        std::unique_ptr<Ring> m_ring;
+    };
+}
@@ -0,0 +1,224 @@
+/**
+ * Copyright © 2026 CZ.NIC, z. s. p. o.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, you can obtain one at https://mozilla.org/MPL/2.0/.
+ */
+
+#include <queue>
+#include <algorithm>
+#include <utility>
+
+#include "cdns.h"
+#include "merge.h"
+
+namespace {
+    /**
+     * @brief Convert number of ticks between time resolutions without overflowing for large values
+     * @param ticks Number of ticks in the source resolution
+     * @param from Ticks per second of the source resolution
+     * @param to Ticks per second of the target resolution
+     */
+    int64_t convert_ticks(int64_t ticks, uint64_t from, uint64_t to)
+    {
+        if (from == to || from == 0)
+            return ticks;
+
+        int64_t f = static_cast<int64_t>(from);
+        int64_t t = static_cast<int64_t>(to);
+        return (ticks / f) * t + (ticks % f) * t / f;
+    }
+
+    /**
+     * @brief Convert timestamp between time resolutions
+     */
+    CDNS::Timestamp convert_timestamp(const CDNS::Timestamp& ts, uint64_t from, uint64_t to)
+    {
+        if (from == to || from == 0)
+            return ts;
+
+        return CDNS::Timestamp(ts.m_secs, static_cast<uint64_t>(convert_ticks(ts.m_ticks, from, to)));
+    }
+}
+
+/**
+ * @brief One input of the merge with its current Block and order of the Block's items
+ */
+struct CDNS::TimeOrderedMerge::Input {
+    Input(CdnsReader& reader, std::size_t prefetch)
+        : reader(reader), prefetcher(reader, prefetch), block(), qrs(), mms(), qr_pos(0), mm_pos(0),
+          ticks_per_second(0) {}
+
+    /**
+     * @brief Check if all items of the current Block were written
+     */
+    bool exhausted() const {
+        return qr_pos >= qrs.size() && mm_pos >= mms.size();
+    }
+
+    /**
+     * @brief Check if the next item to write is a Malformed message
+     */
+    bool next_is_mm() const {
+        if (mm_pos >= mms.size())
+            return false;
+
+        return qr_pos >= qrs.size() || mms[mm_pos].first < qrs[qr_pos].first;
+    }
+
+    /**
+     * @brief Get timestamp (in output resolution) of the next item to write
+     */
+    const Timestamp& next_ts() const {
+        return next_is_mm() ? mms[mm_pos].first : qrs[qr_pos].first;
+    }
+
+    /**
+     * @brief Read next Block of the input that contains timestamped items. Address event counts
+     * of the read Blocks are written to the exporter immediately.
+     * @return `false` if there are no more Blocks in the input
+     */
+    bool load(CdnsExporter& exporter, uint64_t out_tps, MergeStats& stats, std::size_t& written) {
+        while (true) {
+            bool eof = false;
+            prefetcher.next(block, eof);
+            if (eof)
+                return false;
+
+            stats.blocks_read++;
+            ticks_per_second = reader.m_file_preamble.get_block_parameters(block.get_block_parameters_index())
+                .storage_parameters.ticks_per_second;
+            Timestamp earliest = convert_timestamp(block.m_block_preamble.earliest_time, ticks_per_second, out_tps);
+
+            bool end = false;
+            while (true) {
+                GenericAddressEventCount aec = block.read_generic_aec(end);
+                if (end)
+                    break;
+                written += exporter.buffer_aec(aec);
+                stats.aec_count++;
+            }
+
+            qrs.clear();
+            qr_pos = 0;
+            uint32_t pos = 0;
+            block.for_each_qr([&](const QueryResponseView& qr) {
+                qrs.emplace_back(qr.ts() ? convert_timestamp(*qr.ts(), ticks_per_second, out_tps) : earliest, pos++);
+            });
+            std::stable_sort(qrs.begin(), qrs.end(), [](const std::pair<Timestamp, uint32_t>& a,
+                                                        const std::pair<Timestamp, uint32_t>& b) {
+                return a.first < b.first;
+            });
+
+            mms.clear();
+            mm_pos = 0;
+            while (true) {
+                GenericMalformedMessage mm = block.read_generic_mm(end);
+                if (end)
+                    break;
+                Timestamp ts = mm.ts ? convert_timestamp(*mm.ts, ticks_per_second, out_tps) : earliest;
+                if (mm.ts)
+                    mm.ts = ts;
+                mms.emplace_back(ts, std::move(mm));
+            }
+            std::stable_sort(mms.begin(), mms.end(), [](const std::pair<Timestamp, GenericMalformedMessage>& a,
+                                                        const std::pair<Timestamp, GenericMalformedMessage>& b) {
+                return a.first < b.first;
+            });
+
+            if (!exhausted())
+                return true;
+        }
+    }
+
+    /**
+     * @brief Write the next item of the current Block to the exporter
+     * @return Number of uncompressed bytes written by the exporter
+     */
+    std::size_t write_next(CdnsExporter& exporter, uint64_t out_tps, MergeStats& stats) {
+        if (next_is_mm()) {
+            stats.mm_count++;
+            return exporter.buffer_mm(mms[mm_pos++].second);
+        }
+
+        auto& item = qrs[qr_pos++];
+        GenericQueryResponse gqr = block.qr_view(item.second).to_generic();
+        if (gqr.ts)
+            gqr.ts = item.first;
+        if (gqr.response_delay)
+            gqr.response_delay = convert_ticks(*gqr.response_delay, ticks_per_second, out_tps);
+        if (gqr.round_trip_time)
+            gqr.round_trip_time = convert_ticks(*gqr.round_trip_time, ticks_per_second, out_tps);
+
+        stats.qr_count++;
+        return exporter.buffer_qr(gqr);
+    }
+
+    CdnsReader& reader;
+    CdnsBlockPrefetcher prefetcher;
+    CdnsBlockRead block;
+    std::vector<std::pair<Timestamp, uint32_t>> qrs; //!< Timestamps and positions of QRs in the Block
+    std::vector<std::pair<Timestamp, GenericMalformedMessage>> mms; //!< Malformed messages of the Block
+    std::size_t qr_pos;
+    std::size_t mm_pos;
+    uint64_t ticks_per_second; //!< Time resolution of the current Block
+};
+
+CDNS::TimeOrderedMerge::TimeOrderedMerge(std::size_t prefetch) : m_prefetch(prefetch), m_readers(), m_stats()
+{
+    if (prefetch == 0)
+        throw std::invalid_argument("Prefetch depth has to be at least 1");
+}
+
+CDNS::TimeOrderedMerge::~TimeOrderedMerge() = default;
+
+void CDNS::TimeOrderedMerge::add_input(CdnsReader& reader)
+{
+    m_readers.push_back(&reader);
+}
+
+std::size_t CDNS::TimeOrderedMerge::run(CdnsExporter& exporter)
+{
+    uint64_t out_tps = exporter.get_active_block_parameters_ref().storage_parameters.ticks_per_second;
+    std::size_t written = 0;
+
+    // Start decoding of all inputs
+    std::vector<std::unique_ptr<Input>> inputs;
+    inputs.reserve(m_readers.size());
+    for (auto reader : m_readers)
+        inputs.emplace_back(new Input(*reader, m_prefetch));
+
+    // Min-heap of the next item's timestamp of each input, ties are broken by the input's order
+    using Entry = std::pair<Timestamp, std::size_t>;
+    auto later = [](const Entry& a, const Entry& b) {
+        return b.first < a.first || (!(a.first < b.first) && b.second < a.second);
+    };
+    std::priority_queue<Entry, std::vector<Entry>, decltype(later)> heap(later);
+
+    for (std::size_t i = 0; i < inputs.size(); i++) {
+        if (inputs[i]->load(exporter, out_tps, m_stats, written))
+            heap.emplace(inputs[i]->next_ts(), i);
+    }
+
+    Timestamp last;
+    while (!heap.empty()) {
+        Entry next = heap.top();
+        heap.pop();
+        Input& input = *inputs[next.second];
+
+        if (next.first < last)
+            m_stats.out_of_order++;
+        else
+            last = next.first;
+
+        written += input.write_next(exporter, out_tps, m_stats);
+
+        if (input.exhausted() && !input.load(exporter, out_tps, m_stats, written))
+            continue;
+
+        heap.emplace(input.next_ts(), next.second);
+    }
+
+    return written;
+}
@@ -0,0 +1,93 @@
+/**
+ * Copyright © 2026 CZ.NIC, z. s. p. o.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, you can obtain one at https://mozilla.org/MPL/2.0/.
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <cstddef>
+#include <memory>
+#include <vector>
+
+namespace CDNS {
+    class CdnsReader;
+    class CdnsExporter;
+
+    /**
+     * @brief Statistics of time-ordered merge
+     */
+    struct MergeStats {
+        MergeStats() : blocks_read(0), qr_count(0), aec_count(0), mm_count(0), out_of_order(0) {}
+
+        uint64_t blocks_read; //!< Number of Blocks read from all inputs
+        uint64_t qr_count; //!< Number of merged Query/Response items
+        uint64_t aec_count; //!< Number of merged Address event count items
+        uint64_t mm_count; //!< Number of merged Malformed message items
+        uint64_t out_of_order; //!< Items written with earlier timestamp than the item before them
+    };
+
+    /**
+     * @brief K-way merge of multiple C-DNS inputs ordered by timestamps of their items
+     *
+     * Query/Response and Malformed message items of all inputs are written to one CdnsExporter
+     * in the order of their timestamps and the exporter packs them into new Blocks (with Block
+     * tables deduplicated over the merged items). Items of each Block are sorted by timestamp,
+     * so the output is fully ordered if Blocks of each input don't overlap in time. Otherwise
+     * the order is preserved as well as possible and the violations are counted in MergeStats.
+     * Address event counts have no timestamp and are written when the Block containing them
+     * is reached.
+     *
+     * Each input is decoded on its own background thread by CdnsBlockPrefetcher, memory use is
+     * bounded by the prefetch depth and the size of the inputs' Blocks. Timestamps and other
+     * values in ticks are converted to the resolution of the exporter's active Block parameters.
+     */
+    class TimeOrderedMerge {
+        public:
+        static constexpr std::size_t DEFAULT_PREFETCH = 2;
+
+        /**
+         * @brief Construct a new TimeOrderedMerge object
+         * @param prefetch Number of Blocks decoded ahead for each input
+         */
+        explicit TimeOrderedMerge(std::size_t prefetch = DEFAULT_PREFETCH);
+
+        ~TimeOrderedMerge();
+
+        /** Delete copy constructor and assignment operator */
+        TimeOrderedMerge(const TimeOrderedMerge& copy) = delete;
+        TimeOrderedMerge& operator=(const TimeOrderedMerge& rhs) = delete;
+
+        /**
+         * @brief Add input to the merge. The reader is used exclusively by the merge until run() returns.
+         * @param reader Reader of the input
+         */
+        void add_input(CdnsReader& reader);
+
+        /**
+         * @brief Merge all inputs to the exporter. Doesn't write the last (partially filled) Block
+         * of the exporter.
+         * @param exporter Exporter to write the merged items to
+         * @throw Rethrows exceptions thrown while reading the inputs
+         * @return Number of uncompressed bytes written by the exporter during the merge
+         */
+        std::size_t run(CdnsExporter& exporter);
+
+        /**
+         * @brief Get statistics of the merge
+         */
+        const MergeStats& get_stats() const {
+            return m_stats;
+        }
+
+        private:
+        struct Input;
+
+        std::size_t m_prefetch;
+        std::vector<CdnsReader*> m_readers;
+        MergeStats m_stats;
+    };
+}
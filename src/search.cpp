@@ -0,0 +1,415 @@
+/**
+ * Copyright © 2026 CZ.NIC, z. s. p. o.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, you can obtain one at https://mozilla.org/MPL/2.0/.
+ */
+
+#include <algorithm>
+#include <stdexcept>
+#include <arpa/inet.h>
+
+#include "search.h"
+
+namespace {
+    /**
+     * @brief Lowercase ASCII letters of domain name (label lengths are never letters)
+     */
+    std::string lowercase(const std::string& name)
+    {
+        std::string ret(name);
+        for (auto& c : ret) {
+            if (c >= 'A' && c <= 'Z')
+                c += 'a' - 'A';
+        }
+
+        return ret;
+    }
+
+    /**
+     * @brief Convert Timestamp to microseconds since the start of UNIX epoch
+     */
+    uint64_t to_microseconds(const CDNS::Timestamp& ts, uint64_t ticks_per_second)
+    {
+        uint64_t us = ts.m_secs * 1000000;
+        if (ticks_per_second > 0)
+            us += ts.m_ticks * 1000000 / ticks_per_second;
+
+        return us;
+    }
+
+    /**
+     * @brief Check if Block parameters shorten stored IP addresses
+     */
+    bool client_prefixes(const CDNS::StorageParameters& sp)
+    {
+        return sp.client_address_prefix_ipv4 || sp.client_address_prefix_ipv6;
+    }
+
+    bool server_prefixes(const CDNS::StorageParameters& sp)
+    {
+        return sp.server_address_prefix_ipv4 || sp.server_address_prefix_ipv6;
+    }
+
+    /**
+     * @brief Check if the Block may contain address from one of the prefixes according to its summary
+     * @param prefixes Searched prefixes
+     * @param summary Block summary
+     * @param range Compare with the range of client addresses in the summary
+     */
+    bool may_contain_address(const std::vector<CDNS::AddressPrefix>& prefixes, const CDNS::BlockSummary& summary,
+                             bool range)
+    {
+        for (auto& prefix : prefixes) {
+            if (prefix.is_address() && !summary.may_contain(CDNS::BlockSummary::address_hash(prefix.address)))
+                continue;
+
+            if (range && summary.min_client_address && summary.max_client_address) {
+                std::string low(prefix.address);
+                std::string high(prefix.address);
+                for (std::size_t bit = prefix.length; bit < prefix.address.size() * 8; bit++) {
+                    low[bit / 8] &= ~(0x80 >> (bit % 8));
+                    high[bit / 8] |= 0x80 >> (bit % 8);
+                }
+
+                if (*summary.max_client_address < low || high < *summary.min_client_address)
+                    continue;
+            }
+            else if (range && summary.qr_count > 0) {
+                // Summary without client addresses means no Query/Response item has one
+                continue;
+            }
+
+            return true;
+        }
+
+        return false;
+    }
+
+    /**
+     * @brief Evaluate the address prefixes for each entry of IP address Block table
+     * @return `false` if no entry matches
+     */
+    bool address_mask(const std::vector<CDNS::AddressPrefix>& prefixes, const CDNS::BlockTable<CDNS::StringItem>& table,
+                      std::vector<char>& mask)
+    {
+        bool any = false;
+        mask.assign(table.size(), 0);
+        for (std::size_t i = 0; i < table.size(); i++) {
+            for (auto& prefix : prefixes) {
+                if (prefix.matches(table[i].data)) {
+                    mask[i] = 1;
+                    any = true;
+                    break;
+                }
+            }
+        }
+
+        return any;
+    }
+
+    bool in_mask(const std::vector<char>& mask, const boost::optional<CDNS::index_t>& index)
+    {
+        return index && *index < mask.size() && mask[*index];
+    }
+}
+
+std::string CDNS::name_to_wire(const std::string& name)
+{
+    std::string wire;
+    std::size_t pos = 0;
+
+    while (pos < name.size()) {
+        std::size_t dot = name.find('.', pos);
+        if (dot == std::string::npos)
+            dot = name.size();
+
+        std::size_t length = dot - pos;
+        // Single "." is the root
+        if (length == 0 && !(pos == 0 && name.size() == 1))
+            throw std::invalid_argument("Empty label in domain name: " + name);
+        if (length > 63)
+            throw std::invalid_argument("Label longer than 63 characters in domain name: " + name);
+
+        if (length > 0) {
+            wire.push_back(static_cast<char>(length));
+            wire.append(name, pos, length);
+        }
+        pos = dot + 1;
+    }
+
+    wire.push_back('\0');
+    return wire;
+}
+
+std::string CDNS::wire_to_name(const std::string& wire)
+{
+    std::string name;
+    std::size_t pos = 0;
+
+    while (pos < wire.size()) {
+        uint8_t length = static_cast<uint8_t>(wire[pos]);
+        if (length == 0 || length > 63 || pos + 1 + length > wire.size())
+            break;
+
+        name.append(wire, pos + 1, length);
+        name.push_back('.');
+        pos += length + 1;
+    }
+
+    if (name.empty())
+        name = ".";
+
+    return name;
+}
+
+std::string CDNS::address_to_string(const std::string& address)
+{
+    char buf[INET6_ADDRSTRLEN];
+    std::string full(address);
+    int family = AF_INET;
+
+    if (full.size() <= 4) {
+        full.resize(4, '\0');
+    }
+    else if (full.size() <= 16) {
+        full.resize(16, '\0');
+        family = AF_INET6;
+    }
+    else {
+        return std::string();
+    }
+
+    if (!inet_ntop(family, full.data(), buf, sizeof(buf)))
+        return std::string();
+
+    return buf;
+}
+
+CDNS::AddressPrefix CDNS::AddressPrefix::parse(const std::string& text)
+{
+    AddressPrefix ret;
+    std::string address = text;
+    boost::optional<unsigned long> length;
+
+    std::size_t slash = text.find('/');
+    if (slash != std::string::npos) {
+        address = text.substr(0, slash);
+        std::string len = text.substr(slash + 1);
+        if (len.empty() || len.find_first_not_of("0123456789") != std::string::npos || len.size() > 3)
+            throw std::invalid_argument("Invalid prefix length: " + text);
+        length = std::stoul(len);
+    }
+
+    unsigned char buf[16];
+    if (inet_pton(AF_INET, address.c_str(), buf) == 1)
+        ret.address.assign(reinterpret_cast<char*>(buf), 4);
+    else if (inet_pton(AF_INET6, address.c_str(), buf) == 1)
+        ret.address.assign(reinterpret_cast<char*>(buf), 16);
+    else
+        throw std::invalid_argument("Invalid IP address: " + text);
+
+    ret.length = ret.address.size() * 8;
+    if (length) {
+        if (*length > ret.length)
+            throw std::invalid_argument("Invalid prefix length: " + text);
+        ret.length = static_cast<unsigned>(*length);
+    }
+
+    return ret;
+}
+
+bool CDNS::AddressPrefix::matches(const std::string& stored) const
+{
+    // Stored address can be shortened, but it can't be longer than the address of its family
+    if (stored.size() > address.size() || (address.size() == 4) != (stored.size() <= 4))
+        return false;
+
+    std::size_t bits = std::min<std::size_t>(length, stored.size() * 8);
+    std::size_t bytes = bits / 8;
+    if (stored.compare(0, bytes, address, 0, bytes) != 0)
+        return false;
+
+    if (bits % 8) {
+        uint8_t mask = static_cast<uint8_t>(0xff << (8 - bits % 8));
+        return (static_cast<uint8_t>(stored[bytes]) & mask) == (static_cast<uint8_t>(address[bytes]) & mask);
+    }
+
+    return true;
+}
+
+void CDNS::QueryResponseSearch::add_qname(const std::string& qname)
+{
+    m_qnames.insert(lowercase(qname));
+}
+
+void CDNS::QueryResponseSearch::add_qname_suffix(const std::string& suffix)
+{
+    m_suffixes.push_back(lowercase(suffix));
+}
+
+void CDNS::QueryResponseSearch::set_qname_regex(const std::string& regex)
+{
+    m_regex = std::regex(regex, std::regex::ECMAScript | std::regex::icase | std::regex::optimize);
+}
+
+bool CDNS::QueryResponseSearch::qname_matches(const std::string& qname) const
+{
+    std::string name = lowercase(qname);
+
+    if (m_qnames.find(name) != m_qnames.end())
+        return true;
+
+    for (auto& suffix : m_suffixes) {
+        // Compare only on label boundaries
+        std::size_t pos = 0;
+        while (pos < name.size()) {
+            if (name.size() - pos == suffix.size() && name.compare(pos, std::string::npos, suffix) == 0)
+                return true;
+
+            uint8_t length = static_cast<uint8_t>(name[pos]);
+            if (length == 0)
+                break;
+            pos += length + 1;
+        }
+    }
+
+    if (m_regex && std::regex_search(wire_to_name(qname), *m_regex))
+        return true;
+
+    return false;
+}
+
+bool CDNS::QueryResponseSearch::may_match(const BlockParameters& parameters, const BlockPreamble& preamble,
+                                          const BlockSummary& summary) const
+{
+    if (summary.qr_count == 0)
+        return false;
+
+    auto& sp = parameters.storage_parameters;
+
+    if (m_from) {
+        if (to_microseconds(preamble.earliest_time, sp.ticks_per_second) > m_to ||
+            to_microseconds(summary.latest_time, sp.ticks_per_second) < *m_from)
+            return false;
+    }
+
+    if (!m_rcodes.empty()) {
+        if (std::none_of(m_rcodes.begin(), m_rcodes.end(),
+                         [&summary](uint16_t rcode) { return summary.has_rcode(rcode); }))
+            return false;
+    }
+
+    // Suffixes and regular expression can't be looked up in the filter
+    if (!m_qnames.empty() && m_suffixes.empty() && !m_regex) {
+        if (std::none_of(m_qnames.begin(), m_qnames.end(),
+                         [&summary](const std::string& qname) {
+                             return summary.may_contain(BlockSummary::name_hash(qname));
+                         }))
+            return false;
+    }
+
+    // Addresses shortened by Block parameters aren't in the filter nor in the range in their full form
+    if (!m_clients.empty() && !client_prefixes(sp) && !may_contain_address(m_clients, summary, true))
+        return false;
+
+    if (!m_servers.empty() && !server_prefixes(sp) && !may_contain_address(m_servers, summary, false))
+        return false;
+
+    return true;
+}
+
+CDNS::BlockSummaryFilter CDNS::QueryResponseSearch::filter(const std::vector<BlockParameters>& block_parameters) const
+{
+    return [this, &block_parameters](const BlockPreamble& preamble, const BlockSummary& summary) {
+        index_t index = preamble.block_parameters_index ? *preamble.block_parameters_index : 0;
+        if (index >= block_parameters.size())
+            return true;
+
+        return may_match(block_parameters[index], preamble, summary);
+    };
+}
+
+std::size_t CDNS::QueryResponseSearch::search(const CdnsBlockRead& block, std::vector<std::size_t>& positions) const
+{
+    // Evaluate conditions on Block tables
+    std::vector<char> names;
+    if (has_qname()) {
+        bool any = false;
+        names.assign(block.m_name_rdata.size(), 0);
+        for (std::size_t i = 0; i < block.m_name_rdata.size(); i++) {
+            names[i] = qname_matches(block.m_name_rdata[i].data);
+            any |= names[i];
+        }
+
+        if (!any)
+            return 0;
+    }
+
+    std::vector<char> clients;
+    if (!m_clients.empty() && !address_mask(m_clients, block.m_ip_address, clients))
+        return 0;
+
+    std::vector<char> servers;
+    if (!m_servers.empty() && !address_mask(m_servers, block.m_ip_address, servers))
+        return 0;
+
+    std::vector<char> signatures;
+    bool check_signatures = !m_servers.empty() || !m_qtypes.empty() || !m_rcodes.empty();
+    if (check_signatures) {
+        bool any = false;
+        signatures.assign(block.m_qr_sig.size(), 0);
+        for (std::size_t i = 0; i < block.m_qr_sig.size(); i++) {
+            auto& sig = block.m_qr_sig[i];
+
+            if (!m_rcodes.empty() && (!sig.response_rcode || m_rcodes.find(*sig.response_rcode) == m_rcodes.end()))
+                continue;
+
+            if (!m_qtypes.empty()) {
+                if (!sig.query_classtype_index || *sig.query_classtype_index >= block.m_classtype.size() ||
+                    m_qtypes.find(block.m_classtype[*sig.query_classtype_index].type) == m_qtypes.end())
+                    continue;
+            }
+
+            if (!m_servers.empty() && !in_mask(servers, sig.server_address_index))
+                continue;
+
+            signatures[i] = 1;
+            any = true;
+        }
+
+        if (!any)
+            return 0;
+    }
+
+    // Test Block table indexes of the items
+    uint64_t ticks_per_second = block.get_block_parameters().storage_parameters.ticks_per_second;
+    std::size_t found = 0;
+    for (std::size_t i = 0; i < block.m_query_responses.size(); i++) {
+        auto& qr = block.m_query_responses[i];
+
+        if (has_qname() && !in_mask(names, qr.query_name_index))
+            continue;
+
+        if (!m_clients.empty() && !in_mask(clients, qr.client_address_index))
+            continue;
+
+        if (check_signatures && !in_mask(signatures, qr.qr_signature_index))
+            continue;
+
+        if (m_from) {
+            if (!qr.time_offset)
+                continue;
+
+            uint64_t time = to_microseconds(*qr.time_offset, ticks_per_second);
+            if (time < *m_from || time > m_to)
+                continue;
+        }
+
+        positions.push_back(i);
+        found++;
+    }
+
+    return found;
+}
@@ -0,0 +1,208 @@
+/**
+ * Copyright © 2026 CZ.NIC, z. s. p. o.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, you can obtain one at https://mozilla.org/MPL/2.0/.
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <cstddef>
+#include <string>
+#include <vector>
+#include <regex>
+#include <unordered_set>
+#include <boost/optional.hpp>
+
+#include "block.h"
+#include "file_preamble.h"
+
+namespace CDNS {
+
+    /**
+     * @brief Convert domain name in presentation format (e.g. "www.example.com") to uncompressed
+     * wire format as stored in NAME/RDATA Block table. Escape sequences aren't supported.
+     * @param name Domain name, trailing dot is optional, "." is the root
+     * @throw std::invalid_argument if a label is empty or longer than 63 characters
+     * @return Domain name in wire format
+     */
+    std::string name_to_wire(const std::string& name);
+
+    /**
+     * @brief Convert domain name in uncompressed wire format to presentation format
+     * @param wire Domain name in wire format
+     * @return Domain name in presentation format with trailing dot, malformed name is returned
+     * up to the malformed label
+     */
+    std::string wire_to_name(const std::string& wire);
+
+    /**
+     * @brief Convert IP address stored in Block table to presentation format. Addresses shortened
+     * by address prefix length in Block parameters are padded by zeros.
+     * @param address IP address as stored in the Block table (up to 4 bytes for IPv4, up to 16 bytes for IPv6)
+     * @return IP address in presentation format, empty string if the address is longer than 16 bytes
+     */
+    std::string address_to_string(const std::string& address);
+
+    /**
+     * @brief IP address or IP address prefix
+     */
+    struct AddressPrefix {
+        AddressPrefix() : address(), length(0) {}
+
+        /**
+         * @brief Parse IP address prefix
+         * @param text IPv4 or IPv6 address optionally followed by "/" and prefix length
+         * (e.g. "192.0.2.1", "192.0.2.0/24", "2001:db8::/32")
+         * @throw std::invalid_argument if the address or prefix length is invalid
+         */
+        static AddressPrefix parse(const std::string& text);
+
+        /**
+         * @brief Check if the prefix is a whole address (/32 for IPv4, /128 for IPv6)
+         */
+        bool is_address() const {
+            return length == address.size() * 8;
+        }
+
+        /**
+         * @brief Check if IP address stored in Block table belongs to the prefix. Addresses shortened
+         * by address prefix length in Block parameters are compared on the stored bits only.
+         * @param stored IP address as stored in the Block table
+         */
+        bool matches(const std::string& stored) const;
+
+        std::string address; //!< Address in network byte order (4 bytes for IPv4, 16 bytes for IPv6)
+        unsigned length; //!< Prefix length in bits
+    };
+
+    /**
+     * @brief Search for Query/Response items in C-DNS Blocks
+     *
+     * Items match if they match all kinds of conditions that were set and for each kind of
+     * condition at least one of its values (e.g. any of the QNAMEs and any of the client prefixes).
+     * QNAMEs are compared ASCII case-insensitively. Item without a field that has a condition set
+     * doesn't match.
+     *
+     * Conditions are evaluated once per Block table entry (NAME/RDATA, IP address and
+     * Query/Response signature tables) and each item then only tests its Block table indexes,
+     * so the cost of complex conditions doesn't grow with the number of items. Blocks with
+     * BlockSummary can be skipped without decoding by may_match().
+     */
+    class QueryResponseSearch {
+        public:
+        QueryResponseSearch() : m_qnames(), m_suffixes(), m_regex(), m_clients(), m_servers(), m_qtypes(),
+                                m_rcodes(), m_from(), m_to() {}
+
+        /**
+         * @brief Match items with given QNAME
+         * @param qname QNAME in uncompressed wire format
+         */
+        void add_qname(const std::string& qname);
+
+        /**
+         * @brief Match items with QNAME equal to or below given domain name
+         * @param suffix Domain name in uncompressed wire format
+         */
+        void add_qname_suffix(const std::string& suffix);
+
+        /**
+         * @brief Match items with QNAME matching regular expression
+         * @param regex ECMAScript regular expression searched for (case-insensitively) in QNAME
+         * in presentation format with trailing dot
+         * @throw std::regex_error if the regular expression is invalid
+         */
+        void set_qname_regex(const std::string& regex);
+
+        /**
+         * @brief Match items with client address in given prefix
+         */
+        void add_client(const AddressPrefix& prefix) {
+            m_clients.push_back(prefix);
+        }
+
+        /**
+         * @brief Match items with server address in given prefix
+         */
+        void add_server(const AddressPrefix& prefix) {
+            m_servers.push_back(prefix);
+        }
+
+        /**
+         * @brief Match items with given QTYPE
+         */
+        void add_qtype(uint16_t qtype) {
+            m_qtypes.insert(qtype);
+        }
+
+        /**
+         * @brief Match items with given response RCODE
+         */
+        void add_rcode(uint16_t rcode) {
+            m_rcodes.insert(rcode);
+        }
+
+        /**
+         * @brief Match items with timestamp in given time range
+         * @param from Start of the time range in microseconds since the start of UNIX epoch (inclusive)
+         * @param to End of the time range in microseconds since the start of UNIX epoch (inclusive)
+         */
+        void set_time_range(uint64_t from, uint64_t to) {
+            m_from = from;
+            m_to = to;
+        }
+
+        /**
+         * @brief Check if any condition was set
+         */
+        bool empty() const {
+            return !has_qname() && m_clients.empty() && m_servers.empty() && m_qtypes.empty() &&
+                   m_rcodes.empty() && !m_from;
+        }
+
+        /**
+         * @brief Check if Block may contain matching items according to its summary
+         * @param parameters Block parameters of the Block
+         * @param preamble Block preamble of the Block
+         * @param summary Summary of the Block
+         * @return `false` if the Block certainly doesn't contain any matching item
+         */
+        bool may_match(const BlockParameters& parameters, const BlockPreamble& preamble,
+                       const BlockSummary& summary) const;
+
+        /**
+         * @brief Get BlockSummaryFilter for reading Blocks of given C-DNS file
+         * @param block_parameters Block parameters from the file preamble. The search and the
+         * Block parameters have to outlive the filter.
+         */
+        BlockSummaryFilter filter(const std::vector<BlockParameters>& block_parameters) const;
+
+        /**
+         * @brief Find matching Query/Response items in the Block
+         * @param block Block to search in
+         * @param positions Positions of the matching items in the Block (see CdnsBlockRead::qr_view())
+         * are appended to this vector
+         * @return Number of matching items
+         */
+        std::size_t search(const CdnsBlockRead& block, std::vector<std::size_t>& positions) const;
+
+        private:
+        bool has_qname() const {
+            return !m_qnames.empty() || !m_suffixes.empty() || m_regex;
+        }
+
+        bool qname_matches(const std::string& qname) const;
+
+        std::unordered_set<std::string> m_qnames;
+        std::vector<std::string> m_suffixes;
+        boost::optional<std::regex> m_regex;
+        std::vector<AddressPrefix> m_clients;
+        std::vector<AddressPrefix> m_servers;
+        std::unordered_set<uint16_t> m_qtypes;
+        std::unordered_set<uint16_t> m_rcodes;
+        boost::optional<uint64_t> m_from;
+        uint64_t m_to;
+    };
+}
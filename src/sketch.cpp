@@ -0,0 +1,203 @@
+/**
+ * Copyright © 2026 CZ.NIC, z. s. p. o.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, you can obtain one at https://mozilla.org/MPL/2.0/.
+ */
+
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+
+#include "sketch.h"
+
+constexpr std::size_t CDNS::SpaceSaving::DEFAULT_CAPACITY;
+constexpr unsigned CDNS::HyperLogLog::DEFAULT_PRECISION;
+constexpr unsigned CDNS::HyperLogLog::MIN_PRECISION;
+constexpr unsigned CDNS::HyperLogLog::MAX_PRECISION;
+
+namespace {
+    /**
+     * @brief Order counters by count from the highest, equal counts alphabetically
+     */
+    bool higher_count(const CDNS::SpaceSaving::Entry& lhs, const CDNS::SpaceSaving::Entry& rhs)
+    {
+        if (lhs.count != rhs.count)
+            return lhs.count > rhs.count;
+        return lhs.key < rhs.key;
+    }
+}
+
+CDNS::SpaceSaving::SpaceSaving(std::size_t capacity)
+    : m_capacity(capacity), m_total(0), m_counters(), m_order()
+{
+    if (capacity == 0)
+        throw std::invalid_argument("Space-Saving summary needs at least 1 counter");
+}
+
+CDNS::SpaceSaving::SpaceSaving(const SpaceSaving& copy)
+    : m_capacity(copy.m_capacity), m_total(copy.m_total), m_counters(copy.m_counters), m_order()
+{
+    for (auto& counter : m_counters)
+        m_order.insert(&counter);
+}
+
+CDNS::SpaceSaving& CDNS::SpaceSaving::operator=(const SpaceSaving& rhs)
+{
+    if (this != &rhs) {
+        m_capacity = rhs.m_capacity;
+        m_total = rhs.m_total;
+        m_order.clear();
+        m_counters = rhs.m_counters;
+        for (auto& counter : m_counters)
+            m_order.insert(&counter);
+    }
+
+    return *this;
+}
+
+void CDNS::SpaceSaving::update(Map::value_type& counter, uint64_t count, uint64_t error)
+{
+    m_order.erase(&counter);
+    counter.second.count = count;
+    counter.second.error = error;
+    m_order.insert(&counter);
+}
+
+void CDNS::SpaceSaving::add(const std::string& key, uint64_t count)
+{
+    if (count == 0)
+        return;
+
+    m_total += count;
+    auto it = m_counters.find(key);
+    if (it != m_counters.end()) {
+        update(*it, it->second.count + count, it->second.error);
+        return;
+    }
+
+    // Replace the string with the lowest count
+    uint64_t min = 0;
+    if (m_counters.size() >= m_capacity) {
+        auto lowest = *m_order.begin();
+        min = lowest->second.count;
+        m_order.erase(m_order.begin());
+        m_counters.erase(m_counters.find(lowest->first));
+    }
+
+    auto inserted = m_counters.emplace(key, Counter{min + count, min});
+    m_order.insert(&*inserted.first);
+}
+
+void CDNS::SpaceSaving::merge(const SpaceSaving& other)
+{
+    // Strings without counter in one of the summaries occurred there at most min_count() times
+    uint64_t min = min_count();
+    uint64_t other_min = other.min_count();
+    std::vector<Entry> merged;
+    merged.reserve(m_counters.size() + other.m_counters.size());
+
+    for (auto& counter : m_counters) {
+        auto it = other.m_counters.find(counter.first);
+        if (it != other.m_counters.end())
+            merged.push_back(Entry{counter.first, counter.second.count + it->second.count,
+                                   counter.second.error + it->second.error});
+        else
+            merged.push_back(Entry{counter.first, counter.second.count + other_min, counter.second.error + other_min});
+    }
+
+    for (auto& counter : other.m_counters) {
+        if (m_counters.find(counter.first) == m_counters.end())
+            merged.push_back(Entry{counter.first, counter.second.count + min, counter.second.error + min});
+    }
+
+    // Keep the highest counts
+    if (merged.size() > m_capacity) {
+        std::nth_element(merged.begin(), merged.begin() + m_capacity, merged.end(), higher_count);
+        merged.resize(m_capacity);
+    }
+
+    m_order.clear();
+    m_counters.clear();
+    for (auto& entry : merged) {
+        auto inserted = m_counters.emplace(std::move(entry.key), Counter{entry.count, entry.error});
+        m_order.insert(&*inserted.first);
+    }
+    m_total += other.m_total;
+}
+
+std::vector<CDNS::SpaceSaving::Entry> CDNS::SpaceSaving::top(std::size_t k) const
+{
+    std::vector<Entry> ret;
+    ret.reserve(m_counters.size());
+    for (auto& counter : m_counters)
+        ret.push_back(Entry{counter.first, counter.second.count, counter.second.error});
+
+    k = std::min(k, ret.size());
+    std::partial_sort(ret.begin(), ret.begin() + k, ret.end(), higher_count);
+    ret.resize(k);
+    return ret;
+}
+
+uint64_t CDNS::SpaceSaving::min_count() const
+{
+    if (m_counters.size() < m_capacity || m_order.empty())
+        return 0;
+
+    return (*m_order.begin())->second.count;
+}
+
+CDNS::HyperLogLog::HyperLogLog(unsigned precision)
+    : m_precision(precision), m_registers()
+{
+    if (precision < MIN_PRECISION || precision > MAX_PRECISION)
+        throw std::invalid_argument("HyperLogLog precision has to be between " + std::to_string(MIN_PRECISION) +
+                                    " and " + std::to_string(MAX_PRECISION));
+
+    m_registers.assign(std::size_t(1) << precision, 0);
+}
+
+void CDNS::HyperLogLog::merge(const HyperLogLog& other)
+{
+    if (other.m_precision != m_precision)
+        throw std::invalid_argument("Can't merge HyperLogLog estimates with different precision");
+
+    for (std::size_t i = 0; i < m_registers.size(); i++)
+        m_registers[i] = std::max(m_registers[i], other.m_registers[i]);
+}
+
+double CDNS::HyperLogLog::estimate() const
+{
+    double m = static_cast<double>(m_registers.size());
+    double alpha;
+    switch (m_registers.size()) {
+        case 16:
+            alpha = 0.673;
+            break;
+        case 32:
+            alpha = 0.697;
+            break;
+        case 64:
+            alpha = 0.709;
+            break;
+        default:
+            alpha = 0.7213 / (1.0 + 1.079 / m);
+            break;
+    }
+
+    double sum = 0.0;
+    std::size_t zeros = 0;
+    for (auto reg : m_registers) {
+        sum += std::ldexp(1.0, -static_cast<int>(reg));
+        zeros += (reg == 0);
+    }
+
+    double estimate = alpha * m * m / sum;
+
+    // Linear counting is more accurate for small cardinalities
+    if (estimate <= 2.5 * m && zeros > 0)
+        estimate = m * std::log(m / static_cast<double>(zeros));
+
+    return estimate;
+}
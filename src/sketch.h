@@ -0,0 +1,196 @@
+/**
+ * Copyright © 2026 CZ.NIC, z. s. p. o.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, you can obtain one at https://mozilla.org/MPL/2.0/.
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <cstddef>
+#include <string>
+#include <vector>
+#include <set>
+#include <unordered_map>
+
+namespace CDNS {
+
+    /**
+     * @brief Space-Saving summary of the most frequent strings in bounded memory
+     *
+     * Keeps at most `capacity` counters. A string without a counter replaces the string with the
+     * lowest count and inherits its count as error, so each count is an upper bound of the string's
+     * real count and count minus error is a lower bound. Strings more frequent than total / capacity
+     * are guaranteed to have a counter.
+     *
+     * Summaries are mergeable (Agarwal et al., Mergeable Summaries), so partial summaries can be
+     * built in parallel and merged afterwards with the same error bounds.
+     */
+    class SpaceSaving {
+        public:
+        static constexpr std::size_t DEFAULT_CAPACITY = 10000;
+
+        /**
+         * @brief Counter of one string
+         */
+        struct Entry {
+            std::string key;
+            uint64_t count; //!< Upper bound of the string's count
+            uint64_t error; //!< Maximum overestimation of the count
+        };
+
+        /**
+         * @brief Construct empty summary
+         * @param capacity Maximum number of counters
+         * @throw std::invalid_argument if capacity is 0
+         */
+        explicit SpaceSaving(std::size_t capacity = DEFAULT_CAPACITY);
+
+        /**
+         * @brief Copy constructor and assignment operator rebuild the order of counters,
+         * which refers to the counters of the summary
+         */
+        SpaceSaving(const SpaceSaving& copy);
+        SpaceSaving& operator=(const SpaceSaving& rhs);
+
+        /** Moving keeps the counters in place */
+        SpaceSaving(SpaceSaving&& other) = default;
+        SpaceSaving& operator=(SpaceSaving&& rhs) = default;
+
+        /**
+         * @brief Count occurrences of the string
+         * @param key String to count
+         * @param count Number of occurrences
+         */
+        void add(const std::string& key, uint64_t count = 1);
+
+        /**
+         * @brief Merge other summary into this one. Summaries with different capacities can be merged,
+         * the result keeps the capacity of this summary.
+         * @param other Summary to merge
+         */
+        void merge(const SpaceSaving& other);
+
+        /**
+         * @brief Get counters of the most frequent strings
+         * @param k Maximum number of returned counters
+         * @return Counters ordered by count from the highest (strings with equal counts are ordered
+         * alphabetically)
+         */
+        std::vector<Entry> top(std::size_t k) const;
+
+        /**
+         * @brief Get the lowest count of a string with counter if all counters are used, 0 otherwise.
+         * Strings without counter occurred at most this many times.
+         */
+        uint64_t min_count() const;
+
+        /**
+         * @brief Get the number of used counters
+         */
+        std::size_t size() const {
+            return m_counters.size();
+        }
+
+        /**
+         * @brief Get the maximum number of counters
+         */
+        std::size_t capacity() const {
+            return m_capacity;
+        }
+
+        /**
+         * @brief Get the sum of all counted occurrences
+         */
+        uint64_t total() const {
+            return m_total;
+        }
+
+        private:
+        struct Counter {
+            uint64_t count;
+            uint64_t error;
+        };
+
+        using Map = std::unordered_map<std::string, Counter>;
+
+        /**
+         * @brief Order of counters by count (and key for equal counts), the lowest first
+         */
+        struct Less {
+            bool operator()(const Map::value_type* lhs, const Map::value_type* rhs) const {
+                if (lhs->second.count != rhs->second.count)
+                    return lhs->second.count < rhs->second.count;
+                return lhs->first < rhs->first;
+            }
+        };
+
+        /**
+         * @brief Change count of string that has a counter
+         */
+        void update(Map::value_type& counter, uint64_t count, uint64_t error);
+
+        std::size_t m_capacity;
+        uint64_t m_total;
+        Map m_counters;
+        std::set<const Map::value_type*, Less> m_order;
+    };
+
+    /**
+     * @brief HyperLogLog estimate of the number of distinct strings in bounded memory
+     *
+     * Uses 2^precision one-byte registers, the standard error of the estimate is about
+     * 1.04 / sqrt(2^precision) (0.8 % for the default precision). Small cardinalities
+     * are estimated by linear counting. Estimates are mergeable.
+     */
+    class HyperLogLog {
+        public:
+        static constexpr unsigned DEFAULT_PRECISION = 14;
+        static constexpr unsigned MIN_PRECISION = 4;
+        static constexpr unsigned MAX_PRECISION = 18;
+
+        /**
+         * @brief Construct empty estimate
+         * @param precision Number of hash bits selecting the register
+         * @throw std::invalid_argument if the precision is out of MIN_PRECISION..MAX_PRECISION range
+         */
+        explicit HyperLogLog(unsigned precision = DEFAULT_PRECISION);
+
+        /**
+         * @brief Add string to the estimate
+         * @param hash 64-bit hash of the string (e.g. stable_hash())
+         */
+        void add(uint64_t hash) {
+            std::size_t index = hash >> (64 - m_precision);
+            uint64_t rest = (hash << m_precision) | (1ULL << (m_precision - 1));
+            uint8_t rank = static_cast<uint8_t>(__builtin_clzll(rest) + 1);
+            if (m_registers[index] < rank)
+                m_registers[index] = rank;
+        }
+
+        /**
+         * @brief Merge other estimate into this one
+         * @param other Estimate to merge
+         * @throw std::invalid_argument if the estimates have different precision
+         */
+        void merge(const HyperLogLog& other);
+
+        /**
+         * @brief Get estimated number of distinct strings
+         */
+        double estimate() const;
+
+        /**
+         * @brief Get the precision of the estimate
+         */
+        unsigned precision() const {
+            return m_precision;
+        }
+
+        private:
+        unsigned m_precision;
+        std::vector<uint8_t> m_registers;
+    };
+}
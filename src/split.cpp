@@ -0,0 +1,423 @@
+/**
+ * Copyright © 2026 CZ.NIC, z. s. p. o.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, you can obtain one at https://mozilla.org/MPL/2.0/.
+ */
+
+#include <map>
+#include <deque>
+#include <vector>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <exception>
+#include <stdexcept>
+#include <utility>
+
+#include "cdns.h"
+#include "split.h"
+
+/**
+ * @brief Block queued for writing to an output
+ */
+struct CDNS::CdnsSplit::Task {
+    Task() : raw(), reencode(false), block_parameters_index(0), summary(false), filter_bits(0), qrs(), aecs(),
+             mms() {}
+
+    RawBlock raw; //!< Block copied without re-encoding (unless `reencode` is set)
+    bool reencode; //!< Items below are encoded to a new Block instead of copying `raw`
+    index_t block_parameters_index; //!< Block parameters of the new Block
+    bool summary; //!< Write BlockSummary with the new Block
+    unsigned filter_bits; //!< Bits per item of Bloom filter in the BlockSummary of the new Block, 0 for none
+    std::vector<GenericQueryResponse> qrs;
+    std::vector<GenericAddressEventCount> aecs;
+    std::vector<GenericMalformedMessage> mms;
+};
+
+/**
+ * @brief Output with the Blocks waiting for its writer thread
+ */
+struct CDNS::CdnsSplit::Output {
+    Output(std::unique_ptr<CdnsExporter> exporter, uint64_t bucket)
+        : exporter(std::move(exporter)), tasks(), bucket(bucket), blocks(0), bytes(0), closed(false),
+          finished(false), thread() {}
+
+    std::unique_ptr<CdnsExporter> exporter; //!< Destroyed (and finished) by the writer thread
+    std::deque<Task> tasks;
+    uint64_t bucket; //!< Time bucket of the output when splitting by time
+    uint64_t blocks; //!< Number of Blocks given to the output
+    uint64_t bytes; //!< Size of the Blocks given to the output
+    bool closed; //!< No more Blocks will be given to the output
+    bool finished; //!< Writer thread finished the output
+    std::condition_variable task_cv;
+    std::thread thread;
+};
+
+/**
+ * @brief State shared by the calling thread and the writer threads during run()
+ */
+struct CDNS::CdnsSplit::State {
+    State(CdnsSplit& split, CdnsReader& reader, const OpenOutput& open)
+        : split(split), reader(reader), open(open), file_preamble(reader.m_file_preamble),
+          block_parameters(reader.m_file_preamble.m_block_parameters), block(), outputs(), current(nullptr),
+          buckets(), closed_bucket(), pending(0), max_pending(2 * split.m_threads), error() {}
+
+    /**
+     * @brief Stop the writer threads after an error (keeps the first error)
+     */
+    void stop(std::exception_ptr e) {
+        std::lock_guard<std::mutex> lock(mutex);
+        if (!error)
+            error = e;
+        space_cv.notify_all();
+        for (auto& output : outputs)
+            output->task_cv.notify_all();
+    }
+
+    /**
+     * @brief Close all outputs and wait for the writer threads to finish
+     */
+    void join() {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            for (auto& output : outputs) {
+                output->closed = true;
+                output->task_cv.notify_all();
+            }
+        }
+
+        for (auto& output : outputs) {
+            if (output->thread.joinable())
+                output->thread.join();
+        }
+    }
+
+    /**
+     * @brief Read all Blocks of the input and give them to the outputs
+     */
+    void split_input() {
+        RawBlock current_block;
+        RawBlock next_block;
+        bool has_current = false;
+        bool eof = false;
+
+        while (!failed()) {
+            reader.read_raw_block(next_block, eof);
+            if (eof)
+                break;
+
+            split.m_stats.blocks_read++;
+
+            // Earliest time of the next Block tells whether the current Block may straddle time bucket
+            if (has_current)
+                place(current_block, &next_block.preamble.earliest_time);
+
+            std::swap(current_block, next_block);
+            has_current = true;
+        }
+
+        if (has_current && !failed())
+            place(current_block, nullptr);
+    }
+
+    /**
+     * @brief Give the Block to its output(s)
+     * @param raw Block to place
+     * @param next Earliest time of the following Block, `nullptr` for the last Block
+     */
+    void place(RawBlock& raw, const Timestamp* next) {
+        uint64_t limit = split.m_limit;
+
+        if (split.m_by != SplitBy::TIME) {
+            uint64_t size = raw.data.size();
+            if (!current || (split.m_by == SplitBy::BLOCKS && current->blocks >= limit) ||
+                (split.m_by == SplitBy::SIZE && current->blocks > 0 && current->bytes + size > limit)) {
+                if (current)
+                    close(*current);
+                current = &open_output(raw.preamble.earliest_time.m_secs, 0);
+            }
+
+            current->blocks++;
+            current->bytes += size;
+            copy(*current, raw);
+            return;
+        }
+
+        uint64_t bucket = raw.preamble.earliest_time.m_secs / limit;
+        if (closed_bucket && bucket <= *closed_bucket)
+            split.m_stats.out_of_order++;
+
+        // Blocks are expected in time order, so outputs of earlier buckets won't get any more Blocks
+        while (!buckets.empty() && buckets.begin()->first < bucket) {
+            close(*buckets.begin()->second);
+            closed_bucket = buckets.begin()->first;
+            buckets.erase(buckets.begin());
+        }
+
+        bool straddles;
+        if (raw.summary)
+            straddles = raw.summary->latest_time.m_secs / limit != bucket;
+        else
+            straddles = !next || next->m_secs / limit != bucket;
+
+        if (straddles && split_block(raw, bucket))
+            return;
+
+        copy(bucket_output(bucket), raw);
+    }
+
+    /**
+     * @brief Decode the Block and re-encode its items to the outputs of their time buckets
+     * @param raw Block to split
+     * @param bucket Time bucket of the Block's earliest time
+     * @return `false` if all items of the Block are in one bucket and the Block wasn't split
+     */
+    bool split_block(RawBlock& raw, uint64_t bucket) {
+        uint64_t limit = split.m_limit;
+        block.read(raw, block_parameters);
+
+        std::map<uint64_t, Task> pieces;
+        auto piece = [&](uint64_t piece_bucket) -> Task& {
+            auto it = pieces.find(piece_bucket);
+            if (it != pieces.end())
+                return it->second;
+
+            Task& task = pieces[piece_bucket];
+            task.reencode = true;
+            task.block_parameters_index = raw.get_block_parameters_index();
+            task.summary = static_cast<bool>(raw.summary);
+            task.filter_bits = block.get_read_summary_filter();
+            return task;
+        };
+
+        for (std::size_t i = 0; i < block.m_query_responses.size(); i++) {
+            GenericQueryResponse gqr = block.qr_view(i).to_generic();
+            piece(gqr.ts ? gqr.ts->m_secs / limit : bucket).qrs.push_back(std::move(gqr));
+        }
+
+        bool end = false;
+        while (true) {
+            GenericAddressEventCount aec = block.read_generic_aec(end);
+            if (end)
+                break;
+            piece(bucket).aecs.push_back(std::move(aec));
+        }
+
+        while (true) {
+            GenericMalformedMessage mm = block.read_generic_mm(end);
+            if (end)
+                break;
+            uint64_t mm_bucket = mm.ts ? mm.ts->m_secs / limit : bucket;
+            piece(mm_bucket).mms.push_back(std::move(mm));
+        }
+
+        if (pieces.size() <= 1)
+            return false;
+
+        split.m_stats.blocks_split++;
+        for (auto& p : pieces)
+            push(bucket_output(p.first), std::move(p.second));
+
+        return true;
+    }
+
+    /**
+     * @brief Get output of the time bucket, open it if necessary
+     */
+    Output& bucket_output(uint64_t bucket) {
+        auto it = buckets.find(bucket);
+        if (it != buckets.end())
+            return *it->second;
+
+        Output& output = open_output(bucket * split.m_limit, bucket);
+        buckets.emplace(bucket, &output);
+        return output;
+    }
+
+    /**
+     * @brief Open new output and start its writer thread. Waits if the maximum number of outputs
+     * are being written and some of them can finish.
+     * @param start Start passed to the function opening the outputs
+     * @param bucket Time bucket of the output
+     */
+    Output& open_output(uint64_t start, uint64_t bucket) {
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            space_cv.wait(lock, [this]() {
+                std::size_t running = 0;
+                bool closing = false;
+                for (auto& output : outputs) {
+                    if (!output->finished) {
+                        running++;
+                        closing = closing || output->closed;
+                    }
+                }
+                return error || running < split.m_threads || !closing;
+            });
+        }
+
+        FilePreamble fp = file_preamble;
+        std::unique_ptr<Output> output(new Output(open(fp, outputs.size(), start), bucket));
+        if (!output->exporter)
+            throw std::runtime_error("Output " + std::to_string(outputs.size()) + " wasn't opened");
+
+        Output& ret = *output;
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            outputs.push_back(std::move(output));
+        }
+        ret.thread = std::thread(&State::write, this, std::ref(ret));
+        split.m_stats.outputs++;
+        return ret;
+    }
+
+    /**
+     * @brief Tell the writer thread that the output won't get any more Blocks
+     */
+    void close(Output& output) {
+        std::lock_guard<std::mutex> lock(mutex);
+        output.closed = true;
+        output.task_cv.notify_all();
+    }
+
+    /**
+     * @brief Queue the raw Block for copying to the output
+     */
+    void copy(Output& output, RawBlock& raw) {
+        Task task;
+        task.raw = std::move(raw);
+        push(output, std::move(task));
+        split.m_stats.blocks_copied++;
+    }
+
+    /**
+     * @brief Queue the task for the output's writer thread, waits if too many Blocks are queued
+     */
+    void push(Output& output, Task&& task) {
+        std::unique_lock<std::mutex> lock(mutex);
+        space_cv.wait(lock, [this]() { return error || pending < max_pending; });
+        if (error)
+            return;
+
+        output.tasks.push_back(std::move(task));
+        pending++;
+        output.task_cv.notify_one();
+    }
+
+    /**
+     * @brief Check if a writer thread failed
+     */
+    bool failed() {
+        std::lock_guard<std::mutex> lock(mutex);
+        return static_cast<bool>(error);
+    }
+
+    /**
+     * @brief Main loop of writer threads
+     */
+    void write(Output& output) {
+        try {
+            while (true) {
+                Task task;
+                {
+                    std::unique_lock<std::mutex> lock(mutex);
+                    output.task_cv.wait(lock, [&output, this]() {
+                        return !output.tasks.empty() || output.closed || error;
+                    });
+                    if (output.tasks.empty() || error)
+                        break;
+
+                    task = std::move(output.tasks.front());
+                    output.tasks.pop_front();
+                }
+
+                write_task(*output.exporter, task);
+
+                std::lock_guard<std::mutex> lock(mutex);
+                pending--;
+                space_cv.notify_all();
+            }
+
+            // Write the end of the output
+            output.exporter.reset();
+        }
+        catch (...) {
+            stop(std::current_exception());
+        }
+
+        std::lock_guard<std::mutex> lock(mutex);
+        output.finished = true;
+        space_cv.notify_all();
+    }
+
+    /**
+     * @brief Write the Block of the task to the exporter
+     */
+    static void write_task(CdnsExporter& exporter, Task& task) {
+        if (!task.reencode) {
+            exporter.write_raw_block(task.raw);
+            return;
+        }
+
+        // Start new Block with the Block parameters of the split Block
+        exporter.set_active_block_parameters(task.block_parameters_index);
+        exporter.write_block();
+        exporter.set_block_summary(task.summary);
+        exporter.set_block_filter(task.filter_bits);
+
+        for (auto& aec : task.aecs)
+            exporter.buffer_aec(aec);
+        for (auto& qr : task.qrs)
+            exporter.buffer_qr(qr);
+        for (auto& mm : task.mms)
+            exporter.buffer_mm(mm);
+        exporter.write_block();
+    }
+
+    CdnsSplit& split;
+    CdnsReader& reader;
+    const OpenOutput& open;
+    FilePreamble file_preamble; //!< File preamble of the input for the outputs
+    std::vector<BlockParameters> block_parameters; //!< Block parameters for decoding of split Blocks
+    CdnsBlockRead block; //!< Decoded Block being split
+    std::vector<std::unique_ptr<Output>> outputs; //!< All outputs in the order of opening
+    Output* current; //!< Current output when not splitting by time
+    std::map<uint64_t, Output*> buckets; //!< Open outputs by time bucket when splitting by time
+    boost::optional<uint64_t> closed_bucket; //!< Latest time bucket with closed output
+    std::size_t pending; //!< Number of Blocks queued for writing in all outputs
+    std::size_t max_pending;
+    std::exception_ptr error;
+    std::mutex mutex;
+    std::condition_variable space_cv;
+};
+
+CDNS::CdnsSplit::CdnsSplit(SplitBy by, uint64_t limit, std::size_t threads)
+    : m_by(by), m_limit(limit), m_threads(threads ? threads : std::max(std::thread::hardware_concurrency(), 1U)),
+      m_stats()
+{
+    if (limit == 0)
+        throw std::invalid_argument("Split limit has to be positive");
+}
+
+CDNS::CdnsSplit::~CdnsSplit() = default;
+
+std::size_t CDNS::CdnsSplit::run(CdnsReader& reader, const OpenOutput& open)
+{
+    m_stats = SplitStats();
+    State state(*this, reader, open);
+
+    try {
+        state.split_input();
+    }
+    catch (...) {
+        state.stop(std::current_exception());
+    }
+
+    state.join();
+    if (state.error)
+        std::rethrow_exception(state.error);
+
+    return state.outputs.size();
+}
@@ -0,0 +1,112 @@
+/**
+ * Copyright © 2026 CZ.NIC, z. s. p. o.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, you can obtain one at https://mozilla.org/MPL/2.0/.
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <cstddef>
+#include <memory>
+#include <functional>
+
+namespace CDNS {
+    class CdnsReader;
+    class CdnsExporter;
+    class FilePreamble;
+
+    /**
+     * @brief Criterion of splitting C-DNS input to multiple outputs
+     */
+    enum class SplitBy : uint8_t {
+        BLOCKS = 0, //!< Maximum number of Blocks in each output
+        SIZE, //!< Maximum uncompressed size of Blocks in each output in bytes
+        TIME //!< Time buckets of given length in seconds (aligned to multiples of the length since UNIX epoch)
+    };
+
+    /**
+     * @brief Statistics of splitting
+     */
+    struct SplitStats {
+        SplitStats() : blocks_read(0), blocks_copied(0), blocks_split(0), outputs(0), out_of_order(0) {}
+
+        uint64_t blocks_read; //!< Number of Blocks read from the input
+        uint64_t blocks_copied; //!< Number of Blocks copied to output without re-encoding
+        uint64_t blocks_split; //!< Number of Blocks straddling time bucket boundary re-encoded to multiple outputs
+        uint64_t outputs; //!< Number of opened outputs
+        uint64_t out_of_order; //!< Blocks starting in a time bucket whose output was already finished
+    };
+
+    /**
+     * @brief Splits C-DNS input to multiple outputs by number of Blocks, size of Blocks or time buckets
+     *
+     * Blocks are copied to the outputs as raw bytes (see CdnsReader::read_raw_block()) without
+     * decoding them. When splitting by time, Blocks are assigned to time buckets by the earliest time
+     * in their Block preamble. Only Blocks that may straddle a bucket boundary are decoded: Blocks
+     * whose summary (see CdnsExporter::set_block_summary()) shows a latest time in another bucket,
+     * or without summary, Blocks followed by a Block starting in another bucket and the last Block.
+     * Items of a decoded Block spanning multiple buckets are re-encoded to one new Block in each
+     * of the buckets' outputs (Address event counts, which have no timestamp, go to the bucket of
+     * the Block's earliest time). Blocks without summary are therefore assumed not to overlap in time.
+     *
+     * All outputs get the file preamble of the input, so the Block parameters indexes stay valid.
+     * Each output is written (and compressed) by its own thread, so finishing of the previous
+     * outputs overlaps with reading of the next ones. Memory use is bounded by the number of Blocks
+     * queued for writing (twice the number of threads).
+     */
+    class CdnsSplit {
+        public:
+        /**
+         * @brief Function opening output with given index (counted from 0) for the given file preamble.
+         * `start` is the start of the time bucket in seconds since UNIX epoch when splitting by time,
+         * otherwise the seconds of the earliest time of the output's first Block.
+         */
+        using OpenOutput = std::function<std::unique_ptr<CdnsExporter>(FilePreamble& fp, std::size_t index,
+                                                                       uint64_t start)>;
+
+        /**
+         * @brief Construct a new CdnsSplit object
+         * @param by Criterion of the splitting
+         * @param limit Number of Blocks, number of bytes or length of time bucket in seconds
+         * @param threads Maximum number of outputs written at once (0 for the number of CPUs)
+         * @throw std::invalid_argument if limit is 0
+         */
+        CdnsSplit(SplitBy by, uint64_t limit, std::size_t threads = 0);
+
+        ~CdnsSplit();
+
+        /** Delete copy constructor and assignment operator */
+        CdnsSplit(const CdnsSplit& copy) = delete;
+        CdnsSplit& operator=(const CdnsSplit& rhs) = delete;
+
+        /**
+         * @brief Split all remaining Blocks of the input. The reader is used exclusively by the split
+         * until run() returns.
+         * @param reader Reader of the input
+         * @param open Function opening the outputs, called on the calling thread
+         * @throw Rethrows exceptions thrown while reading the input or opening and writing the outputs
+         * @return Number of opened outputs
+         */
+        std::size_t run(CdnsReader& reader, const OpenOutput& open);
+
+        /**
+         * @brief Get statistics of the split
+         */
+        const SplitStats& get_stats() const {
+            return m_stats;
+        }
+
+        private:
+        struct State;
+        struct Output;
+        struct Task;
+
+        SplitBy m_by;
+        uint64_t m_limit;
+        std::size_t m_threads;
+        SplitStats m_stats;
+    };
+}
@@ -0,0 +1,97 @@
+/**
+ * Copyright © 2026 CZ.NIC, z. s. p. o.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, you can obtain one at https://mozilla.org/MPL/2.0/.
+ */
+
+#include <sstream>
+#include <iomanip>
+
+#include "stats.h"
+
+namespace {
+    /**
+     * @brief Write one line with statistics of a Block table to the stream
+     */
+    void table_line(std::stringstream& ss, const char* name, const CDNS::TableStats& stats)
+    {
+        ss << "\t" << std::left << std::setw(24) << name << std::right
+           << "items: " << std::setw(10) << stats.items
+           << "  lookups: " << std::setw(10) << stats.lookups
+           << "  hit ratio: " << std::fixed << std::setprecision(3) << stats.hit_ratio() << std::endl;
+    }
+
+    /**
+     * @brief Convert nanoseconds to seconds for printing
+     */
+    double seconds(uint64_t ns)
+    {
+        return ns / 1e9;
+    }
+}
+
+std::string CDNS::BlockTablesStats::string() const
+{
+    std::stringstream ss;
+
+    table_line(ss, "ip_address", ip_address);
+    table_line(ss, "classtype", classtype);
+    table_line(ss, "name_rdata", name_rdata);
+    table_line(ss, "qr_sig", qr_sig);
+    table_line(ss, "qlist", qlist);
+    table_line(ss, "qrr", qrr);
+    table_line(ss, "rrlist", rrlist);
+    table_line(ss, "rr", rr);
+    table_line(ss, "malformed_message_data", malformed_message_data);
+
+    return ss.str();
+}
+
+std::string CDNS::ExporterStats::string() const
+{
+    std::stringstream ss;
+
+    ss << "Blocks written: " << blocks_written << std::endl;
+    ss << "Query/Response items: " << qr_count << std::endl;
+    ss << "Address event count items: " << aec_count << std::endl;
+    ss << "Malformed message items: " << mm_count << std::endl;
+    ss << "Dropped by storage hints (QR/AEC/MM): " << dropped_qrs << "/" << dropped_aecs << "/"
+       << dropped_mms << std::endl;
+    ss << "Uncompressed bytes: " << uncompressed_bytes << std::endl;
+    ss << "Compressed bytes: " << compressed_bytes << std::endl;
+    ss << "Compression ratio: " << std::fixed << std::setprecision(3) << compression_ratio() << std::endl;
+    ss << "Write time [s]: " << std::setprecision(6) << seconds(write_ns) << " (encoding: "
+       << seconds(encode_ns()) << ", compression and output: " << seconds(output_ns) << ")" << std::endl;
+    ss << "Output rotations: " << rotations << " (total [s]: " << seconds(rotation_ns) << ", max [s]: "
+       << seconds(max_rotation_ns) << ")" << std::endl;
+    ss << "Block tables:" << std::endl;
+    ss << tables.string();
+
+    return ss.str();
+}
+
+std::string CDNS::ReaderStats::string() const
+{
+    std::stringstream ss;
+
+    ss << "Blocks read: " << blocks_read << " (skipped: " << blocks_skipped << ")" << std::endl;
+    ss << "Query/Response items: " << qr_count << std::endl;
+    ss << "Address event count items: " << aec_count << std::endl;
+    ss << "Malformed message items: " << mm_count << std::endl;
+    ss << "Bytes read: " << decoder.bytes_read << " (decoded: " << bytes_consumed << ")" << std::endl;
+    ss << "Bytes per block: " << std::fixed << std::setprecision(1) << bytes_per_block()
+       << " (max: " << max_block_bytes << ")" << std::endl;
+    ss << "Buffer refills: " << decoder.buffer_refills << std::endl;
+    ss << "Strings: " << decoder.strings << " (bytes: " << decoder.string_bytes << ", allocations: "
+       << decoder.string_allocations << ")" << std::endl;
+    ss << std::setprecision(6);
+    ss << "Read time [s]: " << seconds(read_ns) << " (input: " << seconds(decoder.input_ns) << ", decoding: "
+       << seconds(decode_ns()) << ")" << std::endl;
+    ss << "Decoding phases [s]: tables: " << seconds(phases_ns.tables_ns) << ", items: "
+       << seconds(phases_ns.items_ns) << ", timestamps: " << seconds(phases_ns.fixup_ns) << std::endl;
+    ss << "Generic items conversion [s]: " << seconds(phases_ns.materialize_ns) << std::endl;
+
+    return ss.str();
+}
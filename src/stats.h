@@ -0,0 +1,295 @@
+/**
+ * Copyright © 2026 CZ.NIC, z. s. p. o.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, you can obtain one at https://mozilla.org/MPL/2.0/.
+ */
+
+#pragma once
+
+#include <string>
+#include <cstdint>
+#include <chrono>
+
+namespace CDNS {
+
+    /**
+     * @brief Get current value of monotonic clock in nanoseconds, used to time library operations
+     * @return Current value of monotonic clock in nanoseconds
+     */
+    inline uint64_t monotonic_ns() {
+        return std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now().time_since_epoch()).count();
+    }
+
+    /**
+     * @brief Adds time elapsed between its construction and destruction to given counter if enabled
+     */
+    class ScopedTimer {
+        public:
+        /**
+         * @brief Construct a new ScopedTimer object
+         * @param counter Counter of nanoseconds to add the elapsed time to
+         * @param enabled If `false` the timer does nothing (doesn't even read the clock)
+         */
+        ScopedTimer(uint64_t& counter, bool enabled) : m_counter(counter), m_enabled(enabled),
+                                                       m_start(enabled ? monotonic_ns() : 0) {}
+
+        /**
+         * @brief Destroy the ScopedTimer object and add the elapsed time to the counter
+         */
+        ~ScopedTimer() {
+            if (m_enabled)
+                m_counter += monotonic_ns() - m_start;
+        }
+
+        ScopedTimer(const ScopedTimer& copy) = delete;
+        ScopedTimer& operator=(const ScopedTimer& rhs) = delete;
+
+        private:
+        uint64_t& m_counter;
+        bool m_enabled;
+        uint64_t m_start;
+    };
+
+    /**
+     * @brief Deduplication statistics of one Block table
+     */
+    struct TableStats {
+        TableStats() : items(0), lookups(0), hits(0) {}
+
+        /**
+         * @brief Get the ratio of added values that were already present in the table
+         * @return Ratio of deduplicated values, 0 if nothing was added to the table
+         */
+        double hit_ratio() const {
+            return lookups ? static_cast<double>(hits) / lookups : 0.0;
+        }
+
+        /**
+         * @brief Accumulate statistics of another table (or another Block's table)
+         */
+        TableStats& operator+=(const TableStats& rhs) {
+            items += rhs.items;
+            lookups += rhs.lookups;
+            hits += rhs.hits;
+            return *this;
+        }
+
+        uint64_t items; //!< Number of distinct values stored in the table
+        uint64_t lookups; //!< Number of values added to the table
+        uint64_t hits; //!< Number of added values that were already present in the table
+    };
+
+    /**
+     * @brief Deduplication statistics of all Block tables in C-DNS Block
+     */
+    struct BlockTablesStats {
+        /**
+         * @brief Accumulate statistics of another Block
+         */
+        BlockTablesStats& operator+=(const BlockTablesStats& rhs) {
+            ip_address += rhs.ip_address;
+            classtype += rhs.classtype;
+            name_rdata += rhs.name_rdata;
+            qr_sig += rhs.qr_sig;
+            qlist += rhs.qlist;
+            qrr += rhs.qrr;
+            rrlist += rhs.rrlist;
+            rr += rhs.rr;
+            malformed_message_data += rhs.malformed_message_data;
+            return *this;
+        }
+
+        /**
+         * @brief Creates string representation of Block tables statistics
+         * @return String representation with one line per Block table
+         */
+        std::string string() const;
+
+        TableStats ip_address;
+        TableStats classtype;
+        TableStats name_rdata;
+        TableStats qr_sig;
+        TableStats qlist;
+        TableStats qrr;
+        TableStats rrlist;
+        TableStats rr;
+        TableStats malformed_message_data;
+    };
+
+    /**
+     * @brief Statistics of one C-DNS Block written by CdnsExporter
+     *
+     * Compressed bytes are counted when the compressor releases them to the output. Compressors keep
+     * internal buffers, so for compressed outputs the value is only an approximation of the Block's
+     * contribution and the rest is attributed to later Blocks or to closing the output.
+     */
+    struct BlockWriteStats {
+        BlockWriteStats() : qr_count(0), aec_count(0), mm_count(0), uncompressed_bytes(0),
+                            compressed_bytes(0), write_ns(0), output_ns(0) {}
+
+        /**
+         * @brief Get time spent encoding the Block to CBOR (without compression and output)
+         * @return Encoding time in nanoseconds
+         */
+        uint64_t encode_ns() const {
+            return write_ns > output_ns ? write_ns - output_ns : 0;
+        }
+
+        uint64_t qr_count; //!< Number of Query/Response items in the Block
+        uint64_t aec_count; //!< Number of Address event count items in the Block
+        uint64_t mm_count; //!< Number of Malformed message items in the Block
+        uint64_t uncompressed_bytes; //!< Size of the encoded Block in bytes
+        uint64_t compressed_bytes; //!< Bytes written to the output while writing the Block
+        uint64_t write_ns; //!< Total time spent in CdnsExporter::write_block()
+        uint64_t output_ns; //!< Time spent compressing and writing encoded data to the output
+        BlockTablesStats tables; //!< Block tables statistics of the Block
+    };
+
+    /**
+     * @brief Cumulative runtime statistics of CdnsExporter
+     *
+     * The statistics are kept for the whole life of the exporter (they aren't reset on output rotation)
+     * unless reset explicitly with CdnsExporter::reset_stats().
+     */
+    struct ExporterStats {
+        ExporterStats() : blocks_written(0), qr_count(0), aec_count(0), mm_count(0), dropped_qrs(0),
+                          dropped_aecs(0), dropped_mms(0), uncompressed_bytes(0), compressed_bytes(0),
+                          write_ns(0), output_ns(0), rotations(0), rotation_ns(0), max_rotation_ns(0) {}
+
+        /**
+         * @brief Get ratio of uncompressed and compressed bytes written
+         * @return Compression ratio, 0 if nothing was written to the output yet
+         */
+        double compression_ratio() const {
+            return compressed_bytes ? static_cast<double>(uncompressed_bytes) / compressed_bytes : 0.0;
+        }
+
+        /**
+         * @brief Get time spent encoding Blocks to CBOR (without compression and output)
+         * @return Encoding time in nanoseconds
+         */
+        uint64_t encode_ns() const {
+            return write_ns > output_ns ? write_ns - output_ns : 0;
+        }
+
+        /**
+         * @brief Creates string representation of the statistics
+         * @return Human readable multi-line string representation
+         */
+        std::string string() const;
+
+        uint64_t blocks_written; //!< Number of Blocks written to all outputs
+        uint64_t qr_count; //!< Number of Query/Response items written
+        uint64_t aec_count; //!< Number of Address event count items written
+        uint64_t mm_count; //!< Number of Malformed message items written
+        uint64_t dropped_qrs; //!< Query/Responses not stored because storage hints excluded all their fields
+        uint64_t dropped_aecs; //!< Address events not stored because storage hints exclude them
+        uint64_t dropped_mms; //!< Malformed messages not stored because storage hints excluded all their fields
+        uint64_t uncompressed_bytes; //!< Bytes of encoded C-DNS data (before compression)
+        uint64_t compressed_bytes; //!< Bytes written to the outputs (after compression)
+        uint64_t write_ns; //!< Total time spent writing Blocks (encoding, compression and output)
+        uint64_t output_ns; //!< Time spent compressing and writing encoded data to the output
+        uint64_t rotations; //!< Number of output rotations
+        uint64_t rotation_ns; //!< Total time spent rotating outputs (including export of the current Block)
+        uint64_t max_rotation_ns; //!< Longest output rotation
+        BlockTablesStats tables; //!< Block tables statistics accumulated over all written Blocks
+        BlockWriteStats last_block; //!< Statistics of the last written Block
+    };
+
+    /**
+     * @brief Input statistics of CdnsDecoder
+     *
+     * Counters are always maintained, input time is measured only if timing is enabled
+     * with CdnsDecoder::set_timing().
+     */
+    struct DecoderStats {
+        DecoderStats() : bytes_read(0), buffer_refills(0), input_ns(0), strings(0), string_bytes(0),
+                         string_allocations(0) {}
+
+        uint64_t bytes_read; //!< Bytes read from the input stream
+        uint64_t buffer_refills; //!< Number of reads from the input stream to decoder's buffer
+        uint64_t input_ns; //!< Time spent reading from the input stream (including its decompression)
+        uint64_t strings; //!< Number of decoded byte and text strings
+        uint64_t string_bytes; //!< Total length of decoded strings
+        uint64_t string_allocations; //!< Number of decoded strings that needed to (re)allocate memory
+    };
+
+    /**
+     * @brief Time spent in individual phases of decoding C-DNS Blocks and converting their items
+     * to generic structures
+     */
+    struct BlockReadStats {
+        BlockReadStats() : tables_ns(0), items_ns(0), fixup_ns(0), materialize_ns(0) {}
+
+        /**
+         * @brief Accumulate timing of another Block
+         */
+        BlockReadStats& operator+=(const BlockReadStats& rhs) {
+            tables_ns += rhs.tables_ns;
+            items_ns += rhs.items_ns;
+            fixup_ns += rhs.fixup_ns;
+            materialize_ns += rhs.materialize_ns;
+            return *this;
+        }
+
+        // Decoding phases include input read while decoding them
+        uint64_t tables_ns; //!< Time spent decoding Block tables
+        uint64_t items_ns; //!< Time spent decoding Query/Response, Address event and Malformed message items
+        uint64_t fixup_ns; //!< Time spent converting items' time offsets to absolute timestamps
+        uint64_t materialize_ns; //!< Time spent in read_generic_*() methods of the Block
+    };
+
+    /**
+     * @brief Cumulative runtime statistics of CdnsReader
+     *
+     * Counters are always maintained. Timers are collected only if they are enabled with
+     * CdnsReader::set_timing(), because reading the clock is expensive compared to decoding
+     * small items. Time spent converting Block's items to generic structures is collected
+     * from the Block passed to CdnsReader::read_block_into() when it's passed again to read
+     * the next Block (or to find out there are no more Blocks). Blocks returned by value from
+     * CdnsReader::read_block() are never passed back, so their conversion time isn't included.
+     */
+    struct ReaderStats {
+        ReaderStats() : blocks_read(0), blocks_skipped(0), qr_count(0), aec_count(0), mm_count(0),
+                        bytes_consumed(0), block_bytes(0), last_block_bytes(0), max_block_bytes(0), read_ns(0) {}
+
+        /**
+         * @brief Get average size of read Blocks
+         * @return Average number of uncompressed bytes per Block, 0 if no Block was read
+         */
+        double bytes_per_block() const {
+            uint64_t blocks = blocks_read + blocks_skipped;
+            return blocks ? static_cast<double>(block_bytes) / blocks : 0.0;
+        }
+
+        /**
+         * @brief Get time spent decoding Blocks without reading (and decompressing) the input
+         * @return Time in nanoseconds
+         */
+        uint64_t decode_ns() const {
+            return read_ns > decoder.input_ns ? read_ns - decoder.input_ns : 0;
+        }
+
+        /**
+         * @brief Creates string representation of the statistics
+         * @return Human readable multi-line string representation
+         */
+        std::string string() const;
+
+        uint64_t blocks_read; //!< Number of Blocks read
+        uint64_t blocks_skipped; //!< Number of Blocks skipped by BlockSummaryFilter (not included in blocks_read)
+        uint64_t qr_count; //!< Number of Query/Response items read
+        uint64_t aec_count; //!< Number of Address event count items read
+        uint64_t mm_count; //!< Number of Malformed message items read
+        uint64_t bytes_consumed; //!< Uncompressed bytes of C-DNS data decoded (including file header)
+        uint64_t block_bytes; //!< Uncompressed bytes of all read Blocks
+        uint64_t last_block_bytes; //!< Uncompressed size of the last read Block
+        uint64_t max_block_bytes; //!< Uncompressed size of the largest read Block
+        uint64_t read_ns; //!< Total time spent in CdnsReader::read_block_into() (including input)
+        BlockReadStats phases_ns; //!< Time spent in individual decoding phases
+        DecoderStats decoder; //!< Input statistics of the decoder
+    };
+}
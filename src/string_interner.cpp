@@ -0,0 +1,143 @@
+/**
+ * Copyright © 2026 CZ.NIC, z. s. p. o.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, you can obtain one at https://mozilla.org/MPL/2.0/.
+ */
+
+#include <stdexcept>
+
+#include "string_interner.h"
+
+constexpr std::size_t CDNS::StringInterner::DEFAULT_CAPACITY;
+constexpr uint32_t CDNS::StringInterner::EMPTY;
+constexpr std::size_t CDNS::StringInterner::INITIAL_SLOTS;
+
+CDNS::StringInterner::StringInterner(std::size_t capacity)
+    : m_capacity(capacity), m_entries(), m_slots(), m_mask(0), m_hand(0), m_epoch(1), m_pinned(0),
+      m_lookups(0), m_hits(0), m_evictions(0)
+{
+    if (capacity == 0 || capacity >= EMPTY)
+        throw std::invalid_argument("String interner capacity has to be between 1 and 2^32 - 2");
+
+    m_slots.resize(INITIAL_SLOTS);
+    m_mask = INITIAL_SLOTS - 1;
+}
+
+CDNS::StringInterner::Entry* CDNS::StringInterner::intern(const std::string& data, std::size_t hash)
+{
+    m_lookups++;
+    uint32_t short_hash = static_cast<uint32_t>(hash);
+    std::size_t pos = short_hash & m_mask;
+
+    for ( ; m_slots[pos].entry != EMPTY; pos = (pos + 1) & m_mask) {
+        const Slot& slot = m_slots[pos];
+        if (slot.hash == short_hash && m_entries[slot.entry].item.data == data) {
+            m_hits++;
+            Entry& entry = m_entries[slot.entry];
+            entry.referenced = true;
+            return &entry;
+        }
+    }
+
+    uint32_t index;
+    if (m_entries.size() < m_capacity) {
+        index = static_cast<uint32_t>(m_entries.size());
+        m_entries.emplace_back();
+
+        // Keep load factor of the slots at most 0.5 so probe sequences stay short
+        if (2 * m_entries.size() > m_slots.size()) {
+            grow();
+            pos = short_hash & m_mask;
+            while (m_slots[pos].entry != EMPTY)
+                pos = (pos + 1) & m_mask;
+        }
+    }
+    else {
+        std::size_t victim = evict();
+        if (victim == m_entries.size())
+            return nullptr;
+
+        index = static_cast<uint32_t>(victim);
+        remove_slot(index);
+        m_evictions++;
+
+        // Removal could shift the slots, find the end of the probe sequence again
+        pos = short_hash & m_mask;
+        while (m_slots[pos].entry != EMPTY)
+            pos = (pos + 1) & m_mask;
+    }
+
+    m_slots[pos].hash = short_hash;
+    m_slots[pos].entry = index;
+
+    Entry& entry = m_entries[index];
+    entry.item.data = data;
+    entry.hash = hash;
+    entry.epoch = 0;
+    entry.index = 0;
+    entry.referenced = true;
+    return &entry;
+}
+
+void CDNS::StringInterner::grow()
+{
+    std::vector<Slot> slots(2 * m_slots.size());
+    m_mask = slots.size() - 1;
+
+    for (const Slot& slot : m_slots) {
+        if (slot.entry == EMPTY)
+            continue;
+
+        std::size_t pos = slot.hash & m_mask;
+        while (slots[pos].entry != EMPTY)
+            pos = (pos + 1) & m_mask;
+        slots[pos] = slot;
+    }
+
+    m_slots.swap(slots);
+}
+
+void CDNS::StringInterner::remove_slot(uint32_t index)
+{
+    std::size_t pos = static_cast<uint32_t>(m_entries[index].hash) & m_mask;
+    while (m_slots[pos].entry != index)
+        pos = (pos + 1) & m_mask;
+
+    // Backward shift deletion: move following slots of the cluster into the hole if the hole
+    // lies between their home position and their current position
+    std::size_t hole = pos;
+    for (std::size_t next = (pos + 1) & m_mask; m_slots[next].entry != EMPTY; next = (next + 1) & m_mask) {
+        std::size_t home = m_slots[next].hash & m_mask;
+        if (((next - home) & m_mask) >= ((next - hole) & m_mask)) {
+            m_slots[hole] = m_slots[next];
+            hole = next;
+        }
+    }
+
+    m_slots[hole] = Slot();
+}
+
+std::size_t CDNS::StringInterner::evict()
+{
+    if (m_pinned >= m_entries.size())
+        return m_entries.size();
+
+    // Second pass over all entries finds an entry whose reference bit was cleared by the first one
+    for (std::size_t i = 0; i < 2 * m_entries.size(); i++) {
+        std::size_t pos = m_hand;
+        m_hand = (m_hand + 1) % m_entries.size();
+
+        Entry& entry = m_entries[pos];
+        if (entry.epoch == m_epoch)
+            continue;
+
+        if (entry.referenced)
+            entry.referenced = false;
+        else
+            return pos;
+    }
+
+    return m_entries.size();
+}
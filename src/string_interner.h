@@ -0,0 +1,175 @@
+/**
+ * Copyright © 2026 CZ.NIC, z. s. p. o.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, you can obtain one at https://mozilla.org/MPL/2.0/.
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <cstddef>
+#include <string>
+#include <vector>
+
+#include "format_specification.h"
+#include "block.h"
+
+namespace CDNS {
+
+    /**
+     * @brief Bounded cache of byte strings (IP addresses or NAMEs/RDATAs) shared by consecutive
+     * Blocks of one CdnsExporter
+     *
+     * Each interned string is stored once with its hash. Besides that every entry remembers
+     * the index of the string in the Block table of the Block that's currently being filled,
+     * so adding a string that was already added to the current Block only takes one lookup
+     * in the interner and an integer comparison, and Block tables of filled Blocks don't need
+     * to build their own index maps for the string.
+     *
+     * When the interner is full, entries are evicted using the CLOCK algorithm (approximation
+     * of LRU). Entries used by the current Block are never evicted, so indexes stored in them
+     * stay valid until the next Block is started. If all entries are used by the current Block,
+     * intern() fails and the string has to be added to the Block table directly.
+     *
+     * The interner isn't thread-safe, it should be used only by the thread filling the Blocks.
+     */
+    class StringInterner {
+        public:
+        static constexpr std::size_t DEFAULT_CAPACITY = 65536;
+        static constexpr uint32_t EMPTY = UINT32_MAX;
+        static constexpr std::size_t INITIAL_SLOTS = 1024;
+
+        /**
+         * @brief Interned string with its index in the Block table of the current Block
+         */
+        struct Entry {
+            Entry() : item(), hash(0), epoch(0), index(0), referenced(false) {}
+
+            StringItem item; //!< Interned string
+            std::size_t hash; //!< Hash of the string calculated by CdnsBlock::string_hash()
+            uint64_t epoch; //!< Block the index belongs to (valid if it's the current Block, 0 if none)
+            index_t index; //!< Index of the string in the Block table of the Block
+            bool referenced; //!< Used since the last pass of the CLOCK hand
+        };
+
+        /**
+         * @brief Construct a new StringInterner object
+         * @param capacity Maximum number of interned strings
+         * @throw std::invalid_argument if capacity is 0 or doesn't fit 32 bits
+         */
+        explicit StringInterner(std::size_t capacity = DEFAULT_CAPACITY);
+
+        /** Delete copy constructor and assignment operator */
+        StringInterner(const StringInterner& copy) = delete;
+        StringInterner& operator=(const StringInterner& rhs) = delete;
+
+        /**
+         * @brief Start filling a new Block. Indexes stored in entries by the previous Block are invalidated
+         * and its entries can be evicted again.
+         * @return Identifier of the new Block to compare with Entry::epoch
+         */
+        uint64_t start_block() {
+            m_pinned = 0;
+            return ++m_epoch;
+        }
+
+        /**
+         * @brief Store index of the entry's string in the Block table of the current Block. The entry
+         * isn't evicted until the next Block is started.
+         * @param entry Entry returned by intern()
+         * @param epoch Identifier of the current Block returned by start_block()
+         * @param index Index of the string in the Block table
+         */
+        void set_index(Entry& entry, uint64_t epoch, index_t index) {
+            if (entry.epoch != m_epoch && epoch == m_epoch)
+                m_pinned++;
+            entry.epoch = epoch;
+            entry.index = index;
+        }
+
+        /**
+         * @brief Find the string in the interner or intern it, evicting another string if the interner is full
+         * @param data String to intern
+         * @param hash Hash of the string calculated by CdnsBlock::string_hash()
+         * @return Entry of the string valid until the next call, `nullptr` if the interner is full
+         * of strings used by the current Block
+         */
+        Entry* intern(const std::string& data, std::size_t hash);
+
+        /**
+         * @brief Get the number of interned strings
+         */
+        std::size_t size() const {
+            return m_entries.size();
+        }
+
+        /**
+         * @brief Get the maximum number of interned strings
+         */
+        std::size_t capacity() const {
+            return m_capacity;
+        }
+
+        /**
+         * @brief Get the number of intern() calls
+         */
+        uint64_t lookups() const {
+            return m_lookups;
+        }
+
+        /**
+         * @brief Get the number of intern() calls that found the string already interned
+         */
+        uint64_t hits() const {
+            return m_hits;
+        }
+
+        /**
+         * @brief Get the number of strings evicted from the interner
+         */
+        uint64_t evictions() const {
+            return m_evictions;
+        }
+
+        private:
+        /**
+         * @brief Slot of the open-addressing hash table mapping strings to entries
+         */
+        struct Slot {
+            Slot() : hash(0), entry(EMPTY) {}
+
+            uint32_t hash; //!< Lower 32 bits of the string's hash
+            uint32_t entry; //!< Position of the entry or EMPTY
+        };
+
+        /**
+         * @brief Find entry to reuse for a new string using the CLOCK algorithm
+         * @return Position of the entry, or size of the interner if all entries are used by the current Block
+         */
+        std::size_t evict();
+
+        /**
+         * @brief Double the number of slots of the hash table
+         */
+        void grow();
+
+        /**
+         * @brief Remove entry from the hash table (linear probing with backward shift deletion)
+         * @param index Position of the entry
+         */
+        void remove_slot(uint32_t index);
+
+        std::size_t m_capacity;
+        std::vector<Entry> m_entries;
+        std::vector<Slot> m_slots; //!< Hash table with at least twice as many slots as entries
+        std::size_t m_mask; //!< Number of slots - 1 (number of slots is a power of 2)
+        std::size_t m_hand; //!< Position of the CLOCK hand
+        uint64_t m_epoch; //!< Identifier of the current Block
+        std::size_t m_pinned; //!< Number of entries used by the current Block
+        uint64_t m_lookups;
+        uint64_t m_hits;
+        uint64_t m_evictions;
+    };
+}
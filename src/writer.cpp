@@ -57,8 +57,10 @@ int CDNS::GzipCborOutputWriter::write_gzip(std::size_t in_size, int action)
 
     // Compress data to output
     int ret = deflate(&m_gzip, action);
-    if (ret == Z_OK || ret == Z_STREAM_END)
+    if (ret == Z_OK || ret == Z_STREAM_END) {
         m_writer->write(reinterpret_cast<const char*>(buff), sizeof(buff) - m_gzip.avail_out);
+        m_bytes_written += sizeof(buff) - m_gzip.avail_out;
+    }
     else
         throw CborOutputException("Couldn't write to output file!");
 
@@ -110,8 +112,10 @@ lzma_ret CDNS::XzCborOutputWriter::write_lzma(std::size_t in_size, lzma_action a
 
     // Compress data to output
     lzma_ret ret = lzma_code(&m_lzma, action);
-    if (ret == LZMA_OK || ret == LZMA_STREAM_END)
+    if (ret == LZMA_OK || ret == LZMA_STREAM_END) {
         m_writer->write(reinterpret_cast<const char*>(buff), sizeof(buff) - m_lzma.avail_out);
+        m_bytes_written += sizeof(buff) - m_lzma.avail_out;
+    }
     else
         throw CborOutputException("Couldn't write to output file!");
 
@@ -16,6 +16,7 @@
 #include <cstdint>
 #include <boost/any.hpp>
 #include <memory>
+#include <functional>
 #include <type_traits>
 #include <sys/types.h>
 #include <sys/stat.h>
@@ -70,6 +71,13 @@ namespace CDNS {
          */
         virtual void rotate_output(const boost::any& value) = 0;
 
+        /**
+         * @brief Get the number of bytes written to the underlying output (after compression)
+         * since the writer was created. Counted by the compression layer writers.
+         * @return Number of bytes written to the underlying output
+         */
+        uint64_t get_bytes_written() const { return m_bytes_written; }
+
         protected:
         /**
          * @brief Open the output with given identifier or check if its valid
@@ -80,6 +88,8 @@ namespace CDNS {
          * @brief Close the opened output
          */
         virtual void close() {};
+
+        uint64_t m_bytes_written = 0;
     };
 
     /**
@@ -269,6 +279,192 @@ namespace CDNS {
         int m_value;
     };
 
+    /**
+     * @brief Growable in-memory output buffer
+     *
+     * Copies of MemoryOutput share the same underlying buffer, so the copy given to CdnsEncoder or
+     * CdnsExporter constructor (or to rotate_output()) fills the buffer observed by the caller.
+     * Compressed outputs are complete only after the output is closed (rotated or destroyed).
+     */
+    class MemoryOutput {
+        public:
+        /**
+         * @brief Construct a new empty MemoryOutput object
+         * @param reserve Number of bytes to preallocate in the buffer
+         */
+        explicit MemoryOutput(std::size_t reserve = 0) : m_buffer(std::make_shared<std::string>()) {
+            m_buffer->reserve(reserve);
+        }
+
+        /**
+         * @brief Append data to the buffer
+         * @param p Start of the data
+         * @param size Size of the data in bytes
+         */
+        void append(const char* p, std::size_t size) { m_buffer->append(p, size); }
+
+        /**
+         * @brief Get current content of the buffer
+         * @return Reference to the buffer
+         */
+        const std::string& data() const { return *m_buffer; }
+
+        /**
+         * @brief Get current size of the buffer
+         * @return Size of the buffer in bytes
+         */
+        std::size_t size() const { return m_buffer->size(); }
+
+        /**
+         * @brief Take ownership of the buffer's content without copying, leaving the buffer empty
+         * @return Content of the buffer
+         */
+        std::string release() {
+            std::string ret;
+            ret.swap(*m_buffer);
+            return ret;
+        }
+
+        private:
+        std::shared_ptr<std::string> m_buffer;
+    };
+
+    /**
+     * @brief Output handing all written data to user defined callbacks
+     */
+    struct CallbackOutput {
+        using WriteCallback = std::function<void(const char*, std::size_t)>;
+        using CloseCallback = std::function<void()>;
+
+        /**
+         * @brief Construct a new CallbackOutput object
+         * @param write Called with every chunk of data written to the output
+         * @param close Called when the output is closed (rotated or destroyed), can be empty
+         */
+        CallbackOutput(WriteCallback write, CloseCallback close = nullptr)
+            : on_write(std::move(write)), on_close(std::move(close)) {}
+
+        WriteCallback on_write;
+        CloseCallback on_close;
+    };
+
+    /**
+     * @brief Writes data to growable memory buffer
+     * @tparam MemoryOutput Memory buffer shared with the caller
+     */
+    template<>
+    class Writer<MemoryOutput> : public BaseCborOutputWriter {
+        public:
+        /**
+         * @brief Construct a new Writer<MemoryOutput> object for writing data to memory buffer
+         * @param buffer Memory buffer for the output
+         * @param extension Extension for the output file's name (NOT USED)
+         */
+        Writer(const MemoryOutput& buffer, const std::string extension = "")
+            : BaseCborOutputWriter(), m_value(buffer) {}
+
+        /** Delete copy and move constructors */
+        Writer(Writer& copy) = delete;
+        Writer(Writer&& copy) = delete;
+
+        /**
+         * @brief Append data to the memory buffer
+         * @param p Start of the buffer with data
+         * @param size Size of the data in bytes
+         */
+        void write(const char* p, std::size_t size) override {
+            m_value.append(p, size);
+        }
+
+        /**
+         * @brief Rotate the output memory buffer (previous buffer is left to the caller)
+         * @param value New memory buffer
+         */
+        void rotate_output(const boost::any& value) override {
+            if (value.type() != typeid(MemoryOutput))
+                return;
+
+            m_value = boost::any_cast<MemoryOutput>(value);
+        }
+
+        protected:
+        MemoryOutput m_value;
+    };
+
+    /**
+     * @brief Writes data to user defined callback
+     * @tparam CallbackOutput Callbacks for the output
+     */
+    template<>
+    class Writer<CallbackOutput> : public BaseCborOutputWriter {
+        public:
+        /**
+         * @brief Construct a new Writer<CallbackOutput> object for writing data to user callback
+         * @param callback Callbacks for the output
+         * @param extension Extension for the output file's name (NOT USED)
+         * @throw CborOutputException if write callback is empty
+         */
+        Writer(const CallbackOutput& callback, const std::string extension = "")
+            : BaseCborOutputWriter(), m_value(callback) { open(); }
+
+        /**
+         * @brief Destroy the Writer object and notify the close callback
+         */
+        ~Writer() override { close(); }
+
+        /** Delete copy and move constructors */
+        Writer(Writer& copy) = delete;
+        Writer(Writer&& copy) = delete;
+
+        /**
+         * @brief Hand data in buffer to the write callback
+         * @param p Start of the buffer with data
+         * @param size Size of the data in bytes
+         */
+        void write(const char* p, std::size_t size) override {
+            m_value.on_write(p, size);
+        }
+
+        /**
+         * @brief Rotate the output (close callback of the current output is called)
+         * @param value Callbacks for the new output
+         * @throw CborOutputException if write callback is empty
+         */
+        void rotate_output(const boost::any& value) override {
+            if (value.type() != typeid(CallbackOutput))
+                return;
+
+            close();
+            m_value = boost::any_cast<CallbackOutput>(value);
+            open();
+        }
+
+        protected:
+        /**
+         * @brief Check if the write callback is set
+         * @throw CborOutputException if write callback is empty
+         */
+        void open() override {
+            if (!m_value.on_write)
+                throw CborOutputException("Given write callback is empty!");
+        }
+
+        /**
+         * @brief Call the close callback if it is set
+         */
+        void close() override {
+            try {
+                if (m_value.on_close)
+                    m_value.on_close();
+            }
+            catch (std::exception& e) {
+                std::cerr << e.what() << std::endl;
+            }
+        }
+
+        CallbackOutput m_value;
+    };
+
     /**
      * @brief Writes uncompressed data to output specified by name or other identifier
      */
@@ -297,6 +493,7 @@ namespace CDNS {
          */
         void write(const char* p, std::size_t size) override {
             m_writer->write(p, size);
+            m_bytes_written += size;
         }
 
         /**
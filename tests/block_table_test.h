@@ -106,4 +106,159 @@ namespace CDNS {
         index_t index3 = bt.add(aec3);
         EXPECT_EQ(index, index3);
     }
-}
\ No newline at end of file
+
+    TEST(BlockTableTest, BTCopyTest) {
+        StringItem si, si2;
+        si.data = "Test";
+        si2.data = "Test2";
+        BlockTable<StringItem>* bt = new BlockTable<StringItem>();
+        bt->add(si);
+        bt->add(si2);
+
+        BlockTable<StringItem> copy(*bt);
+        BlockTable<StringItem> assigned;
+        assigned = *bt;
+        delete bt;
+
+        // Index of the copies has to reference their own items
+        index_t found;
+        EXPECT_TRUE(copy.find(si2, found));
+        EXPECT_EQ(found, 1);
+        EXPECT_EQ(copy.add(si), 0);
+        EXPECT_EQ(copy.size(), 2);
+        EXPECT_TRUE(assigned.find(si, found));
+        EXPECT_EQ(found, 0);
+        EXPECT_EQ(assigned.size(), 2);
+    }
+
+    TEST(BlockTableTest, BTMoveTest) {
+        StringItem si, si2;
+        si.data = "Test";
+        si2.data = "Test2";
+        BlockTable<StringItem> bt;
+        bt.add(si);
+        bt.add(si2);
+        const StringItem* item = &bt[1];
+
+        BlockTable<StringItem> moved(std::move(bt));
+        EXPECT_EQ(bt.size(), 0);
+        EXPECT_EQ(moved.size(), 2);
+        // Items aren't relocated by the move
+        EXPECT_EQ(&moved[1], item);
+
+        BlockTable<StringItem> assigned;
+        assigned.add(si2);
+        assigned = std::move(moved);
+        EXPECT_EQ(moved.size(), 0);
+        EXPECT_EQ(&assigned[1], item);
+
+        index_t found;
+        EXPECT_TRUE(assigned.find(si2, found));
+        EXPECT_EQ(found, 1);
+        EXPECT_FALSE(moved.find(si2, found));
+        EXPECT_EQ(moved.add(si2), 0);
+    }
+
+    TEST(BlockTableTest, BTRecycleTest) {
+        StringItem si, si2;
+        si.data = "Test";
+        si2.data = "Test2";
+        BlockTable<StringItem> bt;
+        bt.add(si);
+        bt.add(si2);
+        const StringItem* item = &bt[0];
+
+        // Cleared items are reused by following additions
+        bt.clear();
+        EXPECT_EQ(bt.size(), 0);
+        EXPECT_EQ(bt.begin(), bt.end());
+        EXPECT_THROW(bt[0], std::runtime_error);
+        index_t found;
+        EXPECT_FALSE(bt.find(si, found));
+        EXPECT_EQ(bt.add(si2), 0);
+        EXPECT_EQ(&bt[0], item);
+        EXPECT_EQ(bt[0].data, "Test2");
+
+        StringItem& added = bt.add_item();
+        added.data = "Test3";
+        EXPECT_EQ(bt.size(), 2);
+
+        // Items added without deduplication are found afterwards
+        StringItem si3;
+        si3.data = "Test3";
+        EXPECT_TRUE(bt.find(si3, found));
+        EXPECT_EQ(found, 1);
+        EXPECT_EQ(bt.add(si3), 1);
+        EXPECT_EQ(bt.add(si), 2);
+        EXPECT_EQ(bt.size(), 3);
+    }
+
+    TEST(BlockTableTest, BTStatsTest) {
+        StringItem si, si2;
+        si.data = "Test";
+        si2.data = "Test2";
+        BlockTable<StringItem> bt;
+        EXPECT_EQ(bt.lookups(), 0);
+        EXPECT_EQ(bt.hits(), 0);
+
+        bt.add(si);
+        bt.add(si2);
+        bt.add(si);
+        bt.add(si);
+        EXPECT_EQ(bt.size(), 2);
+        EXPECT_EQ(bt.lookups(), 4);
+        EXPECT_EQ(bt.hits(), 2);
+
+        BlockTable<StringItem> bt2(std::move(bt));
+        EXPECT_EQ(bt2.lookups(), 4);
+        EXPECT_EQ(bt2.hits(), 2);
+        EXPECT_EQ(bt.lookups(), 0);
+
+        bt2.clear();
+        EXPECT_EQ(bt2.lookups(), 0);
+        EXPECT_EQ(bt2.hits(), 0);
+    }
+
+    TEST(BlockTableTest, BTPrecomputedHashTest) {
+        StringItem si, si2;
+        si.data = "Test";
+        si2.data = "Test2";
+        std::size_t hash = CdnsBlock::string_hash(si.data);
+        std::size_t hash2 = CdnsBlock::string_hash(si2.data);
+        EXPECT_EQ(hash, CDNS::hash<StringItem>()(si));
+
+        BlockTable<StringItem> bt;
+        EXPECT_EQ(bt.add(si, hash), 0);
+        EXPECT_EQ(bt.add(si2, hash2), 1);
+        EXPECT_EQ(bt.add(si), 0);
+        EXPECT_EQ(bt.add(si2, hash2), 1);
+        EXPECT_EQ(bt.size(), 2);
+
+        index_t found;
+        EXPECT_TRUE(bt.find(si2, found, hash2));
+        EXPECT_EQ(found, 1);
+
+        // Items with equal hash and different keys aren't mixed up
+        EXPECT_FALSE(bt.find(si2, found, hash));
+        EXPECT_EQ(bt.add(si2, hash), 2);
+        EXPECT_EQ(bt.size(), 3);
+
+        // Index map stays valid when it's rehashed
+        for (int i = 0; i < 1000; i++) {
+            StringItem item;
+            item.data = "name" + std::to_string(i);
+            EXPECT_EQ(bt.add(item, CdnsBlock::string_hash(item.data)), static_cast<index_t>(i + 3));
+        }
+        EXPECT_TRUE(bt.find(si, found));
+        EXPECT_EQ(found, 0);
+
+        // Block table interface for strings
+        BlockParameters bp;
+        CdnsBlock block(bp, 0);
+        EXPECT_EQ(block.add_name_rdata(si.data, hash), 0);
+        EXPECT_EQ(block.add_name_rdata(si.data), 0);
+        EXPECT_EQ(block.add_name_rdata(si2.data), 1);
+        EXPECT_EQ(block.add_ip_address(si2.data, hash2), 0);
+        EXPECT_EQ(block.add_ip_address(si2.data), 0);
+    }
+}
@@ -139,6 +139,30 @@ namespace CDNS {
         EXPECT_FALSE(bs.malformed_items);
     }
 
+    TEST(BlockSummaryTest, BSumCTest) {
+        BlockSummary bs;
+
+        EXPECT_EQ(bs.latest_time.m_secs, 0);
+        EXPECT_EQ(bs.qr_count, 0);
+        EXPECT_EQ(bs.aec_count, 0);
+        EXPECT_EQ(bs.mm_count, 0);
+        EXPECT_FALSE(bs.min_client_address);
+        EXPECT_FALSE(bs.max_client_address);
+        EXPECT_TRUE(bs.rcode_counts.empty());
+    }
+
+    TEST(BlockSummaryTest, BSumOverlapsTest) {
+        BlockSummary bs;
+        bs.latest_time = Timestamp(20, 0);
+        Timestamp earliest(10, 0);
+
+        EXPECT_TRUE(bs.overlaps(earliest, Timestamp(0, 0), Timestamp(10, 0)));
+        EXPECT_TRUE(bs.overlaps(earliest, Timestamp(15, 0), Timestamp(16, 0)));
+        EXPECT_TRUE(bs.overlaps(earliest, Timestamp(20, 0), Timestamp(30, 0)));
+        EXPECT_FALSE(bs.overlaps(earliest, Timestamp(0, 0), Timestamp(9, 999)));
+        EXPECT_FALSE(bs.overlaps(earliest, Timestamp(20, 1), Timestamp(30, 0)));
+    }
+
     TEST(QueryResponseTest, QRCTest) {
         QueryResponse qr;
 
@@ -452,6 +476,236 @@ namespace CDNS {
         EXPECT_TRUE(ret);
     }
 
+    TEST(BlockTest, BlockEstimatedSizeTest) {
+        BlockParameters bp;
+        CdnsBlock block(bp, 0);
+        GenericQueryResponse qr;
+        qr.ts = Timestamp(13, 1234);
+        qr.client_port = 1234;
+        qr.server_ip = "8.8.8.8";
+        EXPECT_EQ(block.get_estimated_size(), 0);
+
+        for (int i = 0; i < 200; i++) {
+            std::size_t size = block.get_estimated_size();
+            qr.client_ip = "10.0.0." + std::to_string(i % 50);
+            qr.query_name = "name" + std::to_string(i % 70) + ".example.com";
+            qr.ts = Timestamp(13, 1234 + i * 1000);
+            block.add_question_response_record(qr);
+            EXPECT_GT(block.get_estimated_size(), size);
+        }
+
+        MemoryOutput buffer;
+        CdnsEncoder enc(buffer, CborOutputCompression::NO_COMPRESSION);
+        std::size_t written = block.write(enc);
+        EXPECT_GT(block.get_estimated_size(), written * 3 / 4);
+        EXPECT_LT(block.get_estimated_size(), written * 5 / 4);
+
+        block.clear();
+        EXPECT_EQ(block.get_estimated_size(), 0);
+    }
+
+    TEST(BlockTest, BlockSummaryTest) {
+        BlockParameters bp;
+        CdnsBlock block(bp, 0);
+        GenericQueryResponse qr;
+
+        for (int i = 0; i < 30; i++) {
+            qr.ts = Timestamp(13, 5000 - i * 100);
+            qr.client_ip = std::string("\x0a\x00\x00", 3) + static_cast<char>(i % 10 + 1);
+            qr.response_rcode = i % 3 == 0 ? 3 : 0;
+            block.add_question_response_record(qr);
+        }
+        GenericMalformedMessage mm;
+        mm.ts = Timestamp(14, 0);
+        block.add_malformed_message(mm);
+
+        BlockSummary summary = block.get_summary();
+        EXPECT_EQ(summary.latest_time.m_secs, 14);
+        EXPECT_EQ(summary.latest_time.m_ticks, 0);
+        EXPECT_EQ(summary.qr_count, 30);
+        EXPECT_EQ(summary.aec_count, 0);
+        EXPECT_EQ(summary.mm_count, 1);
+        EXPECT_EQ(*summary.min_client_address, std::string("\x0a\x00\x00\x01", 4));
+        EXPECT_EQ(*summary.max_client_address, std::string("\x0a\x00\x00\x0a", 4));
+        EXPECT_EQ(summary.rcode_counts.size(), 2);
+        EXPECT_EQ(summary.rcode_counts[0], 20);
+        EXPECT_EQ(summary.rcode_counts[3], 10);
+        EXPECT_TRUE(summary.has_rcode(3));
+        EXPECT_FALSE(summary.has_rcode(2));
+
+        // Summary is written only if enabled and read back from the Block
+        MemoryOutput plain;
+        CdnsEncoder plain_enc(plain, CborOutputCompression::NO_COMPRESSION);
+        std::size_t plain_written = block.write(plain_enc);
+
+        block.set_write_summary(true);
+        MemoryOutput buffer;
+        {
+            CdnsEncoder enc(buffer, CborOutputCompression::NO_COMPRESSION);
+            EXPECT_GT(block.write(enc), plain_written);
+        }
+
+        std::istringstream input(buffer.release());
+        CdnsDecoder dec(input);
+        std::vector<BlockParameters> bps{bp};
+        CdnsBlockRead rblock;
+        EXPECT_TRUE(rblock.read(dec, bps));
+        ASSERT_TRUE(rblock.m_block_summary);
+        EXPECT_EQ(rblock.m_block_summary->latest_time.m_secs, 14);
+        EXPECT_EQ(rblock.m_block_summary->qr_count, 30);
+        EXPECT_EQ(rblock.m_block_summary->mm_count, 1);
+        EXPECT_EQ(*rblock.m_block_summary->min_client_address, *summary.min_client_address);
+        EXPECT_EQ(*rblock.m_block_summary->max_client_address, *summary.max_client_address);
+        EXPECT_EQ(rblock.m_block_summary->rcode_counts, summary.rcode_counts);
+        ASSERT_TRUE(rblock.m_block_summary->body_size);
+        EXPECT_GT(*rblock.m_block_summary->body_size, plain_written / 2);
+        EXPECT_LT(*rblock.m_block_summary->body_size, plain_written);
+        EXPECT_EQ(rblock.get_qr_count(), 30);
+
+        // Read Block doesn't track its latest time, the summary finds it among the items
+        BlockSummary rsummary = rblock.get_summary();
+        EXPECT_EQ(rsummary.latest_time.m_secs, 14);
+        EXPECT_EQ(rsummary.rcode_counts, summary.rcode_counts);
+        EXPECT_FALSE(rblock.string().empty());
+
+        rblock.clear();
+        EXPECT_FALSE(rblock.m_block_summary);
+    }
+
+    TEST(BlockTest, BlockSummaryFilterTest) {
+        BlockParameters bp;
+        CdnsBlock block(bp, 0);
+        GenericQueryResponse qr;
+        qr.ts = Timestamp(13, 0);
+
+        for (int i = 0; i < 20; i++) {
+            qr.query_name = "\x04name" + std::string(1, static_cast<char>('0' + i % 10)) + "\x07Example\x03com";
+            qr.client_ip = std::string("\x0a\x00\x00", 3) + static_cast<char>(i + 1);
+            block.add_question_response_record(qr);
+        }
+
+        EXPECT_FALSE(block.get_summary().filter);
+        block.set_summary_filter(BloomFilter::DEFAULT_BITS_PER_ITEM);
+        EXPECT_EQ(block.get_summary_filter(), BloomFilter::DEFAULT_BITS_PER_ITEM);
+
+        BlockSummary summary = block.get_summary();
+        ASSERT_TRUE(summary.filter);
+        // 20 addresses and 10 names, rounded up to whole bytes
+        EXPECT_EQ(summary.filter->bit_count(), 304);
+        EXPECT_TRUE(summary.may_contain(BlockSummary::name_hash("\x04NAME3\x07example\x03COM")));
+        EXPECT_TRUE(summary.may_contain(BlockSummary::address_hash(std::string("\x0a\x00\x00\x14", 4))));
+
+        // Names and addresses are hashed differently
+        EXPECT_NE(BlockSummary::name_hash("abcd"), BlockSummary::address_hash("abcd"));
+        EXPECT_EQ(BlockSummary::name_hash("ABCD"), BlockSummary::name_hash("abcd"));
+        EXPECT_NE(BlockSummary::address_hash("ABCD"), BlockSummary::address_hash("abcd"));
+
+        // Summary without filter doesn't rule anything out
+        summary.filter = boost::none;
+        EXPECT_TRUE(summary.may_contain(BlockSummary::name_hash("missing")));
+
+        // Filter is read back with the summary
+        block.set_write_summary(true);
+        MemoryOutput buffer;
+        {
+            CdnsEncoder enc(buffer, CborOutputCompression::NO_COMPRESSION);
+            block.write(enc);
+        }
+
+        std::istringstream input(buffer.release());
+        CdnsDecoder dec(input);
+        std::vector<BlockParameters> bps{bp};
+        CdnsBlockRead rblock;
+        EXPECT_TRUE(rblock.read(dec, bps));
+        ASSERT_TRUE(rblock.m_block_summary && rblock.m_block_summary->filter);
+        EXPECT_EQ(rblock.m_block_summary->filter->bits(), block.get_summary().filter->bits());
+        EXPECT_EQ(rblock.get_qr_count(), 20);
+    }
+
+    TEST(BlockTest, BlockMaxSizeTest) {
+        BlockParameters bp;
+        CdnsBlock block(bp, 0);
+        GenericQueryResponse qr;
+        qr.ts = Timestamp(13, 1234);
+        block.set_max_block_size(300);
+        EXPECT_EQ(block.get_max_block_size(), 300);
+
+        std::size_t items = 0;
+        bool full = false;
+        while (!full) {
+            qr.query_name = "name" + std::to_string(items) + ".example.com";
+            full = block.add_question_response_record(qr);
+            items++;
+        }
+
+        EXPECT_GE(block.get_estimated_size(), 300);
+        EXPECT_GT(items, 1);
+        EXPECT_LT(items, bp.storage_parameters.max_block_items);
+
+        // Byte budget is kept after the Block is cleared
+        block.clear();
+        EXPECT_FALSE(block.full());
+        EXPECT_EQ(block.get_max_block_size(), 300);
+    }
+
+    TEST(BlockTest, BlockMaxAgeTest) {
+        BlockParameters bp;
+        CdnsBlock block(bp, 0);
+        GenericQueryResponse qr;
+        block.set_max_block_age(2 * bp.storage_parameters.ticks_per_second);
+        EXPECT_FALSE(block.expired(Timestamp(100, 0)));
+
+        qr.ts = Timestamp(10, 500);
+        EXPECT_FALSE(block.add_question_response_record(qr));
+        qr.ts = Timestamp(11, 700);
+        EXPECT_FALSE(block.add_question_response_record(qr));
+        EXPECT_FALSE(block.expired(Timestamp(12, 499)));
+        EXPECT_TRUE(block.expired(Timestamp(12, 500)));
+
+        qr.ts = Timestamp(12, 500);
+        EXPECT_TRUE(block.add_question_response_record(qr));
+
+        block.clear();
+        EXPECT_FALSE(block.full());
+        EXPECT_FALSE(block.expired(Timestamp(100, 0)));
+    }
+
+    TEST(BlockTest, BlockMoveTest) {
+        BlockParameters bp;
+        bp.storage_parameters.max_block_items = 100;
+        CdnsBlock block(bp, 0);
+        GenericQueryResponse qr;
+        qr.ts = Timestamp(13, 1234);
+        qr.client_ip = "8.8.8.8";
+        qr.query_name = "Test";
+        block.add_question_response_record(qr);
+        block.add_question_response_record(qr);
+        const QueryResponse* item = &block.m_query_responses[0];
+
+        CdnsBlock moved(std::move(block));
+        EXPECT_EQ(block.get_item_count(), 0);
+        EXPECT_EQ(moved.get_qr_count(), 2);
+        EXPECT_EQ(&moved.m_query_responses[0], item);
+        EXPECT_EQ(moved.get_ip_address(0), "8.8.8.8");
+
+        CdnsBlock assigned;
+        assigned = std::move(moved);
+        EXPECT_EQ(moved.get_item_count(), 0);
+        EXPECT_EQ(assigned.get_qr_count(), 2);
+        EXPECT_EQ(&assigned.m_query_responses[0], item);
+
+        // Block tables keep deduplicating after the move
+        EXPECT_EQ(assigned.add_ip_address("8.8.8.8"), 0);
+        EXPECT_EQ(assigned.m_ip_address.size(), 1);
+        EXPECT_FALSE(assigned.add_question_response_record(qr));
+        EXPECT_EQ(assigned.get_qr_count(), 3);
+
+        CdnsBlock copy(assigned);
+        EXPECT_EQ(copy.get_qr_count(), 3);
+        EXPECT_EQ(copy.add_ip_address("8.8.8.8"), 0);
+        EXPECT_EQ(assigned.get_qr_count(), 3);
+    }
+
     TEST(BlockReadTest, BlockReadGenericQRTest) {
         CdnsBlockRead block;
         QueryResponse qr;
@@ -495,6 +749,111 @@ namespace CDNS {
         EXPECT_FALSE(gqr.round_trip_time);
     }
 
+    TEST(BlockReadTest, BlockReadMoveTest) {
+        CdnsBlockRead block;
+        QueryResponse qr;
+        qr.client_port = 1234;
+        qr.time_offset = Timestamp(5, 170);
+        block.add_question_response_record(qr);
+        qr.client_port = 4321;
+        block.add_question_response_record(qr);
+
+        bool end = false;
+        GenericQueryResponse gqr = block.read_generic_qr(end);
+        EXPECT_EQ(*gqr.client_port, 1234);
+
+        // Moved block continues reading where the source stopped
+        CdnsBlockRead moved(std::move(block));
+        EXPECT_EQ(block.get_item_count(), 0);
+        gqr = moved.read_generic_qr(end);
+        EXPECT_FALSE(end);
+        EXPECT_EQ(*gqr.client_port, 4321);
+        gqr = moved.read_generic_qr(end);
+        EXPECT_TRUE(end);
+
+        // Copied block starts reading from the beginning
+        CdnsBlockRead copy(moved);
+        gqr = copy.read_generic_qr(end);
+        EXPECT_FALSE(end);
+        EXPECT_EQ(*gqr.client_port, 1234);
+    }
+
+    TEST(BlockReadTest, BlockReadQRViewTest) {
+        CdnsBlockRead block;
+        ClassType ct;
+        ct.type = 28;
+        ct.class_ = 1;
+        Question q;
+        q.name_index = block.add_name_rdata("example.com");
+        q.classtype_index = block.add_classtype(ct);
+        QueryResponseSignature qrs;
+        qrs.server_address_index = block.add_ip_address("1.1.1.1");
+        qrs.query_classtype_index = q.classtype_index;
+        qrs.response_rcode = 3;
+
+        QueryResponse qr;
+        qr.time_offset = Timestamp(5, 170);
+        qr.client_address_index = block.add_ip_address("8.8.8.8");
+        qr.client_port = 1234;
+        qr.qr_signature_index = block.add_qr_signature(qrs);
+        qr.query_name_index = q.name_index;
+        qr.query_extended = QueryResponseExtended();
+        qr.query_extended->question_index = block.add_question_list({block.add_question(q)});
+        block.add_question_response_record(qr);
+
+        qr = QueryResponse();
+        qr.client_port = 4321;
+        qr.query_name_index = 10;
+        block.add_question_response_record(qr);
+
+        QueryResponseView view = block.qr_view(0);
+        EXPECT_EQ(view.ts()->m_ticks, 170);
+        EXPECT_EQ(*view.client_ip(), "8.8.8.8");
+        EXPECT_EQ(*view.client_port(), 1234);
+        EXPECT_EQ(*view.server_ip(), "1.1.1.1");
+        EXPECT_EQ(*view.query_name(), "example.com");
+        EXPECT_EQ(view.query_classtype()->type, 28);
+        EXPECT_EQ(*view.response_rcode(), 3);
+        EXPECT_FALSE(view.query_rcode());
+        EXPECT_FALSE(view.bailiwick());
+        ASSERT_EQ(view.query_questions().size(), 1);
+        EXPECT_EQ(view.query_questions()[0].name, "example.com");
+        EXPECT_TRUE(view.query_answers().empty());
+        EXPECT_TRUE(view.response_questions().empty());
+
+        // Strings are references into the Block's tables
+        EXPECT_EQ(&*view.query_name(), &block.m_name_rdata[0].data);
+
+        // Fields with invalid index throw only when accessed
+        QueryResponseView invalid = block.qr_view(1);
+        EXPECT_EQ(*invalid.client_port(), 4321);
+        EXPECT_FALSE(invalid.signature());
+        EXPECT_FALSE(invalid.server_port());
+        EXPECT_THROW(invalid.query_name(), std::runtime_error);
+        EXPECT_THROW(block.qr_view(2), std::out_of_range);
+
+        std::size_t ports = 0;
+        EXPECT_EQ(block.for_each_qr([&ports](const QueryResponseView& qrv) {
+            ports += *qrv.client_port();
+        }), 2);
+        EXPECT_EQ(ports, 1234 + 4321);
+
+        EXPECT_EQ(block.for_each_qr([](const QueryResponseView& qrv) {
+            return !qrv.client_ip();
+        }), 1);
+
+        // Generic Query/Response is the fully resolved view
+        bool end = false;
+        GenericQueryResponse gqr = block.read_generic_qr(end);
+        EXPECT_FALSE(end);
+        EXPECT_EQ(*gqr.client_ip, "8.8.8.8");
+        EXPECT_EQ(*gqr.server_ip, "1.1.1.1");
+        EXPECT_EQ(gqr.query_classtype->type, 28);
+        ASSERT_TRUE(gqr.query_questions);
+        EXPECT_EQ(gqr.query_questions->size(), 1);
+        EXPECT_FALSE(gqr.query_answers);
+    }
+
     TEST(BlockReadTest, BlockReadGenericAECTest) {
         CdnsBlock block;
         AddressEventCount aec;
@@ -576,4 +935,31 @@ namespace CDNS {
         EXPECT_FALSE(gmm.ts);
         EXPECT_FALSE(gmm.client_ip);
     }
-}
\ No newline at end of file
+
+    TEST(BlockPoolTest, BlockPoolAcquireReleaseTest) {
+        BlockPool<CdnsBlock> pool(1);
+        EXPECT_EQ(pool.size(), 0);
+        EXPECT_EQ(pool.max_spare(), 1);
+
+        CdnsBlock block = pool.acquire();
+        EXPECT_EQ(block.get_item_count(), 0);
+        GenericQueryResponse qr;
+        qr.ts = Timestamp(13, 1234);
+        qr.client_ip = "8.8.8.8";
+        block.add_question_response_record(qr);
+        const StringItem* ip = &block.m_ip_address[0];
+
+        // Released Block is cleared, but keeps its items for reuse
+        pool.release(std::move(block));
+        EXPECT_EQ(pool.size(), 1);
+        pool.release(CdnsBlock());
+        EXPECT_EQ(pool.size(), 1);
+
+        CdnsBlock block2 = pool.acquire();
+        EXPECT_EQ(pool.size(), 0);
+        EXPECT_EQ(block2.get_item_count(), 0);
+        block2.add_question_response_record(qr);
+        EXPECT_EQ(&block2.m_ip_address[0], ip);
+        EXPECT_EQ(block2.get_ip_address(0), "8.8.8.8");
+    }
+}
@@ -0,0 +1,104 @@
+/**
+ * Copyright © 2026 CZ.NIC, z. s. p. o.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, you can obtain one at https://mozilla.org/MPL/2.0/.
+ */
+
+#pragma once
+
+#include <string>
+#include <sstream>
+#include <stdexcept>
+#include <gtest/gtest.h>
+
+#include "../src/bloom_filter.h"
+#include "../src/writer.h"
+
+namespace CDNS {
+    TEST(BloomFilterTest, BFCTest) {
+        EXPECT_THROW(BloomFilter(10, 0), std::invalid_argument);
+
+        // Empty filter doesn't contain anything
+        BloomFilter bf;
+        EXPECT_EQ(bf.bit_count(), 0);
+        EXPECT_FALSE(bf.may_contain(stable_hash("a", 1)));
+
+        BloomFilter bf2(1000, 10);
+        EXPECT_EQ(bf2.bit_count(), 10000);
+        EXPECT_EQ(bf2.hash_count(), 7);
+
+        // Small filters have at least 64 bits
+        BloomFilter bf3(1, 1);
+        EXPECT_EQ(bf3.bit_count(), 64);
+        EXPECT_EQ(bf3.hash_count(), 1);
+
+        BloomFilter bf4(1, 100);
+        EXPECT_EQ(bf4.hash_count(), BloomFilter::MAX_HASH_COUNT);
+    }
+
+    TEST(BloomFilterTest, BFBitsPerItemTest) {
+        EXPECT_EQ(BloomFilter().bits_per_item(10), 0);
+
+        for (unsigned bits : {1U, 4U, 8U, 10U, 13U}) {
+            for (std::size_t items : {0, 1, 3, 7, 100, 1001}) {
+                BloomFilter bf(items, bits);
+                BloomFilter bf2(items, bf.bits_per_item(items));
+                EXPECT_EQ(bf2.bit_count(), bf.bit_count());
+                EXPECT_EQ(bf2.hash_count(), bf.hash_count());
+            }
+
+            // Size of larger filters gives the exact value
+            EXPECT_EQ(BloomFilter(1001, bits).bits_per_item(1001), bits);
+        }
+    }
+
+    TEST(BloomFilterTest, BFAddTest) {
+        BloomFilter bf(1000, BloomFilter::DEFAULT_BITS_PER_ITEM);
+        for (int i = 0; i < 1000; i++) {
+            std::string data = "name" + std::to_string(i);
+            bf.add(stable_hash(data.data(), data.size()));
+        }
+
+        // No false negatives
+        for (int i = 0; i < 1000; i++) {
+            std::string data = "name" + std::to_string(i);
+            EXPECT_TRUE(bf.may_contain(stable_hash(data.data(), data.size())));
+        }
+
+        // About 1 % false positives
+        int positives = 0;
+        for (int i = 0; i < 10000; i++) {
+            std::string data = "other" + std::to_string(i);
+            positives += bf.may_contain(stable_hash(data.data(), data.size()));
+        }
+        EXPECT_LT(positives, 300);
+    }
+
+    TEST(BloomFilterTest, BFReadWriteTest) {
+        BloomFilter bf(100, 8);
+        for (int i = 0; i < 100; i++) {
+            std::string data = "name" + std::to_string(i);
+            bf.add(stable_hash(data.data(), data.size()));
+        }
+
+        MemoryOutput buffer;
+        {
+            CdnsEncoder enc(buffer, CborOutputCompression::NO_COMPRESSION);
+            bf.write(enc);
+        }
+
+        std::istringstream input(buffer.release());
+        CdnsDecoder dec(input);
+        BloomFilter bf2;
+        bf2.read(dec);
+
+        EXPECT_EQ(bf2.hash_count(), bf.hash_count());
+        EXPECT_EQ(bf2.bits(), bf.bits());
+        for (int i = 0; i < 100; i++) {
+            std::string data = "name" + std::to_string(i);
+            EXPECT_TRUE(bf2.may_contain(stable_hash(data.data(), data.size())));
+        }
+    }
+}
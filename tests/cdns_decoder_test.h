@@ -144,6 +144,20 @@ namespace CDNS {
         EXPECT_EQ(res, "test");
     }
 
+    TEST(CdnsDecoderTest, CDStringIntoTest) {
+        // "test", indefinite length "test" in two chunks, "test"
+        std::istringstream is(dbytestring + "\x5F\x42te\x42st\xFF" + dtextstring);
+        CdnsDecoder dec(is);
+
+        std::string res = "previous content";
+        dec.read_bytestring(res);
+        EXPECT_EQ(res, "test");
+        dec.read_bytestring(res);
+        EXPECT_EQ(res, "test");
+        dec.read_textstring(res);
+        EXPECT_EQ(res, "test");
+    }
+
     TEST(CdnsDecoderTest, CDArrayStartTest) {
         std::istringstream is(darray + dindef_array);
         CdnsDecoder dec(is);
@@ -227,4 +241,64 @@ namespace CDNS {
         peek = dec.peek_type();
         EXPECT_EQ(peek, CborType::SIMPLE);
     }
-}
\ No newline at end of file
+
+    TEST(CdnsDecoderTest, CDSkipIndefTest) {
+        // [_ 1, {_ 1: "test"}], (_ "te", "st"), unsigned
+        std::istringstream is(dindef_array + "\x01" + dindef_map + "\x01" + dbytestring + "\xFF\xFF"
+                              + "\x5F\x42te\x42st\xFF" + dunsigned);
+        CdnsDecoder dec(is);
+
+        dec.skip_item();
+        CborType peek = dec.peek_type();
+        EXPECT_EQ(peek, CborType::BYTE_STRING);
+
+        dec.skip_item();
+        peek = dec.peek_type();
+        EXPECT_EQ(peek, CborType::UNSIGNED);
+    }
+
+    TEST(CdnsDecoderTest, CDLongStringTest) {
+        // Byte string spanning multiple refills of decoder's buffer
+        std::string data(0x3002D, 'x');
+        std::string encoded = std::string("\x5A") + '\0' + '\x03' + '\0' + '\x2D' + data;
+        ASSERT_GT(data.size(), 2 * CdnsDecoder::BUFFER_SIZE);
+
+        std::istringstream is(encoded + encoded + dunsigned);
+        CdnsDecoder dec(is);
+
+        EXPECT_EQ(dec.read_bytestring(), data);
+        dec.skip_item();
+        EXPECT_EQ(dec.read_unsigned(), 42);
+        EXPECT_EQ(dec.get_stats().strings, 1);
+        EXPECT_EQ(dec.get_stats().string_bytes, data.size());
+    }
+
+    TEST(CdnsDecoderTest, CDRecordTest) {
+        // {1: "test"}, 42, long byte string spanning multiple refills of decoder's buffer, 42
+        std::string map = "\xA1\x01" + dbytestring;
+        std::string data(2 * CdnsDecoder::BUFFER_SIZE, 'y');
+        std::string long_string = std::string("\x5A") + '\0' + '\x01' + '\xFF' + '\xFE' + data;
+        std::istringstream is(map + dunsigned + long_string + dunsigned);
+        CdnsDecoder dec(is);
+
+        std::string recorded;
+        dec.start_recording(recorded);
+        dec.skip_item();
+        dec.stop_recording();
+        EXPECT_EQ(recorded, map);
+
+        EXPECT_EQ(dec.read_unsigned(), 42);
+
+        recorded.clear();
+        dec.start_recording(recorded);
+        dec.skip_item();
+        dec.stop_recording();
+        EXPECT_EQ(recorded, long_string);
+
+        // Nothing is recorded after the recording is stopped
+        EXPECT_EQ(dec.read_unsigned(), 42);
+        dec.stop_recording();
+        EXPECT_EQ(recorded, long_string);
+        EXPECT_EQ(dec.get_stats().strings, 0);
+    }
+}
@@ -168,4 +168,226 @@ namespace CDNS {
 
         test_size_and_remove_file(file2, written + 1);
     }
+
+    TEST(CdnsExporterTest, CEMemoryOutputTest) {
+        FilePreamble fp;
+        MemoryOutput buffer;
+        CdnsExporter* exporter = new CdnsExporter(fp, buffer, CborOutputCompression::NO_COMPRESSION);
+        GenericQueryResponse gqr;
+        gqr.ts = Timestamp(12, 12543);
+        gqr.client_port = 1234;
+
+        exporter->buffer_qr(gqr);
+        exporter->write_block();
+        delete exporter;
+
+        std::istringstream input(buffer.release());
+        CdnsReader reader(input);
+        bool end = false;
+        CdnsBlockRead block = reader.read_block(end);
+        EXPECT_FALSE(end);
+        EXPECT_EQ(block.get_qr_count(), 1);
+        GenericQueryResponse rqr = block.read_generic_qr(end);
+        EXPECT_EQ(*rqr.client_port, 1234);
+        block = reader.read_block(end);
+        EXPECT_TRUE(end);
+    }
+
+    TEST(CdnsExporterTest, CEMaxBlockSizeAgeTest) {
+        FilePreamble fp;
+        MemoryOutput buffer;
+        CdnsExporter* exporter = new CdnsExporter(fp, buffer, CborOutputCompression::NO_COMPRESSION);
+        GenericQueryResponse gqr;
+        exporter->set_max_block_size(1000);
+
+        for (int i = 0; i < 100; i++) {
+            gqr.ts = Timestamp(12, i);
+            gqr.query_name = "name" + std::to_string(i) + ".example.com";
+            exporter->buffer_qr(gqr);
+        }
+        EXPECT_GT(exporter->get_blocks_written_count(), 1);
+
+        exporter->set_max_block_size(0);
+        exporter->set_max_block_age(1000);
+        exporter->write_block();
+        std::size_t blocks = exporter->get_blocks_written_count();
+        gqr.ts = Timestamp(20, 0);
+        exporter->buffer_qr(gqr);
+        EXPECT_EQ(exporter->write_block_if_expired(Timestamp(20, 999)), 0);
+        EXPECT_GT(exporter->write_block_if_expired(Timestamp(20, 1000)), 0);
+        EXPECT_EQ(exporter->get_blocks_written_count(), blocks + 1);
+        EXPECT_EQ(exporter->get_block_item_count(), 0);
+        delete exporter;
+    }
+
+    TEST(CdnsExporterTest, CESwapBlockTest) {
+        FilePreamble fp;
+        MemoryOutput buffer;
+        CdnsExporter* exporter = new CdnsExporter(fp, buffer, CborOutputCompression::NO_COMPRESSION);
+        exporter->set_max_block_size(100000);
+        GenericQueryResponse gqr;
+        gqr.ts = Timestamp(12, 12543);
+        gqr.client_port = 1234;
+        exporter->buffer_qr(gqr);
+
+        CdnsBlock block = exporter->swap_block();
+        EXPECT_EQ(block.get_qr_count(), 1);
+        EXPECT_EQ(exporter->get_block_item_count(), 0);
+        EXPECT_EQ(exporter->get_blocks_written_count(), 0);
+
+        // Keep buffering into the spare block while the swapped one is written
+        gqr.client_port = 4321;
+        exporter->buffer_qr(gqr);
+        EXPECT_EQ(exporter->get_block_item_count(), 1);
+        EXPECT_GT(exporter->write_block(block), 0);
+        exporter->recycle_block(std::move(block));
+        EXPECT_EQ(block.get_item_count(), 0);
+
+        block = exporter->swap_block();
+        EXPECT_EQ(block.get_qr_count(), 1);
+        EXPECT_EQ(block.get_max_block_size(), 100000);
+        EXPECT_GT(exporter->write_block(block), 0);
+        exporter->recycle_block(std::move(block));
+        EXPECT_EQ(exporter->get_blocks_written_count(), 2);
+        delete exporter;
+
+        std::istringstream input(buffer.release());
+        CdnsReader reader(input);
+        bool end = false;
+        CdnsBlockRead rblock = reader.read_block(end);
+        GenericQueryResponse rqr = rblock.read_generic_qr(end);
+        EXPECT_EQ(*rqr.client_port, 1234);
+        rblock = reader.read_block(end);
+        rqr = rblock.read_generic_qr(end);
+        EXPECT_EQ(*rqr.client_port, 4321);
+        rblock = reader.read_block(end);
+        EXPECT_TRUE(end);
+    }
+
+    TEST(CdnsExporterTest, CEStatsTest) {
+        FilePreamble fp;
+        MemoryOutput buffer;
+        MemoryOutput buffer2;
+        CdnsExporter* exporter = new CdnsExporter(fp, buffer, CborOutputCompression::GZIP);
+        GenericQueryResponse gqr;
+        gqr.client_ip = std::string("\x7f\x00\x00\x01", 4);
+
+        for (int i = 0; i < 100; i++) {
+            gqr.ts = Timestamp(12, i);
+            gqr.client_port = i;
+            gqr.query_name = "name" + std::to_string(i % 10) + ".example.com";
+            exporter->buffer_qr(gqr);
+        }
+
+        // Empty Query/Response has no field to store
+        exporter->buffer_qr(GenericQueryResponse());
+        exporter->buffer_mm(GenericMalformedMessage());
+
+        ExporterStats stats = exporter->get_stats();
+        EXPECT_EQ(stats.blocks_written, 0);
+        EXPECT_EQ(stats.dropped_qrs, 1);
+        EXPECT_EQ(stats.dropped_mms, 1);
+        EXPECT_EQ(stats.dropped_aecs, 0);
+
+        std::size_t written = exporter->write_block();
+        stats = exporter->get_stats();
+        EXPECT_EQ(stats.blocks_written, 1);
+        EXPECT_EQ(stats.qr_count, 100);
+        EXPECT_EQ(stats.uncompressed_bytes, written);
+        EXPECT_EQ(stats.last_block.qr_count, 100);
+        EXPECT_EQ(stats.last_block.uncompressed_bytes, written);
+        EXPECT_GE(stats.write_ns, stats.output_ns);
+        EXPECT_EQ(stats.write_ns, stats.last_block.write_ns);
+
+        EXPECT_EQ(stats.tables.ip_address.items, 1);
+        EXPECT_EQ(stats.tables.ip_address.lookups, 100);
+        EXPECT_EQ(stats.tables.ip_address.hits, 99);
+        EXPECT_EQ(stats.tables.name_rdata.items, 10);
+        EXPECT_DOUBLE_EQ(stats.tables.name_rdata.hit_ratio(), 0.9);
+        EXPECT_EQ(stats.tables.malformed_message_data.lookups, 0);
+        EXPECT_DOUBLE_EQ(stats.tables.malformed_message_data.hit_ratio(), 0.0);
+
+        // Compressed output is complete after rotation
+        exporter->rotate_output(buffer2, true);
+        stats = exporter->get_stats();
+        EXPECT_EQ(stats.rotations, 1);
+        EXPECT_GT(stats.rotation_ns, 0);
+        EXPECT_EQ(stats.compressed_bytes, buffer.size());
+        EXPECT_EQ(stats.uncompressed_bytes, written + 1);
+        EXPECT_GT(stats.compression_ratio(), 1.0);
+        EXPECT_FALSE(stats.string().empty());
+
+        exporter->reset_stats();
+        stats = exporter->get_stats();
+        EXPECT_EQ(stats.blocks_written, 0);
+        EXPECT_EQ(stats.compressed_bytes, 0);
+        EXPECT_EQ(stats.tables.ip_address.lookups, 0);
+        delete exporter;
+    }
+
+    /**
+     * @brief Export synthetic traffic with string interners of given capacity to uncompressed C-DNS in memory
+     */
+    std::string export_interned(std::size_t capacity, std::size_t count) {
+        GeneratorConfig config;
+        config.seed = 1234;
+        TrafficGenerator generator(config);
+        FilePreamble fp;
+        fp.m_block_parameters[0].storage_parameters.max_block_items = 500;
+        MemoryOutput buffer;
+        {
+            CdnsExporter exporter(fp, buffer, CborOutputCompression::NO_COMPRESSION);
+            exporter.set_string_interning(capacity);
+            generator.generate(exporter, count);
+            exporter.write_block();
+        }
+        return buffer.release();
+    }
+
+    TEST(CdnsExporterTest, CEStringInterningTest) {
+        std::string plain = export_interned(0, 5000);
+
+        // Output doesn't depend on interning, even if the interners are too small for a single Block
+        EXPECT_EQ(export_interned(StringInterner::DEFAULT_CAPACITY, 5000), plain);
+        EXPECT_EQ(export_interned(64, 5000), plain);
+        EXPECT_EQ(export_interned(1, 5000), plain);
+    }
+
+    TEST(CdnsExporterTest, CEStringInterningStatsTest) {
+        FilePreamble fp;
+        MemoryOutput buffer;
+        CdnsExporter exporter(fp, buffer, CborOutputCompression::NO_COMPRESSION);
+        GenericQueryResponse gqr;
+        gqr.ts = Timestamp(12, 0);
+        gqr.client_ip = std::string("\x7f\x00\x00\x01", 4);
+        exporter.buffer_qr(gqr);
+
+        // Interning starts with the next Block
+        exporter.set_string_interning(1024);
+        for (int i = 0; i < 100; i++) {
+            gqr.query_name = "name" + std::to_string(i % 10) + ".example.com";
+            exporter.buffer_qr(gqr);
+        }
+        exporter.write_block();
+
+        for (int i = 0; i < 100; i++) {
+            gqr.query_name = "name" + std::to_string(i % 10) + ".example.com";
+            exporter.buffer_qr(gqr);
+        }
+        exporter.write_block();
+
+        ExporterStats stats = exporter.get_stats();
+        EXPECT_EQ(stats.blocks_written, 2);
+        EXPECT_EQ(stats.last_block.tables.ip_address.items, 1);
+        EXPECT_EQ(stats.last_block.tables.ip_address.lookups, 100);
+        EXPECT_EQ(stats.last_block.tables.ip_address.hits, 99);
+        EXPECT_EQ(stats.last_block.tables.name_rdata.items, 10);
+        EXPECT_DOUBLE_EQ(stats.last_block.tables.name_rdata.hit_ratio(), 0.9);
+
+        CdnsBlock block(fp.get_block_parameters(0), 0);
+        block.add_ip_address("\x7f\x00\x00\x01");
+        StringInterner interner;
+        EXPECT_THROW(block.set_string_interners(&interner, nullptr), std::runtime_error);
+        EXPECT_NO_THROW(block.set_string_interners(nullptr, &interner));
+    }
 }
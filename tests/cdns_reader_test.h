@@ -186,6 +186,60 @@ namespace CDNS {
         remove_file(file);
     }
 
+    TEST(CdnsReaderTest, CRReadBlockIntoTest) {
+        create_test_file();
+        std::ifstream ifs(file, std::ifstream::binary);
+        CdnsReader reader(ifs);
+
+        // Read first block
+        bool eof = false;
+        CdnsBlockRead block;
+        reader.read_block_into(block, eof);
+        ASSERT_FALSE(eof);
+        EXPECT_EQ(block.get_qr_count(), 2);
+        EXPECT_EQ(block.get_aec_count(), 2);
+        EXPECT_EQ(block.get_mm_count(), 1);
+        const StringItem* ip = &block.m_ip_address[0];
+
+        GenericQueryResponse gqr = block.read_generic_qr(eof);
+        ASSERT_FALSE(eof);
+        EXPECT_EQ(*gqr.asn, "1234");
+
+        // Read second block into the same object, reusing its items
+        reader.read_block_into(block, eof);
+        ASSERT_FALSE(eof);
+        EXPECT_EQ(block.get_qr_count(), 1);
+        EXPECT_EQ(block.get_aec_count(), 1);
+        EXPECT_EQ(block.get_mm_count(), 0);
+        EXPECT_EQ(&block.m_ip_address[0], ip);
+
+        gqr = block.read_generic_qr(eof);
+        ASSERT_FALSE(eof);
+        EXPECT_EQ(gqr.ts->m_secs, 13);
+        EXPECT_EQ(*gqr.client_ip, "8.8.8.8");
+        EXPECT_EQ(*gqr.asn, "5678");
+        gqr = block.read_generic_qr(eof);
+        ASSERT_TRUE(eof);
+
+        GenericAddressEventCount gaec = block.read_generic_aec(eof);
+        ASSERT_FALSE(eof);
+        EXPECT_EQ(gaec.ae_type, AddressEventTypeValues::icmpv6_packet_too_big);
+        gaec = block.read_generic_aec(eof);
+        ASSERT_TRUE(eof);
+
+        // Check for end of file
+        reader.read_block_into(block, eof);
+        ASSERT_TRUE(eof);
+        EXPECT_EQ(block.get_item_count(), 0);
+        gqr = block.read_generic_qr(eof);
+        ASSERT_TRUE(eof);
+        gaec = block.read_generic_aec(eof);
+        ASSERT_TRUE(eof);
+
+        ifs.close();
+        remove_file(file);
+    }
+
     TEST(CdnsReaderTest, CRReadHugeTimestampOffsetTest) {
         FilePreamble fp;
         CdnsExporter* exporter = new CdnsExporter(fp, file, CborOutputCompression::NO_COMPRESSION);
@@ -233,4 +287,356 @@ namespace CDNS {
         ifs.close();
         remove_file(file);
     }
+
+    TEST(CdnsReaderTest, CRStatsTest) {
+        FilePreamble fp;
+        fp.m_block_parameters[0].storage_parameters.max_block_items = 10;
+        MemoryOutput buffer;
+        CdnsExporter* exporter = new CdnsExporter(fp, buffer, CborOutputCompression::NO_COMPRESSION);
+        GenericQueryResponse gqr;
+
+        for (int i = 0; i < 25; i++) {
+            gqr.ts = Timestamp(12, i);
+            gqr.query_name = "name" + std::to_string(i) + ".example.com";
+            exporter->buffer_qr(gqr);
+        }
+        exporter->write_block();
+        delete exporter;
+
+        std::string data = buffer.release();
+        std::istringstream input(data);
+        CdnsReader reader(input);
+        reader.set_timing(true);
+        CdnsBlockRead block;
+        bool eof = false;
+
+        reader.read_block_into(block, eof);
+        ASSERT_FALSE(eof);
+        ReaderStats stats = reader.get_stats();
+        EXPECT_EQ(stats.blocks_read, 1);
+        EXPECT_EQ(stats.qr_count, 10);
+        EXPECT_GT(stats.last_block_bytes, 0);
+        EXPECT_EQ(stats.decoder.bytes_read, data.size());
+        EXPECT_EQ(stats.decoder.buffer_refills, 1);
+        EXPECT_GE(stats.decoder.strings, 10);
+
+        while (!eof) {
+            while (!eof)
+                block.read_generic_qr(eof);
+            reader.read_block_into(block, eof);
+        }
+
+        stats = reader.get_stats();
+        EXPECT_EQ(stats.blocks_read, 3);
+        EXPECT_EQ(stats.qr_count, 25);
+        EXPECT_EQ(stats.bytes_consumed, data.size());
+        EXPECT_LT(stats.block_bytes, data.size());
+        EXPECT_GE(stats.max_block_bytes, stats.last_block_bytes);
+        EXPECT_DOUBLE_EQ(stats.bytes_per_block(), stats.block_bytes / 3.0);
+        EXPECT_GT(stats.read_ns, 0);
+        EXPECT_GT(stats.phases_ns.tables_ns, 0);
+        EXPECT_GT(stats.phases_ns.items_ns, 0);
+        EXPECT_GT(stats.phases_ns.materialize_ns, 0);
+        EXPECT_FALSE(stats.string().empty());
+    }
+
+    TEST(CdnsReaderTest, CRBlockSummaryFilterTest) {
+        FilePreamble fp;
+        fp.m_block_parameters[0].storage_parameters.max_block_items = 10;
+        MemoryOutput buffer;
+        CdnsExporter* exporter = new CdnsExporter(fp, buffer, CborOutputCompression::NO_COMPRESSION);
+        exporter->set_block_summary(true);
+        GenericQueryResponse gqr;
+
+        // 5 Blocks, each one covering 10 seconds. Only the 4th Block has NXDOMAIN responses.
+        for (int i = 0; i < 50; i++) {
+            gqr.ts = Timestamp(100 + i, 0);
+            gqr.query_name = "name" + std::to_string(i) + ".example.com";
+            gqr.response_rcode = (i == 35) ? 3 : 0;
+            exporter->buffer_qr(gqr);
+        }
+        exporter->write_block();
+        delete exporter;
+
+        std::string data = buffer.release();
+        std::istringstream input(data);
+        CdnsReader reader(input);
+        CdnsBlockRead block;
+        bool eof = false;
+        std::vector<uint64_t> decoded;
+
+        Timestamp from(112, 0);
+        Timestamp to(125, 0);
+        auto time_filter = [&from, &to](const BlockPreamble& bp, const BlockSummary& bs) {
+            return bs.overlaps(bp.earliest_time, from, to);
+        };
+
+        while (true) {
+            bool ret = reader.read_block_into(block, eof, time_filter);
+            if (eof)
+                break;
+
+            ASSERT_TRUE(block.m_block_summary);
+            if (ret) {
+                EXPECT_EQ(block.get_qr_count(), 10);
+                decoded.push_back(block.m_block_preamble.earliest_time.m_secs);
+            }
+            else {
+                EXPECT_EQ(block.get_item_count(), 0);
+                EXPECT_EQ(block.m_ip_address.size() + block.m_name_rdata.size(), 0);
+                EXPECT_EQ(block.m_block_summary->qr_count, 10);
+            }
+        }
+        EXPECT_EQ(decoded, std::vector<uint64_t>({110, 120}));
+
+        ReaderStats stats = reader.get_stats();
+        EXPECT_EQ(stats.blocks_read, 2);
+        EXPECT_EQ(stats.blocks_skipped, 3);
+        EXPECT_EQ(stats.qr_count, 20);
+        EXPECT_EQ(stats.bytes_consumed, data.size());
+
+        // Filter by RCODE
+        std::istringstream input2(data);
+        CdnsReader reader2(input2);
+        std::size_t nxdomain = 0;
+        eof = false;
+        while (!eof) {
+            if (reader2.read_block_into(block, eof, [](const BlockPreamble&, const BlockSummary& bs) {
+                return bs.has_rcode(3);
+            })) {
+                nxdomain += block.get_qr_count();
+            }
+        }
+        EXPECT_EQ(nxdomain, 10);
+        EXPECT_EQ(reader2.get_stats().blocks_skipped, 4);
+
+        // Readers without filter decode all Blocks
+        std::istringstream input3(data);
+        CdnsReader reader3(input3);
+        eof = false;
+        std::size_t qrs = 0;
+        while (true) {
+            reader3.read_block_into(block, eof);
+            if (eof)
+                break;
+            qrs += block.get_qr_count();
+        }
+        EXPECT_EQ(qrs, 50);
+    }
+
+    TEST(CdnsReaderTest, CRBlockLookupTest) {
+        FilePreamble fp;
+        fp.m_block_parameters[0].storage_parameters.max_block_items = 10;
+        MemoryOutput buffer;
+        CdnsExporter* exporter = new CdnsExporter(fp, buffer, CborOutputCompression::NO_COMPRESSION);
+        exporter->set_block_filter(BloomFilter::DEFAULT_BITS_PER_ITEM);
+        GenericQueryResponse gqr;
+
+        // 10 Blocks with distinct QNAMEs and client addresses
+        for (int i = 0; i < 100; i++) {
+            gqr.ts = Timestamp(100 + i, 0);
+            gqr.query_name = "name" + std::to_string(i) + ".example.com";
+            gqr.client_ip = std::string("\x0a\x00\x00", 3) + static_cast<char>(i);
+            exporter->buffer_qr(gqr);
+        }
+        exporter->write_block();
+        delete exporter;
+
+        std::string data = buffer.release();
+        auto lookup_blocks = [&data](const BlockLookup& lookup, uint64_t& skipped) {
+            std::istringstream input(data);
+            CdnsReader reader(input);
+            CdnsBlockRead block;
+            bool eof = false;
+            std::vector<uint64_t> decoded;
+            while (true) {
+                reader.read_block_matching(block, eof, lookup);
+                if (eof)
+                    break;
+
+                EXPECT_TRUE(block.m_block_summary);
+                decoded.push_back(block.m_block_preamble.earliest_time.m_secs);
+            }
+            skipped = reader.get_stats().blocks_skipped;
+            return decoded;
+        };
+
+        // QNAMEs are compared case-insensitively
+        uint64_t skipped = 0;
+        BlockLookup name;
+        name.add_name("NAME42.Example.com");
+        EXPECT_EQ(lookup_blocks(name, skipped), std::vector<uint64_t>({140}));
+        EXPECT_EQ(skipped, 9);
+
+        BlockLookup address;
+        address.add_address(std::string("\x0a\x00\x00\x07", 4));
+        address.add_address(std::string("\x0a\x00\x00\x63", 4));
+        EXPECT_EQ(lookup_blocks(address, skipped), std::vector<uint64_t>({100, 190}));
+        EXPECT_EQ(skipped, 8);
+
+        BlockLookup missing;
+        missing.add_name("evil.example");
+        EXPECT_TRUE(lookup_blocks(missing, skipped).empty());
+        EXPECT_EQ(skipped, 10);
+
+        // Empty lookup matches all Blocks
+        EXPECT_EQ(lookup_blocks(BlockLookup(), skipped).size(), 10);
+        EXPECT_EQ(skipped, 0);
+
+        // Blocks with summary but without the filter are always decoded
+        MemoryOutput buffer2;
+        exporter = new CdnsExporter(fp, buffer2, CborOutputCompression::NO_COMPRESSION);
+        exporter->set_block_summary(true);
+        for (int i = 0; i < 20; i++) {
+            gqr.ts = Timestamp(100 + i, 0);
+            exporter->buffer_qr(gqr);
+        }
+        exporter->write_block();
+        delete exporter;
+
+        data = buffer2.release();
+        EXPECT_EQ(lookup_blocks(missing, skipped).size(), 2);
+        EXPECT_EQ(skipped, 0);
+    }
+
+    TEST(CdnsReaderTest, CRPrefetchTest) {
+        FilePreamble fp;
+        fp.m_block_parameters[0].storage_parameters.max_block_items = 10;
+        MemoryOutput buffer;
+        CdnsExporter* exporter = new CdnsExporter(fp, buffer, CborOutputCompression::NO_COMPRESSION);
+        GenericQueryResponse gqr;
+
+        for (int i = 0; i < 95; i++) {
+            gqr.ts = Timestamp(12, i);
+            gqr.query_name = "name" + std::to_string(i) + ".example.com";
+            exporter->buffer_qr(gqr);
+        }
+        exporter->write_block();
+        delete exporter;
+
+        std::string data = buffer.release();
+        std::istringstream input(data);
+        CdnsReader reader(input);
+        EXPECT_THROW(CdnsBlockPrefetcher(reader, 0), std::invalid_argument);
+
+        CdnsBlockPrefetcher prefetcher(reader, 3);
+        CdnsBlockRead block;
+        bool eof = false;
+        int i = 0;
+        std::size_t blocks = 0;
+
+        while (true) {
+            prefetcher.next(block, eof);
+            if (eof)
+                break;
+            blocks++;
+
+            bool end = false;
+            while (true) {
+                GenericQueryResponse read = block.read_generic_qr(end);
+                if (end)
+                    break;
+                ASSERT_TRUE(read.query_name);
+                EXPECT_EQ(*read.query_name, "name" + std::to_string(i++) + ".example.com");
+            }
+        }
+
+        EXPECT_EQ(blocks, 10);
+        EXPECT_EQ(i, 95);
+        EXPECT_EQ(block.get_item_count(), 0);
+
+        // Further calls keep returning end of file
+        prefetcher.next(block, eof);
+        EXPECT_TRUE(eof);
+    }
+
+    TEST(CdnsReaderTest, CRPrefetchErrorTest) {
+        FilePreamble fp;
+        MemoryOutput buffer;
+        CdnsExporter* exporter = new CdnsExporter(fp, buffer, CborOutputCompression::NO_COMPRESSION);
+        GenericQueryResponse gqr;
+        gqr.query_name = "example.com";
+        exporter->buffer_qr(gqr);
+        exporter->write_block();
+        delete exporter;
+
+        // Cut the file in the middle of the Block
+        std::string data = buffer.release();
+        std::istringstream input(data.substr(0, data.size() - 5));
+        CdnsReader reader(input);
+        CdnsBlockRead block;
+        bool eof = false;
+
+        {
+            CdnsBlockPrefetcher prefetcher(reader);
+            EXPECT_ANY_THROW(prefetcher.next(block, eof));
+            EXPECT_TRUE(eof);
+        }
+
+        // Destroying the prefetcher before reading all Blocks stops the background thread
+        std::istringstream input2(data);
+        CdnsReader reader2(input2);
+        CdnsBlockPrefetcher prefetcher(reader2, 1);
+    }
+
+    TEST(CdnsReaderTest, CRParallelBlockReaderTest) {
+        FilePreamble fp;
+        fp.m_block_parameters[0].storage_parameters.max_block_items = 10;
+        MemoryOutput buffer;
+        CdnsExporter* exporter = new CdnsExporter(fp, buffer, CborOutputCompression::NO_COMPRESSION);
+        exporter->set_block_summary(true);
+        GenericQueryResponse gqr;
+
+        for (int i = 0; i < 95; i++) {
+            gqr.ts = Timestamp(100 + i / 10, i);
+            gqr.query_name = "name" + std::to_string(i) + ".example.com";
+            exporter->buffer_qr(gqr);
+        }
+        exporter->write_block();
+        delete exporter;
+
+        std::string data = buffer.release();
+        auto process = [](CdnsBlockRead& block) {
+            std::vector<std::string> names;
+            block.for_each_qr([&names](const QueryResponseView& qr) { names.push_back(*qr.query_name()); });
+            return names;
+        };
+
+        // Results are consumed in the order of the Blocks
+        std::istringstream input(data);
+        CdnsReader reader(input);
+        ParallelBlockReader<std::vector<std::string>> parallel(reader, 3);
+        EXPECT_EQ(parallel.threads(), 3);
+        std::vector<std::string> names;
+        auto consume = [&names](std::vector<std::string>& result) {
+            names.insert(names.end(), result.begin(), result.end());
+        };
+        EXPECT_EQ(parallel.run(process, consume), 10);
+        ASSERT_EQ(names.size(), 95);
+        for (int i = 0; i < 95; i++)
+            EXPECT_EQ(names[i], "name" + std::to_string(i) + ".example.com");
+
+        // Blocks rejected by the filter aren't processed
+        std::istringstream input2(data);
+        CdnsReader reader2(input2);
+        ParallelBlockReader<std::vector<std::string>> filtered(reader2, 2);
+        filtered.set_filter([](const BlockPreamble& preamble, const BlockSummary&) {
+            return preamble.earliest_time.m_secs % 2 == 0;
+        });
+        names.clear();
+        EXPECT_EQ(filtered.run(process, consume), 5);
+        ASSERT_EQ(names.size(), 50);
+        EXPECT_EQ(names[10], "name20.example.com");
+        EXPECT_EQ(reader2.get_stats().blocks_skipped, 5);
+
+        // Errors of the workers are rethrown
+        std::istringstream input3(data);
+        CdnsReader reader3(input3);
+        ParallelBlockReader<int> failing(reader3, 2);
+        EXPECT_THROW(failing.run([](CdnsBlockRead& block) -> int {
+            if (block.m_block_preamble.earliest_time.m_secs == 105)
+                throw std::runtime_error("Processing failed");
+            return 0;
+        }, [](int&) {}), std::runtime_error);
+    }
 }
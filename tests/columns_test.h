@@ -0,0 +1,172 @@
+/**
+ * Copyright © 2026 CZ.NIC, z. s. p. o.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, you can obtain one at https://mozilla.org/MPL/2.0/.
+ */
+
+#pragma once
+
+#include <sstream>
+#include <limits>
+#include <gtest/gtest.h>
+
+#include "../src/cdns.h"
+#include "common.h"
+#include "generator_test.h"
+
+namespace CDNS {
+    TEST(ColumnTest, ColumnValidityTest) {
+        Column<uint16_t> column;
+        for (uint16_t i = 0; i < 20; i++) {
+            if (i % 3 == 0)
+                column.push_null();
+            else
+                column.push_back(i);
+        }
+
+        ASSERT_EQ(column.size(), 20);
+        EXPECT_EQ(column.null_count(), 7);
+        EXPECT_EQ(column.validity().size(), 3);
+        EXPECT_FALSE(column.valid(0));
+        EXPECT_TRUE(column.valid(1));
+        EXPECT_EQ(column[0], 0);
+        EXPECT_EQ(column[19], 19);
+        EXPECT_EQ(column.at(19), 19);
+        EXPECT_THROW(column.at(18), std::out_of_range);
+        EXPECT_THROW(column.at(20), std::out_of_range);
+
+        column.clear();
+        EXPECT_EQ(column.size(), 0);
+        EXPECT_EQ(column.null_count(), 0);
+        column.push_back(5);
+        EXPECT_TRUE(column.valid(0));
+        EXPECT_EQ(column.validity().size(), 1);
+    }
+
+    TEST(ColumnTest, StringDictionaryTest) {
+        StringDictionary dict;
+        EXPECT_EQ(dict.size(), 0);
+        dict.push_back("abc");
+        dict.push_back("");
+        dict.push_back("de");
+
+        ASSERT_EQ(dict.size(), 3);
+        EXPECT_EQ(dict.get(0), "abc");
+        EXPECT_EQ(dict.get(1), "");
+        EXPECT_EQ(dict.get(2), "de");
+        EXPECT_THROW(dict.get(3), std::out_of_range);
+        EXPECT_EQ(dict.offsets(), std::vector<StringDictionary::offset_type>({0, 3, 3, 5}));
+        EXPECT_EQ(dict.data(), "abcde");
+
+        dict.clear();
+        EXPECT_EQ(dict.size(), 0);
+        EXPECT_EQ(dict.offsets().size(), 1);
+
+        // Dictionaries of many Blocks may exceed 2 GiB, offsets must not wrap at 32 bits
+        EXPECT_EQ(sizeof(StringDictionary::offset_type), 8);
+        EXPECT_GT(static_cast<uint64_t>(std::numeric_limits<StringDictionary::offset_type>::max()),
+                  static_cast<uint64_t>(std::numeric_limits<int32_t>::max()) * 2);
+    }
+
+    TEST(ColumnTest, BlockReadQRColumnsTest) {
+        GeneratorConfig config;
+        std::istringstream input(generate_to_memory(config, 3000));
+        CdnsReader reader(input);
+        CdnsBlockRead block;
+        QueryResponseColumns columns;
+        bool eof = false;
+        std::size_t blocks = 0;
+
+        while (true) {
+            reader.read_block_into(block, eof);
+            if (eof)
+                break;
+            blocks++;
+
+            block.read_qr_columns(columns);
+            ASSERT_EQ(columns.size(), block.get_qr_count());
+            ASSERT_EQ(columns.ip_address.size(), block.m_ip_address.size());
+            ASSERT_EQ(columns.name_rdata.size(), block.m_name_rdata.size());
+            EXPECT_EQ(columns.ticks_per_second, 1000000);
+
+            // Compare with generic Query/Responses of the Block
+            bool end = false;
+            for (std::size_t i = 0; i < columns.size(); i++) {
+                GenericQueryResponse gqr = block.read_generic_qr(end);
+                ASSERT_FALSE(end);
+
+                ASSERT_TRUE(gqr.ts);
+                EXPECT_EQ(columns.timestamp.at(i), static_cast<int64_t>(gqr.ts->m_secs * 1000000 + gqr.ts->m_ticks));
+                ASSERT_TRUE(gqr.client_ip);
+                EXPECT_EQ(columns.ip_address.get(columns.client_address.at(i)), *gqr.client_ip);
+                EXPECT_EQ(columns.client_port.at(i), *gqr.client_port);
+                EXPECT_EQ(columns.ip_address.get(columns.server_address.at(i)), *gqr.server_ip);
+                EXPECT_EQ(columns.transport_flags.at(i), *gqr.qr_transport_flags);
+                ASSERT_TRUE(gqr.query_name);
+                EXPECT_EQ(columns.name_rdata.get(columns.qname.at(i)), *gqr.query_name);
+                ASSERT_TRUE(gqr.query_classtype);
+                EXPECT_EQ(columns.qtype.at(i), gqr.query_classtype->type);
+                EXPECT_EQ(columns.qclass.at(i), gqr.query_classtype->class_);
+
+                EXPECT_EQ(columns.rcode.valid(i), !!gqr.response_rcode);
+                if (gqr.response_rcode) {
+                    EXPECT_EQ(columns.rcode[i], *gqr.response_rcode);
+                }
+                EXPECT_EQ(columns.response_size.valid(i), !!gqr.response_size);
+                if (gqr.response_size) {
+                    EXPECT_EQ(columns.response_size[i], *gqr.response_size);
+                }
+            }
+
+            // Reading columns doesn't consume generic items
+            block.read_generic_qr(end);
+            EXPECT_TRUE(end);
+        }
+
+        EXPECT_EQ(blocks, 3);
+    }
+
+    TEST(ColumnTest, ReaderQRColumnsTest) {
+        GeneratorConfig config;
+        std::string data = generate_to_memory(config, 3000);
+        QueryResponseColumns columns;
+
+        std::istringstream input(data);
+        CdnsReader reader(input);
+        EXPECT_EQ(reader.read_qr_columns(columns), 3);
+        EXPECT_EQ(reader.get_stats().blocks_read, 3);
+
+        // Compare with the generic Query/Responses of the whole file
+        std::istringstream input2(data);
+        CdnsReader reader2(input2);
+        CdnsBlockRead block;
+        bool eof = false;
+        std::size_t pos = 0;
+        std::size_t ip_addresses = 0;
+
+        while (true) {
+            reader2.read_block_into(block, eof);
+            if (eof)
+                break;
+
+            ip_addresses += block.m_ip_address.size();
+            bool end = false;
+            while (true) {
+                GenericQueryResponse gqr = block.read_generic_qr(end);
+                if (end)
+                    break;
+
+                ASSERT_LT(pos, columns.size());
+                EXPECT_EQ(columns.ip_address.get(columns.client_address.at(pos)), *gqr.client_ip);
+                EXPECT_EQ(columns.name_rdata.get(columns.qname.at(pos)), *gqr.query_name);
+                EXPECT_EQ(columns.timestamp.at(pos), static_cast<int64_t>(gqr.ts->m_secs * 1000000 + gqr.ts->m_ticks));
+                pos++;
+            }
+        }
+
+        EXPECT_EQ(pos, columns.size());
+        EXPECT_EQ(columns.ip_address.size(), ip_addresses);
+    }
+}
@@ -0,0 +1,136 @@
+/**
+ * Copyright © 2026 CZ.NIC, z. s. p. o.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, you can obtain one at https://mozilla.org/MPL/2.0/.
+ */
+
+#pragma once
+
+#include <sstream>
+#include <fstream>
+#include <stdexcept>
+#include <gtest/gtest.h>
+
+#include "../src/cdns.h"
+#include "common.h"
+#include "generator_test.h"
+
+namespace CDNS {
+    /**
+     * @brief Read whole file to string
+     */
+    std::string read_file(const std::string& name) {
+        std::ifstream stream(name, std::ifstream::binary);
+        return std::string((std::istreambuf_iterator<char>(stream)), std::istreambuf_iterator<char>());
+    }
+
+    /**
+     * @brief Decompress data with DecompressStreamBuf
+     * @param data Compressed or uncompressed data
+     * @param compression Expected detected compression
+     */
+    std::string decompress(const std::string& data, CborOutputCompression compression) {
+        std::istringstream input(data);
+        DecompressStreamBuf buffer(input);
+        EXPECT_EQ(buffer.compression(), compression);
+        std::istream stream(&buffer);
+        std::string ret((std::istreambuf_iterator<char>(stream)), std::istreambuf_iterator<char>());
+        EXPECT_EQ(buffer.get_bytes_read(), data.size());
+        return ret;
+    }
+
+    TEST(CompressionTest, CDetectTest) {
+        EXPECT_EQ(detect_compression("\x1f\x8b\x08", 3), CborOutputCompression::GZIP);
+        EXPECT_EQ(detect_compression("\xfd" "7zXZ\x00\x00", 7), CborOutputCompression::XZ);
+        EXPECT_EQ(detect_compression("\xfd" "7zXZ", 5), CborOutputCompression::NO_COMPRESSION);
+        EXPECT_EQ(detect_compression("\x1f", 1), CborOutputCompression::NO_COMPRESSION);
+        EXPECT_EQ(detect_compression("\x9f\x98", 2), CborOutputCompression::NO_COMPRESSION);
+        EXPECT_EQ(detect_compression("", 0), CborOutputCompression::NO_COMPRESSION);
+    }
+
+    TEST(CompressionTest, CDecompressExporterTest) {
+        GeneratorConfig config;
+        std::string data = generate_to_memory(config, 5000);
+
+        EXPECT_EQ(decompress(data, CborOutputCompression::NO_COMPRESSION), data);
+        EXPECT_EQ(decompress("", CborOutputCompression::NO_COMPRESSION), "");
+
+        // Files compressed by CdnsExporter get the extension from the writer
+        for (auto compression : {CborOutputCompression::GZIP, CborOutputCompression::XZ}) {
+            std::string name = file + (compression == CborOutputCompression::GZIP ? ".gz" : ".xz");
+            {
+                std::istringstream input(data);
+                CdnsReader reader(input);
+                CdnsExporter exporter(reader.m_file_preamble, file, compression);
+                RawBlock raw;
+                bool eof = false;
+                while (true) {
+                    reader.read_raw_block(raw, eof);
+                    if (eof)
+                        break;
+                    exporter.write_raw_block(raw);
+                }
+            }
+
+            std::string compressed = read_file(name);
+            EXPECT_LT(compressed.size(), data.size());
+            EXPECT_EQ(decompress(compressed, compression), data);
+            remove_file(name);
+        }
+    }
+
+    TEST(CompressionTest, CParallelCompressorTest) {
+        GeneratorConfig config;
+        std::string data = generate_to_memory(config, 5000);
+
+        EXPECT_THROW(ParallelCompressor(file, CborOutputCompression::GZIP, 2, 0), std::invalid_argument);
+        EXPECT_THROW(ParallelCompressor("nonexistent/" + file, CborOutputCompression::GZIP), CborOutputException);
+
+        for (auto compression : {CborOutputCompression::NO_COMPRESSION, CborOutputCompression::GZIP,
+                                 CborOutputCompression::XZ}) {
+            // Small chunks make the output a sequence of many GZIP members or XZ streams
+            ParallelCompressor compressor(file, compression, 3, 4096);
+            {
+                std::istringstream input(data);
+                CdnsReader reader(input);
+                CdnsExporter exporter(reader.m_file_preamble, compressor.output(),
+                                      CborOutputCompression::NO_COMPRESSION);
+                RawBlock raw;
+                bool eof = false;
+                while (true) {
+                    reader.read_raw_block(raw, eof);
+                    if (eof)
+                        break;
+                    exporter.write_raw_block(raw);
+                }
+            }
+            compressor.close();
+            EXPECT_THROW(compressor.write("a", 1), CborOutputException);
+
+            std::string compressed = read_file(file);
+            EXPECT_EQ(compressor.get_bytes_in(), data.size());
+            EXPECT_EQ(compressor.get_bytes_out(), compressed.size());
+            EXPECT_EQ(decompress(compressed, compression), data);
+
+            // Decompressed output is readable by CdnsReader
+            std::istringstream input(compressed);
+            DecompressStreamBuf buffer(input);
+            std::istream stream(&buffer);
+            CdnsReader reader(stream);
+            CdnsBlockRead block;
+            std::size_t items = 0;
+            bool eof = false;
+            while (true) {
+                reader.read_block_into(block, eof);
+                if (eof)
+                    break;
+                items += block.get_item_count();
+            }
+            EXPECT_EQ(items, 5000);
+
+            remove_file(file);
+        }
+    }
+}
@@ -0,0 +1,142 @@
+/**
+ * Copyright © 2026 CZ.NIC, z. s. p. o.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, you can obtain one at https://mozilla.org/MPL/2.0/.
+ */
+
+#pragma once
+
+#include <sstream>
+#include <set>
+#include <gtest/gtest.h>
+
+#include "../src/cdns.h"
+#include "common.h"
+
+namespace CDNS {
+    /**
+     * @brief Generate given number of items with the given configuration to uncompressed C-DNS in memory
+     */
+    std::string generate_to_memory(const GeneratorConfig& config, std::size_t count) {
+        TrafficGenerator generator(config);
+        FilePreamble fp;
+        fp.m_block_parameters[0].storage_parameters.max_block_items = 1000;
+        MemoryOutput buffer;
+        {
+            CdnsExporter exporter(fp, buffer, CborOutputCompression::NO_COMPRESSION);
+            generator.generate(exporter, count);
+            exporter.write_block();
+        }
+        return buffer.release();
+    }
+
+    TEST(TrafficGeneratorTest, TGCTest) {
+        GeneratorConfig config;
+        EXPECT_NO_THROW(TrafficGenerator{config});
+
+        config.qnames = 0;
+        EXPECT_THROW(TrafficGenerator{config}, std::invalid_argument);
+
+        config = GeneratorConfig();
+        config.ipv4_clients = 0;
+        config.ipv6_clients = 0;
+        EXPECT_THROW(TrafficGenerator{config}, std::invalid_argument);
+
+        config = GeneratorConfig();
+        config.rate = 0;
+        EXPECT_THROW(TrafficGenerator{config}, std::invalid_argument);
+
+        config = GeneratorConfig();
+        config.tcp_ratio = 1.5;
+        EXPECT_THROW(TrafficGenerator{config}, std::invalid_argument);
+    }
+
+    TEST(TrafficGeneratorTest, TGDeterminismTest) {
+        GeneratorConfig config;
+        config.seed = 1234;
+
+        std::string first = generate_to_memory(config, 5000);
+        std::string second = generate_to_memory(config, 5000);
+        EXPECT_EQ(first, second);
+
+        config.seed = 1235;
+        std::string third = generate_to_memory(config, 5000);
+        EXPECT_NE(first, third);
+    }
+
+    TEST(TrafficGeneratorTest, TGQueryResponseTest) {
+        GeneratorConfig config;
+        config.qnames = 100;
+        TrafficGenerator generator(config);
+
+        std::vector<GenericQueryResponse> qrs = generator.generate_qrs(20000);
+        ASSERT_EQ(qrs.size(), 20000);
+
+        std::set<std::string> names;
+        std::size_t tcp = 0;
+        std::size_t nxdomain = 0;
+        std::size_t unanswered = 0;
+        Timestamp last = config.start;
+
+        for (auto& qr : qrs) {
+            ASSERT_TRUE(qr.ts);
+            EXPECT_TRUE(last <= *qr.ts);
+            last = *qr.ts;
+
+            ASSERT_TRUE(qr.query_name);
+            names.insert(*qr.query_name);
+            ASSERT_TRUE(qr.qr_transport_flags);
+            if (*qr.qr_transport_flags & QueryResponseTransportFlagsMask::tcp)
+                tcp++;
+
+            if (!qr.response_rcode)
+                unanswered++;
+            else if (*qr.response_rcode == 3)
+                nxdomain++;
+        }
+
+        EXPECT_LE(names.size(), 100);
+        EXPECT_GT(names.size(), 50);
+        EXPECT_NEAR(tcp / 20000.0, config.tcp_ratio, 0.01);
+        EXPECT_NEAR(nxdomain / 20000.0, config.nxdomain_ratio, 0.02);
+        EXPECT_NEAR(unanswered / 20000.0, config.unanswered_ratio, 0.005);
+
+        // 20000 items at 10000 items per second should take about 2 seconds of traffic time
+        EXPECT_EQ(generator.now().m_secs - config.start.m_secs, 2);
+    }
+
+    TEST(TrafficGeneratorTest, TGExporterTest) {
+        GeneratorConfig config;
+        config.address_event_ratio = 0.05;
+        config.malformed_ratio = 0.05;
+
+        std::istringstream input(generate_to_memory(config, 10000));
+        CdnsReader reader(input);
+        CdnsBlockRead block;
+        bool eof = false;
+        std::size_t blocks = 0;
+        std::size_t qrs = 0;
+        std::size_t aecs = 0;
+        std::size_t mms = 0;
+
+        while (true) {
+            reader.read_block_into(block, eof);
+            if (eof)
+                break;
+            blocks++;
+            qrs += block.get_qr_count();
+            aecs += block.get_aec_count();
+            mms += block.get_mm_count();
+        }
+
+        // Repeated Address events are aggregated into one item with count
+        EXPECT_GE(blocks, 10);
+        EXPECT_LE(qrs + aecs + mms, 10000);
+        EXPECT_GT(qrs + aecs + mms, 9500);
+        EXPECT_GT(aecs, 0);
+        EXPECT_GT(mms, 0);
+        EXPECT_GT(qrs, 8000);
+    }
+}
@@ -9,6 +9,10 @@
 #pragma once
 
 #include <stdint.h>
+#include <set>
+#include <vector>
+#include <functional>
+#include <string>
 #include <gtest/gtest.h>
 
 #include "../src/cdns.h"
@@ -105,6 +109,72 @@ namespace CDNS {
         EXPECT_NE(hash, hash4);
     }
 
+    TEST(HashTest, HPackedKeyTest) {
+        // Absent fields differ from fields with zero value
+        QueryResponseSignature qrs, qrs2;
+        CDNS::hash<QueryResponseSignature> qrs_hash;
+        qrs2.query_edns_version = 0;
+        EXPECT_FALSE(qrs == qrs2);
+        EXPECT_NE(qrs_hash(qrs), qrs_hash(qrs2));
+        qrs.query_edns_version = 0;
+        EXPECT_TRUE(qrs == qrs2);
+
+        // Every field of the signature is part of the key
+        std::vector<std::function<void(QueryResponseSignature&)>> setters = {
+            [](QueryResponseSignature& s) { s.server_address_index = 1; },
+            [](QueryResponseSignature& s) { s.server_port = 1; },
+            [](QueryResponseSignature& s) { s.qr_transport_flags = QueryResponseTransportFlagsMask::tcp; },
+            [](QueryResponseSignature& s) { s.qr_type = QueryResponseTypeValues::client; },
+            [](QueryResponseSignature& s) { s.qr_sig_flags = QueryResponseFlagsMask::has_query; },
+            [](QueryResponseSignature& s) { s.query_opcode = 1; },
+            [](QueryResponseSignature& s) { s.qr_dns_flags = DNSFlagsMask::query_rd; },
+            [](QueryResponseSignature& s) { s.query_rcode = 1; },
+            [](QueryResponseSignature& s) { s.query_classtype_index = 1; },
+            [](QueryResponseSignature& s) { s.query_qdcount = 1; },
+            [](QueryResponseSignature& s) { s.query_ancount = 1; },
+            [](QueryResponseSignature& s) { s.query_nscount = 1; },
+            [](QueryResponseSignature& s) { s.query_arcount = 1; },
+            [](QueryResponseSignature& s) { s.query_edns_version = 1; },
+            [](QueryResponseSignature& s) { s.query_udp_size = 1; },
+            [](QueryResponseSignature& s) { s.query_opt_rdata_index = 1; },
+            [](QueryResponseSignature& s) { s.response_rcode = 1; }
+        };
+        std::set<std::size_t> hashes;
+        for (std::size_t i = 0; i < setters.size(); i++) {
+            QueryResponseSignature a, b;
+            setters[i](a);
+            setters[i](b);
+            EXPECT_TRUE(a == b);
+            EXPECT_EQ(qrs_hash(a), qrs_hash(b));
+            hashes.insert(qrs_hash(a));
+
+            for (std::size_t j = 0; j < setters.size(); j++) {
+                QueryResponseSignature c;
+                setters[j](c);
+                EXPECT_EQ(a == c, i == j);
+            }
+        }
+        EXPECT_EQ(hashes.size(), setters.size());
+
+        RR rr, rr2;
+        CDNS::hash<RR> rr_hash;
+        rr2.ttl = 0;
+        EXPECT_FALSE(rr == rr2);
+        EXPECT_NE(rr_hash(rr), rr_hash(rr2));
+        rr.rdata_index = 0;
+        EXPECT_FALSE(rr == rr2);
+        rr.ttl = 0;
+        rr2.rdata_index = 0;
+        EXPECT_TRUE(rr == rr2);
+        EXPECT_EQ(rr_hash(rr), rr_hash(rr2));
+
+        AddressEventCount aec, aec2;
+        CDNS::hash<AddressEventCount> aec_hash;
+        aec2.ae_code = 0;
+        EXPECT_FALSE(aec == aec2);
+        EXPECT_NE(aec_hash(aec), aec_hash(aec2));
+    }
+
     TEST(HashTest, HMalformedMessageDataTest) {
         MalformedMessageData mmd, mmd2, mmd3;
         CDNS::hash<MalformedMessageData> hash_func;
@@ -194,4 +264,128 @@ namespace CDNS {
         EXPECT_NE(hash, hash5);
         EXPECT_EQ(hash3, hash5);
     }
+
+    /**
+     * @brief Bitwise reference implementation of CRC32C (Castagnoli)
+     */
+    uint32_t reference_crc32c(const unsigned char* data, std::size_t size, uint32_t seed) {
+        uint32_t crc = seed;
+        for (std::size_t i = 0; i < size; i++) {
+            crc ^= data[i];
+            for (int bit = 0; bit < 8; bit++)
+                crc = (crc >> 1) ^ (0x82F63B78 & (0 - (crc & 1)));
+        }
+        return ~crc;
+    }
+
+    /**
+     * @brief Switches hash backend for the life of the object and restores the original one afterwards
+     */
+    class ScopedHashBackend {
+        public:
+        explicit ScopedHashBackend(HashBackend backend) : m_original(get_hash_backend()) {
+            set_hash_backend(backend);
+        }
+
+        ~ScopedHashBackend() {
+            set_hash_backend(m_original);
+        }
+
+        private:
+        HashBackend m_original;
+    };
+
+    TEST(HashTest, HBackendSelectionTest) {
+        EXPECT_TRUE(hash_backend_supported(HashBackend::PORTABLE));
+        EXPECT_TRUE(hash_backend_supported(get_hash_backend()));
+
+        for (auto backend : {HashBackend::PORTABLE, HashBackend::SSE42_CRC32C, HashBackend::ARMV8_CRC32C}) {
+            EXPECT_FALSE(hash_backend_name(backend).empty());
+            if (hash_backend_supported(backend)) {
+                ScopedHashBackend scoped(backend);
+                EXPECT_EQ(get_hash_backend(), backend);
+            }
+            else {
+                EXPECT_THROW(set_hash_backend(backend), std::invalid_argument);
+            }
+        }
+    }
+
+    TEST(HashTest, HBackendCRC32CTest) {
+        std::string data = "123456789";
+        std::string long_data;
+        for (int i = 0; i < 100; i++)
+            long_data.push_back(static_cast<char>(i * 7));
+
+        for (auto backend : {HashBackend::SSE42_CRC32C, HashBackend::ARMV8_CRC32C}) {
+            if (!hash_backend_supported(backend))
+                continue;
+
+            ScopedHashBackend scoped(backend);
+            EXPECT_EQ(hash_value(data.data(), data.size()), 0xE3069283);
+
+            // Every length exercises a different combination of the 8, 4, 2 and 1 byte steps
+            const unsigned char* p = reinterpret_cast<const unsigned char*>(long_data.data());
+            for (std::size_t size = 0; size <= long_data.size(); size++) {
+                EXPECT_EQ(hash_value(p, size), reference_crc32c(p, size, ~0U));
+                EXPECT_EQ(hash_value(p + 1, size - (size > 0), 42), reference_crc32c(p + 1, size - (size > 0), 42));
+            }
+        }
+    }
+
+    TEST(HashTest, HBackendPropertiesTest) {
+        std::string data;
+        for (int i = 0; i < 100; i++)
+            data.push_back(static_cast<char>(i * 13));
+
+        for (auto backend : {HashBackend::PORTABLE, HashBackend::SSE42_CRC32C, HashBackend::ARMV8_CRC32C}) {
+            if (!hash_backend_supported(backend))
+                continue;
+
+            ScopedHashBackend scoped(backend);
+            std::set<std::size_t> hashes;
+            for (std::size_t size = 0; size <= data.size(); size++) {
+                std::size_t hash = hash_value(data.data(), size);
+                EXPECT_TRUE(hash <= UINT32_MAX);
+                EXPECT_EQ(hash, hash_value(data.data(), size));
+                EXPECT_NE(hash, hash_value(data.data(), size, 42));
+                hashes.insert(hash);
+
+                // Change of any single byte changes the hash
+                std::string changed = data.substr(0, size);
+                for (std::size_t i = 0; i < size; i++) {
+                    changed[i] ^= 1;
+                    EXPECT_NE(hash, hash_value(changed.data(), size));
+                    changed[i] ^= 1;
+                }
+            }
+            EXPECT_EQ(hashes.size(), data.size() + 1);
+
+            // Block tables work with every backend
+            BlockTable<StringItem> bt;
+            for (int i = 0; i < 1000; i++) {
+                StringItem si;
+                si.data = "name" + std::to_string(i % 500);
+                EXPECT_EQ(bt.add(si), static_cast<index_t>(i % 500));
+            }
+            EXPECT_EQ(bt.size(), 500);
+        }
+    }
+
+    TEST(HashTest, HStableHashTest) {
+        // Stable hashes are written to C-DNS output, so their values mustn't ever change
+        EXPECT_EQ(stable_hash("", 0), 0x2ab6f3a107a9206bULL);
+        EXPECT_EQ(stable_hash("example", 7), 0xbbf9e5d7ae52c344ULL);
+        EXPECT_EQ(stable_hash("\x07" "example\x03" "com\x00", 13), 0x88fd7bd8c49caaa6ULL);
+        EXPECT_EQ(stable_hash("0123456789abcdefghijklmnopqrstuvwxyz", 36, 1), 0x23678f8fc39ff91dULL);
+
+        // Hash backend doesn't affect them
+        for (auto backend : {HashBackend::PORTABLE, HashBackend::SSE42_CRC32C, HashBackend::ARMV8_CRC32C}) {
+            if (!hash_backend_supported(backend))
+                continue;
+
+            ScopedHashBackend scoped(backend);
+            EXPECT_EQ(stable_hash("example", 7), 0xbbf9e5d7ae52c344ULL);
+        }
+    }
 }
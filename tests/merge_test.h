@@ -0,0 +1,363 @@
+/**
+ * Copyright © 2026 CZ.NIC, z. s. p. o.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, you can obtain one at https://mozilla.org/MPL/2.0/.
+ */
+
+#pragma once
+
+#include <sstream>
+#include <gtest/gtest.h>
+
+#include "../src/cdns.h"
+#include "common.h"
+#include "generator_test.h"
+
+namespace CDNS {
+    /**
+     * @brief Read timestamps of all Query/Response items and count all items in C-DNS data
+     */
+    std::vector<Timestamp> read_qr_timestamps(const std::string& data, std::size_t& items) {
+        std::istringstream input(data);
+        CdnsReader reader(input);
+        CdnsBlockRead block;
+        std::vector<Timestamp> ret;
+        bool eof = false;
+        items = 0;
+
+        while (true) {
+            reader.read_block_into(block, eof);
+            if (eof)
+                break;
+
+            items += block.get_item_count();
+            block.for_each_qr([&ret](const QueryResponseView& qr) {
+                ret.push_back(*qr.ts());
+            });
+        }
+
+        return ret;
+    }
+
+    TEST(TimeOrderedMergeTest, TOMGeneratedTest) {
+        std::vector<std::string> data;
+        std::size_t total = 0;
+        for (uint64_t seed = 1; seed <= 3; seed++) {
+            GeneratorConfig config;
+            config.seed = seed;
+            config.rate = 5000 * seed;
+            data.push_back(generate_to_memory(config, 3000));
+
+            std::size_t items = 0;
+            read_qr_timestamps(data.back(), items);
+            total += items;
+        }
+
+        std::vector<std::unique_ptr<std::istringstream>> inputs;
+        std::vector<std::unique_ptr<CdnsReader>> readers;
+        TimeOrderedMerge merge(1);
+        for (auto& d : data) {
+            inputs.emplace_back(new std::istringstream(d));
+            readers.emplace_back(new CdnsReader(*inputs.back()));
+            merge.add_input(*readers.back());
+        }
+
+        FilePreamble fp;
+        fp.m_block_parameters[0].storage_parameters.max_block_items = 2000;
+        MemoryOutput buffer;
+        {
+            CdnsExporter exporter(fp, buffer, CborOutputCompression::NO_COMPRESSION);
+            EXPECT_GT(merge.run(exporter), 0);
+            exporter.write_block();
+        }
+
+        const MergeStats& stats = merge.get_stats();
+        EXPECT_EQ(stats.blocks_read, 9);
+        EXPECT_EQ(stats.out_of_order, 0);
+
+        std::size_t items = 0;
+        std::vector<Timestamp> ts = read_qr_timestamps(buffer.release(), items);
+        EXPECT_EQ(ts.size(), stats.qr_count);
+        EXPECT_EQ(items, total);
+        EXPECT_TRUE(std::is_sorted(ts.begin(), ts.end()));
+    }
+
+    TEST(TimeOrderedMergeTest, TOMTicksConversionTest) {
+        // First input in milliseconds, second one in microseconds
+        FilePreamble fp_ms;
+        fp_ms.m_block_parameters[0].storage_parameters.ticks_per_second = 1000;
+        MemoryOutput buffer_ms;
+        MemoryOutput buffer_us;
+        GenericQueryResponse gqr;
+        {
+            CdnsExporter exporter(fp_ms, buffer_ms, CborOutputCompression::NO_COMPRESSION);
+            gqr.ts = Timestamp(10, 500);
+            gqr.response_delay = 20;
+            exporter.buffer_qr(gqr);
+            exporter.write_block();
+        }
+        {
+            FilePreamble fp;
+            CdnsExporter exporter(fp, buffer_us, CborOutputCompression::NO_COMPRESSION);
+            gqr.response_delay = boost::none;
+            gqr.ts = Timestamp(10, 600000);
+            exporter.buffer_qr(gqr);
+            gqr.ts = Timestamp(10, 400000);
+            exporter.buffer_qr(gqr);
+            exporter.write_block();
+        }
+
+        std::istringstream input_ms(buffer_ms.release());
+        std::istringstream input_us(buffer_us.release());
+        CdnsReader reader_ms(input_ms);
+        CdnsReader reader_us(input_us);
+        TimeOrderedMerge merge;
+        merge.add_input(reader_ms);
+        merge.add_input(reader_us);
+
+        FilePreamble fp;
+        MemoryOutput output;
+        {
+            CdnsExporter exporter(fp, output, CborOutputCompression::NO_COMPRESSION);
+            merge.run(exporter);
+            exporter.write_block();
+        }
+
+        std::istringstream input(output.release());
+        CdnsReader reader(input);
+        bool eof = false;
+        CdnsBlockRead block = reader.read_block(eof);
+        ASSERT_FALSE(eof);
+        ASSERT_EQ(block.get_qr_count(), 3);
+
+        // Items within one Block are sorted too
+        EXPECT_EQ(block.qr_view(0).ts()->m_ticks, 400000);
+        EXPECT_EQ(block.qr_view(1).ts()->m_ticks, 500000);
+        EXPECT_EQ(*block.qr_view(1).response_delay(), 20000);
+        EXPECT_EQ(block.qr_view(2).ts()->m_ticks, 600000);
+        EXPECT_EQ(merge.get_stats().out_of_order, 0);
+    }
+
+    TEST(RawBlockTest, RBCopyTest) {
+        GeneratorConfig config;
+        config.seed = 42;
+        std::string first = generate_to_memory(config, 2500);
+        config.seed = 43;
+        std::string second = generate_to_memory(config, 1500);
+
+        // Output has the Block parameters of both inputs, the second input's Blocks use index 1
+        FilePreamble fp;
+        {
+            std::istringstream input(first);
+            CdnsReader reader(input);
+            fp = reader.m_file_preamble;
+            BlockParameters bp = fp.get_block_parameters(0);
+            bp.storage_parameters.max_block_items = 1234;
+            EXPECT_EQ(fp.add_block_parameters(bp), 1);
+        }
+
+        // Copy the Blocks raw and decoded
+        std::vector<RawBlock> raw_blocks;
+        MemoryOutput raw_buffer;
+        MemoryOutput decoded_buffer;
+        {
+            CdnsExporter raw_exporter(fp, raw_buffer, CborOutputCompression::NO_COMPRESSION);
+            CdnsExporter decoded_exporter(fp, decoded_buffer, CborOutputCompression::NO_COMPRESSION);
+            CdnsBlockRead block;
+            index_t index = 0;
+
+            for (auto& data : {first, second}) {
+                std::istringstream raw_input(data);
+                std::istringstream decoded_input(data);
+                CdnsReader raw_reader(raw_input);
+                CdnsReader decoded_reader(decoded_input);
+                bool eof = false;
+
+                while (true) {
+                    RawBlock raw_block;
+                    raw_reader.read_raw_block(raw_block, eof);
+                    if (eof)
+                        break;
+
+                    EXPECT_EQ(raw_block.get_block_parameters_index(), 0);
+                    raw_block.preamble.block_parameters_index = index;
+                    EXPECT_GT(raw_exporter.write_raw_block(raw_block), raw_block.data.size());
+                    raw_blocks.push_back(raw_block);
+
+                    decoded_reader.read_block_into(block, eof);
+                    ASSERT_FALSE(eof);
+                    EXPECT_EQ(block.m_block_preamble.earliest_time.m_secs, raw_block.preamble.earliest_time.m_secs);
+                    EXPECT_EQ(block.m_block_preamble.earliest_time.m_ticks, raw_block.preamble.earliest_time.m_ticks);
+                    block.m_block_preamble.block_parameters_index = index;
+                    decoded_exporter.write_block(block);
+                }
+
+                decoded_reader.read_block_into(block, eof);
+                EXPECT_TRUE(eof);
+                EXPECT_EQ(raw_reader.get_stats().block_bytes, decoded_reader.get_stats().block_bytes);
+                EXPECT_EQ(raw_reader.get_stats().bytes_consumed, decoded_reader.get_stats().bytes_consumed);
+                index++;
+            }
+
+            EXPECT_EQ(raw_exporter.get_stats().blocks_written, 5);
+            EXPECT_EQ(raw_exporter.get_stats().uncompressed_bytes,
+                      decoded_exporter.get_stats().uncompressed_bytes);
+        }
+
+        // Copied Blocks keep their encoded data and contain the same items as re-encoded Blocks
+        std::istringstream raw_input(raw_buffer.release());
+        std::istringstream decoded_input(decoded_buffer.release());
+        CdnsReader raw_reader(raw_input);
+        CdnsReader decoded_reader(decoded_input);
+        EXPECT_EQ(raw_reader.m_file_preamble.block_parameters_size(), 2);
+
+        CdnsBlockRead raw_block;
+        CdnsBlockRead decoded_block;
+        bool eof = false;
+        std::size_t blocks = 0;
+        std::size_t items = 0;
+        while (true) {
+            raw_reader.read_block_into(raw_block, eof);
+            decoded_reader.read_block_into(decoded_block, eof);
+            if (eof)
+                break;
+
+            ASSERT_LT(blocks, raw_blocks.size());
+            EXPECT_EQ(raw_block.get_block_parameters_index(), blocks < 3 ? 0 : 1);
+            EXPECT_EQ(raw_block.get_qr_count(), decoded_block.get_qr_count());
+            EXPECT_EQ(raw_block.get_aec_count(), decoded_block.get_aec_count());
+            EXPECT_EQ(raw_block.get_mm_count(), decoded_block.get_mm_count());
+
+            std::vector<Timestamp> raw_ts;
+            std::vector<Timestamp> decoded_ts;
+            raw_block.for_each_qr([&raw_ts](const QueryResponseView& qr) { raw_ts.push_back(*qr.ts()); });
+            decoded_block.for_each_qr([&decoded_ts](const QueryResponseView& qr) { decoded_ts.push_back(*qr.ts()); });
+            ASSERT_EQ(raw_ts.size(), decoded_ts.size());
+            for (std::size_t i = 0; i < raw_ts.size(); i++) {
+                EXPECT_EQ(raw_ts[i].m_secs, decoded_ts[i].m_secs);
+                EXPECT_EQ(raw_ts[i].m_ticks, decoded_ts[i].m_ticks);
+            }
+
+            items += raw_block.get_item_count();
+            blocks++;
+        }
+        EXPECT_EQ(blocks, 5);
+        EXPECT_EQ(items, 4000);
+
+        // Reading the output raw again gives the original encoded data
+        std::istringstream input(raw_input.str());
+        CdnsReader reader(input);
+        RawBlock copy;
+        for (auto& original : raw_blocks) {
+            reader.read_raw_block(copy, eof);
+            ASSERT_FALSE(eof);
+            EXPECT_EQ(copy.fields, original.fields);
+            EXPECT_TRUE(copy.data == original.data);
+            EXPECT_TRUE(copy.preamble.block_parameters_index == original.preamble.block_parameters_index);
+        }
+        reader.read_raw_block(copy, eof);
+        EXPECT_TRUE(eof);
+    }
+
+    TEST(RawBlockTest, RBInvalidIndexTest) {
+        GeneratorConfig config;
+        std::string data = generate_to_memory(config, 10);
+
+        FilePreamble fp;
+        MemoryOutput buffer;
+        {
+            std::istringstream input(data);
+            CdnsReader reader(input);
+            RawBlock raw_block;
+            bool eof = false;
+            reader.read_raw_block(raw_block, eof);
+            ASSERT_FALSE(eof);
+
+            raw_block.preamble.block_parameters_index = 5;
+            CdnsExporter exporter(fp, buffer, CborOutputCompression::NO_COMPRESSION);
+            exporter.write_raw_block(raw_block);
+        }
+
+        std::istringstream input(buffer.release());
+        CdnsReader reader(input);
+        RawBlock raw_block;
+        bool eof = false;
+        EXPECT_THROW(reader.read_raw_block(raw_block, eof), CdnsDecoderException);
+    }
+
+    TEST(RawBlockTest, RBSummaryTest) {
+        GeneratorConfig config;
+        TrafficGenerator generator(config);
+        FilePreamble fp;
+        fp.m_block_parameters[0].storage_parameters.max_block_items = 1000;
+        MemoryOutput buffer;
+        {
+            CdnsExporter exporter(fp, buffer, CborOutputCompression::NO_COMPRESSION);
+            exporter.set_block_summary(true);
+            generator.generate(exporter, 3500);
+            exporter.write_block();
+        }
+        std::string data = buffer.release();
+
+        // Raw Blocks with summary decode to the same Blocks as Blocks read directly
+        std::istringstream raw_input(data);
+        std::istringstream decoded_input(data);
+        CdnsReader raw_reader(raw_input);
+        CdnsReader decoded_reader(decoded_input);
+        RawBlock raw;
+        CdnsBlockRead raw_block;
+        CdnsBlockRead decoded_block;
+        bool eof = false;
+        std::size_t blocks = 0;
+        while (true) {
+            raw_reader.read_raw_block(raw, eof);
+            decoded_reader.read_block_into(decoded_block, eof);
+            if (eof)
+                break;
+
+            ASSERT_TRUE(raw.summary);
+            EXPECT_TRUE(raw.summary->body_size);
+            EXPECT_EQ(raw.summary->qr_count, decoded_block.get_qr_count());
+            raw_block.read(raw, raw_reader.m_file_preamble.m_block_parameters);
+            EXPECT_EQ(raw_block.get_item_count(), decoded_block.get_item_count());
+            EXPECT_EQ(raw_block.get_summary().latest_time.m_secs, decoded_block.get_summary().latest_time.m_secs);
+            EXPECT_EQ(raw_block.get_summary().latest_time.m_ticks, decoded_block.get_summary().latest_time.m_ticks);
+            blocks++;
+        }
+        EXPECT_EQ(blocks, 4);
+        EXPECT_EQ(raw_reader.get_stats().bytes_consumed, decoded_reader.get_stats().bytes_consumed);
+
+        // Rejected Blocks are skipped and their data aren't kept
+        std::istringstream input(data);
+        CdnsReader reader(input);
+        auto filter = [](const BlockPreamble&, const BlockSummary& summary) { return summary.qr_count < 900; };
+        std::size_t copied = 0;
+        while (true) {
+            bool read = reader.read_raw_block(raw, eof, filter);
+            if (eof)
+                break;
+
+            if (read) {
+                EXPECT_LT(raw.summary->qr_count, 900);
+                EXPECT_FALSE(raw.data.empty());
+                copied++;
+            }
+            else {
+                EXPECT_TRUE(raw.data.empty());
+            }
+        }
+        EXPECT_EQ(copied, 1);
+        EXPECT_EQ(reader.get_stats().blocks_skipped, 3);
+
+        // Blocks without summary are always read
+        std::string plain = generate_to_memory(config, 1500);
+        std::istringstream plain_input(plain);
+        CdnsReader plain_reader(plain_input);
+        auto reject = [](const BlockPreamble&, const BlockSummary&) { return false; };
+        EXPECT_TRUE(plain_reader.read_raw_block(raw, eof, reject));
+        EXPECT_FALSE(raw.summary);
+        EXPECT_FALSE(raw.data.empty());
+    }
+}
@@ -0,0 +1,78 @@
+#!/usr/bin/env python3
+
+import os
+import unittest
+
+import pycdns
+import common
+
+class TestAggregate(unittest.TestCase):
+
+    def test_space_saving(self):
+        summary = pycdns.SpaceSaving(2)
+        summary.add("a", 5)
+        summary.add("b", 3)
+        summary.add("c")
+        self.assertEqual(summary.size(), 2)
+        self.assertEqual(summary.total(), 9)
+        top = summary.top(2)
+        self.assertEqual(top[0].key, "a")
+        self.assertEqual(top[0].count, 5)
+        self.assertEqual(top[1].key, "c")
+        self.assertEqual(top[1].count, 4)
+        self.assertEqual(top[1].error, 3)
+        self.assertRaises(ValueError, pycdns.SpaceSaving, 0)
+
+    def test_hyperloglog(self):
+        estimate = pycdns.HyperLogLog()
+        for i in range(0, 1000):
+            estimate.add(i * 0x9e3779b97f4a7c15 % 2**64)
+        self.assertAlmostEqual(estimate.estimate(), 1000, delta=50)
+        self.assertRaises(ValueError, estimate.merge, pycdns.HyperLogLog(10))
+
+    def test_traffic_aggregate(self):
+        fp = pycdns.FilePreamble()
+        exporter = pycdns.CdnsExporter(fp, common.file, pycdns.CborOutputCompression.NO_COMPRESSION)
+        gqr = pycdns.GenericQueryResponse()
+
+        for i in range(0, 2):
+            for j in range(0, 5):
+                gqr.ts = pycdns.Timestamp(100 + i * 10 + j, 0)
+                gqr.query_name = pycdns.name_to_wire("name" + str(j % 2) + ".example")
+                gqr.response_rcode = j % 2
+                exporter.buffer_qr(gqr)
+            exporter.write_block()
+        del exporter
+
+        total = pycdns.TrafficAggregate(10)
+        ifs = pycdns.Ifstream(common.file)
+        reader = pycdns.CdnsReader(ifs)
+        while True:
+            block, eof = reader.read_block()
+            if eof:
+                break
+            aggregate = pycdns.TrafficAggregate(10)
+            aggregate.add_block(block)
+            total.merge(aggregate)
+
+        self.assertEqual(total.qr_count, 10)
+        self.assertEqual(total.time_series, {100: 5, 110: 5})
+        self.assertEqual(total.rcodes, {0: 6, 1: 4})
+        self.assertEqual(total.qnames.top(1)[0].key, pycdns.name_to_wire("name0.example"))
+        self.assertEqual(total.qnames.top(1)[0].count, 6)
+        self.assertRaises(ValueError, total.merge, pycdns.TrafficAggregate(60))
+        del reader
+        del ifs
+
+        workers = pycdns.TrafficAggregate(10)
+        ifs = pycdns.Ifstream(common.file)
+        reader = pycdns.CdnsReader(ifs)
+        self.assertEqual(workers.add_blocks(reader, 2), 2)
+        self.assertEqual(workers.string(10), total.string(10))
+
+        del reader
+        del ifs
+        os.remove(common.file)
+
+if __name__ == '__main__':
+    unittest.main()
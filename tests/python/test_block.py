@@ -481,6 +481,29 @@ class TestBlock(unittest.TestCase):
         self.assertFalse(gqr.asn)
         self.assertFalse(gqr.round_trip_time)
 
+    def test_block_qr_view(self):
+        block = pycdns.CdnsBlockRead()
+        qr = pycdns.QueryResponse()
+        qr.client_port = 1234
+        qr.client_address_index = block.add_ip_address("8.8.8.8")
+        qr.query_name_index = block.add_name_rdata("example.com")
+        block.add_question_response_record(qr)
+        qr.client_port = 4321
+        block.add_question_response_record(qr)
+
+        view = block.qr_view(0)
+        self.assertEqual(view.client_port(), 1234)
+        self.assertEqual(view.client_ip(), "8.8.8.8")
+        self.assertEqual(view.query_name(), "example.com")
+        self.assertIsNone(view.server_ip())
+        self.assertIsNone(view.response_rcode())
+        self.assertEqual(view.to_generic().client_port, 1234)
+
+        ports = []
+        self.assertEqual(block.for_each_qr(lambda qrv: ports.append(qrv.client_port())), 2)
+        self.assertEqual(ports, [1234, 4321])
+        self.assertEqual(block.for_each_qr(lambda qrv: False), 1)
+
     def test_block_read_generic_aec(self):
         block = pycdns.CdnsBlock()
         aec = pycdns.AddressEventCount()
@@ -1,6 +1,7 @@
 #!/usr/bin/env python3
 
 import os
+import gzip
 import unittest
 
 import pycdns
@@ -156,3 +157,112 @@ class TestCdnsExporter(unittest.TestCase):
         del exporter
 
         common.test_size_and_remove_file(self, common.file2, written + 1)
+
+    def test_ce_memory_output(self):
+        fp = pycdns.FilePreamble()
+        buffer = pycdns.MemoryOutput()
+        exporter = pycdns.CdnsExporter(fp, buffer, pycdns.CborOutputCompression.GZIP)
+        gqr = pycdns.GenericQueryResponse()
+        gqr.ts = pycdns.Timestamp(12, 12543)
+        gqr.client_port = 1234
+
+        exporter.buffer_qr(gqr)
+        written = exporter.write_block()
+        del exporter
+
+        size = buffer.size()
+        released = buffer.release()
+        self.assertIsInstance(released, memoryview)
+        self.assertEqual(released.nbytes, size)
+        data = gzip.decompress(released)
+        self.assertEqual(len(data), written + 1)
+        self.assertEqual(buffer.size(), 0)
+
+    def test_ce_max_block_size_age(self):
+        fp = pycdns.FilePreamble()
+        buffer = pycdns.MemoryOutput()
+        exporter = pycdns.CdnsExporter(fp, buffer, pycdns.CborOutputCompression.NO_COMPRESSION)
+        gqr = pycdns.GenericQueryResponse()
+        exporter.set_max_block_size(1000)
+
+        for i in range(0, 100):
+            gqr.ts = pycdns.Timestamp(12, i)
+            gqr.query_name = "name" + str(i) + ".example.com"
+            exporter.buffer_qr(gqr)
+        self.assertGreater(exporter.get_blocks_written_count(), 1)
+
+        exporter.set_max_block_size(0)
+        exporter.set_max_block_age(1000)
+        exporter.write_block()
+        gqr.ts = pycdns.Timestamp(20, 0)
+        exporter.buffer_qr(gqr)
+        self.assertEqual(exporter.write_block_if_expired(pycdns.Timestamp(20, 999)), 0)
+        self.assertGreater(exporter.write_block_if_expired(pycdns.Timestamp(20, 1000)), 0)
+        self.assertEqual(exporter.get_block_item_count(), 0)
+        del exporter
+
+    def test_ce_swap_block(self):
+        fp = pycdns.FilePreamble()
+        buffer = pycdns.MemoryOutput()
+        exporter = pycdns.CdnsExporter(fp, buffer, pycdns.CborOutputCompression.NO_COMPRESSION)
+        gqr = pycdns.GenericQueryResponse()
+        gqr.ts = pycdns.Timestamp(12, 12543)
+        gqr.client_port = 1234
+        exporter.buffer_qr(gqr)
+
+        block = exporter.swap_block()
+        self.assertEqual(block.get_qr_count(), 1)
+        self.assertEqual(exporter.get_block_item_count(), 0)
+        self.assertGreater(exporter.write_block(block), 0)
+        exporter.recycle_block(block)
+        self.assertEqual(block.get_item_count(), 0)
+        self.assertEqual(exporter.get_blocks_written_count(), 1)
+        del exporter
+
+    def test_ce_stats(self):
+        fp = pycdns.FilePreamble()
+        buffer = pycdns.MemoryOutput()
+        exporter = pycdns.CdnsExporter(fp, buffer, pycdns.CborOutputCompression.NO_COMPRESSION)
+        gqr = pycdns.GenericQueryResponse()
+
+        for i in range(0, 10):
+            gqr.ts = pycdns.Timestamp(12, i)
+            gqr.query_name = "name" + str(i % 2) + ".example.com"
+            exporter.buffer_qr(gqr)
+        exporter.buffer_qr(pycdns.GenericQueryResponse())
+        written = exporter.write_block()
+
+        stats = exporter.get_stats()
+        self.assertEqual(stats.blocks_written, 1)
+        self.assertEqual(stats.qr_count, 10)
+        self.assertEqual(stats.dropped_qrs, 1)
+        self.assertEqual(stats.uncompressed_bytes, written)
+        self.assertEqual(stats.tables.name_rdata.items, 2)
+        self.assertEqual(stats.tables.name_rdata.hits, 8)
+        self.assertAlmostEqual(stats.tables.name_rdata.hit_ratio(), 0.8)
+        self.assertEqual(stats.last_block.qr_count, 10)
+
+        exporter.reset_stats()
+        self.assertEqual(exporter.get_stats().blocks_written, 0)
+        del exporter
+
+    def test_ce_string_interning(self):
+        outputs = []
+        for capacity in [0, 1024, 2]:
+            fp = pycdns.FilePreamble()
+            buffer = pycdns.MemoryOutput()
+            exporter = pycdns.CdnsExporter(fp, buffer, pycdns.CborOutputCompression.NO_COMPRESSION)
+            exporter.set_string_interning(capacity)
+            gqr = pycdns.GenericQueryResponse()
+
+            for i in range(0, 20):
+                gqr.ts = pycdns.Timestamp(12, i)
+                gqr.query_name = "name" + str(i % 5) + ".example.com"
+                exporter.buffer_qr(gqr)
+                if i % 10 == 9:
+                    exporter.write_block()
+            del exporter
+            outputs.append(buffer.release())
+
+        self.assertEqual(outputs[0], outputs[1])
+        self.assertEqual(outputs[0], outputs[2])
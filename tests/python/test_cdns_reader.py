@@ -175,6 +175,30 @@ class TestCdnsReader(unittest.TestCase):
         del ifs
         os.remove(common.file)
 
+    def test_cr_read_block_into(self):
+        self.create_test_file()
+        ifs = pycdns.Ifstream(common.file)
+        reader = pycdns.CdnsReader(ifs)
+
+        block = pycdns.CdnsBlockRead()
+        eof = reader.read_block_into(block)
+        self.assertFalse(eof)
+        self.assertEqual(block.get_qr_count(), 2)
+
+        eof = reader.read_block_into(block)
+        self.assertFalse(eof)
+        self.assertEqual(block.get_qr_count(), 1)
+        gqr, eof = block.read_generic_qr()
+        self.assertFalse(eof)
+        self.assertEqual(gqr.asn, "5678")
+
+        eof = reader.read_block_into(block)
+        self.assertTrue(eof)
+        self.assertEqual(block.get_item_count(), 0)
+
+        del ifs
+        os.remove(common.file)
+
     def test_cr_read_huge_timestamp_offset(self):
         fp = pycdns.FilePreamble()
         exporter = pycdns.CdnsExporter(fp, common.file, pycdns.CborOutputCompression.NO_COMPRESSION)
@@ -220,3 +244,148 @@ class TestCdnsReader(unittest.TestCase):
 
         del ifs
         os.remove(common.file)
+
+    def test_cr_stats(self):
+        self.create_test_file()
+        ifs = pycdns.Ifstream(common.file)
+        reader = pycdns.CdnsReader(ifs)
+        reader.set_timing(True)
+
+        block = pycdns.CdnsBlockRead()
+        eof = False
+        while not eof:
+            eof = reader.read_block_into(block)
+
+        stats = reader.get_stats()
+        self.assertEqual(stats.blocks_read, 2)
+        self.assertEqual(stats.qr_count, 3)
+        self.assertEqual(stats.bytes_consumed, os.path.getsize(common.file))
+        self.assertGreater(stats.bytes_per_block(), 0)
+        self.assertGreater(stats.decoder.buffer_refills, 0)
+        self.assertGreater(stats.read_ns, 0)
+
+        del ifs
+        os.remove(common.file)
+
+    def test_cr_block_summary_filter(self):
+        fp = pycdns.FilePreamble()
+        exporter = pycdns.CdnsExporter(fp, common.file, pycdns.CborOutputCompression.NO_COMPRESSION)
+        exporter.set_block_summary(True)
+        gqr = pycdns.GenericQueryResponse()
+
+        for i in range(0, 3):
+            gqr.ts = pycdns.Timestamp(100 + i * 10, 0)
+            gqr.response_rcode = 3 if i == 1 else 0
+            exporter.buffer_qr(gqr)
+            exporter.write_block()
+        del exporter
+
+        ifs = pycdns.Ifstream(common.file)
+        reader = pycdns.CdnsReader(ifs)
+        block = pycdns.CdnsBlockRead()
+        decoded = []
+        while True:
+            ret, eof = reader.read_block_into(block, lambda bp, bs: bs.has_rcode(3))
+            if eof:
+                break
+            self.assertEqual(block.m_block_summary.qr_count, 1)
+            if ret:
+                decoded.append(block.m_block_preamble.earliest_time.m_secs)
+
+        self.assertEqual(decoded, [110])
+        self.assertEqual(reader.get_stats().blocks_skipped, 2)
+
+        del ifs
+        os.remove(common.file)
+
+    def test_cr_block_lookup(self):
+        fp = pycdns.FilePreamble()
+        exporter = pycdns.CdnsExporter(fp, common.file, pycdns.CborOutputCompression.NO_COMPRESSION)
+        exporter.set_block_filter(pycdns.BloomFilter.DEFAULT_BITS_PER_ITEM)
+        gqr = pycdns.GenericQueryResponse()
+
+        for i in range(0, 3):
+            gqr.ts = pycdns.Timestamp(100 + i * 10, 0)
+            gqr.query_name = "name" + str(i) + ".example.com"
+            exporter.buffer_qr(gqr)
+            exporter.write_block()
+        del exporter
+
+        lookup = pycdns.BlockLookup()
+        lookup.add_name("NAME2.example.com")
+        ifs = pycdns.Ifstream(common.file)
+        reader = pycdns.CdnsReader(ifs)
+        block = pycdns.CdnsBlockRead()
+        decoded = []
+        while True:
+            eof = reader.read_block_matching(block, lookup)
+            if eof:
+                break
+            decoded.append(block.m_block_preamble.earliest_time.m_secs)
+
+        self.assertEqual(decoded, [120])
+        self.assertEqual(reader.get_stats().blocks_skipped, 2)
+
+        del ifs
+        os.remove(common.file)
+
+    def test_cr_prefetch(self):
+        self.create_test_file()
+        ifs = pycdns.Ifstream(common.file)
+        reader = pycdns.CdnsReader(ifs)
+
+        qrs = 0
+        blocks = 0
+        for block in reader.blocks(prefetch=1):
+            blocks += 1
+            qrs += block.get_qr_count()
+
+        self.assertEqual(blocks, 2)
+        self.assertEqual(qrs, 3)
+        self.assertEqual(reader.get_stats().blocks_read, 2)
+
+        del reader
+        del ifs
+        os.remove(common.file)
+
+    def test_cr_prefetch_reuse(self):
+        self.create_test_file()
+        ifs = pycdns.Ifstream(common.file)
+        reader = pycdns.CdnsReader(ifs)
+
+        # The iterator refills the same Block object by default
+        blocks = reader.blocks(prefetch=1)
+        first = next(blocks)
+        second = next(blocks)
+        self.assertIs(first, second)
+        self.assertRaises(StopIteration, next, blocks)
+        del blocks
+        del reader
+        del ifs
+
+        ifs = pycdns.Ifstream(common.file)
+        reader = pycdns.CdnsReader(ifs)
+        kept = list(reader.blocks(prefetch=1, reuse=False))
+        self.assertEqual(len(kept), 2)
+        self.assertIsNot(kept[0], kept[1])
+        self.assertEqual(sum(block.get_qr_count() for block in kept), 3)
+
+        del reader
+        del ifs
+        os.remove(common.file)
+
+    def test_cr_prefetch_next(self):
+        self.create_test_file()
+        ifs = pycdns.Ifstream(common.file)
+        reader = pycdns.CdnsReader(ifs)
+        prefetcher = pycdns.CdnsBlockPrefetcher(reader)
+        block = pycdns.CdnsBlockRead()
+
+        self.assertFalse(prefetcher.next(block))
+        self.assertFalse(prefetcher.next(block))
+        self.assertTrue(prefetcher.next(block))
+
+        del prefetcher
+        del reader
+        del ifs
+        os.remove(common.file)
@@ -0,0 +1,82 @@
+#!/usr/bin/env python3
+
+import unittest
+
+import pycdns
+
+try:
+    import numpy
+except ImportError:
+    numpy = None
+
+try:
+    import pyarrow
+except ImportError:
+    pyarrow = None
+
+class TestQueryResponseColumns(unittest.TestCase):
+
+    def generate(self, count):
+        fp = pycdns.FilePreamble()
+        buffer = pycdns.MemoryOutput()
+        exporter = pycdns.CdnsExporter(fp, buffer, pycdns.CborOutputCompression.NO_COMPRESSION)
+        generator = pycdns.TrafficGenerator()
+        generator.generate(exporter, count)
+        exporter.write_block()
+        del exporter
+        return bytes(buffer.release())
+
+    def test_qrc_block(self):
+        iss = pycdns.Istringstream(self.generate(1000))
+        reader = pycdns.CdnsReader(iss)
+        block, eof = reader.read_block()
+        self.assertFalse(eof)
+
+        columns = block.read_qr_columns()
+        self.assertEqual(len(columns), block.get_qr_count())
+        self.assertEqual(columns.ticks_per_second, 1000000)
+
+        gqr, end = block.read_generic_qr()
+        self.assertFalse(end)
+        self.assertEqual(columns.timestamp[0], gqr.ts.m_secs * 1000000 + gqr.ts.m_ticks)
+        self.assertEqual(columns.client_port[0], gqr.client_port)
+        self.assertEqual(columns.name_rdata[columns.qname[0]], gqr.query_name.encode())
+        self.assertEqual(len(columns.ip_address), len(columns.ip_address.to_list()))
+
+        with self.assertRaises(IndexError):
+            columns.timestamp[len(columns)]
+
+        block.read_qr_columns(columns, True)
+        self.assertEqual(len(columns), 2 * block.get_qr_count())
+
+    def test_qrc_reader(self):
+        iss = pycdns.Istringstream(self.generate(1000))
+        reader = pycdns.CdnsReader(iss)
+        columns = reader.read_qr_columns()
+        self.assertEqual(len(columns), reader.get_stats().qr_count)
+
+    @unittest.skipIf(numpy is None, "NumPy not available")
+    def test_qrc_numpy(self):
+        iss = pycdns.Istringstream(self.generate(1000))
+        columns = pycdns.CdnsReader(iss).read_qr_columns()
+        arrays = columns.to_numpy()
+
+        self.assertEqual(arrays["timestamp"].dtype, numpy.int64)
+        self.assertEqual(len(arrays["qname"]), len(columns))
+        self.assertEqual(arrays["client_port"][0], columns.client_port[0])
+        self.assertTrue(numpy.array_equal(numpy.asarray(columns.qtype), arrays["qtype"]))
+        if columns.rcode.null_count() > 0:
+            self.assertEqual(numpy.count_nonzero(~arrays["rcode_valid"]), columns.rcode.null_count())
+
+    @unittest.skipIf(pyarrow is None, "pyarrow not available")
+    def test_qrc_arrow(self):
+        iss = pycdns.Istringstream(self.generate(1000))
+        columns = pycdns.CdnsReader(iss).read_qr_columns()
+        batch = columns.to_arrow()
+
+        self.assertEqual(batch.num_rows, len(columns))
+        self.assertEqual(batch.column(batch.schema.get_field_index("rcode")).null_count,
+                         columns.rcode.null_count())
+        qname = batch.column(batch.schema.get_field_index("qname"))
+        self.assertEqual(qname.type.value_type, pyarrow.large_binary())
+        self.assertEqual(qname[0].as_py(), columns.name_rdata[columns.qname[0]])
@@ -0,0 +1,40 @@
+#!/usr/bin/env python3
+
+import unittest
+
+import pycdns
+
+class TestTrafficGenerator(unittest.TestCase):
+
+    def test_tg_ctest(self):
+        config = pycdns.GeneratorConfig()
+        config.qnames = 0
+
+        with self.assertRaises(ValueError):
+            pycdns.TrafficGenerator(config)
+
+    def test_tg_determinism(self):
+        config = pycdns.GeneratorConfig()
+        config.seed = 1234
+        first = pycdns.TrafficGenerator(config).generate_qrs(100)
+        second = pycdns.TrafficGenerator(config).generate_qrs(100)
+
+        self.assertEqual(len(first), 100)
+        for a, b in zip(first, second):
+            self.assertEqual(a.ts.m_secs, b.ts.m_secs)
+            self.assertEqual(a.ts.m_ticks, b.ts.m_ticks)
+            self.assertEqual(a.query_name, b.query_name)
+            self.assertEqual(a.client_ip, b.client_ip)
+
+    def test_tg_generate(self):
+        fp = pycdns.FilePreamble()
+        buffer = pycdns.MemoryOutput()
+        exporter = pycdns.CdnsExporter(fp, buffer, pycdns.CborOutputCompression.NO_COMPRESSION)
+        generator = pycdns.TrafficGenerator()
+
+        generator.generate(exporter, 1000)
+        self.assertGreater(exporter.get_block_item_count(), 900)
+        exporter.write_block()
+        del exporter
+
+        self.assertGreater(buffer.size(), 0)
@@ -0,0 +1,62 @@
+#!/usr/bin/env python3
+
+import os
+import unittest
+
+import pycdns
+import common
+
+class TestSearch(unittest.TestCase):
+
+    def test_name(self):
+        wire = pycdns.name_to_wire("www.example.com")
+        self.assertEqual(wire, "\x03www\x07example\x03com\x00")
+        self.assertEqual(pycdns.wire_to_name(wire), "www.example.com.")
+        self.assertRaises(ValueError, pycdns.name_to_wire, "www..com")
+        self.assertEqual(pycdns.address_to_string("\x0a\x00\x00\x01"), "10.0.0.1")
+
+    def test_address_prefix(self):
+        prefix = pycdns.AddressPrefix.parse("10.0.0.0/8")
+        self.assertEqual(prefix.length, 8)
+        self.assertFalse(prefix.is_address())
+        self.assertTrue(prefix.matches("\x0a\x01\x02\x03"))
+        self.assertFalse(prefix.matches("\x0b\x01\x02\x03"))
+        self.assertRaises(ValueError, pycdns.AddressPrefix.parse, "10.0.0.0/33")
+
+    def test_search(self):
+        fp = pycdns.FilePreamble()
+        exporter = pycdns.CdnsExporter(fp, common.file, pycdns.CborOutputCompression.NO_COMPRESSION)
+        exporter.set_block_filter(pycdns.BloomFilter.DEFAULT_BITS_PER_ITEM)
+        gqr = pycdns.GenericQueryResponse()
+
+        for i in range(0, 3):
+            for j in range(0, 5):
+                gqr.ts = pycdns.Timestamp(100 + i * 10 + j, 0)
+                gqr.query_name = pycdns.name_to_wire("name" + str(j) + ".zone" + str(i) + ".example")
+                gqr.response_rcode = j % 2
+                exporter.buffer_qr(gqr)
+            exporter.write_block()
+        del exporter
+
+        search = pycdns.QueryResponseSearch()
+        search.add_qname_suffix(pycdns.name_to_wire("ZONE1.example"))
+        search.add_rcode(1)
+        ifs = pycdns.Ifstream(common.file)
+        reader = pycdns.CdnsReader(ifs)
+        bp = reader.m_file_preamble.get_block_parameters(0)
+        block = pycdns.CdnsBlockRead()
+        found = []
+        while True:
+            decoded, eof = reader.read_block_into(block, lambda preamble, summary: search.may_match(bp, preamble, summary))
+            if eof:
+                break
+            if decoded:
+                found += [block.qr_view(pos).to_generic().ts.m_secs for pos in search.search(block)]
+
+        self.assertEqual(found, [111, 113])
+
+        del ifs
+        os.remove(common.file)
+
+if __name__ == '__main__':
+    unittest.main()
@@ -0,0 +1,233 @@
+/**
+ * Copyright © 2026 CZ.NIC, z. s. p. o.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, you can obtain one at https://mozilla.org/MPL/2.0/.
+ */
+
+#pragma once
+
+#include <string>
+#include <sstream>
+#include <stdexcept>
+#include <gtest/gtest.h>
+
+#include "../src/cdns.h"
+#include "../src/search.h"
+
+namespace CDNS {
+    /**
+     * @brief Write 40 Query/Response items (4 Blocks) with Block summary for search tests
+     *
+     * Item i has QNAME "hostI.zoneZ.example." (Z = i % 4), client 10.0.0.i (or 2001:db8::i for odd i),
+     * server 192.0.2.(i % 2), QTYPE 1 or 28 (for every 3rd item), RCODE 3 for every 5th item, otherwise 0
+     * and timestamp 100 + i seconds.
+     */
+    std::string write_search_data() {
+        FilePreamble fp;
+        fp.m_block_parameters[0].storage_parameters.max_block_items = 10;
+        MemoryOutput buffer;
+        {
+            CdnsExporter exporter(fp, buffer, CborOutputCompression::NO_COMPRESSION);
+            exporter.set_block_filter(BloomFilter::DEFAULT_BITS_PER_ITEM);
+            for (int i = 0; i < 40; i++) {
+                GenericQueryResponse gqr;
+                gqr.ts = Timestamp(100 + i, 0);
+                gqr.query_name = name_to_wire("host" + std::to_string(i) + ".zone" + std::to_string(i % 4) + ".example");
+                if (i % 2)
+                    gqr.client_ip = std::string("\x20\x01\x0d\xb8", 4) + std::string(11, '\0') + static_cast<char>(i);
+                else
+                    gqr.client_ip = std::string("\x0a\x00\x00", 3) + static_cast<char>(i);
+                gqr.server_ip = std::string("\xc0\x00\x02", 3) + static_cast<char>(i % 2);
+                ClassType ct;
+                ct.type = i % 3 ? 1 : 28;
+                ct.class_ = 1;
+                gqr.query_classtype = ct;
+                gqr.response_rcode = i % 5 ? 0 : 3;
+                exporter.buffer_qr(gqr);
+            }
+            exporter.write_block();
+        }
+
+        return buffer.release();
+    }
+
+    /**
+     * @brief Search all Blocks of C-DNS data and return seconds of timestamps of the matching items
+     */
+    std::vector<uint64_t> search_data(const std::string& data, const QueryResponseSearch& search,
+                                      uint64_t& decoded) {
+        std::istringstream input(data);
+        CdnsReader reader(input);
+        auto filter = search.filter(reader.m_file_preamble.m_block_parameters);
+        CdnsBlockRead block;
+        bool eof = false;
+        std::vector<uint64_t> ret;
+
+        while (true) {
+            reader.read_block_into(block, eof, filter);
+            if (eof)
+                break;
+
+            std::vector<std::size_t> positions;
+            std::size_t found = search.search(block, positions);
+            EXPECT_EQ(found, positions.size());
+            for (auto pos : positions)
+                ret.push_back(block.qr_view(pos).ts()->m_secs);
+        }
+
+        decoded = reader.get_stats().blocks_read;
+        return ret;
+    }
+
+    TEST(SearchTest, STNameTest) {
+        EXPECT_EQ(name_to_wire("www.example.com"), std::string("\x03www\x07" "example\x03" "com\x00", 17));
+        EXPECT_EQ(name_to_wire("www.example.com."), name_to_wire("www.example.com"));
+        EXPECT_EQ(name_to_wire("."), std::string("\x00", 1));
+        EXPECT_THROW(name_to_wire("www..com"), std::invalid_argument);
+        EXPECT_THROW(name_to_wire(std::string(64, 'a') + ".com"), std::invalid_argument);
+
+        EXPECT_EQ(wire_to_name(name_to_wire("www.Example.com")), "www.Example.com.");
+        EXPECT_EQ(wire_to_name(name_to_wire(".")), ".");
+        EXPECT_EQ(wire_to_name(std::string("\x03www\x10" "exa", 8)), "www.");
+    }
+
+    TEST(SearchTest, STAddressPrefixTest) {
+        AddressPrefix p4 = AddressPrefix::parse("192.0.2.0/23");
+        EXPECT_EQ(p4.address, std::string("\xc0\x00\x02\x00", 4));
+        EXPECT_EQ(p4.length, 23);
+        EXPECT_FALSE(p4.is_address());
+        EXPECT_TRUE(p4.matches(std::string("\xc0\x00\x03\x01", 4)));
+        EXPECT_FALSE(p4.matches(std::string("\xc0\x00\x04\x01", 4)));
+        EXPECT_FALSE(p4.matches(std::string("\xc0\x00\x02\x00", 4) + std::string(12, '\0')));
+
+        // Addresses shortened by address prefix length are compared on their bits only
+        EXPECT_TRUE(p4.matches(std::string("\xc0\x00", 2)));
+        EXPECT_TRUE(AddressPrefix::parse("192.0.2.1").matches(std::string("\xc0\x00\x02", 3)));
+
+        AddressPrefix p6 = AddressPrefix::parse("2001:db8::1");
+        EXPECT_EQ(p6.length, 128);
+        EXPECT_TRUE(p6.is_address());
+        EXPECT_TRUE(p6.matches(p6.address));
+        EXPECT_FALSE(p6.matches(std::string("\x20\x01\x0d\xb8", 4)));
+        EXPECT_TRUE(AddressPrefix::parse("2001:db8::/32").matches(std::string("\x20\x01\x0d\xb8", 4) + std::string(12, '\x01')));
+        EXPECT_TRUE(AddressPrefix::parse("::/0").matches(p6.address));
+
+        EXPECT_THROW(AddressPrefix::parse("192.0.2.0/33"), std::invalid_argument);
+        EXPECT_THROW(AddressPrefix::parse("192.0.2.0/"), std::invalid_argument);
+        EXPECT_THROW(AddressPrefix::parse("example.com"), std::invalid_argument);
+    }
+
+    TEST(SearchTest, STSearchTest) {
+        std::string data = write_search_data();
+        uint64_t decoded = 0;
+
+        // Empty search matches all items
+        QueryResponseSearch all;
+        EXPECT_TRUE(all.empty());
+        EXPECT_EQ(search_data(data, all, decoded).size(), 40);
+        EXPECT_EQ(decoded, 4);
+
+        // QNAMEs are compared case-insensitively, the filter skips Blocks without them
+        QueryResponseSearch qname;
+        qname.add_qname(name_to_wire("HOST13.zone1.example"));
+        qname.add_qname(name_to_wire("host33.zone1.example"));
+        EXPECT_FALSE(qname.empty());
+        EXPECT_EQ(search_data(data, qname, decoded), std::vector<uint64_t>({113, 133}));
+        EXPECT_EQ(decoded, 2);
+
+        // Suffixes match on label boundaries only
+        QueryResponseSearch suffix;
+        suffix.add_qname_suffix(name_to_wire("zone2.example"));
+        EXPECT_EQ(search_data(data, suffix, decoded).size(), 10);
+        QueryResponseSearch partial;
+        partial.add_qname_suffix(name_to_wire("one2.example"));
+        EXPECT_TRUE(search_data(data, partial, decoded).empty());
+
+        QueryResponseSearch regex;
+        regex.set_qname_regex("^HOST1[0-9]\\.");
+        EXPECT_EQ(search_data(data, regex, decoded).size(), 10);
+        EXPECT_EQ(decoded, 4);
+
+        // Client prefixes are checked against the client address range in the summary
+        QueryResponseSearch client;
+        client.add_client(AddressPrefix::parse("10.0.0.0/27"));
+        EXPECT_EQ(search_data(data, client, decoded).size(), 16);
+        EXPECT_EQ(decoded, 4);
+        QueryResponseSearch client6;
+        client6.add_client(AddressPrefix::parse("2001:db8::5"));
+        EXPECT_EQ(search_data(data, client6, decoded), std::vector<uint64_t>({105}));
+        EXPECT_EQ(decoded, 1);
+
+        QueryResponseSearch server;
+        server.add_server(AddressPrefix::parse("192.0.2.1"));
+        EXPECT_EQ(search_data(data, server, decoded).size(), 20);
+
+        QueryResponseSearch qtype;
+        qtype.add_qtype(28);
+        EXPECT_EQ(search_data(data, qtype, decoded).size(), 14);
+
+        // RCODEs are in the summary
+        QueryResponseSearch rcode;
+        rcode.add_rcode(3);
+        EXPECT_EQ(search_data(data, rcode, decoded).size(), 8);
+        QueryResponseSearch rcode2;
+        rcode2.add_rcode(2);
+        EXPECT_TRUE(search_data(data, rcode2, decoded).empty());
+        EXPECT_EQ(decoded, 0);
+
+        QueryResponseSearch time;
+        time.set_time_range(115 * 1000000, 124 * 1000000);
+        EXPECT_EQ(search_data(data, time, decoded).size(), 10);
+        EXPECT_EQ(decoded, 2);
+
+        // All kinds of conditions have to match
+        QueryResponseSearch combined;
+        combined.add_qname_suffix(name_to_wire("example"));
+        combined.add_server(AddressPrefix::parse("192.0.2.0"));
+        combined.add_rcode(3);
+        combined.add_rcode(0);
+        combined.add_qtype(28);
+        combined.set_time_range(100 * 1000000, 119 * 1000000);
+        EXPECT_EQ(search_data(data, combined, decoded), std::vector<uint64_t>({100, 106, 112, 118}));
+        EXPECT_EQ(decoded, 2);
+    }
+
+    TEST(SearchTest, STMayMatchTest) {
+        BlockParameters bp;
+        BlockPreamble preamble;
+        preamble.earliest_time = Timestamp(100, 0);
+        BlockSummary summary;
+        summary.latest_time = Timestamp(110, 500000);
+        summary.qr_count = 10;
+        summary.min_client_address = std::string("\x0a\x00\x00\x01", 4);
+        summary.max_client_address = std::string("\x0a\x00\x00\x10", 4);
+        summary.rcode_counts[0] = 10;
+
+        QueryResponseSearch time;
+        time.set_time_range(110500000, 120000000);
+        EXPECT_TRUE(time.may_match(bp, preamble, summary));
+        time.set_time_range(110500001, 120000000);
+        EXPECT_FALSE(time.may_match(bp, preamble, summary));
+
+        QueryResponseSearch client;
+        client.add_client(AddressPrefix::parse("10.0.0.16/28"));
+        EXPECT_TRUE(client.may_match(bp, preamble, summary));
+        QueryResponseSearch client2;
+        client2.add_client(AddressPrefix::parse("10.0.0.32/28"));
+        EXPECT_FALSE(client2.may_match(bp, preamble, summary));
+
+        // Stored addresses shortened by Block parameters can't be compared with the range
+        bp.storage_parameters.client_address_prefix_ipv4 = 8;
+        EXPECT_TRUE(client2.may_match(bp, preamble, summary));
+
+        QueryResponseSearch rcode;
+        rcode.add_rcode(3);
+        EXPECT_FALSE(rcode.may_match(bp, preamble, summary));
+
+        // Only Query/Response items are searched
+        summary.qr_count = 0;
+        EXPECT_FALSE(QueryResponseSearch().may_match(bp, preamble, summary));
+    }
+}
@@ -0,0 +1,247 @@
+/**
+ * Copyright © 2026 CZ.NIC, z. s. p. o.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, you can obtain one at https://mozilla.org/MPL/2.0/.
+ */
+
+#pragma once
+
+#include <string>
+#include <sstream>
+#include <map>
+#include <stdexcept>
+#include <gtest/gtest.h>
+
+#include "../src/cdns.h"
+#include "../src/hash.h"
+#include "../src/sketch.h"
+#include "../src/aggregate.h"
+#include "generator_test.h"
+
+namespace CDNS {
+
+    TEST(SketchTest, SSExactTest) {
+        EXPECT_THROW(SpaceSaving(0), std::invalid_argument);
+
+        SpaceSaving summary(10);
+        for (int i = 0; i < 5; i++)
+            summary.add("key" + std::to_string(i), i + 1);
+        summary.add("key4");
+        summary.add("key0", 0);
+
+        EXPECT_EQ(summary.size(), 5);
+        EXPECT_EQ(summary.total(), 16);
+        EXPECT_EQ(summary.min_count(), 0);
+
+        auto top = summary.top(3);
+        ASSERT_EQ(top.size(), 3);
+        EXPECT_EQ(top[0].key, "key4");
+        EXPECT_EQ(top[0].count, 6);
+        EXPECT_EQ(top[0].error, 0);
+        EXPECT_EQ(top[1].key, "key3");
+        EXPECT_EQ(top[1].count, 4);
+        EXPECT_EQ(top[2].key, "key2");
+        EXPECT_EQ(summary.top(100).size(), 5);
+
+        // Copies don't share the counters
+        SpaceSaving copy(summary);
+        copy.add("key0", 10);
+        EXPECT_EQ(copy.top(1)[0].key, "key0");
+        EXPECT_EQ(summary.top(1)[0].key, "key4");
+        summary = copy;
+        summary.add("key1", 20);
+        EXPECT_EQ(summary.top(1)[0].key, "key1");
+        EXPECT_EQ(copy.top(1)[0].key, "key0");
+    }
+
+    TEST(SketchTest, SSHeavyHittersTest) {
+        SpaceSaving summary(20);
+        std::map<std::string, uint64_t> exact;
+
+        // 3 heavy hitters among 1000 rare strings
+        for (int i = 0; i < 3000; i++) {
+            std::string key = i % 3 ? "rare" + std::to_string(i % 1000) : "heavy" + std::to_string(i % 9);
+            summary.add(key);
+            exact[key]++;
+        }
+
+        EXPECT_EQ(summary.size(), 20);
+        EXPECT_EQ(summary.total(), 3000);
+        EXPECT_LE(summary.min_count(), summary.total() / summary.capacity());
+
+        auto top = summary.top(3);
+        ASSERT_EQ(top.size(), 3);
+        for (auto& entry : top) {
+            EXPECT_EQ(entry.key.compare(0, 5, "heavy"), 0);
+            EXPECT_GE(entry.count, exact[entry.key]);
+            EXPECT_LE(entry.count - entry.error, exact[entry.key]);
+        }
+    }
+
+    TEST(SketchTest, SSMergeTest) {
+        SpaceSaving first(10);
+        SpaceSaving second(10);
+        SpaceSaving whole(10);
+        std::map<std::string, uint64_t> exact;
+
+        // 2 heavy hitters occurring more than total / capacity times among 200 rare strings
+        for (int i = 0; i < 2000; i++) {
+            std::string key = i % 3 ? "rare" + std::to_string(i % 200) : "heavy" + std::to_string(i % 2);
+            (i < 1000 ? first : second).add(key);
+            whole.add(key);
+            exact[key]++;
+        }
+
+        first.merge(second);
+        EXPECT_EQ(first.size(), 10);
+        EXPECT_EQ(first.total(), 2000);
+
+        auto top = first.top(2);
+        ASSERT_EQ(top.size(), 2);
+        EXPECT_EQ(top[0].key, "heavy0");
+        EXPECT_EQ(top[1].key, "heavy1");
+        for (auto& entry : first.top(10)) {
+            EXPECT_GE(entry.count, exact[entry.key]);
+            EXPECT_LE(entry.count - entry.error, exact[entry.key]);
+        }
+
+        // Merging into summary with free counters keeps exact counts
+        SpaceSaving small(5);
+        small.add("a", 3);
+        SpaceSaving large(5);
+        large.add("a", 2);
+        large.add("b", 1);
+        large.merge(small);
+        ASSERT_EQ(large.top(2).size(), 2);
+        EXPECT_EQ(large.top(2)[0].count, 5);
+        EXPECT_EQ(large.top(2)[0].error, 0);
+        EXPECT_EQ(large.top(2)[1].key, "b");
+    }
+
+    TEST(SketchTest, HLLTest) {
+        EXPECT_THROW(HyperLogLog(HyperLogLog::MIN_PRECISION - 1), std::invalid_argument);
+        EXPECT_THROW(HyperLogLog(HyperLogLog::MAX_PRECISION + 1), std::invalid_argument);
+
+        HyperLogLog empty;
+        EXPECT_EQ(empty.estimate(), 0.0);
+
+        HyperLogLog first;
+        HyperLogLog second;
+        for (int i = 0; i < 100000; i++) {
+            std::string key = "key" + std::to_string(i);
+            uint64_t hash = stable_hash(key.data(), key.size());
+            (i % 2 ? first : second).add(hash);
+            // Repeated strings don't change the estimate
+            first.add(hash);
+        }
+
+        EXPECT_NEAR(second.estimate(), 50000, 50000 * 0.03);
+        EXPECT_NEAR(first.estimate(), 100000, 100000 * 0.03);
+        first.merge(second);
+        EXPECT_NEAR(first.estimate(), 100000, 100000 * 0.03);
+
+        HyperLogLog small(10);
+        for (int i = 0; i < 100; i++) {
+            std::string key = "key" + std::to_string(i);
+            small.add(stable_hash(key.data(), key.size()));
+        }
+        EXPECT_NEAR(small.estimate(), 100, 5);
+        EXPECT_THROW(small.merge(first), std::invalid_argument);
+    }
+
+    TEST(SketchTest, TATest) {
+        EXPECT_THROW(TrafficAggregate(0), std::invalid_argument);
+        EXPECT_THROW(TrafficAggregate(60, 10).merge(TrafficAggregate(10, 10)), std::invalid_argument);
+
+        GeneratorConfig config;
+        config.qnames = 500;
+        std::string data = generate_to_memory(config, 20000);
+
+        // Aggregate all Blocks sequentially and count items directly
+        TrafficAggregate sequential(10);
+        std::map<uint64_t, uint64_t> time_series;
+        std::map<std::string, uint64_t> qnames;
+        uint64_t qrs = 0;
+        {
+            std::istringstream input(data);
+            CdnsReader reader(input);
+            CdnsBlockRead block;
+            bool eof = false;
+            while (true) {
+                reader.read_block_into(block, eof);
+                if (eof)
+                    break;
+
+                sequential.add_block(block);
+                for (std::size_t i = 0; i < block.m_query_responses.size(); i++) {
+                    auto qr = block.qr_view(i);
+                    qrs++;
+                    time_series[qr.ts()->m_secs - qr.ts()->m_secs % 10]++;
+                    if (qr.query_name())
+                        qnames[*qr.query_name()]++;
+                }
+            }
+        }
+
+        EXPECT_EQ(sequential.qr_count, qrs);
+        EXPECT_EQ(sequential.time_series, time_series);
+        EXPECT_NEAR(sequential.distinct_qnames.estimate(), qnames.size(), qnames.size() * 0.05);
+
+        // Counters suffice for all QNAMEs, so the counts are exact
+        auto top = sequential.qnames.top(5);
+        ASSERT_EQ(top.size(), 5);
+        for (auto& entry : top) {
+            EXPECT_EQ(entry.error, 0);
+            EXPECT_EQ(entry.count, qnames[entry.key]);
+        }
+
+        uint64_t rcodes = sequential.unanswered;
+        for (auto& count : sequential.rcodes)
+            rcodes += count.second;
+        EXPECT_EQ(rcodes, qrs);
+
+        // Aggregates of individual Blocks merged in parallel give the same result
+        std::istringstream input(data);
+        CdnsReader reader(input);
+        TrafficAggregate merged(10);
+        ParallelBlockReader<TrafficAggregate> parallel(reader, 3);
+        parallel.run([](CdnsBlockRead& block) {
+            TrafficAggregate aggregate(10);
+            aggregate.add_block(block);
+            return aggregate;
+        }, [&merged](TrafficAggregate& aggregate) {
+            merged.merge(aggregate);
+        });
+
+        EXPECT_EQ(merged.qr_count, sequential.qr_count);
+        EXPECT_EQ(merged.unanswered, sequential.unanswered);
+        EXPECT_EQ(merged.time_series, sequential.time_series);
+        EXPECT_EQ(merged.rcodes, sequential.rcodes);
+        EXPECT_EQ(merged.qtypes, sequential.qtypes);
+        EXPECT_EQ(merged.distinct_qnames.estimate(), sequential.distinct_qnames.estimate());
+        EXPECT_EQ(merged.distinct_clients.estimate(), sequential.distinct_clients.estimate());
+        EXPECT_EQ(merged.string(10), sequential.string(10));
+
+        // Partial aggregates of the workers give the same result
+        std::istringstream workers_input(data);
+        CdnsReader workers_reader(workers_input);
+        TrafficAggregate workers(10);
+        EXPECT_EQ(workers.add_blocks(workers_reader, 3), 20);
+        EXPECT_EQ(workers.string(10), sequential.string(10));
+        EXPECT_EQ(workers.distinct_qnames.estimate(), sequential.distinct_qnames.estimate());
+
+        // With fewer counters than QNAMEs the counts stay within their error bounds
+        std::istringstream small_input(data);
+        CdnsReader small_reader(small_input);
+        TrafficAggregate small(10, 50);
+        small.add_blocks(small_reader, 3);
+        EXPECT_EQ(small.qr_count, qrs);
+        EXPECT_EQ(small.qnames.size(), 50);
+        for (auto& entry : small.qnames.top(50)) {
+            EXPECT_GE(entry.count, qnames[entry.key]);
+            EXPECT_LE(entry.count - entry.error, qnames[entry.key]);
+        }
+    }
+}
@@ -0,0 +1,196 @@
+/**
+ * Copyright © 2026 CZ.NIC, z. s. p. o.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, you can obtain one at https://mozilla.org/MPL/2.0/.
+ */
+
+#pragma once
+
+#include <set>
+#include <sstream>
+#include <stdexcept>
+#include <gtest/gtest.h>
+
+#include "../src/cdns.h"
+#include "generator_test.h"
+#include "merge_test.h"
+
+namespace CDNS {
+    /**
+     * @brief Generate 20000 items (20 Blocks) spanning 20 seconds, optionally with Block summary
+     * and its Bloom filter
+     */
+    std::string generate_split_data(bool summary, unsigned filter_bits = 0) {
+        GeneratorConfig config;
+        config.rate = 1000;
+        TrafficGenerator generator(config);
+        FilePreamble fp;
+        fp.m_block_parameters[0].storage_parameters.max_block_items = 1000;
+        MemoryOutput buffer;
+        {
+            CdnsExporter exporter(fp, buffer, CborOutputCompression::NO_COMPRESSION);
+            exporter.set_block_summary(summary);
+            exporter.set_block_filter(filter_bits);
+            generator.generate(exporter, 20000);
+            exporter.write_block();
+        }
+        return buffer.release();
+    }
+
+    /**
+     * @brief Split C-DNS data to memory outputs
+     * @param starts Start passed to the function opening the outputs for each output
+     */
+    std::vector<MemoryOutput> split_data(const std::string& data, CdnsSplit& split, std::vector<uint64_t>& starts) {
+        std::istringstream input(data);
+        CdnsReader reader(input);
+        std::vector<MemoryOutput> outputs;
+
+        std::size_t count = split.run(reader, [&outputs, &starts](FilePreamble& fp, std::size_t index, uint64_t start) {
+            EXPECT_EQ(index, outputs.size());
+            outputs.emplace_back();
+            starts.push_back(start);
+            return std::unique_ptr<CdnsExporter>(new CdnsExporter(fp, outputs.back(),
+                                                                  CborOutputCompression::NO_COMPRESSION));
+        });
+
+        EXPECT_EQ(count, outputs.size());
+        EXPECT_EQ(split.get_stats().outputs, outputs.size());
+        return outputs;
+    }
+
+    /**
+     * @brief Count Blocks of C-DNS data
+     */
+    std::size_t count_blocks(const std::string& data) {
+        std::istringstream input(data);
+        CdnsReader reader(input);
+        RawBlock raw;
+        bool eof = false;
+        std::size_t blocks = 0;
+
+        while (true) {
+            reader.read_raw_block(raw, eof);
+            if (eof)
+                break;
+            blocks++;
+        }
+
+        return blocks;
+    }
+
+    TEST(CdnsSplitTest, CSBlocksTest) {
+        EXPECT_THROW(CdnsSplit(SplitBy::BLOCKS, 0), std::invalid_argument);
+
+        std::string data = generate_split_data(false);
+        std::size_t items = 0;
+        std::vector<Timestamp> timestamps = read_qr_timestamps(data, items);
+
+        CdnsSplit split(SplitBy::BLOCKS, 3, 2);
+        std::vector<uint64_t> starts;
+        std::vector<MemoryOutput> outputs = split_data(data, split, starts);
+        ASSERT_EQ(outputs.size(), 7);
+        EXPECT_EQ(split.get_stats().blocks_read, 20);
+        EXPECT_EQ(split.get_stats().blocks_copied, 20);
+        EXPECT_EQ(split.get_stats().blocks_split, 0);
+
+        // Outputs contain the Blocks of the input in the original order
+        std::vector<Timestamp> split_timestamps;
+        std::size_t split_items = 0;
+        for (std::size_t i = 0; i < outputs.size(); i++) {
+            EXPECT_EQ(count_blocks(outputs[i].data()), i < 6 ? 3 : 2);
+            std::size_t output_items = 0;
+            auto output_timestamps = read_qr_timestamps(outputs[i].data(), output_items);
+            ASSERT_FALSE(output_timestamps.empty());
+            EXPECT_LE(starts[i], output_timestamps.front().m_secs);
+            split_timestamps.insert(split_timestamps.end(), output_timestamps.begin(), output_timestamps.end());
+            split_items += output_items;
+        }
+        EXPECT_EQ(split_items, items);
+        ASSERT_EQ(split_timestamps.size(), timestamps.size());
+        for (std::size_t i = 0; i < timestamps.size(); i++) {
+            EXPECT_EQ(split_timestamps[i].m_secs, timestamps[i].m_secs);
+            EXPECT_EQ(split_timestamps[i].m_ticks, timestamps[i].m_ticks);
+        }
+    }
+
+    TEST(CdnsSplitTest, CSSizeTest) {
+        std::string data = generate_split_data(false);
+
+        // Each output has at least one Block
+        CdnsSplit single(SplitBy::SIZE, 1, 3);
+        std::vector<uint64_t> starts;
+        EXPECT_EQ(split_data(data, single, starts).size(), 20);
+
+        CdnsSplit split(SplitBy::SIZE, data.size() / 4);
+        starts.clear();
+        std::vector<MemoryOutput> outputs = split_data(data, split, starts);
+        EXPECT_GE(outputs.size(), 5);
+        EXPECT_LE(outputs.size(), 6);
+        for (auto& output : outputs)
+            EXPECT_LE(output.size(), data.size() / 4 + 100);
+    }
+
+    TEST(CdnsSplitTest, CSTimeTest) {
+        for (bool summary : {false, true}) {
+            std::string data = generate_split_data(summary);
+            std::size_t items = 0;
+            std::vector<Timestamp> timestamps = read_qr_timestamps(data, items);
+            std::set<uint64_t> buckets;
+            for (auto& ts : timestamps)
+                buckets.insert(ts.m_secs / 3 * 3);
+
+            CdnsSplit split(SplitBy::TIME, 3, 2);
+            std::vector<uint64_t> starts;
+            std::vector<MemoryOutput> outputs = split_data(data, split, starts);
+            ASSERT_EQ(outputs.size(), buckets.size());
+            EXPECT_EQ(std::set<uint64_t>(starts.begin(), starts.end()), buckets);
+            EXPECT_EQ(split.get_stats().blocks_read, 20);
+            EXPECT_GT(split.get_stats().blocks_split, 0);
+            EXPECT_EQ(split.get_stats().blocks_copied + split.get_stats().blocks_split, 20);
+            EXPECT_EQ(split.get_stats().out_of_order, 0);
+
+            // Each output contains only items of its time bucket
+            std::size_t split_items = 0;
+            std::size_t split_qrs = 0;
+            for (std::size_t i = 0; i < outputs.size(); i++) {
+                std::size_t output_items = 0;
+                for (auto& ts : read_qr_timestamps(outputs[i].data(), output_items)) {
+                    EXPECT_GE(ts.m_secs, starts[i]);
+                    EXPECT_LT(ts.m_secs, starts[i] + 3);
+                    split_qrs++;
+                }
+                split_items += output_items;
+            }
+            EXPECT_EQ(split_items, items);
+            EXPECT_EQ(split_qrs, timestamps.size());
+        }
+    }
+
+    TEST(CdnsSplitTest, CSTimeFilterTest) {
+        // Split Blocks keep the size of the input's Bloom filters
+        std::string data = generate_split_data(true, 4);
+        CdnsSplit split(SplitBy::TIME, 3, 2);
+        std::vector<uint64_t> starts;
+        std::vector<MemoryOutput> outputs = split_data(data, split, starts);
+        EXPECT_GT(split.get_stats().blocks_split, 0);
+
+        std::size_t blocks = 0;
+        for (auto& output : outputs) {
+            std::istringstream input(output.data());
+            CdnsReader reader(input);
+            CdnsBlockRead block;
+            bool eof = false;
+            while (true) {
+                reader.read_block_into(block, eof);
+                if (eof)
+                    break;
+                EXPECT_EQ(block.get_read_summary_filter(), 4);
+                blocks++;
+            }
+        }
+        EXPECT_GT(blocks, 20);
+    }
+}
@@ -0,0 +1,133 @@
+/**
+ * Copyright © 2026 CZ.NIC, z. s. p. o.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, you can obtain one at https://mozilla.org/MPL/2.0/.
+ */
+
+#pragma once
+
+#include <string>
+#include <stdexcept>
+#include <gtest/gtest.h>
+
+#include "../src/string_interner.h"
+
+namespace CDNS {
+    TEST(StringInternerTest, SICTest) {
+        EXPECT_THROW(StringInterner{0}, std::invalid_argument);
+        EXPECT_NO_THROW(StringInterner{1});
+
+        StringInterner interner;
+        EXPECT_EQ(interner.capacity(), StringInterner::DEFAULT_CAPACITY);
+        EXPECT_EQ(interner.size(), 0);
+    }
+
+    TEST(StringInternerTest, SIInternTest) {
+        StringInterner interner(4096);
+        uint64_t epoch = interner.start_block();
+
+        // Enough strings to grow the hash table a few times
+        for (int i = 0; i < 3000; i++) {
+            std::string data = "name" + std::to_string(i);
+            StringInterner::Entry* entry = interner.intern(data, CdnsBlock::string_hash(data));
+            ASSERT_NE(entry, nullptr);
+            EXPECT_EQ(entry->item.data, data);
+            EXPECT_EQ(entry->epoch, 0);
+            interner.set_index(*entry, epoch, i);
+        }
+        EXPECT_EQ(interner.size(), 3000);
+
+        for (int i = 0; i < 3000; i++) {
+            std::string data = "name" + std::to_string(i);
+            StringInterner::Entry* entry = interner.intern(data, CdnsBlock::string_hash(data));
+            ASSERT_NE(entry, nullptr);
+            EXPECT_EQ(entry->epoch, epoch);
+            EXPECT_EQ(entry->index, i);
+        }
+        EXPECT_EQ(interner.size(), 3000);
+        EXPECT_EQ(interner.lookups(), 6000);
+        EXPECT_EQ(interner.hits(), 3000);
+        EXPECT_EQ(interner.evictions(), 0);
+
+        // Strings with colliding hashes are still distinguished
+        StringInterner::Entry* entry = interner.intern("collision", 1);
+        interner.set_index(*entry, epoch, 1);
+        entry = interner.intern("other", 1);
+        EXPECT_EQ(entry->item.data, "other");
+        EXPECT_EQ(entry->epoch, 0);
+    }
+
+    TEST(StringInternerTest, SIEvictTest) {
+        StringInterner interner(3);
+        interner.start_block();
+        for (auto& data : {"a", "b", "c"})
+            interner.intern(data, CdnsBlock::string_hash(data));
+
+        // First pass of the CLOCK clears all reference bits and evicts "a"
+        interner.intern("d", CdnsBlock::string_hash("d"));
+        EXPECT_EQ(interner.evictions(), 1);
+
+        // "c" is used again, so "b" is evicted next
+        interner.intern("c", CdnsBlock::string_hash("c"));
+        interner.intern("e", CdnsBlock::string_hash("e"));
+        EXPECT_EQ(interner.size(), 3);
+        EXPECT_EQ(interner.evictions(), 2);
+
+        uint64_t hits = interner.hits();
+        for (auto& data : {"c", "d", "e"})
+            interner.intern(data, CdnsBlock::string_hash(data));
+        EXPECT_EQ(interner.hits(), hits + 3);
+        EXPECT_EQ(interner.evictions(), 2);
+
+        interner.intern("b", CdnsBlock::string_hash("b"));
+        EXPECT_EQ(interner.hits(), hits + 3);
+        EXPECT_EQ(interner.evictions(), 3);
+    }
+
+    TEST(StringInternerTest, SIPinnedTest) {
+        StringInterner interner(2);
+        uint64_t epoch = interner.start_block();
+        for (auto& data : {"a", "b"}) {
+            StringInterner::Entry* entry = interner.intern(data, CdnsBlock::string_hash(data));
+            interner.set_index(*entry, epoch, 0);
+        }
+
+        // All entries are used by the current Block
+        EXPECT_EQ(interner.intern("c", CdnsBlock::string_hash("c")), nullptr);
+        EXPECT_EQ(interner.evictions(), 0);
+
+        // Next Block can evict them
+        epoch = interner.start_block();
+        StringInterner::Entry* entry = interner.intern("c", CdnsBlock::string_hash("c"));
+        ASSERT_NE(entry, nullptr);
+        EXPECT_EQ(entry->item.data, "c");
+        EXPECT_EQ(interner.evictions(), 1);
+    }
+
+    TEST(StringInternerTest, SIRemoveClusterTest) {
+        // All strings share the home slot, evicting them has to keep the rest of the cluster reachable
+        StringInterner interner(8);
+        interner.start_block();
+        for (int i = 0; i < 8; i++)
+            interner.intern("s" + std::to_string(i), 7);
+
+        for (int round = 0; round < 4; round++) {
+            interner.start_block();
+            for (int i = 0; i < 8; i++) {
+                std::string data = "r" + std::to_string(round) + "_" + std::to_string(i);
+                ASSERT_NE(interner.intern(data, 7 + (i % 2) * 1024), nullptr);
+            }
+            std::size_t hits = interner.hits();
+            for (int i = 0; i < 8; i++) {
+                std::string data = "r" + std::to_string(round) + "_" + std::to_string(i);
+                StringInterner::Entry* entry = interner.intern(data, 7 + (i % 2) * 1024);
+                ASSERT_NE(entry, nullptr);
+                EXPECT_EQ(entry->item.data, data);
+            }
+            EXPECT_EQ(interner.hits(), hits + 8);
+            EXPECT_EQ(interner.size(), 8);
+        }
+    }
+}
@@ -11,9 +11,18 @@
 #include "hash_test.h"
 #include "timestamp_test.h"
 #include "block_table_test.h"
+#include "string_interner_test.h"
+#include "bloom_filter_test.h"
 #include "block_test.h"
 #include "writer_test.h"
 #include "cdns_encoder_test.h"
 #include "cdns_decoder_test.h"
 #include "cdns_exporter_test.h"
 #include "cdns_reader_test.h"
+#include "generator_test.h"
+#include "columns_test.h"
+#include "merge_test.h"
+#include "search_test.h"
+#include "sketch_test.h"
+#include "split_test.h"
+#include "compression_test.h"
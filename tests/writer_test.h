@@ -237,4 +237,193 @@ namespace CDNS {
 
         remove_file(file + ".xz");
     }
+
+    TEST(IoUringWriterTest, IUWCTest) {
+        CborOutputWriter* cow = new CborOutputWriter(IoUringOutput(file, 4096, 2));
+        struct stat buff;
+
+        EXPECT_EQ(stat((file + ".part").c_str(), &buff), 0);
+        delete cow;
+        remove_file(file);
+
+        EXPECT_EQ(stat(file.c_str(), &buff), -1);
+    }
+
+    TEST(IoUringWriterTest, IUWWriteTest) {
+        CborOutputWriter* cow = new CborOutputWriter(IoUringOutput(file, 4096, 2));
+        std::string out;
+
+        // Spans multiple buffers so more writes are in flight at once
+        for (int i = 0; out.size() < 5 * 4096 + 100; i++)
+            out += std::to_string(i) + ",";
+
+        cow->write(out.c_str(), 1000);
+        cow->write(out.c_str() + 1000, out.size() - 1000);
+        delete cow;
+
+        test_content_and_remove_file(file, out);
+    }
+
+    TEST(IoUringWriterTest, IUWRotateTest) {
+        CborOutputWriter* cow = new CborOutputWriter(IoUringOutput(file, 4096, 2));
+        std::string out("test");
+
+        cow->write(out.c_str(), out.size());
+        cow->rotate_output(IoUringOutput(file2));
+        cow->write(out.c_str(), out.size());
+        delete cow;
+
+        test_content_and_remove_file(file, out);
+        test_content_and_remove_file(file2, out);
+    }
+
+    TEST(IoUringWriterTest, IUWFDWriteTest) {
+        int fd = open(file.c_str(), O_CREAT | O_RDWR | O_TRUNC, 0644);
+        CborOutputWriter* cow = new CborOutputWriter(IoUringOutput(fd, 4096, 3));
+        std::string out(3 * 4096 + 7, 'x');
+
+        cow->write(out.c_str(), out.size());
+        delete cow;
+
+        test_content_and_remove_file(file, out);
+    }
+
+    TEST(IoUringWriterTest, IUWFailedWriteTest) {
+        // Writes to read-only descriptor fail
+        close(open(file.c_str(), O_CREAT | O_TRUNC | O_WRONLY, 0644));
+        int fd = open(file.c_str(), O_RDONLY);
+        CborOutputWriter* cow = new CborOutputWriter(IoUringOutput(fd, 4096, 3));
+        std::string out(2 * 4096 + 7, 'x');
+
+        // Failure is reported when the failed buffer is reused or at the latest when the output is closed
+        bool failed = false;
+        try {
+            cow->write(out.c_str(), out.size());
+        }
+        catch (CborOutputException& e) {
+            failed = true;
+        }
+        try {
+            cow->rotate_output(IoUringOutput(file2));
+        }
+        catch (CborOutputException& e) {
+            failed = true;
+        }
+        EXPECT_TRUE(failed);
+
+        // Writer continues with the new output
+        cow->write(out.c_str(), out.size());
+        delete cow;
+
+        test_content_and_remove_file(file, "");
+        test_content_and_remove_file(file2, out);
+    }
+
+    TEST(IoUringWriterTest, IUWGzipWriteTest) {
+        GzipCborOutputWriter* cow = new GzipCborOutputWriter(IoUringOutput(file));
+        std::string out("test");
+
+        cow->write(out.c_str(), out.size());
+        delete cow;
+
+        gzFile gzfile = gzopen((file + ".gz").c_str(), "rb");
+        char gz[255];
+        int ret = gzread(gzfile, gz, 255);
+        EXPECT_EQ(ret, out.size());
+        EXPECT_EQ(std::string(gz, ret), out);
+        gzclose(gzfile);
+
+        remove_file(file + ".gz");
+    }
+
+    TEST(MemoryOutputWriterTest, MOWWriteTest) {
+        MemoryOutput buffer;
+        CborOutputWriter* cow = new CborOutputWriter(buffer);
+        std::string out("test");
+
+        cow->write(out.c_str(), out.size());
+        cow->write(out.c_str(), out.size());
+        EXPECT_EQ(buffer.data(), out + out);
+        delete cow;
+
+        std::string result = buffer.release();
+        EXPECT_EQ(result, out + out);
+        EXPECT_EQ(buffer.size(), 0);
+    }
+
+    TEST(MemoryOutputWriterTest, MOWRotateTest) {
+        MemoryOutput buffer, buffer2;
+        CborOutputWriter* cow = new CborOutputWriter(buffer);
+        std::string out("test");
+
+        cow->write(out.c_str(), out.size());
+        cow->rotate_output(buffer2);
+        cow->write(out.c_str(), out.size());
+        cow->write(out.c_str(), out.size());
+        delete cow;
+
+        EXPECT_EQ(buffer.data(), out);
+        EXPECT_EQ(buffer2.data(), out + out);
+    }
+
+    TEST(MemoryOutputWriterTest, MOWGzipWriteTest) {
+        MemoryOutput buffer;
+        GzipCborOutputWriter* cow = new GzipCborOutputWriter(buffer);
+        std::string out("test");
+
+        cow->write(out.c_str(), out.size());
+        delete cow;
+
+        z_stream gzip;
+        std::memset(&gzip, 0, sizeof(gzip));
+        ASSERT_EQ(inflateInit2(&gzip, 31), Z_OK);
+        char result[255];
+        gzip.next_in = reinterpret_cast<const unsigned char*>(buffer.data().data());
+        gzip.avail_in = buffer.size();
+        gzip.next_out = reinterpret_cast<unsigned char*>(result);
+        gzip.avail_out = sizeof(result);
+        EXPECT_EQ(inflate(&gzip, Z_FINISH), Z_STREAM_END);
+        EXPECT_EQ(std::string(result, sizeof(result) - gzip.avail_out), out);
+        inflateEnd(&gzip);
+    }
+
+    TEST(MemoryOutputWriterTest, MOWXzWriteTest) {
+        MemoryOutput buffer;
+        XzCborOutputWriter* cow = new XzCborOutputWriter(buffer);
+        std::string out("test");
+
+        cow->write(out.c_str(), out.size());
+        delete cow;
+
+        uint64_t memlimit = UINT64_MAX;
+        std::size_t in_pos = 0, out_pos = 0;
+        uint8_t result[255];
+        EXPECT_EQ(lzma_stream_buffer_decode(&memlimit, 0, nullptr,
+                                            reinterpret_cast<const uint8_t*>(buffer.data().data()),
+                                            &in_pos, buffer.size(), result, &out_pos, sizeof(result)),
+                  LZMA_OK);
+        EXPECT_EQ(std::string(reinterpret_cast<char*>(result), out_pos), out);
+    }
+
+    TEST(CallbackOutputWriterTest, CBOWWriteTest) {
+        std::string result;
+        unsigned closed = 0;
+        CallbackOutput callback([&result](const char* p, std::size_t size) { result.append(p, size); },
+                                [&closed]() { closed++; });
+        CborOutputWriter* cow = new CborOutputWriter(callback);
+        std::string out("test");
+
+        cow->write(out.c_str(), out.size());
+        cow->rotate_output(callback);
+        EXPECT_EQ(closed, 1);
+        cow->write(out.c_str(), out.size());
+        delete cow;
+
+        EXPECT_EQ(closed, 2);
+        EXPECT_EQ(result, out + out);
+    }
+
+    TEST(CallbackOutputWriterTest, CBOWEmptyTest) {
+        EXPECT_THROW(CborOutputWriter(CallbackOutput(nullptr)), CborOutputException);
+    }
 }
\ No newline at end of file